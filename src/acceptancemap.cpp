@@ -0,0 +1,392 @@
+/// @file acceptancemap.cpp
+/// @date 19.10.2026
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include "constants.h"
+#include "hitkernel.h"
+#include "hash.h"
+#include "acceptancemap.h"
+
+//identifies files with acceptance maps
+//(version 2: 3-gamma decays weighted as in TGenPhaseSpace, prompt gamma of 2&1 decays not required,
+//version 3: grid points outside the barrel hold acceptance at the nearest point inside)
+static const char kMapMagic[8] = {'J', 'P', 'E', 'T', 'A', 'C', 'C', '3'};
+//number of decays pushed to the hit point kernel at once
+static const int kDecaysPerBatch = 4096;
+//relative distance from the wall of the barrel at which grid points outside it are computed
+static const double kWallMargin = 1e-6;
+
+///
+/// \brief isotropicDirection Draws a random unit vector.
+/// \param rng Random engine.
+/// \param dir Output array with 3 components.
+///
+static void isotropicDirection(std::mt19937_64& rng, double* dir)
+{
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    double cosTheta = 2.0*uni(rng)-1.0;
+    double sinTheta = std::sqrt(1.0-cosTheta*cosTheta);
+    double phi = 2.0*TMath::Pi()*uni(rng);
+    dir[0] = sinTheta*std::cos(phi);
+    dir[1] = sinTheta*std::sin(phi);
+    dir[2] = cosTheta;
+}
+
+///
+/// \brief boostPhoton Boosts a photon from the rest frame of a system to the frame in which the system moves with velocity beta.
+/// \param beta Velocity of the system (3 components, |beta|<1).
+/// \param p Momentum of the photon, replaced by the boosted one.
+///
+static void boostPhoton(const double* beta, double* p)
+{
+    double b2 = beta[0]*beta[0]+beta[1]*beta[1]+beta[2]*beta[2];
+    double gamma = 1.0/std::sqrt(1.0-b2);
+    double bp = beta[0]*p[0]+beta[1]*p[1]+beta[2]*p[2];
+    double e = std::sqrt(p[0]*p[0]+p[1]*p[1]+p[2]*p[2]);
+    double factor = (b2>0.0 ? (gamma-1.0)*bp/b2 : 0.0)+gamma*e;
+    for(int kk=0; kk<3; kk++)
+        p[kk] += factor*beta[kk];
+}
+
+///
+/// \brief AcceptanceMap::AcceptanceMap Constructor, the map is empty until Build() or Load() is called.
+/// \param type Type of the decay: ONE, TWO, THREE or TWOandONE.
+/// \param R Radius of the detector [mm].
+/// \param L Length of the detector [mm].
+/// \param grid Grid of source positions.
+/// \param samples Number of decays simulated in every grid point.
+/// \param seed Seed of the random generator.
+///
+AcceptanceMap::AcceptanceMap(DecayType type, double R, double L, const AcceptanceGrid& grid, int samples, unsigned long seed) :
+    fDecayType_(type),
+    fR_(R),
+    fL_(L),
+    fGrid_(grid),
+    fSamples_(samples),
+    fSeed_(seed),
+    fBuilt_(false)
+{
+    if(type!=ONE && type!=TWO && type!=THREE && type!=TWOandONE)
+        throw(std::string("[ERROR] Acceptance maps are available only for 1, 2, 3 and 2&1 gamma decays!"));
+    if(fGrid_.nx<1 || fGrid_.ny<1 || fGrid_.nz<1 || fSamples_<1)
+        throw(std::string("[ERROR] Invalid grid of the acceptance map!"));
+    fValues_.assign(fGrid_.nx*fGrid_.ny*fGrid_.nz, 0.0);
+}
+
+///
+/// \brief AcceptanceMap::DefaultGrid Grid covering the whole barrel.
+/// \param R Radius of the detector [mm].
+/// \param L Length of the detector [mm].
+/// \param nx Number of points along X axis.
+/// \param ny Number of points along Y axis.
+/// \param nz Number of points along Z axis.
+/// \return Grid spanning from -R to R in X and Y and from -L/2 to L/2 in Z.
+///
+AcceptanceGrid AcceptanceMap::DefaultGrid(double R, double L, int nx, int ny, int nz)
+{
+    AcceptanceGrid grid = {nx, ny, nz, -R, R, -R, R, -L/2.0, L/2.0};
+    return grid;
+}
+
+///
+/// \brief AcceptanceMap::GetKey Describes everything the map depends on.
+/// \return Human-readable key, stored also in the cache file.
+///
+std::string AcceptanceMap::GetKey() const
+{
+    std::ostringstream key;
+    key<<std::setprecision(10);
+    key<<"type="<<fDecayType_<<" R="<<fR_<<" L="<<fL_<<" grid="<<fGrid_.nx<<"x"<<fGrid_.ny<<"x"<<fGrid_.nz\
+       <<" x=["<<fGrid_.xMin<<","<<fGrid_.xMax<<"] y=["<<fGrid_.yMin<<","<<fGrid_.yMax<<"] z=["<<fGrid_.zMin<<","<<fGrid_.zMax<<"]"\
+       <<" samples="<<fSamples_<<" seed="<<fSeed_;
+    return key.str();
+}
+
+///
+/// \brief AcceptanceMap::GetCacheFileName
+/// \return Name of the file (without directory) in which the map is cached.
+///
+std::string AcceptanceMap::GetCacheFileName() const
+{
+    std::ostringstream name;
+    name<<"acceptance_"<<std::hex<<std::setw(16)<<std::setfill('0')<<fnv1a(GetKey())<<".map";
+    return name.str();
+}
+
+///
+/// \brief AcceptanceMap::Coordinate_ Position of a grid point along one axis.
+///
+double AcceptanceMap::Coordinate_(int index, int n, double min, double max) const
+{
+    return n>1 ? min+(max-min)*index/(double)(n-1) : min;
+}
+
+///
+/// \brief AcceptanceMap::ComputePoint_ Simulates decays in a single point and counts the ones in which all required photons hit the barrel.
+/// Photons are required as in InitialCuts, the prompt photon of 2&1 decays is not, so it is not simulated at all.
+/// 3-gamma decays are generated and weighted in the same way as in TGenPhaseSpace, used by the event loop.
+/// \param x X coordinate of the source [mm].
+/// \param y Y coordinate of the source [mm].
+/// \param z Z coordinate of the source [mm].
+/// \param rng Random engine.
+/// \return Fraction of accepted decays.
+///
+double AcceptanceMap::ComputePoint_(double x, double y, double z, std::mt19937_64& rng) const
+{
+    if(!Inside_(x, y, z))
+        return 0.0;
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    const double M = 2.0*e_mass_MeV;
+    int photonsPerDecay = fDecayType_==ONE ? 1 : (fDecayType_==THREE ? 3 : 2);
+    PhotonBatch photons;
+    HitBatch hits;
+    photons.Reserve(kDecaysPerBatch*photonsPerDecay);
+    std::vector<double> weights(kDecaysPerBatch, 1.0);
+    double accepted = 0.0;
+    double total = 0.0;
+    for(int done=0; done<fSamples_; done+=kDecaysPerBatch)
+    {
+        int n = std::min(kDecaysPerBatch, fSamples_-done);
+        photons.Clear();
+        for(int ii=0; ii<n; ii++)
+        {
+            double a[3];
+            isotropicDirection(rng, a);
+            if(fDecayType_==ONE)
+            {
+                photons.Push(x, y, z, a[0], a[1], a[2], 1.0);
+            }
+            else if(fDecayType_==THREE)
+            {
+                //as in TGenPhaseSpace: invariant mass of photons 1 and 2 is uniform, the decay is weighted
+                //by the product of momenta in the two-body decays (Ps -> 12 + 3 and 12 -> 1 + 2)
+                double m12 = (1.0-uni(rng))*M;
+                double p3 = (M*M-m12*m12)/(2.0*M);
+                weights[ii] = p3*m12/2.0;
+                double b[3];
+                isotropicDirection(rng, b);
+                double beta[3];
+                double e12 = std::sqrt(m12*m12+p3*p3);
+                double p1[3], p2[3];
+                for(int kk=0; kk<3; kk++)
+                {
+                    beta[kk] = -p3*a[kk]/e12;
+                    p1[kk] = m12/2.0*b[kk];
+                    p2[kk] = -p1[kk];
+                }
+                boostPhoton(beta, p1);
+                boostPhoton(beta, p2);
+                photons.Push(x, y, z, p1[0], p1[1], p1[2], std::sqrt(p1[0]*p1[0]+p1[1]*p1[1]+p1[2]*p1[2]));
+                photons.Push(x, y, z, p2[0], p2[1], p2[2], std::sqrt(p2[0]*p2[0]+p2[1]*p2[1]+p2[2]*p2[2]));
+                photons.Push(x, y, z, p3*a[0], p3*a[1], p3*a[2], p3);
+            }
+            else
+            {
+                //back-to-back annihilation photons, the prompt photon of 2&1 decays is not required by InitialCuts
+                photons.Push(x, y, z, a[0], a[1], a[2], M/2.0);
+                photons.Push(x, y, z, -a[0], -a[1], -a[2], M/2.0);
+            }
+        }
+        CalculateHitPointsBatch(photons, fR_, fL_, hits);
+        for(int ii=0; ii<n; ii++)
+        {
+            bool pass = true;
+            for(int kk=0; kk<photonsPerDecay; kk++)
+                pass &= !hits.miss[ii*photonsPerDecay+kk];
+            total += weights[ii];
+            if(pass)
+                accepted += weights[ii];
+        }
+    }
+    return total>0.0 ? accepted/total : 0.0;
+}
+
+///
+/// \brief AcceptanceMap::ClampToBarrel_ Moves a point outside the barrel to the nearest point just inside it.
+/// Grid points outside the barrel (e.g. corners of the default grid) get the acceptance at the wall instead of 0,
+/// otherwise interpolation near the wall would mix in zeros and underestimate acceptance.
+/// \param x X coordinate [mm], updated.
+/// \param y Y coordinate [mm], updated.
+/// \param z Z coordinate [mm], updated.
+///
+void AcceptanceMap::ClampToBarrel_(double& x, double& y, double& z) const
+{
+    const double rMax = fR_*(1.0-kWallMargin);
+    const double zMax = fL_/2.0*(1.0-kWallMargin);
+    double r = std::sqrt(x*x+y*y);
+    if(r > rMax)
+    {
+        x *= rMax/r;
+        y *= rMax/r;
+    }
+    z = std::max(-zMax, std::min(zMax, z));
+}
+
+///
+/// \brief AcceptanceMap::Build Computes acceptance in all grid points. Points are distributed dynamically between threads.
+/// Every point has its own random stream, so the result does not depend on the number of threads.
+/// \param threads Number of threads, 0 means std::thread::hardware_concurrency().
+///
+void AcceptanceMap::Build(unsigned threads)
+{
+    if(threads==0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    const int noOfPoints = fValues_.size();
+    std::atomic<int> next(0);
+    auto worker = [this, &next, noOfPoints]()
+    {
+        for(int index=next++; index<noOfPoints; index=next++)
+        {
+            int ix = index%fGrid_.nx;
+            int iy = (index/fGrid_.nx)%fGrid_.ny;
+            int iz = index/(fGrid_.nx*fGrid_.ny);
+            std::seed_seq seq{(unsigned)fSeed_, (unsigned)(fSeed_>>32), (unsigned)index};
+            std::mt19937_64 rng(seq);
+            double x = Coordinate_(ix, fGrid_.nx, fGrid_.xMin, fGrid_.xMax);
+            double y = Coordinate_(iy, fGrid_.ny, fGrid_.yMin, fGrid_.yMax);
+            double z = Coordinate_(iz, fGrid_.nz, fGrid_.zMin, fGrid_.zMax);
+            ClampToBarrel_(x, y, z);
+            fValues_[index] = ComputePoint_(x, y, z, rng);
+        }
+    };
+    std::vector<std::thread> pool;
+    for(unsigned ii=1; ii<threads; ii++)
+        pool.push_back(std::thread(worker));
+    worker();
+    for(auto& thread : pool)
+        thread.join();
+    fBuilt_ = true;
+}
+
+///
+/// \brief AcceptanceMap::Save Writes the map to the cache directory.
+/// \param cacheDir Path to the cache directory (with trailing slash).
+/// \return True if succeeded.
+///
+bool AcceptanceMap::Save(const std::string& cacheDir) const
+{
+    if(!fBuilt_)
+        return false;
+    std::ofstream out((cacheDir+GetCacheFileName()).c_str(), std::ios::binary);
+    if(!out)
+        return false;
+    std::string key = GetKey();
+    uint32_t keyLength = key.size();
+    uint64_t noOfValues = fValues_.size();
+    out.write(kMapMagic, sizeof(kMapMagic));
+    out.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+    out.write(key.data(), keyLength);
+    out.write(reinterpret_cast<const char*>(&noOfValues), sizeof(noOfValues));
+    out.write(reinterpret_cast<const char*>(fValues_.data()), noOfValues*sizeof(double));
+    return out.good();
+}
+
+///
+/// \brief AcceptanceMap::Load Reads the map from the cache directory. The key stored in the file must match the key of this map.
+/// \param cacheDir Path to the cache directory (with trailing slash).
+/// \return True if the map was found and loaded.
+///
+bool AcceptanceMap::Load(const std::string& cacheDir)
+{
+    std::ifstream in((cacheDir+GetCacheFileName()).c_str(), std::ios::binary);
+    if(!in)
+        return false;
+    char magic[sizeof(kMapMagic)];
+    uint32_t keyLength = 0;
+    uint64_t noOfValues = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&keyLength), sizeof(keyLength));
+    if(!in || std::memcmp(magic, kMapMagic, sizeof(kMapMagic))!=0 || keyLength>4096)
+        return false;
+    std::string key(keyLength, ' ');
+    in.read(&key[0], keyLength);
+    in.read(reinterpret_cast<char*>(&noOfValues), sizeof(noOfValues));
+    if(!in || key!=GetKey() || noOfValues!=fValues_.size())
+        return false;
+    in.read(reinterpret_cast<char*>(fValues_.data()), noOfValues*sizeof(double));
+    fBuilt_ = in.good();
+    return fBuilt_;
+}
+
+///
+/// \brief AcceptanceMap::LoadOrBuild Loads the map from cache, builds and caches it if it is not there.
+/// \param cacheDir Path to the cache directory (with trailing slash).
+/// \param threads Number of threads used to build the map.
+/// \param silent If true, less output is printed.
+///
+void AcceptanceMap::LoadOrBuild(const std::string& cacheDir, unsigned threads, bool silent)
+{
+    if(Load(cacheDir))
+    {
+        if(!silent) std::cout<<"[INFO] Acceptance map loaded from cache: "<<cacheDir+GetCacheFileName()<<std::endl;
+        return;
+    }
+    if(!silent) std::cout<<"[INFO] Building acceptance map: "<<GetKey()<<std::endl;
+    Build(threads);
+    if(Save(cacheDir))
+    {
+        if(!silent) std::cout<<"[INFO] Acceptance map saved to cache: "<<cacheDir+GetCacheFileName()<<std::endl;
+    }
+    else
+        std::cerr<<"[WARNING] Unable to save acceptance map to: "<<cacheDir+GetCacheFileName()<<std::endl;
+}
+
+///
+/// \brief AcceptanceMap::Interpolate Trilinear interpolation between grid points.
+/// \param x X coordinate of the source [mm].
+/// \param y Y coordinate of the source [mm].
+/// \param z Z coordinate of the source [mm].
+/// \return Interpolated acceptance, 0 outside the grid and the barrel.
+///
+double AcceptanceMap::Interpolate(double x, double y, double z) const
+{
+    if(!Inside_(x, y, z))
+        return 0.0;
+    double pos[3] = {x, y, z};
+    int n[3] = {fGrid_.nx, fGrid_.ny, fGrid_.nz};
+    double min[3] = {fGrid_.xMin, fGrid_.yMin, fGrid_.zMin};
+    double max[3] = {fGrid_.xMax, fGrid_.yMax, fGrid_.zMax};
+    int i0[3];
+    double frac[3];
+    for(int kk=0; kk<3; kk++)
+    {
+        if(n[kk]==1)
+        {
+            i0[kk] = 0;
+            frac[kk] = 0.0;
+            continue;
+        }
+        double f = (pos[kk]-min[kk])/(max[kk]-min[kk])*(n[kk]-1);
+        if(f < 0.0 || f > n[kk]-1)
+            return 0.0;
+        i0[kk] = std::min((int)f, n[kk]-2);
+        frac[kk] = f-i0[kk];
+    }
+    double value = 0.0;
+    for(int corner=0; corner<8; corner++)
+    {
+        int idx[3];
+        double weight = 1.0;
+        for(int kk=0; kk<3; kk++)
+        {
+            int upper = (corner>>kk) & 1;
+            if(n[kk]==1 && upper)
+            {
+                weight = 0.0;
+                break;
+            }
+            idx[kk] = i0[kk]+upper;
+            weight *= upper ? frac[kk] : 1.0-frac[kk];
+        }
+        if(weight > 0.0)
+            value += weight*fValues_[Index_(idx[0], idx[1], idx[2])];
+    }
+    return value;
+}
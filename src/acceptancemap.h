@@ -0,0 +1,69 @@
+/// @file acceptancemap.h
+/// @date 19.10.2026
+#ifndef ACCEPTANCEMAP_H
+#define ACCEPTANCEMAP_H
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include "event.h"
+
+///
+/// \brief The AcceptanceGrid struct Regular 3D grid of source positions [mm].
+///
+struct AcceptanceGrid
+{
+    int nx;
+    int ny;
+    int nz;
+    double xMin;
+    double xMax;
+    double yMin;
+    double yMax;
+    double zMin;
+    double zMax;
+};
+
+///
+/// \brief The AcceptanceMap class Geometric acceptance of the barrel as a function of the source position.
+/// Values are computed once on a grid, cached on disk and interpolated afterwards.
+///
+class AcceptanceMap
+{
+    public:
+        AcceptanceMap(DecayType type, double R, double L, const AcceptanceGrid& grid, int samples=100000, unsigned long seed=1);
+        //builds the map using many threads, 0 means as many threads as hardware supports
+        void Build(unsigned threads=0);
+        //load/save from/to the cache directory, file name is derived from the key
+        bool Load(const std::string& cacheDir);
+        bool Save(const std::string& cacheDir) const;
+        void LoadOrBuild(const std::string& cacheDir, unsigned threads=0, bool silent=false);
+        //trilinear interpolation, returns 0 outside the grid and the barrel
+        double Interpolate(double x, double y, double z) const;
+        inline double GetValueAt(int ix, int iy, int iz) const {return fValues_[Index_(ix, iy, iz)];}
+        inline bool IsBuilt() const {return fBuilt_;}
+        inline DecayType GetDecayType() const {return fDecayType_;}
+        inline const AcceptanceGrid& GetGrid() const {return fGrid_;}
+        std::string GetKey() const;
+        std::string GetCacheFileName() const;
+        static AcceptanceGrid DefaultGrid(double R, double L, int nx, int ny, int nz);
+
+    private:
+        DecayType fDecayType_;
+        double fR_; //radius of the detector [mm]
+        double fL_; //length of the detector [mm]
+        AcceptanceGrid fGrid_;
+        int fSamples_; //number of decays simulated in every grid point
+        unsigned long fSeed_; //seed of the random generator, combined with the index of grid point
+        bool fBuilt_;
+        std::vector<double> fValues_; //acceptance in grid points, x index changes fastest
+
+        inline int Index_(int ix, int iy, int iz) const {return ix+fGrid_.nx*(iy+fGrid_.ny*iz);}
+        //sources on the surface of the barrel and outside it have no acceptance
+        inline bool Inside_(double x, double y, double z) const {return x*x+y*y < fR_*fR_ && std::fabs(z) < fL_/2.0;}
+        void ClampToBarrel_(double& x, double& y, double& z) const;
+        double Coordinate_(int index, int n, double min, double max) const;
+        double ComputePoint_(double x, double y, double z, std::mt19937_64& rng) const;
+};
+
+#endif // ACCEPTANCEMAP_H
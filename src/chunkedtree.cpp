@@ -0,0 +1,226 @@
+/// @file chunkedtree.cpp
+/// @date 19.10.2026
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include "chunkedtree.h"
+
+///
+/// \brief ChunkedTree::ChunkedTree Creates a single tree in the given directory.
+/// \param dir Directory in which the tree is stored.
+/// \param pManag ParamManager reference with tree settings.
+///
+ChunkedTree::ChunkedTree(TDirectory* dir, const ParamManager& pManag) :
+    fTree_(nullptr),
+    fDir_(dir),
+    fFile_(nullptr),
+    fChunkIndex_(0),
+    fMaxEntries_(0),
+    fMaxBytes_(0),
+    fEntries_(0),
+    fCompression_(-1),
+    fAutoFlush_(pManag.GetAutoFlush()),
+    fAutoSave_(pManag.GetAutoSave())
+{
+    CreateTree_();
+}
+
+///
+/// \brief ChunkedTree::ChunkedTree Creates a tree split into files of limited number of events and size. The first file
+/// is opened immediately, the next ones when an event does not fit into the current file.
+/// \param dir Directory in which chunks are created, ending with '/'.
+/// \param name Name of the run, used as a prefix of chunk files and in the manifest.
+/// \param manifest Path of the manifest, it has to be created with CreateChunkManifest.
+/// \param pManag ParamManager reference with limits of chunks and tree settings.
+///
+ChunkedTree::ChunkedTree(const std::string& dir, const std::string& name, const std::string& manifest, const ParamManager& pManag) :
+    fTree_(nullptr),
+    fDir_(nullptr),
+    fFile_(nullptr),
+    fChunkDir_(dir),
+    fName_(name),
+    fManifest_(manifest),
+    fChunkIndex_(0),
+    fMaxEntries_(pManag.GetChunkEvents()),
+    fMaxBytes_(static_cast<Long64_t>(pManag.GetChunkSize()*1e9)),
+    fEntries_(0),
+    fCompression_(CompressionSettings(pManag.GetCompressionAlgorithm(), pManag.GetCompressionLevel())),
+    fAutoFlush_(pManag.GetAutoFlush()),
+    fAutoSave_(pManag.GetAutoSave())
+{
+    OpenChunk_();
+}
+
+///
+/// \brief ChunkedTree::~ChunkedTree Destructor, writes the tree if it was not closed.
+///
+ChunkedTree::~ChunkedTree()
+{
+    try
+    {
+        Close();
+    }
+    catch(std::string& ex)
+    {
+        //destructors must not throw, the error is only reported
+        fprintf(stderr, "%s\n", ex.c_str());
+    }
+}
+
+///
+/// \brief ChunkedTree::SetBranchSetup Sets the function creating or connecting branches, it is called immediately
+/// and for the tree of every new chunk. It has to stay valid until it is replaced.
+/// \param setup Function receiving the tree, empty function removes the previous one.
+///
+void ChunkedTree::SetBranchSetup(const BranchSetup& setup)
+{
+    fSetup_ = setup;
+    if(fSetup_ && fTree_)
+        fSetup_(fTree_);
+}
+
+///
+/// \brief ChunkedTree::Fill Fills the tree, starting a new chunk if the current one is full. Limits of size are checked
+/// against the data already written to the file, so they may be exceeded by the amount of data buffered by the tree.
+///
+void ChunkedTree::Fill()
+{
+    if(fFile_ && fTree_->GetEntries()>0 && ((fMaxEntries_>0 && fTree_->GetEntries()>=fMaxEntries_) || \
+                                            (fMaxBytes_>0 && fFile_->GetEND()>=fMaxBytes_)))
+    {
+        CloseChunk_();
+        OpenChunk_();
+    }
+    fTree_->Fill();
+    fEntries_++;
+}
+
+///
+/// \brief ChunkedTree::Close Writes the tree and closes the current chunk. Nothing can be filled afterwards.
+///
+void ChunkedTree::Close()
+{
+    if(fFile_)
+    {
+        CloseChunk_();
+    }
+    else if(fTree_)
+    {
+        TDirectory* previous = gDirectory;
+        fDir_->cd();
+        fTree_->Write();
+        delete fTree_;
+        fTree_ = nullptr;
+        previous->cd();
+    }
+}
+
+///
+/// \brief ChunkedTree::CreateTree_ Creates a tree in the current chunk or in the directory and connects its branches.
+///
+void ChunkedTree::CreateTree_()
+{
+    fTree_ = new TTree("tree", "Tree with events and histograms");
+    fTree_->SetDirectory(fFile_ ? fFile_ : fDir_);
+    fTree_->SetAutoFlush(fAutoFlush_);
+    fTree_->SetAutoSave(fAutoSave_);
+    if(fSetup_)
+        fSetup_(fTree_);
+}
+
+///
+/// \brief ChunkedTree::OpenChunk_ Opens the next chunk and creates a tree in it. The current directory is not changed,
+/// so that histograms are still created in the main output file.
+///
+void ChunkedTree::OpenChunk_()
+{
+    char index[16];
+    snprintf(index, sizeof(index), "_%04d.root", fChunkIndex_);
+    std::string path = fChunkDir_+fName_+index;
+    TDirectory* previous = gDirectory;
+    fFile_ = new TFile(path.c_str(), "recreate");
+    if(fFile_->IsZombie())
+    {
+        delete fFile_;
+        fFile_ = nullptr;
+        previous->cd();
+        throw(std::string("[ERROR] Cannot create the file of the tree: ")+path);
+    }
+    if(fCompression_>=0)
+        fFile_->SetCompressionSettings(fCompression_);
+    fChunkIndex_++;
+    CreateTree_();
+    previous->cd();
+}
+
+///
+/// \brief ChunkedTree::CloseChunk_ Writes the tree to the current chunk, closes it and appends it to the manifest.
+///
+void ChunkedTree::CloseChunk_()
+{
+    char index[16];
+    snprintf(index, sizeof(index), "_%04d.root", fChunkIndex_-1);
+    std::string file = fName_+index;
+    TDirectory* previous = gDirectory;
+    fFile_->cd();
+    fTree_->Write();
+    Long64_t entries = fTree_->GetEntries();
+    fFile_->Close(); //deletes the tree
+    delete fFile_;
+    fFile_ = nullptr;
+    fTree_ = nullptr;
+    if(previous!=gDirectory)
+        previous->cd();
+    struct stat info;
+    long long bytes = stat((fChunkDir_+file).c_str(), &info)==0 ? static_cast<long long>(info.st_size) : 0;
+    std::ofstream manifest(fManifest_.c_str(), std::ios::app);
+    manifest<<fName_<<" "<<file<<" "<<entries<<" "<<bytes<<std::endl;
+    if(!manifest)
+        throw(std::string("[ERROR] Cannot write to the manifest: ")+fManifest_);
+}
+
+///
+/// \brief CreateChunkManifest Creates an empty manifest, an existing one is overwritten.
+/// \param manifest Path of the manifest.
+///
+void CreateChunkManifest(const std::string& manifest)
+{
+    std::ofstream file(manifest.c_str(), std::ios::trunc);
+    file<<"# run file entries bytes"<<std::endl;
+    if(!file)
+        throw(std::string("[ERROR] Cannot create the manifest: ")+manifest);
+}
+
+///
+/// \brief MakeChunkChain Creates a chain of chunks listed in the manifest. Numbers of entries are taken from the manifest,
+/// so chunks are not opened until they are read, and empty chunks are skipped.
+/// \param manifest Path of the manifest, chunks are expected in the same directory.
+/// \param run Name of the run, all runs are chained if empty.
+/// \return Pointer to a new TChain owned by the caller.
+///
+TChain* MakeChunkChain(const std::string& manifest, const std::string& run)
+{
+    std::ifstream file(manifest.c_str());
+    if(!file)
+        throw(std::string("[ERROR] Cannot open the manifest: ")+manifest);
+    std::string dir = manifest.find('/')==std::string::npos ? "" : manifest.substr(0, manifest.rfind('/')+1);
+    TChain* chain = new TChain("tree");
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(line.empty() || line[0]=='#')
+            continue;
+        std::istringstream fields(line);
+        std::string name, chunk;
+        Long64_t entries = 0;
+        if(!(fields>>name>>chunk>>entries))
+        {
+            delete chain;
+            throw(std::string("[ERROR] Invalid line in the manifest ")+manifest+": "+line);
+        }
+        if((run.empty() || name==run) && entries>0)
+            chain->Add((dir+chunk).c_str(), entries);
+    }
+    return chain;
+}
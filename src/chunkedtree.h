@@ -0,0 +1,63 @@
+/// @file chunkedtree.h
+/// @date 19.10.2026
+#ifndef CHUNKEDTREE_H
+#define CHUNKEDTREE_H
+#include <string>
+#include <functional>
+#include "TTree.h"
+#include "TFile.h"
+#include "TChain.h"
+#include "parammanager.h"
+
+///
+/// \brief The ChunkedTree class Tree with events of one simulation run. It is either stored in a directory of the main
+/// output file, or split into independent files (chunks) of limited number of events and size. Every chunk contains
+/// a complete tree called "tree" and is listed in a manifest as soon as it is closed, see MakeChunkChain.
+///
+class ChunkedTree
+{
+    public:
+        typedef std::function<void(TTree*)> BranchSetup;
+
+        //single tree stored in the given directory, chunk limits are ignored
+        ChunkedTree(TDirectory* dir, const ParamManager& pManag);
+        //tree split into files <dir><name>_NNNN.root, which are appended to the manifest
+        ChunkedTree(const std::string& dir, const std::string& name, const std::string& manifest, const ParamManager& pManag);
+        ~ChunkedTree();
+        void SetBranchSetup(const BranchSetup& setup);
+        void Fill();
+        void Close();
+        inline TTree* GetTree() const {return fTree_;}
+        inline bool IsChunked() const {return !fManifest_.empty();}
+        inline int GetNumberOfChunks() const {return fChunkIndex_;}
+        inline Long64_t GetEntries() const {return fEntries_;}
+
+    private:
+        ChunkedTree(const ChunkedTree&);
+        ChunkedTree& operator=(const ChunkedTree&);
+        void CreateTree_();
+        void OpenChunk_();
+        void CloseChunk_();
+
+        TTree* fTree_; //owned by fFile_ or fDir_
+        TDirectory* fDir_; //directory of the tree if it is not chunked
+        TFile* fFile_; //current chunk, nullptr if the tree is not chunked or the chunk is not opened yet
+        BranchSetup fSetup_; //creates or connects branches of a new tree
+        std::string fChunkDir_;
+        std::string fName_;
+        std::string fManifest_; //empty if the tree is not chunked
+        int fChunkIndex_; //number of opened chunks
+        Long64_t fMaxEntries_; //0 - no limit
+        Long64_t fMaxBytes_; //0 - no limit
+        Long64_t fEntries_; //entries in all chunks
+        int fCompression_;
+        Long64_t fAutoFlush_;
+        Long64_t fAutoSave_;
+};
+
+//truncates the manifest and writes its header
+void CreateChunkManifest(const std::string& manifest);
+//chain of chunks of the given run listed in the manifest, all runs if the name is empty
+TChain* MakeChunkChain(const std::string& manifest, const std::string& run="");
+
+#endif // CHUNKEDTREE_H
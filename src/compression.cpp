@@ -0,0 +1,62 @@
+/// @file compression.cpp
+/// @date 19.10.2026
+#include "compression.h"
+
+///
+/// \brief ParseCompressionAlgorithm Converts name used in the parameter file to the algorithm.
+/// \param name One of: default, zlib, lzma, lz4, zstd.
+/// \return Compression algorithm.
+///
+CompressionAlgorithm ParseCompressionAlgorithm(const std::string& name)
+{
+    if(name == "default")
+        return DEFAULT_COMPRESSION;
+    if(name == "zlib")
+        return ZLIB;
+    if(name == "lzma")
+        return LZMA;
+    if(name == "lz4")
+        return LZ4;
+    if(name == "zstd")
+        return ZSTD;
+    throw(std::string("Unknown compression algorithm: ")+name);
+}
+
+///
+/// \brief CompressionAlgorithmName Converts the algorithm to its name used in the parameter file.
+/// \param algorithm Compression algorithm.
+/// \return Name of the algorithm.
+///
+std::string CompressionAlgorithmName(CompressionAlgorithm algorithm)
+{
+    switch(algorithm)
+    {
+        case ZLIB:
+            return "zlib";
+        case LZMA:
+            return "lzma";
+        case LZ4:
+            return "lz4";
+        case ZSTD:
+            return "zstd";
+        default:
+            return "default";
+    }
+}
+
+///
+/// \brief CompressionSettings Combines algorithm and level in the way ROOT does (100*algorithm+level).
+/// \param algorithm Compression algorithm.
+/// \param level Compression level from 0 (no compression) to 9, values outside are clamped.
+/// \return Compression settings for TFile, -1 if ROOT's default settings should be used.
+///
+int CompressionSettings(CompressionAlgorithm algorithm, int level)
+{
+    if(algorithm == DEFAULT_COMPRESSION)
+        return -1;
+    if(level < 0)
+        level = 0;
+    if(level > 9)
+        level = 9;
+    return 100*algorithm+level;
+}
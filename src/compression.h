@@ -0,0 +1,25 @@
+/// @file compression.h
+/// @date 19.10.2026
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+#include <string>
+
+///
+/// \brief The CompressionAlgorithm enum Compression algorithms of ROOT files. Values are the same as in ROOT::RCompressionSetting.
+///
+enum CompressionAlgorithm
+{
+    DEFAULT_COMPRESSION = 0, //ROOT's default settings are left untouched
+    ZLIB = 1,
+    LZMA = 2,
+    LZ4 = 4,
+    ZSTD = 5
+};
+
+//conversion between names used in the parameter file and algorithms, unknown name throws
+CompressionAlgorithm ParseCompressionAlgorithm(const std::string& name);
+std::string CompressionAlgorithmName(CompressionAlgorithm algorithm);
+//value accepted by TFile::SetCompressionSettings, -1 for DEFAULT_COMPRESSION
+int CompressionSettings(CompressionAlgorithm algorithm, int level);
+
+#endif // COMPRESSION_H
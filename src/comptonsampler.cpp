@@ -0,0 +1,115 @@
+/// @file comptonsampler.cpp
+/// @date 19.10.2026
+#include <cmath>
+#include <algorithm>
+#include "TRandom.h"
+#include "constants.h"
+#include "comptonsampler.h"
+
+///
+/// \brief ComptonSampler::SampleCosTheta Samples the Compton scattering angle from the Klein-Nishina distribution
+/// with the rejection technique of Kahn, which needs about two triplets of random numbers per angle.
+/// \param E Energy of the incident photon in MeV.
+/// \return Cosine of the scattering angle.
+///
+double ComptonSampler::SampleCosTheta(double E)
+{
+    double k = E/static_cast<double>(e_mass_MeV);
+    double k2 = 1.0+2.0*k;
+    while(true)
+    {
+        double r1 = gRandom->Rndm();
+        double r2 = gRandom->Rndm();
+        double r3 = gRandom->Rndm();
+        if(r1<=k2/(k2+8.0))
+        {
+            double eta = 1.0+2.0*k*r2; //ratio of the incident and scattered energy
+            if(r3<=4.0*(1.0/eta-1.0/(eta*eta)))
+                return 1.0-(eta-1.0)/k;
+        }
+        else
+        {
+            double eta = k2/(1.0+2.0*k*r2);
+            double cosTheta = 1.0-(eta-1.0)/k;
+            if(r3<=0.5*(cosTheta*cosTheta+1.0/eta))
+                return cosTheta;
+        }
+    }
+}
+
+///
+/// \brief ComptonSampler::ScatteredEnergy Energy of the photon after Compton scattering.
+/// \param E Energy of the incident photon in MeV.
+/// \param cosTheta Cosine of the scattering angle.
+/// \return Energy of the scattered photon in MeV.
+///
+double ComptonSampler::ScatteredEnergy(double E, double cosTheta)
+{
+    return E/(1.0+(E/static_cast<double>(e_mass_MeV))*(1.0-cosTheta));
+}
+
+///
+/// \brief ComptonSampler::Smear Smears the energy deposited by the photon with the phenomenological resolution of the detector.
+/// \param edep Deposited energy in MeV.
+/// \param E Energy of the incident photon in MeV, it sets the resolution.
+/// \param low Lower limit of the smearing.
+/// \param high Higher limit of the smearing.
+/// \return Smeared energy, or edep if it is outside the limits.
+///
+double ComptonSampler::Smear(double edep, double E, double low, double high)
+{
+    const double coeff = 0.0444; //phenomenological coefficient
+    if(edep>=low && edep<=high)
+        return gRandom->Gaus(edep, coeff*std::sqrt(E));
+    return edep;
+}
+
+///
+/// \brief ComptonSampler::RotateDirection Rotates a normalized direction by the polar angle theta and the azimuthal angle phi around itself.
+/// \param dir Direction to be rotated.
+/// \param cosTheta Cosine of the polar angle.
+/// \param phi Azimuthal angle.
+///
+void ComptonSampler::RotateDirection(double* dir, double cosTheta, double phi)
+{
+    double sinTheta = std::sqrt(std::max(0.0, 1.0-cosTheta*cosTheta));
+    double cosPhi = std::cos(phi);
+    double sinPhi = std::sin(phi);
+    double perp = std::sqrt(std::max(0.0, 1.0-dir[2]*dir[2]));
+    double rotated[3];
+    if(perp<1e-10)
+    {
+        rotated[0] = sinTheta*cosPhi;
+        rotated[1] = sinTheta*sinPhi;
+        rotated[2] = (dir[2]>0.0 ? 1.0 : -1.0)*cosTheta;
+    }
+    else
+    {
+        rotated[0] = sinTheta*(dir[0]*dir[2]*cosPhi-dir[1]*sinPhi)/perp+dir[0]*cosTheta;
+        rotated[1] = sinTheta*(dir[1]*dir[2]*cosPhi+dir[0]*sinPhi)/perp+dir[1]*cosTheta;
+        rotated[2] = -sinTheta*cosPhi*perp+dir[2]*cosTheta;
+    }
+    double norm = std::sqrt(rotated[0]*rotated[0]+rotated[1]*rotated[1]+rotated[2]*rotated[2]);
+    for(int ii=0; ii<3; ii++)
+        dir[ii] = rotated[ii]/norm;
+}
+
+///
+/// \brief ComptonSampler::Scatter Scatters a photon of the event: samples the angle and sets the energy of the Compton
+/// electron as the deposited energy, and its smeared value. The four-momentum of the photon is not changed.
+/// \param event Pointer to Event object.
+/// \param index Index of the photon.
+/// \param low Lower limit of the smearing.
+/// \param high Higher limit of the smearing.
+/// \return False if the photon does not exist or did not pass cuts, nothing is set then.
+///
+bool ComptonSampler::Scatter(Event* event, int index, double low, double high)
+{
+    if(event->GetFourMomentumOf(index) == nullptr || !event->GetCutPassingOf(index))
+        return false;
+    double E = event->GetFourMomentumOf(index)->Energy();
+    double edep = ElectronEnergy(E, SampleCosTheta(E));
+    event->SetEdepOf(index, edep);
+    event->SetEdepSmearOf(index, Smear(edep, E, low, high));
+    return true;
+}
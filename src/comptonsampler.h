@@ -0,0 +1,32 @@
+/// @file comptonsampler.h
+/// @date 19.10.2026
+///
+/// Sampling of Compton scattering without any state or histograms, shared by the detector (ComptonScattering)
+/// and by phantoms. Angles follow the Klein-Nishina distribution and are sampled exactly, so no PDF has to be tabulated.
+#ifndef COMPTONSAMPLER_H
+#define COMPTONSAMPLER_H
+#include "event.h"
+
+///
+/// \brief The ComptonSampler class Stateless Compton scattering engine, all random numbers are taken from gRandom.
+///
+class ComptonSampler
+{
+    public:
+        //cosine of the scattering angle sampled from the Klein-Nishina distribution, E in MeV
+        static double SampleCosTheta(double E);
+        //energy of the scattered photon and of the Compton electron, E in MeV
+        static double ScatteredEnergy(double E, double cosTheta);
+        static inline double ElectronEnergy(double E, double cosTheta) {return E-ScatteredEnergy(E, cosTheta);}
+        //detector-like smearing of the deposited energy, applied only within [low, high]
+        static double Smear(double edep, double E, double low, double high);
+        //rotates the normalized direction by the polar angle theta and the azimuthal angle phi around itself
+        static void RotateDirection(double* dir, double cosTheta, double phi);
+        //sets the deposited and smeared energy of the photon, returns false if the photon is not scattered
+        static bool Scatter(Event* event, int index, double low, double high);
+
+    private:
+        ComptonSampler();
+};
+
+#endif // COMPTONSAMPLER_H
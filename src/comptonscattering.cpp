@@ -2,6 +2,8 @@
 #include "TCanvas.h"
 #include "TLine.h"
 #include "comptonscattering.h"
+#include "comptonsampler.h"
+#include "rawoutput.h"
 
 unsigned ComptonScattering::objectID_= 1;
 ///
@@ -9,69 +11,66 @@ unsigned ComptonScattering::objectID_= 1;
 /// \param type Type of the decay, can be: TWO, THREE or TWOandTHREE.
 /// \param low Lower limit for smearing effect.
 /// \param high Higher limit for smearing effect.
+/// \param histogramGroups Groups of histograms to be booked, see HistogramGroup. Only COMPTON_HISTOGRAMS is used.
 ///
-ComptonScattering::ComptonScattering(DecayType type, float low, float high) : fSilentMode_(false), fDecayType_(type), fSmearLowLimit_(low), fSmearHighLimit_(high)
+ComptonScattering::ComptonScattering(DecayType type, float low, float high, unsigned histogramGroups) : fSilentMode_(false), fDecayType_(type), fSmearLowLimit_(low), fSmearHighLimit_(high)
 {
+    //binning of deposited energy and electron energy histograms
+    HistogramDef defDepos = Histogram1D("fH_photon_E_depos_", COMPTON_HISTOGRAMS, 52, 0.0, 2.0);
+    HistogramDef defElectron = Histogram1D("fH_electron_E_", COMPTON_HISTOGRAMS, 52, 0.0, 2.0);
     if(fDecayType_==THREE)
     {
         fTypeString_ = "3";
-        fH_photon_E_depos_ = new TH1F((std::string("fH_photon_E_depos_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_photon_E_depos_", 52, 0.0, 0.600);
-        fH_electron_E_ = new TH1F((std::string("fH_electron_E_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_electron_E_", 52, 0.0, 0.511);
-        fH_electron_E_blur_ = new TH1F((std::string("fH_electron_E_blur_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_electron_E_blur_", 52, 0.0, 0.511);
+        defDepos = Histogram1D("fH_photon_E_depos_", COMPTON_HISTOGRAMS, 52, 0.0, 0.600);
+        defElectron = Histogram1D("fH_electron_E_", COMPTON_HISTOGRAMS, 52, 0.0, 0.511);
     }
     else if(fDecayType_==TWO)
     {
         fTypeString_ = "2";
-        fH_photon_E_depos_ = new TH1F((std::string("fH_photon_E_depos_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_photon_E_depos_", 21, 0.510, 0.512);
-        fH_photon_E_depos_->GetXaxis()->SetNdivisions(7, false);
-        fH_electron_E_ = new TH1F((std::string("fH_electron_E_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_electron_E_", 52, 0.0, 0.511);
-        fH_electron_E_blur_ = new TH1F((std::string("fH_electron_E_blur_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_electron_E_blur_", 52, 0.0, 0.511);
+        defDepos = Histogram1D("fH_photon_E_depos_", COMPTON_HISTOGRAMS, 21, 0.510, 0.512);
+        defDepos.Divisions(7);
+        defElectron = Histogram1D("fH_electron_E_", COMPTON_HISTOGRAMS, 52, 0.0, 0.511);
     }
     else if(fDecayType_==TWOandONE)
     {
         fTypeString_ = "2&1";
-        fH_photon_E_depos_ = new TH1F((std::string("fH_photon_E_depos_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_photon_E_depos_", 52, 0.3, 1.3);
-        fH_electron_E_ = new TH1F((std::string("fH_electron_E_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_electron_E_", 52, 0.0, 1.3);
-        fH_electron_E_blur_ = new TH1F((std::string("fH_electron_E_blur_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_electron_E_blur_", 52, 0.0, 1.3);
+        defDepos = Histogram1D("fH_photon_E_depos_", COMPTON_HISTOGRAMS, 52, 0.3, 1.3);
+        defElectron = Histogram1D("fH_electron_E_", COMPTON_HISTOGRAMS, 52, 0.0, 1.3);
     }
     else if(fDecayType_==TWOandN)
     {
         fTypeString_ = "2&N";
-        fH_photon_E_depos_ = new TH1F((std::string("fH_photon_E_depos_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_photon_E_depos_", 104, 0.0, 4.0);
-        fH_electron_E_ = new TH1F((std::string("fH_electron_E_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_electron_E_", 104, 0.0, 4.0);
-        fH_electron_E_blur_ = new TH1F((std::string("fH_electron_E_blur_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_electron_E_blur_", 104, 0.0, 4.0);
+        defDepos = Histogram1D("fH_photon_E_depos_", COMPTON_HISTOGRAMS, 104, 0.0, 4.0);
+        defElectron = Histogram1D("fH_electron_E_", COMPTON_HISTOGRAMS, 104, 0.0, 4.0);
     }
     else if(fDecayType_==ONE)
     {
         fTypeString_ = "1";
-        fH_photon_E_depos_ = new TH1F((std::string("fH_photon_E_depos_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_photon_E_depos_", 52, 0.0, 2.0);
-        fH_electron_E_ = new TH1F((std::string("fH_electron_E_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_electron_E_", 52, 0.0, 2.0);
-        fH_electron_E_blur_ = new TH1F((std::string("fH_electron_E_blur_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_electron_E_blur_", 52, 0.0, 2.0);
     }
-    fH_electron_E_->SetFillColor(kBlue);
-    fH_electron_E_->SetTitle("Electrons' energy distribution");
-    fH_electron_E_->GetXaxis()->SetTitle("E [MeV]");
-    fH_electron_E_->GetYaxis()->SetTitle("dN/dE");
-    fH_electron_E_->GetYaxis()->SetTitleOffset(1.8);
+    fRegistry_ = HistogramRegistry(histogramGroups, fTypeString_+"_"+std::to_string(objectID_));
 
-    fH_electron_E_blur_->SetFillColor(kBlue);
-    fH_electron_E_blur_->SetTitle("Electrons' energy distribution, smear effect");
-    fH_electron_E_blur_->GetXaxis()->SetTitle("E [MeV]");
-    fH_electron_E_blur_->GetYaxis()->SetTitle("dN/dE");
-    fH_electron_E_blur_->GetYaxis()->SetTitleOffset(1.8);
-
-    fH_photon_E_depos_->SetFillColor(kBlue);
-    fH_photon_E_depos_->SetTitle("Incident photon energy deposition");
-    fH_photon_E_depos_->GetXaxis()->SetTitle("E [MeV]");
-    fH_photon_E_depos_->GetYaxis()->SetTitle("dN/dE");
-    fH_photon_E_depos_->GetYaxis()->SetTitleOffset(1.8);
-    
-    fH_photon_theta_ = new TH1F((std::string("fH_photon_theta_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_photon_theta_", 50, 0.0, TMath::Pi());
-    fH_photon_theta_->SetFillColor(kBlue);
-    fH_photon_theta_->SetTitle("Scattering angle distribution");
-    fH_photon_theta_->GetXaxis()->SetTitle("#theta");
-    fH_photon_theta_->GetYaxis()->SetTitle("dN/d#theta");
-    fH_photon_theta_->GetYaxis()->SetTitleOffset(1.8);
+    //histograms are filled in Scatter after deposited energies are set
+    defElectron.Titles("Electrons' energy distribution", "E [MeV]", "dN/dE").TitleOffsets(0.0, 1.8).FillColor(kBlue);
+    fRegistry_.AddPhotonHistogram(defElectron,\
+        [](HistogramFiller& h, const Event* event, int ii){h.Fill(event->GetEdepOf(ii));});
+    HistogramDef defBlur = defElectron;
+    defBlur.key = "fH_electron_E_blur_";
+    defBlur.title = "Electrons' energy distribution, smear effect";
+    fRegistry_.AddPhotonHistogram(defBlur,\
+        [](HistogramFiller& h, const Event* event, int ii){h.Fill(event->GetEdepSmearOf(ii));});
+    defDepos.Titles("Incident photon energy deposition", "E [MeV]", "dN/dE").TitleOffsets(0.0, 1.8).FillColor(kBlue);
+    fRegistry_.AddPhotonHistogram(defDepos,\
+        [](HistogramFiller& h, const Event* event, int ii){h.Fill(event->GetFourMomentumOf(ii)->Energy());});
+    fRegistry_.AddPhotonHistogram(Histogram1D("fH_photon_theta_", COMPTON_HISTOGRAMS, 50, 0.0, TMath::Pi())\
+        .Titles("Scattering angle distribution", "#theta", "dN/d#theta").TitleOffsets(0.0, 1.8).FillColor(kBlue),\
+        [](HistogramFiller& h, const Event* event, int ii)
+        {
+            //scattering angle is recovered from the energy of the Compton electron
+            double E = event->GetFourMomentumOf(ii)->Energy();
+            double cosTheta = 1.0 - e_mass_MeV*(1.0/(E-event->GetEdepOf(ii)) - 1.0/E);
+            h.Fill(TMath::ACos(cosTheta > 1.0 ? 1.0 : (cosTheta < -1.0 ? -1.0 : cosTheta)));
+        });
+    AssignHistograms_();
 
     fH_PDF_ = new TH2D((std::string("fH_PDF_")+fTypeString_+"_"+std::to_string(objectID_)).c_str(), "fH_PDF_", 1000, 0.0, 1.022, 1000, 0.0, TMath::Pi());
     fH_PDF_->SetTitle("Klein-Nishima function");
@@ -112,10 +111,8 @@ ComptonScattering::ComptonScattering(const ComptonScattering &est)
     fSmearHighLimit_=est.fSmearHighLimit_;
     fPDF = new TF1(*est.fPDF);  //special root object
     fPDF_Theta = new TF1(*est.fPDF_Theta);
-    fH_photon_E_depos_=new TH1F(*est.fH_photon_E_depos_); //distribution of energy deposited by incident photons
-    fH_electron_E_ = new TH1F(*est.fH_electron_E_);   //energy distribution for electrons
-    fH_electron_E_blur_ = new TH1F(*est.fH_electron_E_blur_);
-    fH_photon_theta_ = new TH1F(*est.fH_photon_theta_);   //angle distribution for electrons
+    fRegistry_ = est.fRegistry_;
+    AssignHistograms_();
     fH_PDF_ = new TH2D(*est.fH_PDF_);  // Klein-Nishina function plot, for testing purpose only
     fH_PDF_cross = new TH1D(*est.fH_PDF_cross);
     fH_PDF_Theta_ = new TH2D(*est.fH_PDF_Theta_);
@@ -136,10 +133,8 @@ ComptonScattering& ComptonScattering::operator=(const ComptonScattering &est)
     fSmearHighLimit_=est.fSmearHighLimit_;
     fPDF = new TF1(*est.fPDF);  //special root object
     fPDF_Theta = new TF1(*est.fPDF_Theta);
-    fH_photon_E_depos_=new TH1F(*est.fH_photon_E_depos_); //distribution of energy deposited by incident photons
-    fH_electron_E_ = new TH1F(*est.fH_electron_E_);   //energy distribution for electrons
-    fH_electron_E_blur_ = new TH1F(*est.fH_electron_E_blur_);
-    fH_photon_theta_ = new TH1F(*est.fH_photon_theta_);   //angle distribution for electrons
+    fRegistry_ = est.fRegistry_;
+    AssignHistograms_();
     fH_PDF_ = new TH2D(*est.fH_PDF_);  // Klein-Nishina function plot, for testing purpose only
     fH_PDF_cross = new TH1D(*est.fH_PDF_cross);
     fH_PDF_Theta_ = new TH2D(*est.fH_PDF_Theta_);
@@ -154,11 +149,15 @@ ComptonScattering& ComptonScattering::operator=(const ComptonScattering &est)
 ///
 bool equal_histograms(const TH1* h1, const TH1* h2)
 {
+    if(!h1 || !h2)
+        return h1 == h2; //both disabled
     return (h1->Integral() == h2->Integral() && h1->GetEntries() == h2->GetEntries() && h1->GetMean() == h2->GetMean());
 }
 
 bool ComptonScattering::operator==(const ComptonScattering &est) const
 {
+    fRegistry_.Flush();
+    est.fRegistry_.Flush();
     bool isEqual = (fDecayType_==est.fDecayType_) && (fSilentMode_==est.fSilentMode_) && (fTypeString_==est.fTypeString_) &&
          (fSmearLowLimit_==est.fSmearLowLimit_) && (fSmearHighLimit_==est.fSmearHighLimit_) && \
           equal_histograms(fH_photon_E_depos_, est.fH_photon_E_depos_) && equal_histograms(fH_electron_E_, est.fH_electron_E_) &&\
@@ -167,14 +166,10 @@ bool ComptonScattering::operator==(const ComptonScattering &est) const
 }
 
 ///
-/// \brief ComptonScattering::~ComptonScattering Destructor, releases memory after histograms.
+/// \brief ComptonScattering::~ComptonScattering Destructor, releases memory after histograms. Filled histograms are deleted by the registry.
 ///
 ComptonScattering::~ComptonScattering()
 {
-    if(fH_electron_E_) delete fH_electron_E_;
-    if(fH_electron_E_blur_) delete fH_electron_E_blur_;
-    if(fH_photon_theta_) delete fH_photon_theta_;
-    if(fH_photon_E_depos_) delete fH_photon_E_depos_;
     if(fH_PDF_) delete fH_PDF_;
     if(fH_PDF_cross) delete fH_PDF_cross;
     if(fPDF) delete fPDF;
@@ -183,6 +178,17 @@ ComptonScattering::~ComptonScattering()
     if(fPDF_Theta) delete fPDF_Theta;
 }
 
+///
+/// \brief ComptonScattering::AssignHistograms_ Sets pointers to histograms owned by the registry.
+///
+void ComptonScattering::AssignHistograms_()
+{
+    fH_electron_E_ = RegistryHistogram<TH1F>(fRegistry_, "fH_electron_E_");
+    fH_electron_E_blur_ = RegistryHistogram<TH1F>(fRegistry_, "fH_electron_E_blur_");
+    fH_photon_E_depos_ = RegistryHistogram<TH1F>(fRegistry_, "fH_photon_E_depos_");
+    fH_photon_theta_ = RegistryHistogram<TH1F>(fRegistry_, "fH_photon_theta_");
+}
+
 ///
 /// \brief ComptonScattering::DrawPDF Draws Klein-Nishina function and saves to a file.
 /// \param filePrefix Prefix of the output file, may contain path.
@@ -248,6 +254,9 @@ void ComptonScattering::DrawPDF(std::string filePrefix, double crossSectionE)
 ///
 void ComptonScattering::DrawComptonHistograms(std::string filePrefix, OutputOptions output)
 {
+    if(!fH_photon_E_depos_)
+        return; //Compton histograms are disabled
+    fRegistry_.Flush();
     if(!fSilentMode_)
         std::cout<<"[INFO] Drawing histograms for Compton electrons and scattered photons."<<std::endl;
     TCanvas* c = new TCanvas((fTypeString_+"-gammas_compton_distr").c_str(), "Compton effect distributions", 1300, 1200);
@@ -296,7 +305,9 @@ void ComptonScattering::DrawComptonHistograms(std::string filePrefix, OutputOpti
 
 ///
 /// \brief ComptonScattering::Scatter Scatters gammas from the event, performs smearing and fills histograms.
+/// Angles are sampled by ComptonSampler, fPDF_Theta is used only for drawing.
 /// \param event Pointer to Event object that is to be scattered.
+/// \param index Index of the photon to be scattered, all photons are scattered if negative.
 ///
 void ComptonScattering::Scatter(Event* event, int index) const
 {
@@ -309,29 +320,8 @@ void ComptonScattering::Scatter(Event* event, int index) const
     }
     for(int ii=lowLimit; ii<highLimit; ii++)
     {
-        if(event->GetFourMomentumOf(ii) != nullptr && event->GetCutPassingOf(ii))
-        {
-            double E = event->GetFourMomentumOf(ii)->Energy();
-            fH_photon_E_depos_->Fill(E);
-            fPDF_Theta->SetParameter(0, E); //set incident photon energy
-            double theta = fPDF_Theta->GetRandom(); //get scattering angle
-            fH_photon_theta_->Fill(theta);
-            double new_E = E * (1.0 - 1.0/(1.0+(E/(e_mass_MeV))*(1-TMath::Cos(theta)))); //E*(1-P) -- Compton electron's energy
-            fH_electron_E_->Fill(new_E);
-            event->SetEdepOf(ii, new_E);
-            //if new_E is within limit -- smear, otherwise fill histogram with new_E
-            if((new_E >= fSmearLowLimit_) && (new_E <= fSmearHighLimit_))
-            {
-                double Esmear = gRandom->Gaus(new_E, sigmaE(E));
-                fH_electron_E_blur_->Fill(Esmear);
-                event->SetEdepSmearOf(ii, Esmear);
-            }
-            else
-            {
-                fH_electron_E_blur_->Fill(new_E);
-                event->SetEdepSmearOf(ii, new_E);
-            }
-        }
+        if(ComptonSampler::Scatter(event, ii, fSmearLowLimit_, fSmearHighLimit_))
+            fRegistry_.FillPhoton(event, ii);
     }
 }
 
@@ -365,13 +355,23 @@ long double ComptonScattering::KleinNishinaTheta_(double* angle, double* energy)
 }
 
 ///
-/// \brief ComptonScattering::sigmaE Calculates std dev for the smearing effect.
-/// \param E Incident photon's energy.
-/// \param coeff Phenomenological coeff.
-/// \return  std dev for electron's energy distribution
+/// \brief ComptonScattering::WriteHistograms Writes histograms and smearing limits to the current directory without drawing them.
 ///
-double ComptonScattering::sigmaE(double E, double coeff) const
+void ComptonScattering::WriteHistograms() const
 {
-    return coeff*E/TMath::Sqrt(E);
+    fRegistry_.Write();
+    WriteRawValue(fSmearLowLimit_, "fSmearLowLimit_");
+    WriteRawValue(fSmearHighLimit_, "fSmearHighLimit_");
 }
 
+///
+/// \brief ComptonScattering::ReadHistograms Replaces histograms with the ones written by WriteHistograms, so they can be drawn.
+/// \param dir Directory with raw histograms.
+///
+void ComptonScattering::ReadHistograms(TDirectory* dir)
+{
+    fRegistry_.Read(dir);
+    AssignHistograms_();
+    fSmearLowLimit_ = ReadRawValue(dir, "fSmearLowLimit_", fSmearLowLimit_);
+    fSmearHighLimit_ = ReadRawValue(dir, "fSmearHighLimit_", fSmearHighLimit_);
+}
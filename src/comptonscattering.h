@@ -12,6 +12,7 @@
 #include "constants.h"
 #include "event.h"
 #include "parammanager.h"
+#include "histogramregistry.h"
 
 ///
 /// \brief The ComptonScattering class Class responsible for Compton scattering according to the Klein-Nishina formula.
@@ -19,13 +20,18 @@
 class ComptonScattering
 {
     public:
-        ComptonScattering(DecayType type, float low=0.0, float high=2.0);
+        ComptonScattering(DecayType type, float low=0.0, float high=2.0, unsigned histogramGroups=ALL_HISTOGRAMS);
         ComptonScattering(const ComptonScattering& est);
         ComptonScattering& operator=(const ComptonScattering& est);
         bool operator==(const ComptonScattering &cs) const;
         ~ComptonScattering();
         void DrawPDF(std::string filePrefix="", double crossSectionE=0.511);
         void DrawComptonHistograms(std::string filePrefix, OutputOptions output=PNG);
+        //writing histograms without drawing (RAW output) and reading them back (tools/renderer)
+        void WriteHistograms() const;
+        //histogram fills are buffered, flushing is needed only when histograms are accessed directly
+        inline void FlushHistograms() const {fRegistry_.Flush();}
+        void ReadHistograms(TDirectory* dir);
         void Scatter(Event* event, int index=-1) const; //perfors scattering
         inline void EnableSilentMode() {fSilentMode_=true;}
         inline void DisableSilentMode() {fSilentMode_=false;}
@@ -40,6 +46,8 @@ class ComptonScattering
         bool fSilentMode_; //if true then less output is generated
         DecayType fDecayType_;
         std::string fTypeString_;
+        //owns filled histograms, pointers below are only shortcuts and are nullptr if COMPTON_HISTOGRAMS is disabled
+        mutable HistogramRegistry fRegistry_;
         TH1F* fH_electron_E_;   //energy distribution for electrons
         TH1F* fH_electron_E_blur_;   //energy distribution for electrons blurred by detector effects
         TH1F* fH_photon_E_depos_; //distribution of energy deposited by incident photons
@@ -52,7 +60,7 @@ class ComptonScattering
         float fSmearHighLimit_; //higher limit for phenomenologicly derived smearing effect
         static long double KleinNishina_(double* angle, double* energy); //Klein-Nishina function
         static long double KleinNishinaTheta_(double* angle, double* energy); //Klein-Nishina based theta PDF
-        double sigmaE(double E, double coeff=0.0444) const; //calculate std dev for the smearing effevt
+        void AssignHistograms_();
 
         static unsigned objectID_;
 
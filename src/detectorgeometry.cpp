@@ -0,0 +1,448 @@
+/// @file detectorgeometry.cpp
+/// @date 19.10.2026
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include "constants.h"
+#include "hitkernel.h"
+#include "detectorgeometry.h"
+
+//value written to the coordinates of photons that missed the detector (the same as in Event)
+static const double kMissSentinel = -2000.0;
+//intersections closer than that are treated as numerical noise
+static const double kMinDistance = 1e-9;
+static const double kDegToRad = M_PI/180.0;
+
+DetectorGeometry::DetectorGeometry() :
+    fBuilt_(false)
+{
+}
+
+///
+/// \brief DetectorGeometry::AddBarrel Adds the surface of a cylinder with axis parallel to Z.
+/// \param R Radius [mm].
+/// \param zMin Lower edge along Z [mm].
+/// \param zMax Upper edge along Z [mm].
+/// \param x X coordinate of the axis [mm].
+/// \param y Y coordinate of the axis [mm].
+///
+void DetectorGeometry::AddBarrel(double R, double zMin, double zMax, double x, double y)
+{
+    if(R<=0.0 || zMax<=zMin)
+        throw(std::string("Barrel must have positive radius and zMax > zMin!"));
+    GeometryPrimitive prim;
+    prim.type = BARREL;
+    prim.center[0] = x;
+    prim.center[1] = y;
+    prim.center[2] = (zMin+zMax)/2.0;
+    prim.size[0] = R;
+    prim.size[1] = 0.0;
+    prim.size[2] = (zMax-zMin)/2.0;
+    for(int ii=0; ii<9; ii++)
+        prim.rotation[ii] = ii%4==0 ? 1.0 : 0.0;
+    prim.boundsMin[0] = x-R;
+    prim.boundsMax[0] = x+R;
+    prim.boundsMin[1] = y-R;
+    prim.boundsMax[1] = y+R;
+    prim.boundsMin[2] = zMin;
+    prim.boundsMax[2] = zMax;
+    fPrimitives_.push_back(prim);
+    fBuilt_ = false;
+}
+
+///
+/// \brief DetectorGeometry::AddBox Adds a box. The box is first rotated around its local X axis by tilt and then around Z by rotZ.
+/// \param cx X coordinate of the center [mm].
+/// \param cy Y coordinate of the center [mm].
+/// \param cz Z coordinate of the center [mm].
+/// \param hx Half length along local X [mm].
+/// \param hy Half length along local Y [mm].
+/// \param hz Half length along local Z [mm].
+/// \param rotZ Rotation around Z axis [deg].
+/// \param tilt Rotation around local X axis [deg].
+///
+void DetectorGeometry::AddBox(double cx, double cy, double cz, double hx, double hy, double hz, double rotZ, double tilt)
+{
+    if(hx<=0.0 || hy<=0.0 || hz<=0.0)
+        throw(std::string("Box must have positive dimensions!"));
+    GeometryPrimitive prim;
+    prim.type = BOX;
+    prim.center[0] = cx;
+    prim.center[1] = cy;
+    prim.center[2] = cz;
+    prim.size[0] = hx;
+    prim.size[1] = hy;
+    prim.size[2] = hz;
+    //rotation = Rz(rotZ)*Rx(tilt), stored row by row
+    double cb = std::cos(rotZ*kDegToRad);
+    double sb = std::sin(rotZ*kDegToRad);
+    double ca = std::cos(tilt*kDegToRad);
+    double sa = std::sin(tilt*kDegToRad);
+    double* m = prim.rotation;
+    m[0] = cb; m[1] = -sb*ca; m[2] = sb*sa;
+    m[3] = sb; m[4] = cb*ca;  m[5] = -cb*sa;
+    m[6] = 0;  m[7] = sa;     m[8] = ca;
+    for(int rr=0; rr<3; rr++)
+    {
+        double extent = 0.0;
+        for(int cc=0; cc<3; cc++)
+            extent += std::fabs(m[3*rr+cc])*prim.size[cc];
+        prim.boundsMin[rr] = prim.center[rr]-extent;
+        prim.boundsMax[rr] = prim.center[rr]+extent;
+    }
+    fPrimitives_.push_back(prim);
+    fBuilt_ = false;
+}
+
+///
+/// \brief DetectorGeometry::AddRing Adds a ring of identical modules placed uniformly around Z axis.
+/// Local X axis of every module points outwards.
+/// \param noOfModules Number of modules in the ring.
+/// \param R Distance between Z axis and the centers of modules [mm].
+/// \param hx Half thickness (radial) [mm].
+/// \param hy Half width (tangential) [mm].
+/// \param hz Half length (axial) [mm].
+/// \param z Z coordinate of the centers [mm].
+/// \param tilt Rotation of every module around its radial axis [deg].
+///
+void DetectorGeometry::AddRing(int noOfModules, double R, double hx, double hy, double hz, double z, double tilt)
+{
+    if(noOfModules<1)
+        throw(std::string("Ring must have at least one module!"));
+    for(int ii=0; ii<noOfModules; ii++)
+    {
+        double phi = 360.0*ii/noOfModules;
+        AddBox(R*std::cos(phi*kDegToRad), R*std::sin(phi*kDegToRad), z, hx, hy, hz, phi, tilt);
+    }
+}
+
+///
+/// \brief DetectorGeometry::Import Reads components from a text file. Every line describes one element:
+/// "barrel R zMin zMax [x y]", "box cx cy cz hx hy hz [rotZ tilt]" or "ring n R hx hy hz [z tilt]".
+/// Lines starting with '#' are ignored. Builds the BVH at the end.
+/// \param inFile Path to the file.
+///
+void DetectorGeometry::Import(const std::string& inFile)
+{
+    std::ifstream geoFile(inFile.c_str());
+    if(!geoFile.is_open())
+        throw(std::string("Cannot open geometry file: ")+inFile);
+    std::string row;
+    int lineNo = 0;
+    while(getline(geoFile, row))
+    {
+        lineNo++;
+        std::istringstream is(row);
+        std::string keyword;
+        if(!(is>>keyword) || keyword[0]=='#')
+            continue;
+        std::vector<double> values;
+        std::string token;
+        while(is>>token && token[0]!='#')
+            values.push_back(atof(token.c_str()));
+        if(keyword=="barrel" && (values.size()==3 || values.size()==5))
+        {
+            values.resize(5, 0.0);
+            AddBarrel(values[0], values[1], values[2], values[3], values[4]);
+        }
+        else if(keyword=="box" && (values.size()==6 || values.size()==8))
+        {
+            values.resize(8, 0.0);
+            AddBox(values[0], values[1], values[2], values[3], values[4], values[5], values[6], values[7]);
+        }
+        else if(keyword=="ring" && (values.size()==5 || values.size()==7))
+        {
+            values.resize(7, 0.0);
+            AddRing(int(values[0]), values[1], values[2], values[3], values[4], values[5], values[6]);
+        }
+        else
+            throw(std::string("Invalid line ")+std::to_string(lineNo)+" in geometry file "+inFile+": "+row);
+    }
+    if(fPrimitives_.empty())
+        throw(std::string("Geometry file contains no components: ")+inFile);
+    Build();
+}
+
+///
+/// \brief DetectorGeometry::Build Builds the bounding volume hierarchy.
+///
+void DetectorGeometry::Build()
+{
+    fNodes_.clear();
+    fOrder_.resize(fPrimitives_.size());
+    for(unsigned ii=0; ii<fOrder_.size(); ii++)
+        fOrder_[ii] = ii;
+    if(!fPrimitives_.empty())
+    {
+        fNodes_.reserve(2*fPrimitives_.size());
+        BuildNode_(0, fPrimitives_.size());
+    }
+    fBuilt_ = true;
+}
+
+///
+/// \brief DetectorGeometry::BuildNode_ Recursively creates a node for primitives fOrder_[first, first+count).
+/// Primitives are split in half along the axis with the largest spread of centers.
+/// \return Index of the created node.
+///
+int DetectorGeometry::BuildNode_(int first, int count)
+{
+    Node_ node;
+    double cMin[3];
+    double cMax[3];
+    for(int kk=0; kk<3; kk++)
+    {
+        node.boundsMin[kk] = cMin[kk] = std::numeric_limits<double>::max();
+        node.boundsMax[kk] = cMax[kk] = -std::numeric_limits<double>::max();
+    }
+    for(int ii=first; ii<first+count; ii++)
+    {
+        const GeometryPrimitive& prim = fPrimitives_[fOrder_[ii]];
+        for(int kk=0; kk<3; kk++)
+        {
+            node.boundsMin[kk] = std::min(node.boundsMin[kk], prim.boundsMin[kk]);
+            node.boundsMax[kk] = std::max(node.boundsMax[kk], prim.boundsMax[kk]);
+            double c = 0.5*(prim.boundsMin[kk]+prim.boundsMax[kk]);
+            cMin[kk] = std::min(cMin[kk], c);
+            cMax[kk] = std::max(cMax[kk], c);
+        }
+    }
+    node.left = -1;
+    node.right = -1;
+    node.first = first;
+    node.count = count;
+    int index = fNodes_.size();
+    fNodes_.push_back(node);
+    if(count<=kMaxLeafSize_)
+        return index;
+
+    int axis = 0;
+    for(int kk=1; kk<3; kk++)
+        if(cMax[kk]-cMin[kk] > cMax[axis]-cMin[axis])
+            axis = kk;
+    int half = count/2;
+    const std::vector<GeometryPrimitive>& prims = fPrimitives_;
+    std::nth_element(fOrder_.begin()+first, fOrder_.begin()+first+half, fOrder_.begin()+first+count,
+                     [&prims, axis](int a, int b)
+                     {
+                         return prims[a].boundsMin[axis]+prims[a].boundsMax[axis] < prims[b].boundsMin[axis]+prims[b].boundsMax[axis];
+                     });
+    int left = BuildNode_(first, half);
+    int right = BuildNode_(first+half, count-half);
+    fNodes_[index].left = left;
+    fNodes_[index].right = right;
+    fNodes_[index].count = 0;
+    return index;
+}
+
+///
+/// \brief DetectorGeometry::IntersectBounds_ Slab test of a ray against an axis-aligned box.
+/// \param bMin Lower corner of the box.
+/// \param bMax Upper corner of the box.
+/// \param origin Origin of the ray.
+/// \param invDir Inverse of the ray direction components.
+/// \param tMax Intersections further than this are not interesting.
+/// \return True if the ray crosses the box between 0 and tMax.
+///
+bool DetectorGeometry::IntersectBounds_(const double* bMin, const double* bMax, const double* origin, const double* invDir, double tMax)
+{
+    double tNear = 0.0;
+    double tFar = tMax;
+    for(int kk=0; kk<3; kk++)
+    {
+        if(std::isinf(invDir[kk]))
+        {
+            //ray parallel to the slab
+            if(origin[kk]<bMin[kk] || origin[kk]>bMax[kk])
+                return false;
+            continue;
+        }
+        double t1 = (bMin[kk]-origin[kk])*invDir[kk];
+        double t2 = (bMax[kk]-origin[kk])*invDir[kk];
+        if(t1>t2)
+            std::swap(t1, t2);
+        tNear = std::max(tNear, t1);
+        tFar = std::min(tFar, t2);
+        if(tNear>tFar)
+            return false;
+    }
+    return true;
+}
+
+///
+/// \brief DetectorGeometry::IntersectPrimitive_ Finds the first intersection of a ray with a primitive.
+/// Photons emitted inside a box hit it at the emission point.
+/// \return Ray parameter of the intersection or -1 if there is none.
+///
+double DetectorGeometry::IntersectPrimitive_(const GeometryPrimitive& prim, const double* origin, const double* direction)
+{
+    double o[3] = {origin[0]-prim.center[0], origin[1]-prim.center[1], origin[2]-prim.center[2]};
+    if(prim.type==BARREL)
+    {
+        double a = direction[0]*direction[0]+direction[1]*direction[1];
+        if(a<=1e-20)
+            return -1.0;
+        double b = o[0]*direction[0]+o[1]*direction[1];
+        double c = o[0]*o[0]+o[1]*o[1]-prim.size[0]*prim.size[0];
+        double delta = b*b-a*c;
+        if(delta<0.0)
+            return -1.0;
+        double sq = std::sqrt(delta);
+        double roots[2] = {(-b-sq)/a, (-b+sq)/a};
+        for(int ii=0; ii<2; ii++)
+        {
+            if(roots[ii]<kMinDistance)
+                continue;
+            if(std::fabs(o[2]+direction[2]*roots[ii])<=prim.size[2])
+                return roots[ii];
+        }
+        return -1.0;
+    }
+    //box: transforming the ray to the local frame
+    const double* m = prim.rotation;
+    double tNear = -std::numeric_limits<double>::max();
+    double tFar = std::numeric_limits<double>::max();
+    for(int cc=0; cc<3; cc++)
+    {
+        double lo = m[cc]*o[0]+m[3+cc]*o[1]+m[6+cc]*o[2];
+        double ld = m[cc]*direction[0]+m[3+cc]*direction[1]+m[6+cc]*direction[2];
+        if(std::fabs(ld)<1e-20)
+        {
+            if(std::fabs(lo)>prim.size[cc])
+                return -1.0;
+            continue;
+        }
+        double t1 = (-prim.size[cc]-lo)/ld;
+        double t2 = (prim.size[cc]-lo)/ld;
+        if(t1>t2)
+            std::swap(t1, t2);
+        tNear = std::max(tNear, t1);
+        tFar = std::min(tFar, t2);
+    }
+    if(tNear>tFar || tFar<kMinDistance)
+        return -1.0;
+    return std::max(tNear, 0.0);
+}
+
+///
+/// \brief DetectorGeometry::Intersect Finds the first component hit by a ray, traversing the BVH.
+/// \param origin Origin of the ray.
+/// \param direction Direction of the ray, does not have to be normalized.
+/// \return Ray parameter and index of the hit component (-1 if none).
+///
+GeometryHit DetectorGeometry::Intersect(const double* origin, const double* direction) const
+{
+    if(!fBuilt_)
+        throw(std::string("DetectorGeometry::Build() has to be called before intersection queries!"));
+    GeometryHit best = {std::numeric_limits<double>::max(), -1};
+    if(fNodes_.empty())
+        return best;
+    double invDir[3];
+    for(int kk=0; kk<3; kk++)
+        invDir[kk] = direction[kk]!=0.0 ? 1.0/direction[kk] : std::numeric_limits<double>::infinity();
+    //depth of a median split tree is logarithmic, 64 levels are more than enough
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while(top>0)
+    {
+        const Node_& node = fNodes_[stack[--top]];
+        if(!IntersectBounds_(node.boundsMin, node.boundsMax, origin, invDir, best.t))
+            continue;
+        if(node.left<0)
+        {
+            for(int ii=node.first; ii<node.first+node.count; ii++)
+            {
+                const GeometryPrimitive& prim = fPrimitives_[fOrder_[ii]];
+                if(!IntersectBounds_(prim.boundsMin, prim.boundsMax, origin, invDir, best.t))
+                    continue;
+                double t = IntersectPrimitive_(prim, origin, direction);
+                //ties (e.g. photon emitted inside overlapping boxes) are resolved by the index of a component
+                if(t>=0.0 && (t<best.t || (t==best.t && fOrder_[ii]<best.component)))
+                {
+                    best.t = t;
+                    best.component = fOrder_[ii];
+                }
+            }
+        }
+        else
+        {
+            stack[top++] = node.right;
+            stack[top++] = node.left;
+        }
+    }
+    return best;
+}
+
+///
+/// \brief DetectorGeometry::IntersectBruteForce Finds the first component hit by a ray checking all of them.
+/// \param origin Origin of the ray.
+/// \param direction Direction of the ray, does not have to be normalized.
+/// \return Ray parameter and index of the hit component (-1 if none).
+///
+GeometryHit DetectorGeometry::IntersectBruteForce(const double* origin, const double* direction) const
+{
+    GeometryHit best = {std::numeric_limits<double>::max(), -1};
+    for(unsigned ii=0; ii<fPrimitives_.size(); ii++)
+    {
+        double t = IntersectPrimitive_(fPrimitives_[ii], origin, direction);
+        if(t>=0.0 && t<best.t)
+        {
+            best.t = t;
+            best.component = ii;
+        }
+    }
+    return best;
+}
+
+///
+/// \brief DetectorGeometry::CalculateHitPoints Calculates hit points of all photons from the batch.
+/// \param photons Batch of photons, the momentum is used as the direction of the ray.
+/// \param hits Output, resized to the size of the batch.
+///
+void DetectorGeometry::CalculateHitPoints(const PhotonBatch& photons, HitBatch& hits) const
+{
+    const double timeFactor = 1000000.0/light_speed_SI;
+    hits.Resize(photons.Size());
+    for(std::size_t ii=0; ii<photons.Size(); ii++)
+    {
+        double origin[3] = {photons.x0[ii], photons.y0[ii], photons.z0[ii]};
+        double direction[3] = {photons.px[ii], photons.py[ii], photons.pz[ii]};
+        //photons absorbed in a phantom have zero momentum and never reach the detector
+        GeometryHit hit = {0.0, -1};
+        if(photons.E[ii]>0.0)
+            hit = Intersect(origin, direction);
+        if(hit.component>=0)
+        {
+            hits.x[ii] = origin[0]+direction[0]*hit.t;
+            hits.y[ii] = origin[1]+direction[1]*hit.t;
+            hits.z[ii] = origin[2]+direction[2]*hit.t;
+            hits.t[ii] = photons.E[ii]*hit.t*timeFactor;
+            hits.miss[ii] = 0;
+        }
+        else
+        {
+            hits.x[ii] = kMissSentinel;
+            hits.y[ii] = kMissSentinel;
+            hits.z[ii] = kMissSentinel;
+            hits.t[ii] = kMissSentinel;
+            hits.miss[ii] = 1;
+        }
+    }
+}
+
+///
+/// \brief DetectorGeometry::Print Prints summary of the geometry.
+///
+void DetectorGeometry::Print() const
+{
+    int noOfBarrels = 0;
+    for(unsigned ii=0; ii<fPrimitives_.size(); ii++)
+        if(fPrimitives_[ii].type==BARREL)
+            noOfBarrels++;
+    std::cout<<"[INFO] Detector geometry: "<<noOfBarrels<<" barrel(s), "<<fPrimitives_.size()-noOfBarrels<<" box(es), "\
+             <<fNodes_.size()<<" BVH nodes"<<std::endl;
+}
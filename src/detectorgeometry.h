@@ -0,0 +1,93 @@
+/// @file detectorgeometry.h
+/// @date 19.10.2026
+#ifndef DETECTORGEOMETRY_H
+#define DETECTORGEOMETRY_H
+#include <string>
+#include <vector>
+
+struct PhotonBatch;
+struct HitBatch;
+
+///
+/// \brief The GeometryPrimitiveType enum Specifies the shape of a detector component.
+///
+enum GeometryPrimitiveType
+{
+    BARREL = 0, //surface of a cylinder with axis parallel to Z
+    BOX = 1 //rotated box, e.g. a scintillator module
+};
+
+///
+/// \brief The GeometryPrimitive struct A single component of the detector.
+///
+struct GeometryPrimitive
+{
+    GeometryPrimitiveType type;
+    double center[3]; //[mm]
+    double size[3]; //BARREL: radius, unused, half length; BOX: half lengths along local axes [mm]
+    double rotation[9]; //BOX only: columns are local axes in the global frame
+    double boundsMin[3]; //axis-aligned bounding box
+    double boundsMax[3];
+};
+
+///
+/// \brief The GeometryHit struct Result of the ray-geometry intersection.
+///
+struct GeometryHit
+{
+    double t; //ray parameter, hit point = origin + t*direction
+    int component; //index of the hit component, -1 if nothing was hit
+};
+
+///
+/// \brief The DetectorGeometry class Detector built of many primitives. First hit is searched using a bounding volume hierarchy,
+/// so the cost grows logarithmically with the number of components.
+///
+class DetectorGeometry
+{
+    public:
+        DetectorGeometry();
+        //adding components, angles in degrees
+        void AddBarrel(double R, double zMin, double zMax, double x=0.0, double y=0.0);
+        void AddBox(double cx, double cy, double cz, double hx, double hy, double hz, double rotZ=0.0, double tilt=0.0);
+        void AddRing(int noOfModules, double R, double hx, double hy, double hz, double z=0.0, double tilt=0.0);
+        //reads components from a text file
+        void Import(const std::string& inFile);
+        //has to be called after adding components and before intersection queries
+        void Build();
+        //first intersection of a ray with positive t
+        GeometryHit Intersect(const double* origin, const double* direction) const;
+        //the same without the BVH, for testing
+        GeometryHit IntersectBruteForce(const double* origin, const double* direction) const;
+        //hit points of a whole batch of photons, the same output format as CalculateHitPointsBatch
+        void CalculateHitPoints(const PhotonBatch& photons, HitBatch& hits) const;
+        inline int GetNumberOfComponents() const {return fPrimitives_.size();}
+        inline const GeometryPrimitive& GetComponent(const unsigned index) const {return fPrimitives_.at(index);}
+        inline bool IsBuilt() const {return fBuilt_;}
+        void Print() const;
+
+    private:
+        ///
+        /// \brief The Node_ struct Node of the BVH. Leaves store a range of indices in fOrder_.
+        ///
+        struct Node_
+        {
+            double boundsMin[3];
+            double boundsMax[3];
+            int left; //index of the left child, -1 for leaves
+            int right; //index of the right child
+            int first; //first primitive (leaves only)
+            int count; //number of primitives (leaves only)
+        };
+        std::vector<GeometryPrimitive> fPrimitives_;
+        std::vector<int> fOrder_; //primitive indices ordered by leaves
+        std::vector<Node_> fNodes_;
+        bool fBuilt_;
+
+        int BuildNode_(int first, int count);
+        static bool IntersectBounds_(const double* bMin, const double* bMax, const double* origin, const double* invDir, double tMax);
+        static double IntersectPrimitive_(const GeometryPrimitive& prim, const double* origin, const double* direction);
+        static const int kMaxLeafSize_ = 4;
+};
+
+#endif // DETECTORGEOMETRY_H
@@ -2,7 +2,10 @@
 /// @author Rafal Maselek <rafal.maselek@ncbj.gov.pl>
 /// @date 13.07.2017
 #include <iostream>
+#include <cmath>
 #include "event.h"
+#include "hitkernel.h"
+#include "detectorgeometry.h"
 #include "constants.h"
 //ROOT stuff
 ClassImp(Event)
@@ -67,6 +70,8 @@ Event::Event(const Event& est) : TObject(est)
 {
     fId = est.fId;
     fDecayType_ = est.fDecayType_;
+    fWeight_ = est.fWeight_;
+    fPassFlag_ = est.fPassFlag_;
     fEmissionPoint_.resize(est.fEmissionPoint_.size());
     std::copy(est.fEmissionPoint_.begin(), est.fEmissionPoint_.end(), fEmissionPoint_.begin());
     fFourMomentum_.resize(est.fFourMomentum_.size());
@@ -79,6 +84,9 @@ Event::Event(const Event& est) : TObject(est)
     std::copy(est.fHitTheta_.begin(), est.fHitTheta_.end(), fHitTheta_.begin());
     fPrimaryPhoton_.resize(est.fPrimaryPhoton_.size());
     std::copy(est.fPrimaryPhoton_.begin(), est.fPrimaryPhoton_.end(), fPrimaryPhoton_.begin());
+    fHitPoint_ = est.fHitPoint_;
+    fEdep_ = est.fEdep_;
+    fEdepSmear_ = est.fEdepSmear_;
 }
 
 ///
@@ -90,6 +98,8 @@ Event& Event::operator=(const Event& est)
 {
     fId = est.fId;
     fDecayType_ = est.fDecayType_;
+    fWeight_ = est.fWeight_;
+    fPassFlag_ = est.fPassFlag_;
     fEmissionPoint_.resize(est.fEmissionPoint_.size());
     std::copy(est.fEmissionPoint_.begin(), est.fEmissionPoint_.end(), fEmissionPoint_.begin());
     fFourMomentum_.resize(est.fFourMomentum_.size());
@@ -102,6 +112,9 @@ Event& Event::operator=(const Event& est)
     std::copy(est.fHitTheta_.begin(), est.fHitTheta_.end(), fHitTheta_.begin());
     fPrimaryPhoton_.resize(est.fPrimaryPhoton_.size());
     std::copy(est.fPrimaryPhoton_.begin(), est.fPrimaryPhoton_.end(), fPrimaryPhoton_.begin());
+    fHitPoint_ = est.fHitPoint_;
+    fEdep_ = est.fEdep_;
+    fEdepSmear_ = est.fEdepSmear_;
     return *this;
 }
 
@@ -116,43 +129,76 @@ Event::~Event()
 ///
 /// \brief Event::CalculateHitPoints Calculates hit points on the detector's surface
 /// \param R Radius of the detector.
+/// \param L Length of the detector.
 ///
 void Event::CalculateHitPoints(double R, double L)
 {
-    for(auto it = fFourMomentum_.begin(); it != fFourMomentum_.end(); ++it)
+    //buffers are reused between calls to avoid allocations in the event loop
+    static thread_local PhotonBatch photons;
+    static thread_local HitBatch hits;
+    photons.Clear();
+    AddPhotonsTo(photons);
+    CalculateHitPointsBatch(photons, R, L, hits);
+    AssignHitPoints(hits, 0);
+}
+
+///
+/// \brief Event::CalculateHitPoints Calculates points where gammas hit a multi-component detector for the first time.
+/// \param geometry Detector geometry with the BVH already built.
+///
+void Event::CalculateHitPoints(const DetectorGeometry& geometry)
+{
+    static thread_local PhotonBatch photons;
+    static thread_local HitBatch hits;
+    photons.Clear();
+    AddPhotonsTo(photons);
+    geometry.CalculateHitPoints(photons, hits);
+    AssignHitPoints(hits, 0);
+}
+
+///
+/// \brief Event::AddPhotonsTo Appends emission points and fourmomenta of this event's photons to the batch.
+/// \param photons Batch of photons, usually shared by many events.
+///
+void Event::AddPhotonsTo(PhotonBatch& photons) const
+{
+    for(unsigned ii=0; ii<fFourMomentum_.size(); ii++)
     {
-        if(it->Pt() > TMath::Power(10, -10))
+        const TLorentzVector& p = fFourMomentum_[ii];
+        const TLorentzVector& x = fEmissionPoint_[ii];
+        photons.Push(x.X(), x.Y(), x.Z(), p.X(), p.Y(), p.Z(), p.T());
+    }
+}
+
+///
+/// \brief Event::AssignHitPoints Copies hit points of this event's photons from a batch calculated by CalculateHitPointsBatch.
+/// Times of flight from the batch are measured from the emission points, so times of emission are added to them.
+/// \param hits Results of the batch calculation.
+/// \param first Index of this event's first photon in the batch.
+///
+void Event::AssignHitPoints(const HitBatch& hits, unsigned first)
+{
+    unsigned n = fFourMomentum_.size();
+    fHitPoint_.clear();
+    fHitPhi_.clear();
+    fHitTheta_.clear();
+    fHitPoint_.reserve(n);
+    fHitPhi_.reserve(n);
+    fHitTheta_.reserve(n);
+    for(unsigned ii=first; ii<first+n; ii++)
+    {
+        double t = hits.miss[ii] ? hits.t[ii] : hits.t[ii]+fEmissionPoint_[ii-first].T();
+        fHitPoint_.push_back(TLorentzVector(hits.x[ii], hits.y[ii], hits.z[ii], t));
+        if(hits.miss[ii])
         {
-            int iter = it-fFourMomentum_.begin();
-            double x0 = fEmissionPoint_[iter].X();
-            double y0 = fEmissionPoint_[iter].Y();
-            double z0 = fEmissionPoint_[iter].Z();
-            double px = it->X();
-            double py = it->Y();
-            double pt2 = px*px+py*py;
-            double delta = 4*(x0*px+y0*py)*(x0*px+y0*py) - 4*(x0*x0+y0*y0-R*R)*pt2;
-            double s = (-2*(x0*px+y0*py)+TMath::Sqrt(delta))/2/pt2;
-            if(TMath::Abs(z0+it->Z()*s) > L/2.0)
-            {
-                //getting out of detector
-                TLorentzVector hit(-2000, -2000, -2000, -2000);
-                fHitPoint_.push_back(hit);
-                fHitPhi_.push_back(-4);
-                fHitTheta_.push_back(-4);
-                continue;
-            }
-            TLorentzVector hit(x0+it->X()*s, y0+it->Y()*s, z0+it->Z()*s, it->T()*s*1000000/light_speed_SI);
-            fHitPoint_.push_back(hit);
-            fHitPhi_.push_back(hit.Phi());//(hit-fEmissionPoint_[it-fFourMomentum_.begin()]).Phi());
-            fHitTheta_.push_back(hit.Theta());//(hit-fEmissionPoint_[it-fFourMomentum_.begin()]).Theta());
+            //getting out of detector
+            fHitPhi_.push_back(-4);
+            fHitTheta_.push_back(-4);
         }
         else
         {
-             TLorentzVector hit(-2000, -2000, -2000, -2000);
-             fHitPoint_.push_back(hit);
-             fHitPhi_.push_back(-4);
-             fHitTheta_.push_back(-4);
-
+            fHitPhi_.push_back(std::atan2(hits.y[ii], hits.x[ii]));
+            fHitTheta_.push_back(std::atan2(std::sqrt(hits.x[ii]*hits.x[ii]+hits.y[ii]*hits.y[ii]), hits.z[ii]));
         }
     }
 }
@@ -8,6 +8,10 @@
 #include "TTree.h"
 #include <vector>
 
+struct PhotonBatch;
+struct HitBatch;
+class DetectorGeometry;
+
 ///
 /// \brief The DecayType enum Specifies the type of decay in which the event was produced.
 ///
@@ -40,6 +44,9 @@ class Event : public TObject
         inline int GetNumberOfDecayProducts() const {return fFourMomentum_.size();}
         inline TLorentzVector* GetHitPointOf(const unsigned index) const
             {return index<fHitPoint_.size() ? const_cast<TLorentzVector*>(&fHitPoint_[index]) : NULL;}
+        //false if hit points were not calculated or the photon missed the detector (its hit point is a sentinel then)
+        inline bool HasHit(const unsigned index) const
+            {return index<fHitPhi_.size() && fHitPhi_[index]!=-4;}
         inline bool GetCutPassingOf(const unsigned index) const
             {return index<fCutPassing_.size() ? fCutPassing_[index] : false;}
         inline bool GetPrimaryPhoton(const unsigned index) const
@@ -53,17 +60,26 @@ class Event : public TObject
         inline double GetEdepSmearOf(const unsigned index) const {return fEdepSmear_[index];}
         inline void SetFourMomentumOf(const unsigned index, TLorentzVector& vector)
         { if(index < fFourMomentum_.size()) fFourMomentum_[index] = TLorentzVector(vector);}
+        inline void SetEmissionPointOf(const unsigned index, TLorentzVector& vector)
+        { if(index < fEmissionPoint_.size()) fEmissionPoint_[index] = TLorentzVector(vector);}
         inline void SetCutPassing(const unsigned ii, bool val)
             {if(ii<fCutPassing_.size()) fCutPassing_[ii]=val;}
         inline void SetPrimaryPhoton(const unsigned ii, bool isPrimary) {fPrimaryPhoton_.at(ii)=isPrimary;}
         inline void SetEdepOf(const unsigned ii, double val) {fEdep_[ii]=val;}
         inline void SetEdepSmearOf(const unsigned ii, double val) {fEdepSmear_[ii]=val;}
+        inline void SetWeight(double weight) {fWeight_=weight;}
 
         //set fPassFlag_ by checking values in fCutPassing_
         void DeducePassFlag();
         //calculates hit point of gammas on a detectors surface and fills fHitTheta_ and fHitPhi_ histograms
         // angles are calculated in reference to the center of the reference system's center !!!
         void CalculateHitPoints(double R, double L);
+        //the same for a multi-component detector
+        void CalculateHitPoints(const DetectorGeometry& geometry);
+        //appends emission points and fourmomenta of all photons to the batch, hit points of many events are calculated at once
+        void AddPhotonsTo(PhotonBatch& photons) const;
+        //fills hit points, fHitTheta_ and fHitPhi_ with results of CalculateHitPointsBatch for photons starting at index first
+        void AssignHitPoints(const HitBatch& hits, unsigned first);
         //number of event
         long fId;
         //ROOT stuff
@@ -71,7 +87,7 @@ class Event : public TObject
 
     private:
         static long fCounter_; //static variable incremented with every call of a constructor (but not copy constructor)
-        std::vector<TLorentzVector> fEmissionPoint_; //x, y, z, t(irrelevant) [mm and s]
+        std::vector<TLorentzVector> fEmissionPoint_; //x, y, z, t [mm and units of hit times], t>0 for photons scattered in a phantom
         std::vector<TLorentzVector> fFourMomentum_; //pX, pY, pZ, E [MeV/c and MeV]
         std::vector<bool> fCutPassing_; //indicates if gamma failed passing through cuts
         double fWeight_; //weight of the event
@@ -0,0 +1,424 @@
+/// @file eventfilter.cpp
+/// @date 19.10.2026
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include "eventfilter.h"
+
+namespace
+{
+    typedef EventFilter::Node Node;
+    const double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+    ///
+    /// \brief IsTrue Converts a value to a logical one, missing values are false.
+    /// \param value Value of an expression.
+    /// \return True for non-zero numbers.
+    ///
+    inline bool IsTrue(double value)
+    {
+        return value != 0.0 && value == value;
+    }
+
+    ///
+    /// \brief IsPrompt Checks if the photon comes from deexcitation rather than from annihilation.
+    /// \param event Pointer to Event object.
+    /// \param index Index of the photon.
+    /// \return True for prompt photons.
+    ///
+    bool IsPrompt(const Event* event, int index)
+    {
+        switch(event->GetDecayType())
+        {
+            case ONE:
+                return true;
+            case THREE:
+                return false;
+            default:
+                return index >= 2; //annihilation gammas come first
+        }
+    }
+
+    ///
+    /// \brief CountPhotons Counts photons fulfilling the predicate.
+    /// \param event Pointer to Event object.
+    /// \param predicate Photon predicate.
+    /// \return Number of photons.
+    ///
+    int CountPhotons(const Event* event, const std::function<bool(const Event*, int)>& predicate)
+    {
+        int count = 0;
+        for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
+        {
+            if(predicate(event, ii))
+                count++;
+        }
+        return count;
+    }
+
+    ///
+    /// \brief EventVariable Compiles a variable describing the whole event.
+    /// \param name Name of the variable.
+    /// \param node Reference to the compiled variable.
+    /// \return False if there is no such variable.
+    ///
+    bool EventVariable(const std::string& name, Node& node)
+    {
+        if(name == "nPhotons")
+            node = [](const Event* event, int){return double(event->GetNumberOfDecayProducts());};
+        else if(name == "nPassed")
+            node = [](const Event* event, int){return double(CountPhotons(event, [](const Event* e, int ii){return e->GetCutPassingOf(ii);}));};
+        else if(name == "nPrimary")
+            node = [](const Event* event, int){return double(CountPhotons(event, [](const Event* e, int ii){return e->GetPrimaryPhoton(ii);}));};
+        else if(name == "nScattered")
+            node = [](const Event* event, int){return double(CountPhotons(event, [](const Event* e, int ii){return !e->GetPrimaryPhoton(ii);}));};
+        else if(name == "nPrompt")
+            node = [](const Event* event, int){return double(CountPhotons(event, IsPrompt));};
+        else if(name == "prompt")
+            node = [](const Event* event, int){return CountPhotons(event, IsPrompt) > 0 ? 1.0 : 0.0;};
+        else if(name == "pass")
+            node = [](const Event* event, int){return event->GetPassFlag() ? 1.0 : 0.0;};
+        else if(name == "weight")
+            node = [](const Event* event, int){return event->GetWeight();};
+        else if(name == "type")
+            node = [](const Event* event, int){return double(event->GetDecayType());};
+        else
+            return false;
+        return true;
+    }
+
+    ///
+    /// \brief HitCoordinate Returns a coordinate of the hit point, missing if it was not calculated or the photon missed the detector.
+    /// \param event Pointer to Event object.
+    /// \param index Index of the photon.
+    /// \param coordinate 0-3 for x, y, z, t.
+    /// \return Value of the coordinate.
+    ///
+    double HitCoordinate(const Event* event, int index, int coordinate)
+    {
+        if(!event->HasHit(index))
+            return kMissing;
+        const TLorentzVector* hit = event->GetHitPointOf(index);
+        switch(coordinate)
+        {
+            case 0:
+                return hit->X();
+            case 1:
+                return hit->Y();
+            case 2:
+                return hit->Z();
+            default:
+                return hit->T();
+        }
+    }
+
+    ///
+    /// \brief PhotonVariable Compiles a variable describing the photon selected by any/all/count.
+    /// \param name Name of the variable.
+    /// \param node Reference to the compiled variable.
+    /// \return False if there is no such variable.
+    ///
+    bool PhotonVariable(const std::string& name, Node& node)
+    {
+        if(name == "E")
+            node = [](const Event* event, int ii){return event->GetFourMomentumOf(ii)->E();};
+        else if(name == "edep")
+            node = [](const Event* event, int ii){return event->GetEdepOf(ii);};
+        else if(name == "edepSmear")
+            node = [](const Event* event, int ii){return event->GetEdepSmearOf(ii);};
+        else if(name == "hitX")
+            node = [](const Event* event, int ii){return HitCoordinate(event, ii, 0);};
+        else if(name == "hitY")
+            node = [](const Event* event, int ii){return HitCoordinate(event, ii, 1);};
+        else if(name == "hitZ")
+            node = [](const Event* event, int ii){return HitCoordinate(event, ii, 2);};
+        else if(name == "hitT")
+            node = [](const Event* event, int ii){return HitCoordinate(event, ii, 3);};
+        else if(name == "passed")
+            node = [](const Event* event, int ii){return event->GetCutPassingOf(ii) ? 1.0 : 0.0;};
+        else if(name == "primary")
+            node = [](const Event* event, int ii){return event->GetPrimaryPhoton(ii) ? 1.0 : 0.0;};
+        else if(name == "prompt")
+            node = [](const Event* event, int ii){return IsPrompt(event, ii) ? 1.0 : 0.0;};
+        else if(name == "index")
+            node = [](const Event*, int ii){return double(ii);};
+        else
+            return false;
+        return true;
+    }
+
+    ///
+    /// \brief The Parser class Recursive descent parser compiling an expression into nested closures.
+    ///
+    class Parser
+    {
+        public:
+            explicit Parser(const std::string& text) : fText_(text), fPos_(0), fPhotonContext_(false) {}
+
+            ///
+            /// \brief Parser::Parse Compiles the whole expression.
+            /// \return Root of the compiled expression.
+            ///
+            Node Parse()
+            {
+                Node root = Or_();
+                SkipSpaces_();
+                if(fPos_ < fText_.size())
+                    Error_("unexpected character");
+                return root;
+            }
+
+        private:
+            const std::string& fText_;
+            size_t fPos_;
+            bool fPhotonContext_; //true inside any/all/count
+
+            void Error_(const std::string& message) const
+            {
+                throw(std::string("Error in filter expression at position ")+std::to_string(fPos_+1)+": "+message+" in \""+fText_+"\"");
+            }
+
+            void SkipSpaces_()
+            {
+                while(fPos_ < fText_.size() && std::isspace(static_cast<unsigned char>(fText_[fPos_])))
+                    fPos_++;
+            }
+
+            //consumes the token if it is next in the text
+            bool Accept_(const std::string& token)
+            {
+                SkipSpaces_();
+                if(fText_.compare(fPos_, token.size(), token) != 0)
+                    return false;
+                fPos_ += token.size();
+                return true;
+            }
+
+            void Expect_(const std::string& token)
+            {
+                if(!Accept_(token))
+                    Error_("expected \""+token+"\"");
+            }
+
+            Node Or_()
+            {
+                Node left = And_();
+                while(Accept_("||"))
+                {
+                    Node right = And_();
+                    left = [left, right](const Event* e, int ii){return IsTrue(left(e, ii)) || IsTrue(right(e, ii)) ? 1.0 : 0.0;};
+                }
+                return left;
+            }
+
+            Node And_()
+            {
+                Node left = Comparison_();
+                while(Accept_("&&"))
+                {
+                    Node right = Comparison_();
+                    left = [left, right](const Event* e, int ii){return IsTrue(left(e, ii)) && IsTrue(right(e, ii)) ? 1.0 : 0.0;};
+                }
+                return left;
+            }
+
+            //comparisons with missing values (NaN) are false
+            Node Comparison_()
+            {
+                Node left = Sum_();
+                if(Accept_("<="))
+                {
+                    Node right = Sum_();
+                    return [left, right](const Event* e, int ii){return left(e, ii) <= right(e, ii) ? 1.0 : 0.0;};
+                }
+                if(Accept_(">="))
+                {
+                    Node right = Sum_();
+                    return [left, right](const Event* e, int ii){return left(e, ii) >= right(e, ii) ? 1.0 : 0.0;};
+                }
+                if(Accept_("=="))
+                {
+                    Node right = Sum_();
+                    return [left, right](const Event* e, int ii){return left(e, ii) == right(e, ii) ? 1.0 : 0.0;};
+                }
+                if(Accept_("!="))
+                {
+                    Node right = Sum_();
+                    return [left, right](const Event* e, int ii){double a = left(e, ii); double b = right(e, ii); return a < b || a > b ? 1.0 : 0.0;};
+                }
+                if(Accept_("<"))
+                {
+                    Node right = Sum_();
+                    return [left, right](const Event* e, int ii){return left(e, ii) < right(e, ii) ? 1.0 : 0.0;};
+                }
+                if(Accept_(">"))
+                {
+                    Node right = Sum_();
+                    return [left, right](const Event* e, int ii){return left(e, ii) > right(e, ii) ? 1.0 : 0.0;};
+                }
+                return left;
+            }
+
+            Node Sum_()
+            {
+                Node left = Product_();
+                while(true)
+                {
+                    if(Accept_("+"))
+                    {
+                        Node right = Product_();
+                        left = [left, right](const Event* e, int ii){return left(e, ii) + right(e, ii);};
+                    }
+                    else if(Accept_("-"))
+                    {
+                        Node right = Product_();
+                        left = [left, right](const Event* e, int ii){return left(e, ii) - right(e, ii);};
+                    }
+                    else
+                        return left;
+                }
+            }
+
+            Node Product_()
+            {
+                Node left = Unary_();
+                while(true)
+                {
+                    if(Accept_("*"))
+                    {
+                        Node right = Unary_();
+                        left = [left, right](const Event* e, int ii){return left(e, ii) * right(e, ii);};
+                    }
+                    else if(Accept_("/"))
+                    {
+                        Node right = Unary_();
+                        left = [left, right](const Event* e, int ii){return left(e, ii) / right(e, ii);};
+                    }
+                    else
+                        return left;
+                }
+            }
+
+            Node Unary_()
+            {
+                SkipSpaces_();
+                //"!=" is handled by Comparison_, here "!" is always a negation
+                if(Accept_("!"))
+                {
+                    Node operand = Unary_();
+                    return [operand](const Event* e, int ii){return IsTrue(operand(e, ii)) ? 0.0 : 1.0;};
+                }
+                if(Accept_("-"))
+                {
+                    Node operand = Unary_();
+                    return [operand](const Event* e, int ii){return -operand(e, ii);};
+                }
+                return Atom_();
+            }
+
+            Node Atom_()
+            {
+                SkipSpaces_();
+                if(fPos_ >= fText_.size())
+                    Error_("unexpected end of expression");
+                if(Accept_("("))
+                {
+                    Node inner = Or_();
+                    Expect_(")");
+                    return inner;
+                }
+                char c = fText_[fPos_];
+                if(std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+                {
+                    const char* begin = fText_.c_str()+fPos_;
+                    char* end = nullptr;
+                    double value = std::strtod(begin, &end);
+                    fPos_ += end-begin;
+                    return [value](const Event*, int){return value;};
+                }
+                if(std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+                    return Identifier_();
+                Error_("unexpected character");
+                return Node();
+            }
+
+            Node Identifier_()
+            {
+                size_t begin = fPos_;
+                while(fPos_ < fText_.size() && (std::isalnum(static_cast<unsigned char>(fText_[fPos_])) || fText_[fPos_] == '_'))
+                    fPos_++;
+                std::string name = fText_.substr(begin, fPos_-begin);
+                if(name == "abs")
+                {
+                    Expect_("(");
+                    Node operand = Or_();
+                    Expect_(")");
+                    return [operand](const Event* e, int ii){return std::fabs(operand(e, ii));};
+                }
+                if(name == "any" || name == "all" || name == "count")
+                    return Quantifier_(name);
+                Node node;
+                if(fPhotonContext_ && PhotonVariable(name, node))
+                    return node;
+                if(EventVariable(name, node))
+                    return node;
+                if(PhotonVariable(name, node))
+                {
+                    fPos_ = begin;
+                    Error_("photon variable \""+name+"\" used outside any/all/count");
+                }
+                fPos_ = begin;
+                Error_("unknown variable \""+name+"\"");
+                return Node();
+            }
+
+            Node Quantifier_(const std::string& name)
+            {
+                if(fPhotonContext_)
+                    Error_("nested "+name+" is not allowed");
+                Expect_("(");
+                fPhotonContext_ = true;
+                Node predicate = Or_();
+                fPhotonContext_ = false;
+                Expect_(")");
+                std::function<bool(const Event*, int)> test = [predicate](const Event* e, int ii){return IsTrue(predicate(e, ii));};
+                if(name == "count")
+                    return [test](const Event* e, int){return double(CountPhotons(e, test));};
+                if(name == "any")
+                    return [test](const Event* e, int){return CountPhotons(e, test) > 0 ? 1.0 : 0.0;};
+                return [test](const Event* e, int){return CountPhotons(e, test) == e->GetNumberOfDecayProducts() ? 1.0 : 0.0;};
+            }
+    };
+}
+
+///
+/// \brief EventFilter::EventFilter Default constructor, all events are accepted.
+///
+EventFilter::EventFilter() :
+    fExpression_("")
+{
+}
+
+///
+/// \brief EventFilter::EventFilter Compiles the expression, see the class description for the syntax.
+/// \param expression Filter expression, empty or "none" accepts all events. Throws std::string on syntax errors.
+///
+EventFilter::EventFilter(const std::string& expression) :
+    fExpression_(expression)
+{
+    if(expression.find_first_not_of(" \t") == std::string::npos || expression == "none")
+        return;
+    Parser parser(fExpression_);
+    fRoot_ = parser.Parse();
+}
+
+///
+/// \brief EventFilter::Accept Evaluates the filter.
+/// \param event Pointer to Event object.
+/// \return True if the event should be saved.
+///
+bool EventFilter::Accept(const Event* event) const
+{
+    return !fRoot_ || IsTrue(fRoot_(event, -1));
+}
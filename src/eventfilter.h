@@ -0,0 +1,37 @@
+/// @file eventfilter.h
+/// @date 19.10.2026
+#ifndef EVENTFILTER_H
+#define EVENTFILTER_H
+#include <string>
+#include <functional>
+#include "event.h"
+
+///
+/// \brief The EventFilter class Predicate deciding which events are saved, compiled once from an expression given in the parameter file.
+///
+/// Expressions are built from numbers, variables, comparisons (< <= > >= == !=), arithmetic (+ - * /), logical
+/// operators (! && ||), parentheses and functions abs(x), any(p), all(p) and count(p). Event variables:
+/// nPhotons, nPassed, nPrimary, nScattered, nPrompt, prompt, pass, weight, type. Photon variables, allowed only
+/// inside any/all/count: E, edep, edepSmear, hitX, hitY, hitZ, hitT, passed, primary, prompt, index.
+/// Energies are in MeV, positions in mm. Comparisons with missing values (e.g. hit point of a photon that did not
+/// reach the detector) are false. Example:
+/// nPassed >= 2 && all(!passed || (edepSmear > 0.2 && abs(hitZ) < 250)) && !prompt
+///
+class EventFilter
+{
+    public:
+        EventFilter(); //accepts all events
+        explicit EventFilter(const std::string& expression);
+        bool Accept(const Event* event) const;
+        inline bool IsEmpty() const {return !fRoot_;}
+        inline const std::string& GetExpression() const {return fExpression_;}
+
+        //compiled expression, the second argument is the index of the photon inside any/all/count, -1 outside
+        typedef std::function<double(const Event*, int)> Node;
+
+    private:
+        std::string fExpression_;
+        Node fRoot_; //empty for an empty expression
+};
+
+#endif // EVENTFILTER_H
@@ -0,0 +1,160 @@
+/// @file flatevent.cpp
+/// @date 19.10.2026
+#include <string>
+#include <vector>
+#include "flatevent.h"
+
+namespace
+{
+    ///
+    /// \brief The Column_ struct Name of a branch, address of its buffer and ROOT leaf type.
+    ///
+    struct Column_
+    {
+        const char* name;
+        void* address;
+        char type;
+        bool perPhoton;
+    };
+
+    ///
+    /// \brief Columns Lists all branches of the flat schema.
+    /// \param flat Buffer whose fields are listed.
+    /// \param sparse Adds columns of the sparse schema.
+    /// \return Columns in the order of creation.
+    ///
+    std::vector<Column_> Columns(FlatEvent& flat, bool sparse)
+    {
+        std::vector<Column_> columns = {
+            {"id", &flat.id, 'L', false},
+            {"decayType", &flat.decayType, 'I', false},
+            {"weight", &flat.weight, 'F', false},
+            {"flags", &flat.flags, 'I', false},
+            {"nPhotons", &flat.nPhotons, 'I', false},
+            {"px", flat.px, 'F', true},
+            {"py", flat.py, 'F', true},
+            {"pz", flat.pz, 'F', true},
+            {"E", flat.E, 'F', true},
+            {"x0", flat.x0, 'F', true},
+            {"y0", flat.y0, 'F', true},
+            {"z0", flat.z0, 'F', true},
+            {"hitX", flat.hitX, 'F', true},
+            {"hitY", flat.hitY, 'F', true},
+            {"hitZ", flat.hitZ, 'F', true},
+            {"hitT", flat.hitT, 'F', true},
+            {"edep", flat.edep, 'F', true},
+            {"edepSmear", flat.edepSmear, 'F', true},
+            {"photonFlags", flat.photonFlags, 'I', true}
+        };
+        if(sparse)
+        {
+            columns.push_back({"nEmitted", &flat.nEmitted, 'I', false});
+            columns.push_back({"photonIndex", flat.photonIndex, 'I', true});
+        }
+        return columns;
+    }
+}
+
+///
+/// \brief FlatEvent::Assign Copies the event into the buffer.
+/// \param event Pointer to Event object.
+/// \param detectedOnly Only photons which passed cuts and hit the detector are copied (sparse schema).
+///
+void FlatEvent::Assign(const Event* event, bool detectedOnly)
+{
+    id = event->fId;
+    decayType = event->GetDecayType();
+    weight = event->GetWeight();
+    flags = event->GetPassFlag() ? EVENT_PASSED : 0;
+    nEmitted = event->GetNumberOfDecayProducts();
+    nPhotons = 0;
+    for(int jj=0; jj<nEmitted; jj++)
+    {
+        //photons which missed the detector have a sentinel hit point, it is not copied
+        const TLorentzVector* hit = event->HasHit(jj) ? event->GetHitPointOf(jj) : nullptr;
+        if(detectedOnly && (!hit || !event->GetCutPassingOf(jj)))
+            continue;
+        if(nPhotons == kMaxPhotons)
+            throw(std::string("[ERROR] Too many photons in the event for the flat tree schema: ")+std::to_string(nEmitted));
+        int ii = nPhotons++;
+        photonIndex[ii] = jj;
+        const TLorentzVector* p = event->GetFourMomentumOf(jj);
+        px[ii] = p->Px();
+        py[ii] = p->Py();
+        pz[ii] = p->Pz();
+        E[ii] = p->E();
+        const TLorentzVector* emission = event->GetEmissionPointOf(jj);
+        x0[ii] = emission ? emission->X() : 0.0;
+        y0[ii] = emission ? emission->Y() : 0.0;
+        z0[ii] = emission ? emission->Z() : 0.0;
+        hitX[ii] = hit ? hit->X() : 0.0;
+        hitY[ii] = hit ? hit->Y() : 0.0;
+        hitZ[ii] = hit ? hit->Z() : 0.0;
+        hitT[ii] = hit ? hit->T() : 0.0;
+        edep[ii] = event->GetEdepOf(jj);
+        edepSmear[ii] = event->GetEdepSmearOf(jj);
+        photonFlags[ii] = (event->GetCutPassingOf(jj) ? PHOTON_PASSED : 0) | (event->GetPrimaryPhoton(jj) ? PHOTON_PRIMARY : 0)\
+                | (hit ? PHOTON_HIT : 0);
+    }
+}
+
+///
+/// \brief FlatEvent::Branch Creates branches of the flat schema. If the tree already has them (e.g. another decay type
+/// is saved to the same tree), only their addresses are changed.
+/// \param tree Tree to which events are written.
+/// \param bufferSize Size of the basket of every branch.
+/// \param sparse Creates also the branches of the sparse schema (nEmitted and photonIndex).
+///
+void FlatEvent::Branch(TTree* tree, Int_t bufferSize, bool sparse)
+{
+    if(IsFlatTree(tree))
+    {
+        SetBranchAddresses(tree);
+        return;
+    }
+    std::vector<Column_> columns = Columns(*this, sparse);
+    for(unsigned ii=0; ii<columns.size(); ii++)
+    {
+        std::string leaf = std::string(columns[ii].name)+(columns[ii].perPhoton ? "[nPhotons]/" : "/")+columns[ii].type;
+        tree->Branch(columns[ii].name, columns[ii].address, leaf.c_str(), bufferSize);
+    }
+}
+
+///
+/// \brief FlatEvent::SetBranchAddresses Connects existing branches with this buffer. For trees written with the flat schema
+/// nEmitted and photonIndex are not read, they are equal to nPhotons and indices of the arrays.
+/// \param tree Tree written with the flat or sparse schema.
+/// \return False if the tree was not written with the flat schema.
+///
+bool FlatEvent::SetBranchAddresses(TTree* tree)
+{
+    if(!IsFlatTree(tree))
+        return false;
+    std::vector<Column_> columns = Columns(*this, IsSparseTree(tree));
+    for(unsigned ii=0; ii<columns.size(); ii++)
+    {
+        if(tree->GetBranch(columns[ii].name))
+            tree->SetBranchAddress(columns[ii].name, columns[ii].address);
+    }
+    return true;
+}
+
+///
+/// \brief FlatEvent::IsFlatTree Checks if the tree was written with the flat or sparse schema.
+/// \param tree Tree to be checked.
+/// \return True if the tree contains the photon counter.
+///
+bool FlatEvent::IsFlatTree(TTree* tree)
+{
+    return tree->GetBranch("nPhotons") != nullptr;
+}
+
+///
+/// \brief FlatEvent::IsSparseTree Checks if the tree was written with the sparse schema.
+/// \param tree Tree to be checked.
+/// \return True if the tree contains the number of emitted photons.
+///
+bool FlatEvent::IsSparseTree(TTree* tree)
+{
+    return tree->GetBranch("nEmitted") != nullptr;
+}
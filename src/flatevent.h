@@ -0,0 +1,70 @@
+/// @file flatevent.h
+/// @date 19.10.2026
+#ifndef FLATEVENT_H
+#define FLATEVENT_H
+#include "TTree.h"
+#include "event.h"
+
+///
+/// \brief The EventFlag enum Bits of FlatEvent::flags.
+///
+enum EventFlag
+{
+    EVENT_PASSED = 1 //all necessary gammas passed cuts
+};
+
+///
+/// \brief The PhotonFlag enum Bits of FlatEvent::photonFlags.
+///
+enum PhotonFlag
+{
+    PHOTON_PASSED = 1, //gamma passed cuts
+    PHOTON_PRIMARY = 2, //gamma was not scattered
+    PHOTON_HIT = 4 //gamma hit the detector
+};
+
+///
+/// \brief The FlatEvent struct Columnar representation of Event: fixed-width leaves and per-photon arrays of length nPhotons.
+/// Used as a buffer of the flat tree schema, every field is stored in a separate branch of the same name.
+/// With the sparse schema only detected photons (passed cuts, hit the detector) are stored, nEmitted keeps the number
+/// of all photons of the event and photonIndex their positions in it. Both are stored only by the sparse schema.
+///
+struct FlatEvent
+{
+    static const int kMaxPhotons = 32;
+
+    Long64_t id;
+    Int_t decayType;
+    Float_t weight;
+    Int_t flags; //bitwise sum of EventFlag values
+    Int_t nEmitted; //number of photons in the event
+    Int_t nPhotons; //number of stored photons
+    Int_t photonIndex[kMaxPhotons]; //index of the photon in the event
+    Float_t px[kMaxPhotons]; //[MeV/c]
+    Float_t py[kMaxPhotons];
+    Float_t pz[kMaxPhotons];
+    Float_t E[kMaxPhotons]; //[MeV]
+    Float_t x0[kMaxPhotons]; //emission point [mm]
+    Float_t y0[kMaxPhotons];
+    Float_t z0[kMaxPhotons];
+    Float_t hitX[kMaxPhotons]; //hit point [mm], zero if not calculated or the gamma missed the detector
+    Float_t hitY[kMaxPhotons];
+    Float_t hitZ[kMaxPhotons];
+    Float_t hitT[kMaxPhotons];
+    Float_t edep[kMaxPhotons]; //[MeV]
+    Float_t edepSmear[kMaxPhotons];
+    Int_t photonFlags[kMaxPhotons]; //bitwise sum of PhotonFlag values
+
+    //copies the event into the buffer, with detectedOnly set photons which were not detected are skipped
+    void Assign(const Event* event, bool detectedOnly=false);
+    //creates branches pointing at this buffer, or only sets their addresses if the tree already has them
+    void Branch(TTree* tree, Int_t bufferSize=32000, bool sparse=false);
+    //sets addresses of existing branches for reading, returns false if the tree was not written with the flat schema
+    bool SetBranchAddresses(TTree* tree);
+    //true if the tree was written with the flat or sparse schema
+    static bool IsFlatTree(TTree* tree);
+    //true if the tree was written with the sparse schema
+    static bool IsSparseTree(TTree* tree);
+};
+
+#endif // FLATEVENT_H
@@ -0,0 +1,23 @@
+/// @file hash.h
+#ifndef HASH_H
+#define HASH_H
+#include <string>
+#include <cstdint>
+
+///
+/// \brief fnv1a Simple 64-bit FNV-1a hash, used to shorten keys of cached maps, tables and runs.
+/// \param str String to be hashed.
+/// \return Hash value.
+///
+inline uint64_t fnv1a(const std::string& str)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for(unsigned char c : str)
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+#endif // HASH_H
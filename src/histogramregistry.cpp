@@ -0,0 +1,396 @@
+/// @file histogramregistry.cpp
+/// @date 19.10.2026
+#include "histogramregistry.h"
+#include "rawoutput.h"
+
+namespace
+{
+    //names of groups used in the parameter file, in the order of bits
+    const char* kGroupNames[] = {"angles", "energies", "pass", "fail", "compton", "cuts"};
+    const unsigned kNumberOfGroups = 6;
+}
+
+///
+/// \brief Histogram1D Creates declaration of a 1D histogram with default appearance.
+/// \param key Name of the member field holding the histogram.
+/// \param groups Groups the histogram belongs to.
+/// \param nx Number of bins.
+/// \param xMin Lower edge.
+/// \param xMax Upper edge.
+/// \return Declaration of the histogram.
+///
+HistogramDef Histogram1D(const std::string& key, unsigned groups, int nx, double xMin, double xMax)
+{
+    return Histogram2D(key, groups, nx, xMin, xMax, 0, 0.0, 0.0);
+}
+
+///
+/// \brief Histogram2D Creates declaration of a 2D histogram with default appearance.
+/// \param key Name of the member field holding the histogram.
+/// \param groups Groups the histogram belongs to.
+/// \param nx Number of bins along X.
+/// \param xMin Lower edge along X.
+/// \param xMax Upper edge along X.
+/// \param ny Number of bins along Y.
+/// \param yMin Lower edge along Y.
+/// \param yMax Upper edge along Y.
+/// \return Declaration of the histogram.
+///
+HistogramDef Histogram2D(const std::string& key, unsigned groups, int nx, double xMin, double xMax, int ny, double yMin, double yMax)
+{
+    HistogramDef def;
+    def.key = key;
+    def.groups = groups;
+    def.nx = nx;
+    def.xMin = xMin;
+    def.xMax = xMax;
+    def.ny = ny;
+    def.yMin = yMin;
+    def.yMax = yMax;
+    def.title = key;
+    def.xTitleOffset = 0.0;
+    def.yTitleOffset = 0.0;
+    def.fillColor = -1;
+    def.xDivisions = 0;
+    def.hideXLabels = false;
+    return def;
+}
+
+///
+/// \brief HistogramFiller::HistogramFiller Constructor.
+/// \param hist Histogram to be filled, not owned.
+/// \param bufferSize Number of values gathered before they are passed to the histogram.
+///
+HistogramFiller::HistogramFiller(TH1* hist, unsigned bufferSize) :
+    fHist_(hist),
+    fHist2D_(dynamic_cast<TH2*>(hist)),
+    fBufferSize_(bufferSize > 0 ? bufferSize : 1)
+{
+    if(fHist_)
+    {
+        fX_.reserve(fBufferSize_);
+        fW_.reserve(fBufferSize_);
+        if(fHist2D_)
+            fY_.reserve(fBufferSize_);
+    }
+}
+
+///
+/// \brief HistogramFiller::Flush Fills the histogram with all buffered values at once.
+///
+void HistogramFiller::Flush() const
+{
+    if(fX_.empty())
+        return;
+    if(fHist2D_)
+        fHist2D_->FillN(fX_.size(), fX_.data(), fY_.data(), fW_.data());
+    else
+        fHist_->FillN(fX_.size(), fX_.data(), fW_.data());
+    fX_.clear();
+    fY_.clear();
+    fW_.clear();
+}
+
+///
+/// \brief HistogramFiller::Discard Drops buffered values without filling the histogram.
+///
+void HistogramFiller::Discard()
+{
+    fX_.clear();
+    fY_.clear();
+    fW_.clear();
+}
+
+///
+/// \brief HistogramRegistry::HistogramRegistry Constructor.
+/// \param enabledGroups Bitwise sum of HistogramGroup values, histograms from other groups are not created.
+/// \param nameSuffix Suffix added to keys to obtain unique names of ROOT objects.
+///
+HistogramRegistry::HistogramRegistry(unsigned enabledGroups, const std::string& nameSuffix) :
+    fEnabledGroups_(enabledGroups),
+    fNameSuffix_(nameSuffix)
+{
+}
+
+///
+/// \brief HistogramRegistry::HistogramRegistry Copy constructor, histograms are cloned.
+/// \param est Instance to be copied.
+///
+HistogramRegistry::HistogramRegistry(const HistogramRegistry& est) :
+    fEnabledGroups_(est.fEnabledGroups_),
+    fNameSuffix_(est.fNameSuffix_)
+{
+    CopyEntries_(est.fEventEntries_, fEventEntries_);
+    CopyEntries_(est.fPhotonEntries_, fPhotonEntries_);
+}
+
+///
+/// \brief HistogramRegistry::operator = Assignment operator, histograms are cloned.
+/// \param est Instance to be copied.
+/// \return Reference to this instance.
+///
+HistogramRegistry& HistogramRegistry::operator=(const HistogramRegistry& est)
+{
+    if(this == &est)
+        return *this;
+    Clear_();
+    fEnabledGroups_ = est.fEnabledGroups_;
+    fNameSuffix_ = est.fNameSuffix_;
+    CopyEntries_(est.fEventEntries_, fEventEntries_);
+    CopyEntries_(est.fPhotonEntries_, fPhotonEntries_);
+    return *this;
+}
+
+///
+/// \brief HistogramRegistry::~HistogramRegistry Destructor, deletes all histograms.
+///
+HistogramRegistry::~HistogramRegistry()
+{
+    Clear_();
+}
+
+///
+/// \brief HistogramRegistry::AddEventHistogram Declares a histogram filled once per event.
+/// \param def Declaration of the histogram.
+/// \param fill Expression filling the histogram.
+/// \return Pointer to the histogram owned by the registry, nullptr if any of its groups is disabled.
+///
+TH1* HistogramRegistry::AddEventHistogram(const HistogramDef& def, const EventFillExpression& fill)
+{
+    if(!IsEnabled(def.groups))
+        return nullptr;
+    Entry_ entry;
+    entry.key = def.key;
+    entry.groups = def.groups;
+    entry.filler = HistogramFiller(Create_(def));
+    entry.eventFill = fill;
+    fEventEntries_.push_back(entry);
+    return entry.filler.GetHistogram();
+}
+
+///
+/// \brief HistogramRegistry::AddPhotonHistogram Declares a histogram filled once per photon.
+/// \param def Declaration of the histogram.
+/// \param fill Expression filling the histogram.
+/// \return Pointer to the histogram owned by the registry, nullptr if any of its groups is disabled.
+///
+TH1* HistogramRegistry::AddPhotonHistogram(const HistogramDef& def, const PhotonFillExpression& fill)
+{
+    if(!IsEnabled(def.groups))
+        return nullptr;
+    Entry_ entry;
+    entry.key = def.key;
+    entry.groups = def.groups;
+    entry.filler = HistogramFiller(Create_(def));
+    entry.photonFill = fill;
+    fPhotonEntries_.push_back(entry);
+    return entry.filler.GetHistogram();
+}
+
+///
+/// \brief HistogramRegistry::Fill Fills all event histograms.
+/// \param event Pointer to Event object.
+/// \param skippedGroups Histograms belonging to any of these groups are not filled, e.g. FAIL_HISTOGRAMS for a valid event.
+///
+void HistogramRegistry::Fill(const Event* event, unsigned skippedGroups)
+{
+    for(unsigned ii=0; ii<fEventEntries_.size(); ii++)
+    {
+        if(fEventEntries_[ii].groups & skippedGroups)
+            continue;
+        fEventEntries_[ii].eventFill(fEventEntries_[ii].filler, event);
+    }
+}
+
+///
+/// \brief HistogramRegistry::FillPhoton Fills all photon histograms for a single photon.
+/// \param event Pointer to Event object.
+/// \param index Index of the photon in the event.
+/// \param skippedGroups Histograms belonging to any of these groups are not filled.
+///
+void HistogramRegistry::FillPhoton(const Event* event, int index, unsigned skippedGroups)
+{
+    for(unsigned ii=0; ii<fPhotonEntries_.size(); ii++)
+    {
+        if(fPhotonEntries_[ii].groups & skippedGroups)
+            continue;
+        fPhotonEntries_[ii].photonFill(fPhotonEntries_[ii].filler, event, index);
+    }
+}
+
+///
+/// \brief HistogramRegistry::Flush Passes buffered values of all histograms to the histograms.
+///
+void HistogramRegistry::Flush() const
+{
+    for(unsigned ii=0; ii<fEventEntries_.size(); ii++)
+        fEventEntries_[ii].filler.Flush();
+    for(unsigned ii=0; ii<fPhotonEntries_.size(); ii++)
+        fPhotonEntries_[ii].filler.Flush();
+}
+
+///
+/// \brief HistogramRegistry::Get Finds histogram by its key.
+/// \param key Key given in the declaration.
+/// \return Pointer to the histogram, nullptr if it was not booked.
+///
+TH1* HistogramRegistry::Get(const std::string& key) const
+{
+    for(unsigned ii=0; ii<fEventEntries_.size(); ii++)
+        if(fEventEntries_[ii].key == key)
+            return fEventEntries_[ii].filler.GetHistogram();
+    for(unsigned ii=0; ii<fPhotonEntries_.size(); ii++)
+        if(fPhotonEntries_[ii].key == key)
+            return fPhotonEntries_[ii].filler.GetHistogram();
+    return nullptr;
+}
+
+///
+/// \brief HistogramRegistry::Write Writes all histograms to the current directory under their keys.
+///
+void HistogramRegistry::Write() const
+{
+    Flush();
+    for(unsigned ii=0; ii<fEventEntries_.size(); ii++)
+        WriteRawHistogram(fEventEntries_[ii].filler.GetHistogram(), fEventEntries_[ii].key);
+    for(unsigned ii=0; ii<fPhotonEntries_.size(); ii++)
+        WriteRawHistogram(fPhotonEntries_[ii].filler.GetHistogram(), fPhotonEntries_[ii].key);
+}
+
+///
+/// \brief HistogramRegistry::Read Replaces histograms with the ones written by Write. Missing keys are left untouched.
+/// \param dir Directory with raw histograms.
+///
+void HistogramRegistry::Read(TDirectory* dir)
+{
+    for(unsigned ii=0; ii<fEventEntries_.size(); ii++)
+    {
+        TH1* hist = fEventEntries_[ii].filler.GetHistogram();
+        fEventEntries_[ii].filler.Discard();
+        ReadRawHistogram(dir, fEventEntries_[ii].key, hist);
+        fEventEntries_[ii].filler = HistogramFiller(hist);
+    }
+    for(unsigned ii=0; ii<fPhotonEntries_.size(); ii++)
+    {
+        TH1* hist = fPhotonEntries_[ii].filler.GetHistogram();
+        fPhotonEntries_[ii].filler.Discard();
+        ReadRawHistogram(dir, fPhotonEntries_[ii].key, hist);
+        fPhotonEntries_[ii].filler = HistogramFiller(hist);
+    }
+}
+
+///
+/// \brief HistogramRegistry::ParseGroups Converts names of groups to flags.
+/// \param names Names of groups: angles, energies, pass, fail, compton, cuts, all or none.
+/// \return Bitwise sum of HistogramGroup values.
+///
+unsigned HistogramRegistry::ParseGroups(const std::vector<std::string>& names)
+{
+    unsigned groups = NO_HISTOGRAMS;
+    for(unsigned ii=0; ii<names.size(); ii++)
+    {
+        if(names[ii] == "all")
+        {
+            groups |= ALL_HISTOGRAMS;
+            continue;
+        }
+        if(names[ii] == "none")
+            continue;
+        bool found = false;
+        for(unsigned jj=0; jj<kNumberOfGroups; jj++)
+        {
+            if(names[ii] == kGroupNames[jj])
+            {
+                groups |= 1u<<jj;
+                found = true;
+            }
+        }
+        if(!found)
+            throw(std::string("Unknown histogram group: ")+names[ii]);
+    }
+    return groups;
+}
+
+///
+/// \brief HistogramRegistry::GroupNames Converts flags to names of groups.
+/// \param groups Bitwise sum of HistogramGroup values.
+/// \return Space separated names of groups, "all" or "none".
+///
+std::string HistogramRegistry::GroupNames(unsigned groups)
+{
+    if((groups & ALL_HISTOGRAMS) == ALL_HISTOGRAMS)
+        return "all";
+    std::string names;
+    for(unsigned jj=0; jj<kNumberOfGroups; jj++)
+    {
+        if(groups & (1u<<jj))
+            names += (names.empty() ? "" : " ") + std::string(kGroupNames[jj]);
+    }
+    return names.empty() ? "none" : names;
+}
+
+///
+/// \brief HistogramRegistry::Create_ Creates ROOT histogram according to the declaration.
+/// \param def Declaration of the histogram.
+/// \return New histogram, owned by the registry.
+///
+TH1* HistogramRegistry::Create_(const HistogramDef& def) const
+{
+    TH1* hist = nullptr;
+    std::string name = def.key+fNameSuffix_;
+    if(def.ny > 0)
+        hist = new TH2F(name.c_str(), def.key.c_str(), def.nx, def.xMin, def.xMax, def.ny, def.yMin, def.yMax);
+    else
+        hist = new TH1F(name.c_str(), def.key.c_str(), def.nx, def.xMin, def.xMax);
+    hist->SetTitle(def.title.c_str());
+    if(def.fillColor >= 0)
+        hist->SetFillColor(def.fillColor);
+    if(def.xDivisions > 0)
+        hist->GetXaxis()->SetNdivisions(def.xDivisions, false);
+    if(!def.xTitle.empty())
+        hist->GetXaxis()->SetTitle(def.xTitle.c_str());
+    if(def.xTitleOffset > 0.0)
+        hist->GetXaxis()->SetTitleOffset(def.xTitleOffset);
+    if(!def.yTitle.empty())
+        hist->GetYaxis()->SetTitle(def.yTitle.c_str());
+    if(def.yTitleOffset > 0.0)
+        hist->GetYaxis()->SetTitleOffset(def.yTitleOffset);
+    if(def.hideXLabels)
+    {
+        hist->GetXaxis()->SetLabelSize(0);
+        hist->GetXaxis()->SetTickLength(0);
+    }
+    return hist;
+}
+
+///
+/// \brief HistogramRegistry::CopyEntries_ Copies entries, histograms are flushed and cloned, fill expressions are shared.
+/// \param from Source entries.
+/// \param to Destination, assumed to be empty.
+///
+void HistogramRegistry::CopyEntries_(const std::vector<Entry_>& from, std::vector<Entry_>& to)
+{
+    to.reserve(from.size());
+    for(unsigned ii=0; ii<from.size(); ii++)
+    {
+        from[ii].filler.Flush();
+        Entry_ entry = from[ii];
+        TH1* clone = static_cast<TH1*>(from[ii].filler.GetHistogram()->Clone());
+        clone->SetDirectory(nullptr);
+        entry.filler = HistogramFiller(clone);
+        to.push_back(entry);
+    }
+}
+
+///
+/// \brief HistogramRegistry::Clear_ Deletes all histograms and entries.
+///
+void HistogramRegistry::Clear_()
+{
+    for(unsigned ii=0; ii<fEventEntries_.size(); ii++)
+        delete fEventEntries_[ii].filler.GetHistogram();
+    for(unsigned ii=0; ii<fPhotonEntries_.size(); ii++)
+        delete fPhotonEntries_[ii].filler.GetHistogram();
+    fEventEntries_.clear();
+    fPhotonEntries_.clear();
+}
@@ -0,0 +1,199 @@
+/// @file histogramregistry.h
+/// @date 19.10.2026
+#ifndef HISTOGRAMREGISTRY_H
+#define HISTOGRAMREGISTRY_H
+#include <string>
+#include <vector>
+#include <functional>
+#include "TH1.h"
+#include "TH2.h"
+#include "TDirectory.h"
+#include "event.h"
+
+///
+/// \brief The HistogramGroup enum Groups of histograms that can be enabled in the parameter file. Values are bit flags.
+///
+enum HistogramGroup
+{
+    NO_HISTOGRAMS = 0,
+    ANGLE_HISTOGRAMS = 1, //angular distributions
+    ENERGY_HISTOGRAMS = 2, //energy and momentum distributions
+    PASS_HISTOGRAMS = 4, //gammas and events that passed cuts
+    FAIL_HISTOGRAMS = 8, //gammas and events that failed cuts
+    COMPTON_HISTOGRAMS = 16, //Compton scattering in the detector
+    CUTS_HISTOGRAMS = 32, //fraction of gammas and events that passed cuts
+    ALL_HISTOGRAMS = 63
+};
+
+///
+/// \brief The HistogramDef struct Declaration of a single histogram: binning, titles and groups it belongs to.
+///
+struct HistogramDef
+{
+    std::string key; //name of the member field, used also as a key in the raw output
+    unsigned groups; //histogram is booked only if all of its groups are enabled
+    int nx;
+    double xMin;
+    double xMax;
+    int ny; //0 for 1D histograms
+    double yMin;
+    double yMax;
+    std::string title;
+    std::string xTitle;
+    std::string yTitle;
+    double xTitleOffset; //0 means default
+    double yTitleOffset; //0 means default
+    int fillColor; //-1 means no fill
+    int xDivisions; //0 means default
+    bool hideXLabels;
+
+    //setters returning reference, so that the declarations can be chained
+    inline HistogramDef& Titles(const std::string& t, const std::string& x, const std::string& y) {title=t; xTitle=x; yTitle=y; return *this;}
+    inline HistogramDef& TitleOffsets(double x, double y) {xTitleOffset=x; yTitleOffset=y; return *this;}
+    inline HistogramDef& FillColor(int color) {fillColor=color; return *this;}
+    inline HistogramDef& Divisions(int n) {xDivisions=n; return *this;}
+    inline HistogramDef& HideXLabels() {hideXLabels=true; return *this;}
+};
+
+HistogramDef Histogram1D(const std::string& key, unsigned groups, int nx, double xMin, double xMax);
+HistogramDef Histogram2D(const std::string& key, unsigned groups, int nx, double xMin, double xMax, int ny, double yMin, double yMax);
+
+///
+/// \brief The HistogramFiller class Wrapper passed to fill expressions, hides the dimension of the histogram.
+/// Values are gathered in contiguous buffers and passed to the histogram with a single FillN call when the buffer is full,
+/// so Flush has to be called before the histogram is drawn, written or read.
+///
+class HistogramFiller
+{
+    public:
+        explicit HistogramFiller(TH1* hist=nullptr, unsigned bufferSize=kDefaultBufferSize);
+        inline void Fill(double x, double w=1.0)
+        {
+            fX_.push_back(x);
+            fW_.push_back(w);
+            if(fX_.size() >= fBufferSize_)
+                Flush();
+        }
+        inline void Fill(double x, double y, double w)
+        {
+            fX_.push_back(x);
+            fY_.push_back(y);
+            fW_.push_back(w);
+            if(fX_.size() >= fBufferSize_)
+                Flush();
+        }
+        //buffers are logically a part of the histogram, so flushing does not change the state seen from outside
+        void Flush() const;
+        //drops buffered values, e.g. when the histogram is replaced
+        void Discard();
+        inline TH1* GetHistogram() const {return fHist_;}
+        inline unsigned GetBufferedEntries() const {return fX_.size();}
+        static const unsigned kDefaultBufferSize = 1024;
+    private:
+        TH1* fHist_;
+        TH2* fHist2D_; //the same object as fHist_ for 2D histograms, nullptr otherwise
+        unsigned fBufferSize_;
+        mutable std::vector<double> fX_;
+        mutable std::vector<double> fY_; //2D histograms only
+        mutable std::vector<double> fW_;
+};
+
+//fill expression called once per event
+typedef std::function<void(HistogramFiller&, const Event*)> EventFillExpression;
+//fill expression called once per existing photon, the last argument is the index of the photon
+typedef std::function<void(HistogramFiller&, const Event*, int)> PhotonFillExpression;
+
+///
+/// \brief The HistogramRegistry class Owns histograms declared with HistogramDef and fills them using fill expressions.
+/// Histograms from disabled groups are not created and are not visited while filling.
+/// Fill expressions must not capture pointers to the owner, because they are shared between copies of the registry.
+///
+class HistogramRegistry
+{
+    public:
+        HistogramRegistry(unsigned enabledGroups=ALL_HISTOGRAMS, const std::string& nameSuffix="");
+        HistogramRegistry(const HistogramRegistry& est);
+        HistogramRegistry& operator=(const HistogramRegistry& est);
+        ~HistogramRegistry();
+
+        //declaring histograms, nullptr is returned if the histogram is disabled
+        TH1* AddEventHistogram(const HistogramDef& def, const EventFillExpression& fill);
+        TH1* AddPhotonHistogram(const HistogramDef& def, const PhotonFillExpression& fill);
+        //filling, histograms belonging to any of skippedGroups are not filled
+        void Fill(const Event* event, unsigned skippedGroups=NO_HISTOGRAMS);
+        void FillPhoton(const Event* event, int index, unsigned skippedGroups=NO_HISTOGRAMS);
+        inline bool HasPhotonHistograms() const {return !fPhotonEntries_.empty();}
+
+        //passes buffered values to histograms, has to be called before drawing
+        void Flush() const;
+
+        TH1* Get(const std::string& key) const;
+        inline bool IsEnabled(unsigned groups) const {return (groups & fEnabledGroups_)==groups;}
+        inline unsigned GetEnabledGroups() const {return fEnabledGroups_;}
+        inline int GetNumberOfHistograms() const {return fEventEntries_.size()+fPhotonEntries_.size();}
+        //raw output, see rawoutput.h, buffers are flushed before writing
+        void Write() const;
+        void Read(TDirectory* dir);
+
+        //conversion between names used in the parameter file and group flags
+        static unsigned ParseGroups(const std::vector<std::string>& names);
+        static std::string GroupNames(unsigned groups);
+
+    private:
+        ///
+        /// \brief The Entry_ struct Booked histogram together with its fill expression.
+        ///
+        struct Entry_
+        {
+            std::string key;
+            unsigned groups;
+            HistogramFiller filler;
+            EventFillExpression eventFill; //empty for photon histograms
+            PhotonFillExpression photonFill; //empty for event histograms
+        };
+        unsigned fEnabledGroups_;
+        std::string fNameSuffix_;
+        std::vector<Entry_> fEventEntries_;
+        std::vector<Entry_> fPhotonEntries_;
+
+        TH1* Create_(const HistogramDef& def) const;
+        void CopyEntries_(const std::vector<Entry_>& from, std::vector<Entry_>& to);
+        void Clear_();
+};
+
+///
+/// \brief RelativeAngle Angle between momenta of two photons, helper for fill expressions.
+/// \param event Pointer to Event object.
+/// \param first Index of the first photon.
+/// \param second Index of the second photon.
+/// \return Angle in radians.
+///
+inline double RelativeAngle(const Event* event, int first, int second)
+{
+    return event->GetFourMomentumOf(first)->Angle(event->GetFourMomentumOf(second)->Vect());
+}
+
+///
+/// \brief DrawIfBooked Draws the histogram unless it belongs to a disabled group.
+/// \param hist Pointer to the histogram, may be nullptr.
+/// \param option Draw option.
+///
+inline void DrawIfBooked(TH1* hist, Option_t* option="")
+{
+    if(hist)
+        hist->Draw(option);
+}
+
+///
+/// \brief RegistryHistogram Returns histogram from the registry casted to the type of member field.
+/// \param registry Registry owning the histogram.
+/// \param key Key of the histogram.
+/// \return Pointer to the histogram or nullptr if it is disabled.
+///
+template<class T>
+T* RegistryHistogram(const HistogramRegistry& registry, const std::string& key)
+{
+    return dynamic_cast<T*>(registry.Get(key));
+}
+
+#endif // HISTOGRAMREGISTRY_H
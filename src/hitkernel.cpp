@@ -0,0 +1,222 @@
+/// @file hitkernel.cpp
+/// @date 19.10.2026
+#include <cmath>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "constants.h"
+#include "hitkernel.h"
+
+//value written to the coordinates of photons that missed the detector (the same as in Event)
+static const double kMissSentinel = -2000.0;
+//photons with transverse momentum squared below this value never reach the barrel
+static const double kMinPt2 = 1e-20;
+
+///
+/// \brief PhotonBatch::Clear Removes all photons from the batch, keeps allocated memory.
+///
+void PhotonBatch::Clear()
+{
+    x0.clear();
+    y0.clear();
+    z0.clear();
+    px.clear();
+    py.clear();
+    pz.clear();
+    E.clear();
+}
+
+///
+/// \brief PhotonBatch::Reserve Reserves memory for n photons.
+/// \param n Number of photons.
+///
+void PhotonBatch::Reserve(std::size_t n)
+{
+    x0.reserve(n);
+    y0.reserve(n);
+    z0.reserve(n);
+    px.reserve(n);
+    py.reserve(n);
+    pz.reserve(n);
+    E.reserve(n);
+}
+
+///
+/// \brief PhotonBatch::Push Adds a photon to the batch.
+/// \param x X coordinate of the emission point [mm].
+/// \param y Y coordinate of the emission point [mm].
+/// \param z Z coordinate of the emission point [mm].
+/// \param momX X component of the momentum [MeV/c].
+/// \param momY Y component of the momentum [MeV/c].
+/// \param momZ Z component of the momentum [MeV/c].
+/// \param energy Energy of the photon [MeV].
+///
+void PhotonBatch::Push(double x, double y, double z, double momX, double momY, double momZ, double energy)
+{
+    x0.push_back(x);
+    y0.push_back(y);
+    z0.push_back(z);
+    px.push_back(momX);
+    py.push_back(momY);
+    pz.push_back(momZ);
+    E.push_back(energy);
+}
+
+///
+/// \brief HitBatch::Resize Resizes all arrays to hold results for n photons.
+/// \param n Number of photons.
+///
+void HitBatch::Resize(std::size_t n)
+{
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+    t.resize(n);
+    miss.resize(n);
+}
+
+///
+/// \brief CalculateHitPointsScalar Calculates hit points photon by photon.
+/// \param photons Batch of photons.
+/// \param R Radius of the detector.
+/// \param L Length of the detector.
+/// \param hits Output, has to be already resized to the size of the batch.
+/// \param first Index of the first photon to be processed.
+///
+void CalculateHitPointsScalar(const PhotonBatch& photons, double R, double L, HitBatch& hits, std::size_t first)
+{
+    const double halfL = L/2.0;
+    const double timeFactor = 1000000.0/light_speed_SI;
+    for(std::size_t ii=first; ii<photons.Size(); ii++)
+    {
+        double x0 = photons.x0[ii];
+        double y0 = photons.y0[ii];
+        double px = photons.px[ii];
+        double py = photons.py[ii];
+        double pt2 = px*px+py*py;
+        double b = x0*px+y0*py;
+        double delta = b*b-(x0*x0+y0*y0-R*R)*pt2;
+        double s = 0.0;
+        double z = 0.0;
+        bool hit = pt2 > kMinPt2 && delta >= 0.0;
+        if(hit)
+        {
+            s = (-b+std::sqrt(delta))/pt2;
+            z = photons.z0[ii]+photons.pz[ii]*s;
+            hit = std::fabs(z) <= halfL;
+        }
+        if(hit)
+        {
+            hits.x[ii] = x0+px*s;
+            hits.y[ii] = y0+py*s;
+            hits.z[ii] = z;
+            hits.t[ii] = photons.E[ii]*s*timeFactor;
+            hits.miss[ii] = 0;
+        }
+        else
+        {
+            hits.x[ii] = kMissSentinel;
+            hits.y[ii] = kMissSentinel;
+            hits.z[ii] = kMissSentinel;
+            hits.t[ii] = kMissSentinel;
+            hits.miss[ii] = 1;
+        }
+    }
+}
+
+///
+/// \brief CalculateHitPointsBatch Calculates hit points of all photons from the batch using the widest available vector unit.
+/// \param photons Batch of photons.
+/// \param R Radius of the detector.
+/// \param L Length of the detector.
+/// \param hits Output, resized to the size of the batch.
+///
+void CalculateHitPointsBatch(const PhotonBatch& photons, double R, double L, HitBatch& hits)
+{
+    const std::size_t n = photons.Size();
+    hits.Resize(n);
+    std::size_t ii = 0;
+#if defined(__AVX512F__)
+    const __m512d vR2 = _mm512_set1_pd(R*R);
+    const __m512d vHalfL = _mm512_set1_pd(L/2.0);
+    const __m512d vMinPt2 = _mm512_set1_pd(kMinPt2);
+    const __m512d vTime = _mm512_set1_pd(1000000.0/light_speed_SI);
+    const __m512d vMiss = _mm512_set1_pd(kMissSentinel);
+    const __m512d vZero = _mm512_setzero_pd();
+    for(; ii+8<=n; ii+=8)
+    {
+        __m512d x0 = _mm512_loadu_pd(&photons.x0[ii]);
+        __m512d y0 = _mm512_loadu_pd(&photons.y0[ii]);
+        __m512d z0 = _mm512_loadu_pd(&photons.z0[ii]);
+        __m512d px = _mm512_loadu_pd(&photons.px[ii]);
+        __m512d py = _mm512_loadu_pd(&photons.py[ii]);
+        __m512d pz = _mm512_loadu_pd(&photons.pz[ii]);
+        __m512d en = _mm512_loadu_pd(&photons.E[ii]);
+        __m512d pt2 = _mm512_fmadd_pd(px, px, _mm512_mul_pd(py, py));
+        __m512d b = _mm512_fmadd_pd(x0, px, _mm512_mul_pd(y0, py));
+        __m512d c = _mm512_sub_pd(_mm512_fmadd_pd(x0, x0, _mm512_mul_pd(y0, y0)), vR2);
+        __m512d delta = _mm512_fmsub_pd(b, b, _mm512_mul_pd(c, pt2));
+        __m512d s = _mm512_div_pd(_mm512_sub_pd(_mm512_sqrt_pd(_mm512_max_pd(delta, vZero)), b), pt2);
+        __m512d hz = _mm512_fmadd_pd(pz, s, z0);
+        __mmask8 hit = _mm512_cmp_pd_mask(pt2, vMinPt2, _CMP_GT_OQ)
+                     & _mm512_cmp_pd_mask(delta, vZero, _CMP_GE_OQ)
+                     & _mm512_cmp_pd_mask(_mm512_abs_pd(hz), vHalfL, _CMP_LE_OQ);
+        _mm512_storeu_pd(&hits.x[ii], _mm512_mask_blend_pd(hit, vMiss, _mm512_fmadd_pd(px, s, x0)));
+        _mm512_storeu_pd(&hits.y[ii], _mm512_mask_blend_pd(hit, vMiss, _mm512_fmadd_pd(py, s, y0)));
+        _mm512_storeu_pd(&hits.z[ii], _mm512_mask_blend_pd(hit, vMiss, hz));
+        _mm512_storeu_pd(&hits.t[ii], _mm512_mask_blend_pd(hit, vMiss, _mm512_mul_pd(_mm512_mul_pd(en, s), vTime)));
+        for(int kk=0; kk<8; kk++)
+            hits.miss[ii+kk] = ((hit>>kk) & 1) ? 0 : 1;
+    }
+#elif defined(__AVX2__)
+    const __m256d vR2 = _mm256_set1_pd(R*R);
+    const __m256d vHalfL = _mm256_set1_pd(L/2.0);
+    const __m256d vMinPt2 = _mm256_set1_pd(kMinPt2);
+    const __m256d vTime = _mm256_set1_pd(1000000.0/light_speed_SI);
+    const __m256d vMiss = _mm256_set1_pd(kMissSentinel);
+    const __m256d vZero = _mm256_setzero_pd();
+    const __m256d vSignBit = _mm256_set1_pd(-0.0);
+    for(; ii+4<=n; ii+=4)
+    {
+        __m256d x0 = _mm256_loadu_pd(&photons.x0[ii]);
+        __m256d y0 = _mm256_loadu_pd(&photons.y0[ii]);
+        __m256d z0 = _mm256_loadu_pd(&photons.z0[ii]);
+        __m256d px = _mm256_loadu_pd(&photons.px[ii]);
+        __m256d py = _mm256_loadu_pd(&photons.py[ii]);
+        __m256d pz = _mm256_loadu_pd(&photons.pz[ii]);
+        __m256d en = _mm256_loadu_pd(&photons.E[ii]);
+        __m256d pt2 = _mm256_add_pd(_mm256_mul_pd(px, px), _mm256_mul_pd(py, py));
+        __m256d b = _mm256_add_pd(_mm256_mul_pd(x0, px), _mm256_mul_pd(y0, py));
+        __m256d c = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(x0, x0), _mm256_mul_pd(y0, y0)), vR2);
+        __m256d delta = _mm256_sub_pd(_mm256_mul_pd(b, b), _mm256_mul_pd(c, pt2));
+        __m256d s = _mm256_div_pd(_mm256_sub_pd(_mm256_sqrt_pd(_mm256_max_pd(delta, vZero)), b), pt2);
+        __m256d hz = _mm256_add_pd(z0, _mm256_mul_pd(pz, s));
+        __m256d hit = _mm256_and_pd(_mm256_cmp_pd(pt2, vMinPt2, _CMP_GT_OQ), _mm256_cmp_pd(delta, vZero, _CMP_GE_OQ));
+        hit = _mm256_and_pd(hit, _mm256_cmp_pd(_mm256_andnot_pd(vSignBit, hz), vHalfL, _CMP_LE_OQ));
+        _mm256_storeu_pd(&hits.x[ii], _mm256_blendv_pd(vMiss, _mm256_add_pd(x0, _mm256_mul_pd(px, s)), hit));
+        _mm256_storeu_pd(&hits.y[ii], _mm256_blendv_pd(vMiss, _mm256_add_pd(y0, _mm256_mul_pd(py, s)), hit));
+        _mm256_storeu_pd(&hits.z[ii], _mm256_blendv_pd(vMiss, hz, hit));
+        _mm256_storeu_pd(&hits.t[ii], _mm256_blendv_pd(vMiss, _mm256_mul_pd(_mm256_mul_pd(en, s), vTime), hit));
+        int bits = _mm256_movemask_pd(hit);
+        for(int kk=0; kk<4; kk++)
+            hits.miss[ii+kk] = ((bits>>kk) & 1) ? 0 : 1;
+    }
+#endif
+    //remainder of the batch (or the whole batch if vector instructions are not available)
+    CalculateHitPointsScalar(photons, R, L, hits, ii);
+}
+
+///
+/// \brief HitKernelInstructionSet Tells which instruction set was compiled in.
+/// \return "AVX-512", "AVX2" or "scalar".
+///
+const char* HitKernelInstructionSet()
+{
+#if defined(__AVX512F__)
+    return "AVX-512";
+#elif defined(__AVX2__)
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+}
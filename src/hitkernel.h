@@ -0,0 +1,52 @@
+/// @file hitkernel.h
+/// @date 19.10.2026
+///
+/// Batch (structure-of-arrays) calculation of hit points on the cylindrical detector's surface.
+/// Vectorized with AVX-512 or AVX2 when the compiler targets them, scalar code is used otherwise and for the remainder.
+#ifndef HITKERNEL_H
+#define HITKERNEL_H
+#include <vector>
+#include <cstddef>
+
+///
+/// \brief The PhotonBatch struct Emission points and fourmomenta of many photons stored as separate arrays.
+///
+struct PhotonBatch
+{
+    std::vector<double> x0; //emission point [mm]
+    std::vector<double> y0;
+    std::vector<double> z0;
+    std::vector<double> px; //momentum [MeV/c]
+    std::vector<double> py;
+    std::vector<double> pz;
+    std::vector<double> E;  //energy [MeV]
+
+    inline std::size_t Size() const {return x0.size();}
+    void Clear();
+    void Reserve(std::size_t n);
+    void Push(double x, double y, double z, double momX, double momY, double momZ, double energy);
+};
+
+///
+/// \brief The HitBatch struct Results of the hit point calculation, one entry per photon from PhotonBatch.
+///
+struct HitBatch
+{
+    std::vector<double> x; //hit point [mm]
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> t; //hit time, same units as in Event
+    std::vector<unsigned char> miss; //1 if photon missed the detector
+
+    inline std::size_t Size() const {return x.size();}
+    void Resize(std::size_t n);
+};
+
+//calculates hit points of all photons from the batch on a barrel with radius R and length L
+void CalculateHitPointsBatch(const PhotonBatch& photons, double R, double L, HitBatch& hits);
+//reference implementation without vector instructions, used for the remainder of the batch and in tests
+void CalculateHitPointsScalar(const PhotonBatch& photons, double R, double L, HitBatch& hits, std::size_t first=0);
+//name of the instruction set used by CalculateHitPointsBatch
+const char* HitKernelInstructionSet();
+
+#endif // HITKERNEL_H
@@ -8,348 +8,234 @@
 #include "TImage.h"
 #include "TLegend.h"
 #include "TText.h"
+#include "TMath.h"
+#include "hitkernel.h"
 #include "initialcuts.h"
 
 unsigned InitialCuts::objectID_ = 1;
 
+namespace
+{
+    ///
+    /// \brief EnergyOrder Finds gammas with the lowest, middle and highest energy out of gammas that can be used to reconstruct an event.
+    /// \param event Pointer to Event object.
+    /// \param indices Output array: indices of min, mid and max energy gamma.
+    ///
+    void EnergyOrder(const Event* event, int* indices)
+    {
+        int minIndex=0;
+        int maxIndex=0;
+        for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
+        {
+            if(ii==2 && (event->GetDecayType()==TWOandONE || event->GetDecayType()==TWOandN))
+                break; //prompt gamma is not used to reconstruct an event
+            minIndex = event->GetFourMomentumOf(ii)->E() < event->GetFourMomentumOf(minIndex)->E() ? ii : minIndex;
+            maxIndex = event->GetFourMomentumOf(ii)->E() > event->GetFourMomentumOf(maxIndex)->E() ? ii : maxIndex;
+        }
+        indices[0] = minIndex;
+        indices[1] = minIndex==maxIndex ? minIndex : 3-minIndex-maxIndex;
+        indices[2] = maxIndex;
+    }
+
+    ///
+    /// \brief AddRelativeAngleHistograms Declares histograms with relative angles for events that passed or failed cuts.
+    /// \param registry Registry where histograms are declared.
+    /// \param type Type of the decay.
+    /// \param suffix "pass" or "fail".
+    /// \param group PASS_HISTOGRAMS or FAIL_HISTOGRAMS.
+    ///
+    void AddRelativeAngleHistograms(HistogramRegistry& registry, DecayType type, const std::string& suffix, unsigned group)
+    {
+        unsigned groups = ANGLE_HISTOGRAMS | group;
+        if(type == THREE)
+        {
+            registry.AddEventHistogram(Histogram2D("fH_12_23_"+suffix+"_", groups, 50, 0, 3.15, 50, 0, 3.15)\
+                .Titles("Polar angle distr, 12 vs 23", "#theta_{12} [rad]", "#theta_{23} [rad]").TitleOffsets(1.4, 1.4),\
+                [](HistogramFiller& h, const Event* event){h.Fill(RelativeAngle(event, 0, 1), RelativeAngle(event, 1, 2), event->GetWeight());});
+            registry.AddEventHistogram(Histogram2D("fH_12_31_"+suffix+"_", groups, 50, 0, 3.15, 50, 0, 3.15)\
+                .Titles("Polar angle distr, 12 vs 31", "#theta_{12} [rad]", "#theta_{31} [rad]").TitleOffsets(1.4, 1.4),\
+                [](HistogramFiller& h, const Event* event){h.Fill(RelativeAngle(event, 0, 1), RelativeAngle(event, 2, 0), event->GetWeight());});
+            registry.AddEventHistogram(Histogram2D("fH_23_31_"+suffix+"_", groups, 50, 0, 3.15, 50, 0, 3.15)\
+                .Titles("Polar angle distr, 23 vs 31", "#theta_{23} [rad]", "#theta_{31} [rad]").TitleOffsets(1.4, 1.4),\
+                [](HistogramFiller& h, const Event* event){h.Fill(RelativeAngle(event, 1, 2), RelativeAngle(event, 2, 0), event->GetWeight());});
+        }
+        else if(type == TWO || type == TWOandONE || type == TWOandN)
+        {
+            HistogramDef def12 = Histogram1D("fH_12_"+suffix+"_", groups, 19, 3.13, 3.15);
+            if(type == TWO)
+                def12 = Histogram1D("fH_12_"+suffix+"_", groups, 20, 3.13, 3.15);
+            else if(type == TWOandN)
+                def12 = Histogram1D("fH_12_"+suffix+"_", groups, 19, 3.1, 3.2);
+            def12.Titles(type==TWOandONE ? "Polar angle distribution between gamma1 and gamma2" : "Distribution of polar angle between 2 gammas",\
+                         "#theta_{12} [rad]", "dN/d#theta_{12}").TitleOffsets(1.4, 1.4).FillColor(kBlue).Divisions(5);
+            registry.AddEventHistogram(def12,\
+                [](HistogramFiller& h, const Event* event){h.Fill(RelativeAngle(event, 0, 1), event->GetWeight());});
+        }
+        if(type == TWOandONE)
+        {
+            registry.AddEventHistogram(Histogram1D("fH_23_"+suffix+"_", groups, 50, 0.0, 3.15)\
+                .Titles("Polar angle distribution between gamma2 and gamma3", "#theta_{23} [rad]", "dN/d#theta_{23}")\
+                .TitleOffsets(1.4, 1.4).FillColor(kBlue).Divisions(5),\
+                [](HistogramFiller& h, const Event* event){if(event->GetNumberOfDecayProducts()>2) h.Fill(RelativeAngle(event, 1, 2), event->GetWeight());});
+            registry.AddEventHistogram(Histogram1D("fH_31_"+suffix+"_", groups, 50, 0.0, 3.15)\
+                .Titles("Polar angle distribution between gamma1 and gamma3", "#theta_{31} [rad]", "dN/d#theta_{31}")\
+                .TitleOffsets(1.4, 1.4).FillColor(kBlue).Divisions(5),\
+                [](HistogramFiller& h, const Event* event){if(event->GetNumberOfDecayProducts()>2) h.Fill(RelativeAngle(event, 2, 0), event->GetWeight());});
+        }
+    }
+
+    ///
+    /// \brief AddDistributionHistograms Declares histograms with E, p, phi and cos(theta) of gammas that passed or failed cuts.
+    /// \param registry Registry where histograms are declared.
+    /// \param nEn Number of bins of energy and momentum histograms.
+    /// \param enMin Lower limit of energy and momentum histograms.
+    /// \param enMax Upper limit of energy and momentum histograms.
+    /// \param suffix "pass" or "fail".
+    /// \param group PASS_HISTOGRAMS or FAIL_HISTOGRAMS.
+    ///
+    void AddDistributionHistograms(HistogramRegistry& registry, int nEn, double enMin, double enMax, const std::string& suffix, unsigned group)
+    {
+        registry.AddPhotonHistogram(Histogram1D("fH_en_"+suffix+"_", ENERGY_HISTOGRAMS | group, nEn, enMin, enMax)\
+            .Titles("Energy distribution", "E [MeV]", "dN/dE").TitleOffsets(1.6, 1.8).FillColor(kBlue),\
+            [](HistogramFiller& h, const Event* event, int ii){h.Fill(event->GetFourMomentumOf(ii)->Energy());});
+        registry.AddPhotonHistogram(Histogram1D("fH_p_"+suffix+"_", ENERGY_HISTOGRAMS | group, nEn, enMin, enMax)\
+            .Titles("Momentum distribution", "p [MeV/c]", "dN/dp").TitleOffsets(1.6, 1.8).FillColor(kBlue),\
+            [](HistogramFiller& h, const Event* event, int ii){h.Fill(event->GetFourMomentumOf(ii)->P());});
+        registry.AddPhotonHistogram(Histogram1D("fH_phi_"+suffix+"_", ANGLE_HISTOGRAMS | group, 52, -3.2, 3.2)\
+            .Titles("Azimuthal angle distribution", "#phi [rad]", "dN/d #phi").TitleOffsets(1.6, 1.8).FillColor(kBlue),\
+            [](HistogramFiller& h, const Event* event, int ii){h.Fill(event->GetFourMomentumOf(ii)->Phi());});
+        registry.AddPhotonHistogram(Histogram1D("fH_cosTheta_"+suffix+"_", ANGLE_HISTOGRAMS | group, 52, -1.01, 1.01)\
+            .Titles("Cosine of polar angle distribution", "cos(#theta)", "dN/d cos(#theta)").TitleOffsets(1.6, 1.8).FillColor(kBlue),\
+            [](HistogramFiller& h, const Event* event, int ii){h.Fill(event->GetFourMomentumOf(ii)->CosTheta());});
+    }
+}
+
 ///
 /// \brief InitialCuts::InitialCuts The only constructor used.
 /// \param type Type of the decay, can be: TWO, THREE or TWOandONE.
 /// \param R Radius of the detector.
 /// \param L Length of the detector.
 /// \param p Probability to interacti with scintillator.
+/// \param histogramGroups Groups of histograms to be booked, see HistogramGroup.
 ///
-InitialCuts::InitialCuts(DecayType type, float R, float L, float p) :
+InitialCuts::InitialCuts(DecayType type, float R, float L, float p, unsigned histogramGroups) :
     fDecayType_(type),
     fR_(R),
     fL_(L),
+    fGeometry_(nullptr),
     fDetectionProbability_(p),
     fAcceptedEvents_(0),
     fAcceptedGammas_(0),
     fNumberOfEvents_(0),
-    fNumberOfGammas_(0)
+    fNumberOfGammas_(0),
+    fRegistry_(histogramGroups, std::to_string(type)+"_"+std::to_string(objectID_))
 {
-    fH_12_pass_=nullptr;
-    fH_12_fail_=nullptr;
-    fH_23_pass_=nullptr;
-    fH_23_fail_=nullptr;
-    fH_31_pass_=nullptr;
-    fH_31_fail_=nullptr;
-    fH_12_23_pass_ = nullptr;
-    fH_12_31_pass_ = nullptr;
-    fH_23_31_pass_ = nullptr;
-    fH_12_23_fail_ = nullptr;
-    fH_12_31_fail_ = nullptr;
-    fH_23_31_fail_ = nullptr;
-    fH_en_pass_mid_ = nullptr;
-
-    //Creating histograms for angle distributions
+    int nEn = 52; //binning of energy and momentum histograms
+    double enMin = 0.0;
+    double enMax = 0.6;
+    HistogramDef defEvent = Histogram1D("fH_en_pass_event_", ENERGY_HISTOGRAMS | PASS_HISTOGRAMS, 19, 0.510, 0.512);
     if(type==THREE)
     {
         fTypeString_="3";
-
-        fH_en_pass_ = new TH1F((std::string("fH_en_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.0, 0.6);
-        fH_p_pass_ = new TH1F((std::string("fH_p_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_p_", 52, 0.0, 0.6);
-        fH_en_fail_ = new TH1F((std::string("fH_en_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.0, 0.6);
-        fH_p_fail_ = new TH1F((std::string("fH_p_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_p_", 52, 0.0, 0.6);
-
-        // histograms for events tha passed cuts
-        fH_12_23_pass_ = new TH2F((std::string("fH_12_23_pass_")+std::to_string(objectID_)).c_str(),"fH_12_23_pass", 50,0, 3.15, 50,0,3.15);
-        fH_12_23_pass_ -> SetTitle("Polar angle distr, 12 vs 23");
-        fH_12_23_pass_ -> GetXaxis()->SetTitle("#theta_{12} [rad]");
-        fH_12_23_pass_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_12_23_pass_ -> GetYaxis()->SetTitle("#theta_{23} [rad]");
-        fH_12_23_pass_ -> GetYaxis()->SetTitleOffset(1.4);
-
-        fH_12_31_pass_ = new TH2F(("fH_12_31_pass"+std::to_string(objectID_)).c_str(),"fH_12_31_pass", 50,0, 3.15, 50,0,3.15);
-        fH_12_31_pass_ -> SetTitle("Polar angle distr, 12 vs 31");
-        fH_12_31_pass_ -> GetXaxis()->SetTitle("#theta_{12} [rad]");
-        fH_12_31_pass_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_12_31_pass_ -> GetYaxis()->SetTitle("#theta_{31} [rad]");
-        fH_12_31_pass_ -> GetYaxis()->SetTitleOffset(1.4);
-
-        fH_23_31_pass_ = new TH2F(("fH_23_31_pass"+std::to_string(objectID_)).c_str(),"fH_23_31_pass", 50,0, 3.15, 50,0,3.15);
-        fH_23_31_pass_ -> SetTitle("Polar angle distr, 23 vs 31");
-        fH_23_31_pass_ -> GetXaxis()->SetTitle("#theta_{23} [rad]");
-        fH_23_31_pass_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_23_31_pass_ -> GetYaxis()->SetTitle("#theta_{31} [rad]");
-        fH_23_31_pass_ -> GetYaxis()->SetTitleOffset(1.4);
-
-        //histograms for events that failed cuts
-        fH_12_23_fail_ = new TH2F(("fH_12_23_fail"+std::to_string(objectID_)).c_str(),"fH_12_23_fail", 50,0, 3.15, 50,0,3.15);
-        fH_12_23_fail_ -> SetTitle("Polar angle distr, 12 vs 23");
-        fH_12_23_fail_ -> GetXaxis()->SetTitle("#theta_{12} [rad]");
-        fH_12_23_fail_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_12_23_fail_ -> GetYaxis()->SetTitle("#theta_{23} [rad]");
-        fH_12_23_fail_ -> GetYaxis()->SetTitleOffset(1.4);
-
-        fH_12_31_fail_ = new TH2F(("fH_12_31_fail"+std::to_string(objectID_)).c_str(),"fH_12_31_fail", 50,0, 3.15, 50,0,3.15);
-        fH_12_31_fail_ -> SetTitle("Polar angle distr, 12 vs 31");
-        fH_12_31_fail_ -> GetXaxis()->SetTitle("#theta_{12} [rad]");
-        fH_12_31_fail_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_12_31_fail_ -> GetYaxis()->SetTitle("#theta_{31} [rad]");
-        fH_12_31_fail_ -> GetYaxis()->SetTitleOffset(1.4);
-
-        fH_23_31_fail_ = new TH2F(("fH_23_31_fail"+std::to_string(objectID_)).c_str(),"fH_23_31_fail", 50,0, 3.15, 50,0,3.15);
-        fH_23_31_fail_ -> SetTitle("Polar angle distr, 23 vs 31");
-        fH_23_31_fail_ -> GetXaxis()->SetTitle("#theta_{23} [rad]");
-        fH_23_31_fail_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_23_31_fail_ -> GetYaxis()->SetTitle("#theta_{31} [rad]");
-        fH_23_31_fail_ -> GetYaxis()->SetTitleOffset(1.4);
-
-        fH_en_pass_low_ = new TH1F((std::string("fH_en_pass_LOW")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.0, 0.6);
-        fH_en_pass_high_ = new TH1F((std::string("fH_en_pass_HIGH")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.0, 0.6);
-        fH_en_pass_event_ = new TH1F((std::string("fH_en_pass_event")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.0, 0.6);
-        fH_en_pass_mid_ = new TH1F((std::string("fH_en_pass_MID")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.0, 0.6);
-        fH_en_pass_mid_ -> SetTitle("Energy distribution, mid energy gammas");
-        fH_en_pass_mid_ -> GetXaxis()->SetTitle("E [MeV]");
-        fH_en_pass_mid_ -> GetXaxis()->SetTitleOffset(1.6);
-        fH_en_pass_mid_ -> GetYaxis()->SetTitle("dN/dE");
-        fH_en_pass_mid_ -> GetYaxis()->SetTitleOffset(2.);
+        defEvent = Histogram1D("fH_en_pass_event_", ENERGY_HISTOGRAMS | PASS_HISTOGRAMS, 52, 0.0, 0.6);
     }
     else if(type==TWO)
-    {
         fTypeString_ = "2";
-
-        fH_en_pass_ = new TH1F((std::string("fH_en_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.0, 0.6);
-        fH_p_pass_ = new TH1F((std::string("fH_p_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_p_", 52, 0.0, 0.6);
-        fH_en_fail_ = new TH1F((std::string("fH_en_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.0, 0.6);
-        fH_p_fail_ = new TH1F((std::string("fH_p_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_p_", 52, 0.0, 0.6);
-
-        fH_en_pass_low_ = new TH1F((std::string("fH_en_pass_LOW")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 19, 0.510, 0.512);
-        fH_en_pass_low_->GetXaxis()->SetNdivisions(5, false);
-        fH_en_pass_high_ = new TH1F((std::string("fH_en_pass_HIGH")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 19, 0.510, 0.512);
-        fH_en_pass_high_->GetXaxis()->SetNdivisions(5, false);
-        fH_en_pass_event_ = new TH1F((std::string("fH_en_pass_event")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 19, 0.510, 0.512);
-        fH_en_pass_event_->GetXaxis()->SetNdivisions(5, false);
-
-        //histogram for events that passed cuts
-        fH_12_pass_ = new TH1F(("fH_12_pass"+std::to_string(objectID_)).c_str(), "fH_12_pass", 20, 3.13, 3.15);
-        fH_12_pass_->SetFillColor(kBlue);
-        fH_12_pass_ -> SetTitle("Distribution of polar angle between 2 gammas");
-        fH_12_pass_ -> GetXaxis()->SetNdivisions(5, false);
-        fH_12_pass_ -> GetXaxis()->SetTitle("#theta_{12} [rad]");
-        fH_12_pass_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_12_pass_ -> GetYaxis()->SetTitle("dN/d#theta_{12}");
-        fH_12_pass_ -> GetYaxis()->SetTitleOffset(1.4);
-        // histogram for events that did not passed cuts
-        fH_12_fail_ = new TH1F(("fH_12_fail"+std::to_string(objectID_)).c_str(), "fH_12_fail", 20, 3.13, 3.15);
-        fH_12_fail_->SetFillColor(kBlue);
-        fH_12_fail_ -> SetTitle("Distribution of polar angle between 2 gammas");
-        fH_12_fail_ -> GetXaxis()->SetNdivisions(5, false);
-        fH_12_fail_ -> GetXaxis()->SetTitle("#theta_{12} [rad]");
-        fH_12_fail_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_12_fail_ -> GetYaxis()->SetTitle("dN/d#theta_{12}");
-        fH_12_fail_ -> GetYaxis()->SetTitleOffset(1.4);
-    }
     else if(type==TWOandONE)
     {
         fTypeString_ = "2&1";
-
-        fH_en_pass_ = new TH1F((std::string("fH_en_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.3, 1.3);
-        fH_p_pass_ = new TH1F((std::string("fH_p_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_p_", 52, 0.3, 1.3);
-        fH_en_fail_ = new TH1F((std::string("fH_en_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.3, 1.3);
-        fH_p_fail_ = new TH1F((std::string("fH_p_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_p_", 52, 0.3, 1.3);
-
-        fH_en_pass_low_ = new TH1F((std::string("fH_en_pass_LOW")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 19, 0.510, 0.512);
-        fH_en_pass_low_->GetXaxis()->SetNdivisions(5, false);
-        fH_en_pass_high_ = new TH1F((std::string("fH_en_pass_HIGH")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 19, 0.510, 0.512);
-        fH_en_pass_high_->GetXaxis()->SetNdivisions(5, false);
-        fH_en_pass_event_ = new TH1F((std::string("fH_en_pass_event")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 19, 0.510, 0.512);
-        fH_en_pass_event_->GetXaxis()->SetNdivisions(5, false);
-        //histograms for events that passed cuts
-        fH_12_pass_ = new TH1F(("fH_12_pass"+std::to_string(objectID_)).c_str(), "fH_12_pass", 19, 3.13, 3.15);
-        fH_12_pass_->SetFillColor(kBlue);
-        fH_12_pass_ -> SetTitle("Polar angle distribution between gamma1 and gamma2");
-        fH_12_pass_ -> GetXaxis()->SetNdivisions(5, false);
-        fH_12_pass_ -> GetXaxis()->SetTitle("#theta_{12} [rad]");
-        fH_12_pass_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_12_pass_ -> GetYaxis()->SetTitle("dN/d#theta_{12}");
-        fH_12_pass_ -> GetYaxis()->SetTitleOffset(1.4);
-        fH_23_pass_ = new TH1F(("fH_23_pass"+std::to_string(objectID_)).c_str(), "fH_23_pass", 50, 0.0, 3.15);
-        fH_23_pass_->SetFillColor(kBlue);
-        fH_23_pass_ -> SetTitle("Polar angle distribution between gamma2 and gamma3");
-        fH_23_pass_ -> GetXaxis()->SetNdivisions(5, false);
-        fH_23_pass_ -> GetXaxis()->SetTitle("#theta_{23} [rad]");
-        fH_23_pass_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_23_pass_ -> GetYaxis()->SetTitle("dN/d#theta_{23}");
-        fH_23_pass_ -> GetYaxis()->SetTitleOffset(1.4);
-        fH_31_pass_ = new TH1F(("fH_31_pass"+std::to_string(objectID_)).c_str(), "fH_31_pass", 50, 0.0, 3.15);
-        fH_31_pass_->SetFillColor(kBlue);
-        fH_31_pass_ -> SetTitle("Polar angle distribution between gamma1 and gamma3");
-        fH_31_pass_ -> GetXaxis()->SetNdivisions(5, false);
-        fH_31_pass_ -> GetXaxis()->SetTitle("#theta_{31} [rad]");
-        fH_31_pass_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_31_pass_ -> GetYaxis()->SetTitle("dN/d#theta_{31}");
-        fH_31_pass_ -> GetYaxis()->SetTitleOffset(1.4);
-        // histogram for events that did not passed cuts
-        fH_12_fail_ = new TH1F(("fH_12_fail"+std::to_string(objectID_)).c_str(), "fH_12_fail", 19, 3.13, 3.15);
-        fH_12_fail_->SetFillColor(kBlue);
-        fH_12_fail_ -> SetTitle("Polar angle distribution between gamma1 and gamma2");
-        fH_12_fail_ -> GetXaxis()->SetNdivisions(5, false);
-        fH_12_fail_ -> GetXaxis()->SetTitle("#theta_{12} [rad]");
-        fH_12_fail_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_12_fail_ -> GetYaxis()->SetTitle("dN/d#theta_{12}");
-        fH_12_fail_ -> GetYaxis()->SetTitleOffset(1.4);
-        fH_23_fail_ = new TH1F(("fH_23_fail"+std::to_string(objectID_)).c_str(), "fH_23_fail", 50, 0.0, 3.15);
-        fH_23_fail_->SetFillColor(kBlue);
-        fH_23_fail_ -> SetTitle("Polar angle distribution between gamma2 and gamma3");
-        fH_23_fail_ -> GetXaxis()->SetNdivisions(5, false);
-        fH_23_fail_ -> GetXaxis()->SetTitle("#theta_{23} [rad]");
-        fH_23_fail_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_23_fail_ -> GetYaxis()->SetTitle("dN/d#theta_{23}");
-        fH_23_fail_ -> GetYaxis()->SetTitleOffset(1.4);
-        fH_31_fail_ = new TH1F(("fH_31_fail"+std::to_string(objectID_)).c_str(), "fH_31_fail", 50, 0.0, 3.15);
-        fH_31_fail_->SetFillColor(kBlue);
-        fH_31_fail_ -> SetTitle("Polar angle distribution between gamma1 and gamma3");
-        fH_31_fail_ -> GetXaxis()->SetNdivisions(5, false);
-        fH_31_fail_ -> GetXaxis()->SetTitle("#theta_{31} [rad]");
-        fH_31_fail_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_31_fail_ -> GetYaxis()->SetTitle("dN/d#theta_{31}");
-        fH_31_fail_ -> GetYaxis()->SetTitleOffset(1.4);
+        enMin = 0.3;
+        enMax = 1.3;
     }
     else if(type==TWOandN)
     {
         fTypeString_ = "2&N";
-
-        fH_en_pass_ = new TH1F((std::string("fH_en_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 104, 0.0, 4.0);
-        fH_p_pass_ = new TH1F((std::string("fH_p_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_p_", 104, 0.0, 4.0);
-        fH_en_fail_ = new TH1F((std::string("fH_en_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 104, 0.0, 4.0);
-        fH_p_fail_ = new TH1F((std::string("fH_p_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_p_", 104, 0.0, 4.0);
-
-        fH_en_pass_low_ = new TH1F((std::string("fH_en_pass_LOW")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 29, 0.4, 0.6);
-        fH_en_pass_low_->GetXaxis()->SetNdivisions(5, false);
-        fH_en_pass_high_ = new TH1F((std::string("fH_en_pass_HIGH")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 29, 0.4, 0.6);
-        fH_en_pass_high_->GetXaxis()->SetNdivisions(5, false);
-        fH_en_pass_event_ = new TH1F((std::string("fH_en_pass_event")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 29, 0.4, 0.6);
-        fH_en_pass_event_->GetXaxis()->SetNdivisions(5, false);
-
-        //histogram for events that passed cuts
-        fH_12_pass_ = new TH1F(("fH_12_pass"+std::to_string(objectID_)).c_str(), "fH_12_pass", 19, 3.1, 3.2);
-        fH_12_pass_->SetFillColor(kBlue);
-        fH_12_pass_ -> SetTitle("Distribution of polar angle between 2 gammas");
-        fH_12_pass_ -> GetXaxis()->SetNdivisions(5, false);
-        fH_12_pass_ -> GetXaxis()->SetTitle("#theta_{12} [rad]");
-        fH_12_pass_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_12_pass_ -> GetYaxis()->SetTitle("dN/d#theta_{12}");
-        fH_12_pass_ -> GetYaxis()->SetTitleOffset(1.4);
-        // histogram for events that did not passed cuts
-        fH_12_fail_ = new TH1F(("fH_12_fail"+std::to_string(objectID_)).c_str(), "fH_12_fail", 19, 3.1, 3.2);
-        fH_12_fail_->SetFillColor(kBlue);
-        fH_12_fail_ -> SetTitle("Distribution of polar angle between 2 gammas");
-        fH_12_fail_ -> GetXaxis()->SetNdivisions(5, false);
-        fH_12_fail_ -> GetXaxis()->SetTitle("#theta_{12} [rad]");
-        fH_12_fail_ -> GetXaxis()->SetTitleOffset(1.4);
-        fH_12_fail_ -> GetYaxis()->SetTitle("dN/d#theta_{12}");
-        fH_12_fail_ -> GetYaxis()->SetTitleOffset(1.4);
+        nEn = 104;
+        enMax = 4.0;
+        defEvent = Histogram1D("fH_en_pass_event_", ENERGY_HISTOGRAMS | PASS_HISTOGRAMS, 29, 0.4, 0.6);
     }
     else if(fDecayType_ == ONE)
     {
         fTypeString_ = "1";
-        fH_en_pass_ = new TH1F((std::string("fH_en_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.0, 2.0);
-        fH_p_pass_ = new TH1F((std::string("fH_p_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_p_", 52, 0.0, 2.0);
-        fH_en_fail_ = new TH1F((std::string("fH_en_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 52, 0.0, 2.0);
-        fH_p_fail_ = new TH1F((std::string("fH_p_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_p_", 52, 0.0, 2.0);
-
-        fH_en_pass_low_ = new TH1F((std::string("fH_en_pass_LOW")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 19, 0.0, 2.0);
-        fH_en_pass_low_->GetXaxis()->SetNdivisions(5, false);
-        fH_en_pass_high_ = new TH1F((std::string("fH_en_pass_HIGH")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 19, 0.0, 2.0);
-        fH_en_pass_high_->GetXaxis()->SetNdivisions(5, false);
-        fH_en_pass_event_ = new TH1F((std::string("fH_en_pass_event")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_en_", 19, 0.0, 2.0);
-        fH_en_pass_event_->GetXaxis()->SetNdivisions(5, false);
+        enMax = 2.0;
+        defEvent = Histogram1D("fH_en_pass_event_", ENERGY_HISTOGRAMS | PASS_HISTOGRAMS, 19, 0.0, 2.0);
     }
     else
     {
         throw(std::string("Invalid no of decay products!"));
     }
-    //histograms for particles that passed through cuts
-    fH_en_pass_->SetFillColor(kBlue);
-    fH_en_pass_ -> SetTitle("Energy distribution");
-    fH_en_pass_ -> GetXaxis()->SetTitle("E [MeV]");
-    fH_en_pass_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_en_pass_ -> GetYaxis()->SetTitle("dN/dE");
-    fH_en_pass_ -> GetYaxis()->SetTitleOffset(1.8);
-    fH_p_pass_->SetFillColor(kBlue);
-    fH_p_pass_ -> SetTitle("Momentum distribution");
-    fH_p_pass_ -> GetXaxis()->SetTitle("p [MeV/c]");
-    fH_p_pass_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_p_pass_ -> GetYaxis()->SetTitle("dN/dp");
-    fH_p_pass_ -> GetYaxis()->SetTitleOffset(1.8);
-    fH_phi_pass_ = new TH1F((std::string("fH_phi_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_phi_", 52, -3.2, 3.2);
-    fH_phi_pass_->SetFillColor(kBlue);
-    fH_phi_pass_ -> SetTitle("Azimuthal angle distribution");
-    fH_phi_pass_ -> GetXaxis()->SetTitle("#phi [rad]");
-    fH_phi_pass_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_phi_pass_ -> GetYaxis()->SetTitle("dN/d #phi");
-    fH_phi_pass_ -> GetYaxis()->SetTitleOffset(1.8);
-    fH_cosTheta_pass_ = new TH1F((std::string("fH_cosTheta_pass_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_cosTheta_", 52, -1.01, 1.01);
-    fH_cosTheta_pass_->SetFillColor(kBlue);
-    fH_cosTheta_pass_ -> SetTitle("Cosine of polar angle distribution");
-    fH_cosTheta_pass_ -> GetXaxis()->SetTitle("cos(#theta)");
-    fH_cosTheta_pass_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_cosTheta_pass_ -> GetYaxis()->SetTitle("dN/d cos(#theta)");
-    fH_cosTheta_pass_ -> GetYaxis()->SetTitleOffset(1.8);
+    if(type!=THREE)
+        defEvent.Divisions(5);
+    defEvent.Titles("Energy distribution", "E [MeV]", "dN/dE").TitleOffsets(1.6, 1.8);
 
-    //histograms for particles that did not pass through cuts
-    fH_en_fail_->SetFillColor(kBlue);
-    fH_en_fail_ -> SetTitle("Energy distribution");
-    fH_en_fail_ -> GetXaxis()->SetTitle("E [MeV]");
-    fH_en_fail_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_en_fail_ -> GetYaxis()->SetTitle("dN/dE");
-    fH_en_fail_ -> GetYaxis()->SetTitleOffset(1.8);
-    fH_p_fail_->SetFillColor(kBlue);
-    fH_p_fail_ -> SetTitle("Momentum distribution");
-    fH_p_fail_ -> GetXaxis()->SetTitle("p [MeV/c]");
-    fH_p_fail_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_p_fail_ -> GetYaxis()->SetTitle("dN/dp");
-    fH_p_fail_ -> GetYaxis()->SetTitleOffset(1.8);
-    fH_phi_fail_ = new TH1F((std::string("fH_phi_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_phi_", 52, -3.2, 3.2);
-    fH_phi_fail_->SetFillColor(kBlue);
-    fH_phi_fail_ -> SetTitle("Azimuthal angle distribution");
-    fH_phi_fail_ -> GetXaxis()->SetTitle("#phi [rad]");
-    fH_phi_fail_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_phi_fail_ -> GetYaxis()->SetTitle("dN/d #phi");
-    fH_phi_fail_ -> GetYaxis()->SetTitleOffset(1.8);
-    fH_cosTheta_fail_ = new TH1F((std::string("fH_cosTheta_fail_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(), "fH_cosTheta_", 52, -1.01, 1.01);
-    fH_cosTheta_fail_->SetFillColor(kBlue);
-    fH_cosTheta_fail_ -> SetTitle("Cosine of polar angle distribution");
-    fH_cosTheta_fail_ -> GetXaxis()->SetTitle("cos(#theta)");
-    fH_cosTheta_fail_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_cosTheta_fail_ -> GetYaxis()->SetTitle("dN/d cos(#theta)");
-    fH_cosTheta_fail_ -> GetYaxis()->SetTitleOffset(1.8);
+    //histograms for gammas and events that passed or failed cuts
+    AddDistributionHistograms(fRegistry_, nEn, enMin, enMax, "pass", PASS_HISTOGRAMS);
+    AddDistributionHistograms(fRegistry_, nEn, enMin, enMax, "fail", FAIL_HISTOGRAMS);
+    AddRelativeAngleHistograms(fRegistry_, type, "pass", PASS_HISTOGRAMS);
+    AddRelativeAngleHistograms(fRegistry_, type, "fail", FAIL_HISTOGRAMS);
 
     //histograms for gammas that passed through cuts, differentation for low, mid and high energy gammas
-    fH_en_pass_event_ -> SetTitle("Energy distribution");
-    fH_en_pass_event_ -> GetXaxis()->SetTitle("E [MeV]");
-    fH_en_pass_event_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_en_pass_event_ -> GetYaxis()->SetTitle("dN/dE");
-    fH_en_pass_event_ -> GetYaxis()->SetTitleOffset(1.8);
-    fH_en_pass_low_ -> SetTitle("Energy distribution, low energy gammas");
-    fH_en_pass_low_ -> GetXaxis()->SetTitle("E [MeV]");
-    fH_en_pass_low_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_en_pass_low_ -> GetYaxis()->SetTitle("dN/dE");
-    fH_en_pass_low_ -> GetYaxis()->SetTitleOffset(1.8);
-    fH_en_pass_high_ -> SetTitle("Energy distribution, high energy gammas");
-    fH_en_pass_high_ -> GetXaxis()->SetTitle("E [MeV]");
-    fH_en_pass_high_ -> GetXaxis()->SetTitleOffset(1.6);
-    fH_en_pass_high_ -> GetYaxis()->SetTitle("dN/dE");
-    fH_en_pass_high_ -> GetYaxis()->SetTitleOffset(1.8);
+    fRegistry_.AddEventHistogram(defEvent,\
+        [](HistogramFiller& h, const Event* event)
+        {
+            for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
+            {
+                if(ii==2 && (event->GetDecayType()==TWOandONE || event->GetDecayType()==TWOandN))
+                    break;
+                h.Fill(event->GetFourMomentumOf(ii)->Energy());
+            }
+        });
+    HistogramDef defLow = defEvent;
+    defLow.key = "fH_en_pass_low_";
+    defLow.title = "Energy distribution, low energy gammas";
+    fRegistry_.AddEventHistogram(defLow,\
+        [](HistogramFiller& h, const Event* event){int ind[3]; EnergyOrder(event, ind); h.Fill(event->GetFourMomentumOf(ind[0])->Energy());});
+    HistogramDef defHigh = defEvent;
+    defHigh.key = "fH_en_pass_high_";
+    defHigh.title = "Energy distribution, high energy gammas";
+    fRegistry_.AddEventHistogram(defHigh,\
+        [](HistogramFiller& h, const Event* event){int ind[3]; EnergyOrder(event, ind); h.Fill(event->GetFourMomentumOf(ind[2])->Energy());});
+    if(type==THREE)
+    {
+        HistogramDef defMid = defEvent;
+        defMid.key = "fH_en_pass_mid_";
+        defMid.title = "Energy distribution, mid energy gammas";
+        defMid.TitleOffsets(1.6, 2.0);
+        fRegistry_.AddEventHistogram(defMid,\
+            [](HistogramFiller& h, const Event* event){int ind[3]; EnergyOrder(event, ind); h.Fill(event->GetFourMomentumOf(ind[1])->Energy());});
+    }
 
     //histograms to monitor cuts passing
-    fH_event_cuts_ = new TH1F((std::string("fH_event_cuts_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(),\
-            "fH_event_cuts_", 3, 0.0, 3.0);
-    fH_event_cuts_->SetTitle("Passing cuts by events");
-    fH_event_cuts_->GetYaxis()->SetTitle("% passed");
-    fH_event_cuts_->GetYaxis()->SetTitleOffset(1.4);
-    fH_event_cuts_->GetXaxis()->SetLabelSize(0);
-    fH_event_cuts_->GetXaxis()->SetTickLength(0);
-    fH_gamma_cuts_ = new TH1F((std::string("fH_gamma_cuts_")+std::to_string(fDecayType_)+std::to_string(objectID_)).c_str(),\
-            "fH_gamma_cuts_", 3, 0.0, 3.0);
-    fH_gamma_cuts_->SetTitle("Passing cuts by gammas");
-    fH_gamma_cuts_->GetYaxis()->SetTitle("% passed");
-    fH_gamma_cuts_->GetYaxis()->SetTitleOffset(1.4);
-    fH_gamma_cuts_->GetXaxis()->SetLabelSize(0);
-    fH_gamma_cuts_->GetXaxis()->SetTickLength(0);
+    fRegistry_.AddEventHistogram(Histogram1D("fH_event_cuts_", CUTS_HISTOGRAMS, 3, 0.0, 3.0)\
+        .Titles("Passing cuts by events", "", "% passed").TitleOffsets(0.0, 1.4).HideXLabels(),\
+        [](HistogramFiller& h, const Event* event)
+        {
+            bool geo_event_pass = true;
+            bool inter_event_pass = true;
+            for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
+            {
+                if(ii>=2 && event->GetDecayType() != THREE) // gammas from deexcitation are not required to reconstruct event
+                    continue;
+                geo_event_pass &= event->GetHitPhiOf(ii)!=-4;
+                inter_event_pass &= event->GetCutPassingOf(ii);
+            }
+            h.Fill(0); //events at the beginning
+            if(geo_event_pass)
+                h.Fill(1);
+            if(inter_event_pass)
+                h.Fill(2);
+        });
+    fRegistry_.AddPhotonHistogram(Histogram1D("fH_gamma_cuts_", CUTS_HISTOGRAMS, 3, 0.0, 3.0)\
+        .Titles("Passing cuts by gammas", "", "% passed").TitleOffsets(0.0, 1.4).HideXLabels(),\
+        [](HistogramFiller& h, const Event* event, int ii)
+        {
+            h.Fill(0); //gammas at the beginning
+            if(event->GetHitPhiOf(ii)!=-4)
+                h.Fill(1);
+            if(event->GetCutPassingOf(ii))
+                h.Fill(2);
+        });
+    AssignHistograms_();
 
     objectID_++;
 }
@@ -358,72 +244,24 @@ InitialCuts::InitialCuts(DecayType type, float R, float L, float p) :
 /// \brief InitialCuts::InitialCuts Copy constructor.
 /// \param est Instance of InitialCuts class.
 ///
-InitialCuts::InitialCuts(const InitialCuts& est)
+InitialCuts::InitialCuts(const InitialCuts& est) :
+    fRegistry_(est.fRegistry_)
 {
     fSilentMode_=est.fSilentMode_;
     fR_ = est.fR_;  //radius in m
     fL_ = est.fL_;  //length in m
+    fGeometry_ = est.fGeometry_;
     fDetectionProbability_ = est.fDetectionProbability_;
     fDecayType_ = est.fDecayType_;
     fTypeString_ = est.fTypeString_;
-
-    fH_12_pass_ = nullptr;
-    fH_12_fail_ = nullptr;
-    fH_23_pass_ = nullptr;
-    fH_31_pass_ = nullptr;
-    fH_12_23_pass_ = nullptr;
-    fH_12_31_pass_ = nullptr;
-    fH_23_31_pass_ = nullptr;
-    fH_12_23_fail_ = nullptr;
-    fH_12_31_fail_ = nullptr;
-    fH_23_31_fail_ = nullptr;
-    fH_31_fail_ = nullptr;
-    fH_23_fail_ = nullptr;
-    fH_en_pass_mid_ = nullptr;
-
-    if(fDecayType_==TWO)
-    {
-        fH_12_pass_ = new TH1F(*est.fH_12_pass_);
-        fH_12_fail_ = new TH1F(*est.fH_12_fail_);
-    }
-    else if(fDecayType_==THREE)
-    {
-        fH_12_23_pass_ = new TH2F(*est.fH_12_23_pass_);
-        fH_12_31_pass_ = new TH2F(*est.fH_12_31_pass_);
-        fH_23_31_pass_ = new TH2F(*est.fH_23_31_pass_);
-        fH_12_23_fail_ = new TH2F(*est.fH_12_23_fail_);
-        fH_12_31_fail_ = new TH2F(*est.fH_12_31_fail_);
-        fH_23_31_fail_ = new TH2F(*est.fH_23_31_fail_);
-        fH_en_pass_mid_ = new TH1F(*est.fH_en_pass_mid_);
-    }
-    else if(fDecayType_==TWOandONE)
-    {
-        fH_12_pass_ = new TH1F(*est.fH_12_pass_);
-        fH_12_fail_ = new TH1F(*est.fH_12_fail_);
-        fH_23_pass_ = new TH1F(*est.fH_23_pass_);
-        fH_23_fail_ = new TH1F(*est.fH_23_fail_);
-        fH_31_pass_ = new TH1F(*est.fH_31_pass_);
-        fH_31_fail_ = new TH1F(*est.fH_31_fail_);
-    }
-
-    fH_en_pass_ = new TH1F(*est.fH_en_pass_);
-    fH_p_pass_ = new TH1F(*est.fH_p_pass_);
-    fH_phi_pass_= new TH1F(*est.fH_phi_pass_);
-    fH_cosTheta_pass_ = new TH1F(*est.fH_cosTheta_pass_);
-    fH_en_fail_ = new TH1F(*est.fH_en_fail_);
-    fH_p_fail_ = new TH1F(*est.fH_p_fail_);
-    fH_phi_fail_= new TH1F(*est.fH_phi_fail_);
-    fH_cosTheta_fail_ = new TH1F(*est.fH_cosTheta_fail_);
-    fH_en_pass_low_ = new TH1F(*est.fH_en_pass_low_);
-    fH_en_pass_high_ = new TH1F(*est.fH_en_pass_high_);
-    fH_en_pass_event_ = new TH1F(*est.fH_en_pass_event_);
-
-    fH_event_cuts_ = new TH1F(*est.fH_event_cuts_);
-    fH_gamma_cuts_ = new TH1F(*est.fH_gamma_cuts_);
+    AssignHistograms_();
     fNumberOfEvents_ = est.fNumberOfEvents_;
     fNumberOfGammas_ = est.fNumberOfGammas_;
     fAcceptedEvents_ = est.fAcceptedEvents_;
     fAcceptedGammas_ = est.fAcceptedGammas_;
+    fReweightEff_ = est.fReweightEff_;
+    fReweightedEvents_ = est.fReweightedEvents_;
+    fReweightedGammas_ = est.fReweightedGammas_;
 }
 
 ///
@@ -436,291 +274,184 @@ InitialCuts& InitialCuts::operator=(const InitialCuts& est)
     fSilentMode_=est.fSilentMode_;
     fR_ = est.fR_;  //radius in m
     fL_ = est.fL_;  //length in m
+    fGeometry_ = est.fGeometry_;
     fDetectionProbability_ = est.fDetectionProbability_;
     fDecayType_ = est.fDecayType_;
     fTypeString_ = est.fTypeString_;
-
-    fH_12_pass_ = nullptr;
-    fH_12_fail_ = nullptr;
-    fH_23_pass_ = nullptr;
-    fH_31_pass_ = nullptr;
-    fH_12_23_pass_ = nullptr;
-    fH_12_31_pass_ = nullptr;
-    fH_23_31_pass_ = nullptr;
-    fH_12_23_fail_ = nullptr;
-    fH_12_31_fail_ = nullptr;
-    fH_23_31_fail_ = nullptr;
-    fH_31_fail_ = nullptr;
-    fH_23_fail_ = nullptr;
-    fH_en_pass_mid_ = nullptr;
-
-    if(fDecayType_==TWO)
-    {
-        fH_12_pass_ = new TH1F(*est.fH_12_pass_);
-        fH_12_fail_ = new TH1F(*est.fH_12_fail_);
-    }
-    else if(fDecayType_==THREE)
-    {
-        fH_12_23_pass_ = new TH2F(*est.fH_12_23_pass_);
-        fH_12_31_pass_ = new TH2F(*est.fH_12_31_pass_);
-        fH_23_31_pass_ = new TH2F(*est.fH_23_31_pass_);
-        fH_12_23_fail_ = new TH2F(*est.fH_12_23_fail_);
-        fH_12_31_fail_ = new TH2F(*est.fH_12_31_fail_);
-        fH_23_31_fail_ = new TH2F(*est.fH_23_31_fail_);
-        fH_en_pass_mid_ = new TH1F(*est.fH_en_pass_mid_);
-    }
-    else if(fDecayType_==TWOandONE)
-    {
-        fH_12_pass_ = new TH1F(*est.fH_12_pass_);
-        fH_12_fail_ = new TH1F(*est.fH_12_fail_);
-        fH_23_pass_ = new TH1F(*est.fH_23_pass_);
-        fH_23_fail_ = new TH1F(*est.fH_23_fail_);
-        fH_31_pass_ = new TH1F(*est.fH_31_pass_);
-        fH_31_fail_ = new TH1F(*est.fH_31_fail_);
-    }
-
-    fH_en_pass_ = new TH1F(*est.fH_en_pass_);
-    fH_p_pass_ = new TH1F(*est.fH_p_pass_);
-    fH_phi_pass_= new TH1F(*est.fH_phi_pass_);
-    fH_cosTheta_pass_ = new TH1F(*est.fH_cosTheta_pass_);
-    fH_en_fail_ = new TH1F(*est.fH_en_fail_);
-    fH_p_fail_ = new TH1F(*est.fH_p_fail_);
-    fH_phi_fail_= new TH1F(*est.fH_phi_fail_);
-    fH_cosTheta_fail_ = new TH1F(*est.fH_cosTheta_fail_);
-    fH_en_pass_low_ = new TH1F(*est.fH_en_pass_low_);
-    fH_en_pass_high_ = new TH1F(*est.fH_en_pass_high_);
-    fH_en_pass_event_ = new TH1F(*est.fH_en_pass_event_);
-
-    fH_event_cuts_ = new TH1F(*est.fH_event_cuts_);
-    fH_gamma_cuts_ = new TH1F(*est.fH_gamma_cuts_);
+    fRegistry_ = est.fRegistry_;
+    AssignHistograms_();
     fNumberOfEvents_ = est.fNumberOfEvents_;
     fNumberOfGammas_ = est.fNumberOfGammas_;
     fAcceptedEvents_ = est.fAcceptedEvents_;
     fAcceptedGammas_ = est.fAcceptedGammas_;
+    fReweightEff_ = est.fReweightEff_;
+    fReweightedEvents_ = est.fReweightedEvents_;
+    fReweightedGammas_ = est.fReweightedGammas_;
     return *this;
 }
 
 ///
-/// \brief InitialCuts::~InitialCuts Releases memory (mostly allocated for histograms).
+/// \brief InitialCuts::~InitialCuts Releases memory, histograms are deleted by the registry.
 ///
 InitialCuts::~InitialCuts()
 {
-    if(fH_12_23_pass_) delete fH_12_23_pass_;
-    if(fH_12_31_pass_) delete fH_12_31_pass_;
-    if(fH_23_31_pass_) delete fH_23_31_pass_;
-    if(fH_12_pass_) delete fH_12_pass_;
-    if(fH_23_pass_) delete fH_23_pass_;
-    if(fH_31_pass_) delete fH_31_pass_;
-    if(fH_12_23_fail_) delete fH_12_23_fail_;
-    if(fH_12_31_fail_) delete fH_12_31_fail_;
-    if(fH_23_31_fail_) delete fH_23_31_fail_;
-    if(fH_12_fail_) delete fH_12_fail_;
-    if(fH_23_fail_) delete fH_23_fail_;
-    if(fH_31_fail_) delete fH_31_fail_;
-    if(fH_en_pass_) delete fH_en_pass_;
-    if(fH_p_pass_) delete fH_p_pass_;
-    if(fH_phi_pass_) delete fH_phi_pass_;
-    if(fH_cosTheta_pass_) delete fH_cosTheta_pass_;
-    if(fH_en_fail_) delete fH_en_fail_;
-    if(fH_p_fail_) delete fH_p_fail_;
-    if(fH_phi_fail_) delete fH_phi_fail_;
-    if(fH_cosTheta_fail_) delete fH_cosTheta_fail_;
-    if(fH_en_pass_low_) delete fH_en_pass_low_;
-    if(fH_en_pass_mid_) delete fH_en_pass_mid_;
-    if(fH_en_pass_high_) delete fH_en_pass_high_;
-    if(fH_en_pass_event_) delete fH_en_pass_event_;
-    if(fH_event_cuts_) delete fH_event_cuts_;
-    if(fH_gamma_cuts_) delete fH_gamma_cuts_;
+}
+
+///
+/// \brief InitialCuts::AssignHistograms_ Sets pointers to histograms owned by the registry.
+///
+void InitialCuts::AssignHistograms_()
+{
+    fH_12_pass_ = RegistryHistogram<TH1F>(fRegistry_, "fH_12_pass_");
+    fH_23_pass_ = RegistryHistogram<TH1F>(fRegistry_, "fH_23_pass_");
+    fH_31_pass_ = RegistryHistogram<TH1F>(fRegistry_, "fH_31_pass_");
+    fH_12_23_pass_ = RegistryHistogram<TH2F>(fRegistry_, "fH_12_23_pass_");
+    fH_12_31_pass_ = RegistryHistogram<TH2F>(fRegistry_, "fH_12_31_pass_");
+    fH_23_31_pass_ = RegistryHistogram<TH2F>(fRegistry_, "fH_23_31_pass_");
+    fH_12_fail_ = RegistryHistogram<TH1F>(fRegistry_, "fH_12_fail_");
+    fH_23_fail_ = RegistryHistogram<TH1F>(fRegistry_, "fH_23_fail_");
+    fH_31_fail_ = RegistryHistogram<TH1F>(fRegistry_, "fH_31_fail_");
+    fH_12_23_fail_ = RegistryHistogram<TH2F>(fRegistry_, "fH_12_23_fail_");
+    fH_12_31_fail_ = RegistryHistogram<TH2F>(fRegistry_, "fH_12_31_fail_");
+    fH_23_31_fail_ = RegistryHistogram<TH2F>(fRegistry_, "fH_23_31_fail_");
+    fH_en_pass_ = RegistryHistogram<TH1F>(fRegistry_, "fH_en_pass_");
+    fH_en_pass_event_ = RegistryHistogram<TH1F>(fRegistry_, "fH_en_pass_event_");
+    fH_en_pass_low_ = RegistryHistogram<TH1F>(fRegistry_, "fH_en_pass_low_");
+    fH_en_pass_mid_ = RegistryHistogram<TH1F>(fRegistry_, "fH_en_pass_mid_");
+    fH_en_pass_high_ = RegistryHistogram<TH1F>(fRegistry_, "fH_en_pass_high_");
+    fH_p_pass_ = RegistryHistogram<TH1F>(fRegistry_, "fH_p_pass_");
+    fH_phi_pass_ = RegistryHistogram<TH1F>(fRegistry_, "fH_phi_pass_");
+    fH_cosTheta_pass_ = RegistryHistogram<TH1F>(fRegistry_, "fH_cosTheta_pass_");
+    fH_en_fail_ = RegistryHistogram<TH1F>(fRegistry_, "fH_en_fail_");
+    fH_p_fail_ = RegistryHistogram<TH1F>(fRegistry_, "fH_p_fail_");
+    fH_phi_fail_ = RegistryHistogram<TH1F>(fRegistry_, "fH_phi_fail_");
+    fH_cosTheta_fail_ = RegistryHistogram<TH1F>(fRegistry_, "fH_cosTheta_fail_");
+    fH_gamma_cuts_ = RegistryHistogram<TH1F>(fRegistry_, "fH_gamma_cuts_");
+    fH_event_cuts_ = RegistryHistogram<TH1F>(fRegistry_, "fH_event_cuts_");
+}
+
+///
+/// \brief InitialCuts::CalculateHitPoints Calculates hit points of a batch of photons, e.g. from many events, on the detector.
+/// \param photons Batch of photons filled by Event::AddPhotonsTo.
+/// \param hits Results, assigned to events by Event::AssignHitPoints.
+///
+void InitialCuts::CalculateHitPoints(const PhotonBatch& photons, HitBatch& hits) const
+{
+    if(fGeometry_)
+        fGeometry_->CalculateHitPoints(photons, hits);
+    else
+        CalculateHitPointsBatch(photons, fR_, fL_, hits);
 }
 
 ///
 /// \brief InitialCuts::AddCuts Checks if an event and particular gammas passed through cuts. Sets flags in Event instance. Fills histograms.
 /// \param event Pointer to an Event object representing a single decay.
+/// \param hitPointsCalculated True if hit points of the event were already assigned from the results of CalculateHitPoints.
 ///
-void InitialCuts::AddCuts(Event* event)
+void InitialCuts::AddCuts(Event* event, bool hitPointsCalculated)
 {
     //Calculate real hit points for pass, and fake hit points for fail (we assume infinite long detector)
-    event->CalculateHitPoints(fR_, fL_); //calculates hit points position and their theta/phi angles
+    //calculates hit points position and their theta/phi angles
+    if(!hitPointsCalculated)
+    {
+        if(fGeometry_)
+            event->CalculateHitPoints(*fGeometry_);
+        else
+            event->CalculateHitPoints(fR_, fL_);
+    }
     fNumberOfEvents_++;
     bool geo_event_pass = true;
     bool inter_event_pass = true;
-    fH_event_cuts_->Fill(0); //events at the beginning
+    int requiredGammas = 0;
+    int geoGammas = 0;
     for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
     {
         if(event->GetFourMomentumOf(ii)!=nullptr)
         {
-            fH_gamma_cuts_->Fill(0); //gammas at the beginning
             fNumberOfGammas_++;
             bool geo_pass = event->GetHitPhiOf(ii)!=-4; //Event::CalculateHitPoints(D, D) sets Phi to -4 when a particle missed detector
-            if(geo_pass)
-                fH_gamma_cuts_->Fill(1);
             bool inter_pass = geo_pass ? DetectionCut_() : false; //if passed geom. then test detector eff
             event->SetCutPassing(ii, inter_pass);
+            if(geo_pass)
+                geoGammas++;
             if(!(ii>=2 && event->GetDecayType() != THREE)) // gammas from deexcitation are not required to reconstruct event
             {
                 geo_event_pass &= geo_pass;
                 inter_event_pass &= inter_pass;
+                requiredGammas++;
             }
         }
         else
             event->SetCutPassing(ii, false);
     }
-    if(geo_event_pass)
-        fH_event_cuts_->Fill(1);
-    if(inter_event_pass)
-        fH_event_cuts_->Fill(2);
-    if(geo_event_pass && inter_event_pass)
-        FillValidEventHistograms_(event);
-    else
-        FillInvalidEventHistograms_(event);
-    //Fills pass/fail distribution histograms
-    FillDistributionHistograms_(event);
-
-    //Let event deduce its flag!
-    event->DeducePassFlag();
-}
-
-///
-/// \brief InitialCuts::DetectionCut_ Checks if gamma interacted with the detector.
-/// \return True if gamma interacted with the detector, false otherwise.
-///
-bool InitialCuts::DetectionCut_()
-{
-    bool pass = false;
-    if(fDetectionProbability_ == 1)
-        pass = true;
-    else
-    {
-        float p = gRandom->Uniform();
-        pass = p < fDetectionProbability_;
-    }
-    if(pass)
-    {
-        fH_gamma_cuts_->Fill(2);
-        fAcceptedGammas_++;
-    }
-    return pass;
-}
-
-///
-/// \brief InitialCuts::FillValidEventHistograms_ Fills histograms only for EVENTS that passed cuts and can be correctly reconstructed.
-/// \param event Pointer to Event object.
-///
-void InitialCuts::FillValidEventHistograms_(const Event* event)
-{
-    fAcceptedEvents_++;
-    bool thirdGammaPrompt = false;
-    int minIndex=0; //indices of min and max energy out of 2 or 3 gammas
-    int maxIndex=0;
-    for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
+    bool valid = geo_event_pass && inter_event_pass;
+    if(!fReweightEff_.empty())
     {
-        if(event->GetFourMomentumOf(ii) != nullptr)
+        //every required gamma is detected independently, so an accepted event survives with probability eff^k
+        for(unsigned ii=0; ii<fReweightEff_.size(); ii++)
         {
-            if(ii==2 && (fDecayType_==TWOandONE || fDecayType_==TWOandN))
-            {
-                thirdGammaPrompt = true;
-                break;
-            }
-            fH_en_pass_event_->Fill(event->GetFourMomentumOf(ii)->Energy());
-            minIndex = event->GetFourMomentumOf(ii)->E() < event->GetFourMomentumOf(minIndex)->E() ? ii : minIndex;
-            maxIndex = event->GetFourMomentumOf(ii)->E() > event->GetFourMomentumOf(maxIndex)->E() ? ii : maxIndex;
+            fReweightedGammas_[ii] += geoGammas*fReweightEff_[ii];
+            if(valid)
+                fReweightedEvents_[ii] += TMath::Power(fReweightEff_[ii], requiredGammas);
         }
+        if(valid)
+            event->SetWeight(event->GetWeight()*TMath::Power(fDetectionProbability_, requiredGammas));
     }
-    fH_en_pass_low_->Fill(event->GetFourMomentumOf(minIndex)->Energy());
-    fH_en_pass_high_->Fill(event->GetFourMomentumOf(maxIndex)->Energy());
-    if(fDecayType_==THREE)
+    if(valid)
     {
-        if(event->GetNumberOfDecayProducts() != 3)
+        fAcceptedEvents_++;
+        if(fDecayType_==THREE && event->GetNumberOfDecayProducts() != 3)
         {
             std::cout<<"[ERROR] Invalid number of decay products for event of type: THREE"<<std::endl;
             throw("[ERROR] Invalid number of decay products for event of type: THREE");
         }
-        //If there are 3 gammas, draw also middle value.
-        int midIndex = minIndex==maxIndex ? minIndex : 3-minIndex-maxIndex;
-        fH_en_pass_mid_->Fill(event->GetFourMomentumOf(midIndex)->Energy());
-        fH_12_23_pass_->Fill(event->GetFourMomentumOf(0)->Angle(event->GetFourMomentumOf(1)->Vect()), \
-                             event->GetFourMomentumOf(1)->Angle(event->GetFourMomentumOf(2)->Vect()), event->GetWeight());
-        fH_12_31_pass_->Fill(event->GetFourMomentumOf(0)->Angle(event->GetFourMomentumOf(1)->Vect()), \
-                             event->GetFourMomentumOf(2)->Angle(event->GetFourMomentumOf(0)->Vect()), event->GetWeight());
-        fH_23_31_pass_->Fill(event->GetFourMomentumOf(1)->Angle(event->GetFourMomentumOf(2)->Vect()), \
-                             event->GetFourMomentumOf(2)->Angle(event->GetFourMomentumOf(0)->Vect()), event->GetWeight());
     }
-    else if(fDecayType_ == TWO || fDecayType_ == TWOandN)
-        fH_12_pass_->Fill(event->GetFourMomentumOf(0)->Angle((event->GetFourMomentumOf(1))->Vect()), event->GetWeight());
-    else if(fDecayType_ == TWOandONE)
+    //events that passed cuts are not put into fail histograms and vice versa, the same for single gammas
+    fRegistry_.Fill(event, valid ? FAIL_HISTOGRAMS : PASS_HISTOGRAMS);
+    if(fRegistry_.HasPhotonHistograms())
     {
-        fH_12_pass_->Fill(event->GetFourMomentumOf(0)->Angle((event->GetFourMomentumOf(1))->Vect()), event->GetWeight());
-        if(thirdGammaPrompt)
+        for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
         {
-            fH_23_pass_->Fill(event->GetFourMomentumOf(1)->Angle((event->GetFourMomentumOf(2))->Vect()), event->GetWeight());
-            fH_31_pass_->Fill(event->GetFourMomentumOf(2)->Angle((event->GetFourMomentumOf(0))->Vect()), event->GetWeight());
+            if(event->GetFourMomentumOf(ii)!=nullptr)
+                fRegistry_.FillPhoton(event, ii, event->GetCutPassingOf(ii) ? FAIL_HISTOGRAMS : PASS_HISTOGRAMS);
         }
     }
-    else if(fDecayType_ != ONE)
-    {
-         throw(std::string("Invalid no of decay products in InitialCuts!"));
-    }
+
+    //Let event deduce its flag!
+    event->DeducePassFlag();
 }
 
 ///
-/// \brief InitialCuts::FillInvalidEventHistograms_ Fills histograms for EVENTS that did not pass cuts and cannot be reconstructed.
-/// \param event Pointer to Event object.
+/// \brief InitialCuts::SetReweightEfficiencies Replaces the random detection cut by weights. Every gamma that hits the
+/// detector passes cuts, the weight of an accepted event is multiplied by p^k, where p is the detection probability and k
+/// the number of gammas required to reconstruct the event, and the expected numbers of accepted events and gammas are
+/// summed for all given efficiencies, so acceptance for all of them is obtained from one run. The sums are reset.
+/// \param effs Efficiencies, empty vector restores the random detection cut.
 ///
-void InitialCuts::FillInvalidEventHistograms_(const Event* event)
+void InitialCuts::SetReweightEfficiencies(const std::vector<double>& effs)
 {
-
-    if(fDecayType_==THREE)
-    {
-        fH_12_23_fail_->Fill(event->GetFourMomentumOf(0)->Angle(event->GetFourMomentumOf(1)->Vect()), \
-                             event->GetFourMomentumOf(1)->Angle(event->GetFourMomentumOf(2)->Vect()), event->GetWeight());
-        fH_12_31_fail_->Fill(event->GetFourMomentumOf(0)->Angle(event->GetFourMomentumOf(1)->Vect()), \
-                             event->GetFourMomentumOf(2)->Angle(event->GetFourMomentumOf(0)->Vect()), event->GetWeight());
-        fH_23_31_fail_->Fill(event->GetFourMomentumOf(1)->Angle(event->GetFourMomentumOf(2)->Vect()), \
-                             event->GetFourMomentumOf(2)->Angle(event->GetFourMomentumOf(0)->Vect()), event->GetWeight());
-    }
-    else if(fDecayType_ == TWO || fDecayType_ == TWOandN)
-        fH_12_fail_->Fill(event->GetFourMomentumOf(0)->Angle((event->GetFourMomentumOf(1))->Vect()), event->GetWeight());
-    else if(fDecayType_ == TWOandONE)
-    {
-        fH_12_fail_->Fill(event->GetFourMomentumOf(0)->Angle((event->GetFourMomentumOf(1))->Vect()), event->GetWeight());
-        if(event->GetFourMomentumOf(2) != nullptr)
-        {
-                fH_23_fail_->Fill(event->GetFourMomentumOf(1)->Angle((event->GetFourMomentumOf(2))->Vect()), event->GetWeight());
-                fH_31_fail_->Fill(event->GetFourMomentumOf(2)->Angle((event->GetFourMomentumOf(0))->Vect()), event->GetWeight());
-        }
-    }
-    else if(fDecayType_ != ONE)
-    {
-         throw(std::string("Invalid no of decay products in InitialCuts!"));
-    }
+    fReweightEff_ = effs;
+    fReweightedEvents_.assign(effs.size(), 0.0);
+    fReweightedGammas_.assign(effs.size(), 0.0);
 }
 
 ///
-/// \brief InitialCuts::FillDistributionHistograms_ Fill histograms with distributions of E, p, phi and cos(theta).
-/// \param event Pointer to Event object.
+/// \brief InitialCuts::DetectionCut_ Checks if gamma interacted with the detector.
+/// \return True if gamma interacted with the detector, false otherwise.
 ///
-void InitialCuts::FillDistributionHistograms_(const Event* event)
+bool InitialCuts::DetectionCut_()
 {
-    for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
+    bool pass = false;
+    if(fDetectionProbability_ == 1 || !fReweightEff_.empty())
+        pass = true;
+    else
     {
-        if(event->GetFourMomentumOf(ii)!=nullptr)
-        {
-            if(event->GetCutPassingOf(ii))
-            {
-                fH_en_pass_->Fill(event->GetFourMomentumOf(ii)->Energy());
-                fH_p_pass_->Fill(event->GetFourMomentumOf(ii)->P());
-                fH_phi_pass_->Fill(event->GetFourMomentumOf(ii)->Phi());
-                fH_cosTheta_pass_->Fill(event->GetFourMomentumOf(ii)->CosTheta());
-            }
-            else
-            {
-                fH_en_fail_->Fill(event->GetFourMomentumOf(ii)->Energy());
-                fH_p_fail_->Fill(event->GetFourMomentumOf(ii)->P());
-                fH_phi_fail_->Fill(event->GetFourMomentumOf(ii)->Phi());
-                fH_cosTheta_fail_->Fill(event->GetFourMomentumOf(ii)->CosTheta());
-            }
-        }
+        float p = gRandom->Uniform();
+        pass = p < fDetectionProbability_;
     }
+    if(pass)
+        fAcceptedGammas_++;
+    return pass;
 }
 
 ///
@@ -743,6 +474,9 @@ void InitialCuts::DrawHistograms(std::string prefix, OutputOptions output)
 void InitialCuts::DrawCutsHistograms(std::string prefix, OutputOptions output)
 {
     std::string outFile;
+    if(!fH_gamma_cuts_)
+        return; //cuts histograms are disabled
+    fRegistry_.Flush();
     if(!fSilentMode_) std::cout<<"[INFO] Drawing histograms for cuts passing."<<std::endl;
     TCanvas* cuts = new TCanvas((fTypeString_+"-gammas_cuts_passed").c_str(),\
                                 (std::string("Fraction of events/gammas that passed cuts, ")+fTypeString_+std::string("-gamma")).c_str(),\
@@ -821,38 +555,35 @@ void InitialCuts::DrawPassHistograms(std::string prefix, OutputOptions output)
 {
     std::string outFile1;
     std::string outFile2;
+    fRegistry_.Flush();
     if(!fSilentMode_) std::cout<<"[INFO] Drawing histograms for gammas that passed cuts."<<std::endl;
-    TCanvas* angles_pass;
-
-    TCanvas* dist_pass = new TCanvas((fTypeString_+"-gammas_dist_pass"+std::to_string(objectID_)).c_str(),\
-                                     ("Basic distributions for passed "\
-                                     +fTypeString_+std::string("-gamma events")).c_str(), 900, 800);
+    //canvases are created only if their histograms were booked
+    TCanvas* angles_pass = nullptr;
+    TCanvas* dist_pass = nullptr;
     //differentation of low, mid and high energy gammas
-    TCanvas *diff_en;
+    TCanvas *diff_en = nullptr;
+    TLegend* legend = nullptr;
     std::string outFileDiffEn;
 
-    dist_pass->Divide(2, 2);
-    dist_pass->cd(1);
-    fH_en_pass_->Draw();
-    dist_pass->cd(2);
-    fH_p_pass_->Draw();
-    dist_pass->cd(3);
-    fH_phi_pass_->Draw();
-    dist_pass->cd(4);
-    fH_cosTheta_pass_->Draw();
-    dist_pass->Update();
-
-    //setting fill colors for histograms that differentiate gammas with low, mid and high energies
-    fH_en_pass_event_->SetFillColor(kBlack);
-    fH_en_pass_low_->SetFillColor(kBlue);
-    fH_en_pass_high_->SetFillColor(kRed);
-    TLegend* legend = new TLegend(0.1, 0.5, 0.4, 0.9);
-    legend->AddEntry(fH_en_pass_event_, "all gammas", "f");
-    legend->AddEntry(fH_en_pass_low_, "lowest energy", "f");
-    legend->AddEntry(fH_en_pass_high_, "highest energy", "f");
+    if(fH_en_pass_ || fH_phi_pass_)
+    {
+        dist_pass = new TCanvas((fTypeString_+"-gammas_dist_pass"+std::to_string(objectID_)).c_str(),\
+                                         ("Basic distributions for passed "\
+                                         +fTypeString_+std::string("-gamma events")).c_str(), 900, 800);
+        dist_pass->Divide(2, 2);
+        dist_pass->cd(1);
+        DrawIfBooked(fH_en_pass_);
+        dist_pass->cd(2);
+        DrawIfBooked(fH_p_pass_);
+        dist_pass->cd(3);
+        DrawIfBooked(fH_phi_pass_);
+        dist_pass->cd(4);
+        DrawIfBooked(fH_cosTheta_pass_);
+        dist_pass->Update();
+    }
 
     //angle distribution depends on the number of decay products
-    if(fDecayType_ == THREE)
+    if(fDecayType_ == THREE && fH_12_23_pass_)
     {
         angles_pass = new TCanvas((fTypeString_+"-gammas_angles_pass_"+std::to_string(objectID_)).c_str(),\
                                     ("Angle ditribution for all generated "\
@@ -866,7 +597,7 @@ void InitialCuts::DrawPassHistograms(std::string prefix, OutputOptions output)
         fH_23_31_pass_->Draw("colz");
         outFile2 = prefix+fTypeString_+"-gammas_angles_pass_.png";
     }
-    else if(fDecayType_ == TWO || fDecayType_ == TWOandN)
+    else if((fDecayType_ == TWO || fDecayType_ == TWOandN) && fH_12_pass_)
     {
         angles_pass = new TCanvas((fTypeString_+"-gammas_angles_pass"+std::to_string(objectID_)).c_str(),\
                                   ("Angle ditribution for all generated "\
@@ -874,7 +605,7 @@ void InitialCuts::DrawPassHistograms(std::string prefix, OutputOptions output)
         fH_12_pass_->Draw();
         outFile2 = prefix+fTypeString_+"-gammas_angles_pass_.png";
     }
-    else if(fDecayType_ == TWOandONE)
+    else if(fDecayType_ == TWOandONE && fH_12_pass_)
     {
         angles_pass = new TCanvas((fTypeString_+"-gammas_angles_pass"+std::to_string(objectID_)).c_str(),\
                                     ("Angle ditribution for all generated "\
@@ -892,7 +623,18 @@ void InitialCuts::DrawPassHistograms(std::string prefix, OutputOptions output)
     TH1F* objLow = nullptr;
     TH1F* objMid = nullptr;
     TH1F* objHigh = nullptr;
-    if(fDecayType_==THREE)
+    if(fH_en_pass_event_)
+    {
+        //setting fill colors for histograms that differentiate gammas with low, mid and high energies
+        fH_en_pass_event_->SetFillColor(kBlack);
+        fH_en_pass_low_->SetFillColor(kBlue);
+        fH_en_pass_high_->SetFillColor(kRed);
+        legend = new TLegend(0.1, 0.5, 0.4, 0.9);
+        legend->AddEntry(fH_en_pass_event_, "all gammas", "f");
+        legend->AddEntry(fH_en_pass_low_, "lowest energy", "f");
+        legend->AddEntry(fH_en_pass_high_, "highest energy", "f");
+    }
+    if(fDecayType_==THREE && fH_en_pass_event_)
     {
         //Drawing energy distribution of gammas from valid events
         diff_en= new TCanvas((fTypeString_+"-gammas_diff_energies").c_str(),\
@@ -920,7 +662,7 @@ void InitialCuts::DrawPassHistograms(std::string prefix, OutputOptions output)
         legend->Draw();
         outFileDiffEn = prefix+fTypeString_+"-gammas_diff_energies_.png";
     }
-    else
+    else if(fH_en_pass_event_)
     {
 
         //Drawing energy distribution of gammas from valid events
@@ -947,11 +689,15 @@ void InitialCuts::DrawPassHistograms(std::string prefix, OutputOptions output)
     if(!fSilentMode_) std::cout<<"[INFO] Saving histograms for passed events."<<std::endl;
     if(output==BOTH || output==PNG)
     {
-        TImage *img = TImage::Create();
-        img->FromPad(dist_pass);
-        outFile1=prefix+fTypeString_+"-gammas_dist_pass_.png";
-        img->WriteImage(outFile1.c_str());
-        if(fDecayType_!=ONE)
+        if(dist_pass)
+        {
+            TImage *img = TImage::Create();
+            img->FromPad(dist_pass);
+            outFile1=prefix+fTypeString_+"-gammas_dist_pass_.png";
+            img->WriteImage(outFile1.c_str());
+            delete img;
+        }
+        if(angles_pass)
         {
             angles_pass->Update();
             TImage *img2 = TImage::Create();
@@ -959,24 +705,28 @@ void InitialCuts::DrawPassHistograms(std::string prefix, OutputOptions output)
             img2->WriteImage(outFile2.c_str());
             delete img2;
         }
-        diff_en->Update();
-        TImage *img3 = TImage::Create();
-        img3->FromPad(diff_en);
-        img3->WriteImage(outFileDiffEn.c_str());
-        delete img;
-        delete img3;
+        if(diff_en)
+        {
+            diff_en->Update();
+            TImage *img3 = TImage::Create();
+            img3->FromPad(diff_en);
+            img3->WriteImage(outFileDiffEn.c_str());
+            delete img3;
+        }
     }
     if(output==BOTH ||output==TREE)
     {
-        dist_pass->Write();
-        if(fDecayType_!=ONE)
+        if(dist_pass)
+            dist_pass->Write();
+        if(angles_pass)
         {
             angles_pass->Update();
             angles_pass->Write();
-            delete angles_pass;
         }
-        diff_en->Write();
+        if(diff_en)
+            diff_en->Write();
     }
+    if(angles_pass) delete angles_pass;
     if(dist_pass) delete dist_pass;
     if(diff_en) delete diff_en;
     if(legend) delete legend;
@@ -995,23 +745,29 @@ void InitialCuts::DrawFailHistograms(std::string prefix, OutputOptions output)
 {
         std::string outFile1;
         std::string outFile2;
+        fRegistry_.Flush();
         if(!fSilentMode_) std::cout<<"[INFO] Drawing histograms for events that did not pass cuts."<<std::endl;
-        TCanvas* angles_fail;
-        TCanvas* dist_fail= new TCanvas((fTypeString_+"-gammas_dist_fail"+std::to_string(objectID_)).c_str(), ("Basic distributions for passed "\
-                                         +fTypeString_+std::string("-gamma events")).c_str(), 900, 800);
-        dist_fail->Divide(2, 2);
-        dist_fail->cd(1);
-        fH_en_fail_->Draw();
-        dist_fail->cd(2);
-        fH_p_fail_->Draw();
-        dist_fail->cd(3);
-        fH_phi_fail_->Draw();
-        dist_fail->cd(4);
-        fH_cosTheta_fail_->Draw();
-        dist_fail->Update();
+        //canvases are created only if their histograms were booked
+        TCanvas* angles_fail = nullptr;
+        TCanvas* dist_fail = nullptr;
+        if(fH_en_fail_ || fH_phi_fail_)
+        {
+            dist_fail= new TCanvas((fTypeString_+"-gammas_dist_fail"+std::to_string(objectID_)).c_str(), ("Basic distributions for passed "\
+                                             +fTypeString_+std::string("-gamma events")).c_str(), 900, 800);
+            dist_fail->Divide(2, 2);
+            dist_fail->cd(1);
+            DrawIfBooked(fH_en_fail_);
+            dist_fail->cd(2);
+            DrawIfBooked(fH_p_fail_);
+            dist_fail->cd(3);
+            DrawIfBooked(fH_phi_fail_);
+            dist_fail->cd(4);
+            DrawIfBooked(fH_cosTheta_fail_);
+            dist_fail->Update();
+        }
 
         //angle distribution depends on the number of decay products
-        if(fDecayType_ == THREE)
+        if(fDecayType_ == THREE && fH_12_23_fail_)
         {
             angles_fail = new TCanvas((fTypeString_+"-gammas_angles_fail"+std::to_string(objectID_)).c_str(), \
                                       ("Angle ditribution for all generated "\
@@ -1027,7 +783,7 @@ void InitialCuts::DrawFailHistograms(std::string prefix, OutputOptions output)
             outFile2 = prefix+fTypeString_+std::string("-gammas_angles_fail.png");
 
         }
-        else if(fDecayType_ == TWO || fDecayType_==TWOandN)
+        else if((fDecayType_ == TWO || fDecayType_==TWOandN) && fH_12_fail_)
         {
             angles_fail = new TCanvas((fTypeString_+"-gammas_angles_fail"+std::to_string(objectID_)).c_str(), \
                                       ("Angle ditribution for all generated "\
@@ -1036,7 +792,7 @@ void InitialCuts::DrawFailHistograms(std::string prefix, OutputOptions output)
             fH_12_fail_->Draw();
             outFile2 = prefix+fTypeString_+std::string("-gammas_angles_fail.png");
         }
-        else if(fDecayType_ == TWOandONE)
+        else if(fDecayType_ == TWOandONE && fH_12_fail_)
         {
             angles_fail = new TCanvas((fTypeString_+"-gammas_angles_fail"+std::to_string(objectID_)).c_str(), \
                                       ("Angle ditribution for all generated "\
@@ -1055,11 +811,15 @@ void InitialCuts::DrawFailHistograms(std::string prefix, OutputOptions output)
         if(!fSilentMode_) std::cout<<"[INFO] Saving histograms for failed events."<<std::endl;
         if(output==BOTH || output==PNG)
         {
-            TImage *img = TImage::Create();
-            img->FromPad(dist_fail);
-            outFile1=prefix+fTypeString_+std::string("-gammas_dist_fail.png");
-            img->WriteImage(outFile1.c_str());
-            if(fDecayType_!=ONE)
+            if(dist_fail)
+            {
+                TImage *img = TImage::Create();
+                img->FromPad(dist_fail);
+                outFile1=prefix+fTypeString_+std::string("-gammas_dist_fail.png");
+                img->WriteImage(outFile1.c_str());
+                delete img;
+            }
+            if(angles_fail)
             {
                 angles_fail->Update();
                 TImage *img2 = TImage::Create();
@@ -1067,18 +827,44 @@ void InitialCuts::DrawFailHistograms(std::string prefix, OutputOptions output)
                 img2->WriteImage(outFile2.c_str());
                 delete img2;
             }
-            delete img;
         }
         if(output==BOTH || output==TREE)
         {
-            dist_fail->Write();
-            if(fDecayType_!=ONE)
+            if(dist_fail)
+                dist_fail->Write();
+            if(angles_fail)
             {
                 angles_fail->Update();
                 angles_fail->Write();
-                delete angles_fail;
             }
         }
+        if(angles_fail) delete angles_fail;
         if(dist_fail) delete dist_fail;
 
 }
+
+///
+/// \brief InitialCuts::WriteHistograms Writes histograms to the current directory without drawing them.
+///
+void InitialCuts::WriteHistograms() const
+{
+    fRegistry_.Write();
+}
+
+///
+/// \brief InitialCuts::ReadHistograms Replaces histograms with the ones written by WriteHistograms, so they can be drawn.
+/// Counters of events and gammas are restored from the cuts histograms.
+/// \param dir Directory with raw histograms.
+///
+void InitialCuts::ReadHistograms(TDirectory* dir)
+{
+    fRegistry_.Read(dir);
+    AssignHistograms_();
+    if(fH_event_cuts_ && fH_gamma_cuts_)
+    {
+        fNumberOfEvents_ = fH_event_cuts_->GetBinContent(1);
+        fAcceptedEvents_ = fH_event_cuts_->GetBinContent(3);
+        fNumberOfGammas_ = fH_gamma_cuts_->GetBinContent(1);
+        fAcceptedGammas_ = fH_gamma_cuts_->GetBinContent(3);
+    }
+}
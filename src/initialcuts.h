@@ -8,6 +8,8 @@
 #include "TRandom3.h"
 #include "event.h"
 #include "parammanager.h"
+#include "detectorgeometry.h"
+#include "histogramregistry.h"
 
 
 ///
@@ -16,31 +18,50 @@
 class InitialCuts
 {
     public:
-        InitialCuts(DecayType type=TWO, float R=437.3, float L=500, float p=1.0);
+        InitialCuts(DecayType type=TWO, float R=437.3, float L=500, float p=1.0, unsigned histogramGroups=ALL_HISTOGRAMS);
         InitialCuts(const InitialCuts&);
         InitialCuts& operator=(const InitialCuts& est);
         ~InitialCuts();
 
         // Getters and setters
-        inline int GetAcceptedEvents() const {return fAcceptedEvents_;}
-        inline int GetAcceptedGammas() const {return fAcceptedGammas_;}
+        inline long long GetAcceptedEvents() const {return fAcceptedEvents_;}
+        inline long long GetAcceptedGammas() const {return fAcceptedGammas_;}
+        inline long long GetNumberOfEvents() const {return fNumberOfEvents_;}
+        inline long long GetNumberOfGammas() const {return fNumberOfGammas_;}
         inline float GetRadius() const {return fR_;}
         inline void SetRadius(float R){fR_=R;}
         inline float GetLength() const {return fL_;}
         inline void SetLength(float L){fL_=L;}
+        //geometry is not owned, nullptr means a single barrel described by fR_ and fL_
+        inline const DetectorGeometry* GetGeometry() const {return fGeometry_;}
+        inline void SetGeometry(const DetectorGeometry* geometry){fGeometry_=geometry;}
         inline float GetDetectionProbability() const {return fDetectionProbability_;}
         inline void SetDetectionProbability(float p){if(p>1.0) fDetectionProbability_=1.0; else if(p<0.0) fDetectionProbability_=0.0; else fDetectionProbability_=p;}
+        //efficiency reweighting, the detection cut is replaced by weights of geometrically accepted events
+        void SetReweightEfficiencies(const std::vector<double>& effs);
+        inline bool IsReweighting() const {return !fReweightEff_.empty();}
+        inline const std::vector<double>& GetReweightEfficiencies() const {return fReweightEff_;}
+        //expected numbers of accepted events and gammas for the efficiency of the given index
+        inline double GetReweightedEvents(const unsigned index) const {return fReweightedEvents_.at(index);}
+        inline double GetReweightedGammas(const unsigned index) const {return fReweightedGammas_.at(index);}
 
         //silent mode switch on/off
         inline void EnableSilentMode(){fSilentMode_=true;}
         inline void DisableSilentMode(){fSilentMode_=false;}
-        //adding cuts
-        void AddCuts(Event* event);
+        //hit points of a batch of photons on the detector handled by these cuts
+        void CalculateHitPoints(const PhotonBatch& photons, HitBatch& hits) const;
+        //adding cuts, hit points are calculated unless they were already assigned from a batch
+        void AddCuts(Event* event, bool hitPointsCalculated=false);
         //drawing histograms
         void DrawHistograms(std::string prefix, OutputOptions output=PNG);
         void DrawCutsHistograms(std::string prefix, OutputOptions output);
         void DrawPassHistograms(std::string prefix, OutputOptions output);
         void DrawFailHistograms(std::string prefix, OutputOptions output);
+        //writing histograms without drawing (RAW output) and reading them back (tools/renderer)
+        void WriteHistograms() const;
+        //histogram fills are buffered, flushing is needed only when histograms are accessed directly
+        inline void FlushHistograms() const {fRegistry_.Flush();}
+        void ReadHistograms(TDirectory* dir);
     private:
         //if set to true, no output is generated to std::cout
         bool fSilentMode_; //false by default
@@ -50,12 +71,20 @@ class InitialCuts
         // detector's parameters
         float fR_;  //radius in cm
         float fL_;  //length in cm
+        const DetectorGeometry* fGeometry_; //multi-component detector, used instead of fR_ and fL_ if set
         float fDetectionProbability_; //probability that detector will detect gamma after being hit
 
-        int fAcceptedEvents_; //no of events that passed all cuts
-        int fAcceptedGammas_; //no of gammas that passed all cuts
-        int fNumberOfEvents_; //total number of events
-        int fNumberOfGammas_; //total number of gammas
+        //counters are summed over all sources of a scan, so they have to hold more than INT_MAX
+        long long fAcceptedEvents_; //no of events that passed all cuts
+        long long fAcceptedGammas_; //no of gammas that passed all cuts
+        long long fNumberOfEvents_; //total number of events
+        long long fNumberOfGammas_; //total number of gammas
+        std::vector<double> fReweightEff_; //efficiencies for which accepted events are counted with weights, empty - no reweighting
+        std::vector<double> fReweightedEvents_; //sums of eff^k over geometrically accepted events, k - number of required gammas
+        std::vector<double> fReweightedGammas_; //sums of eff over geometrically accepted gammas
+
+        //owns all histograms, pointers below are only shortcuts and are nullptr for disabled groups
+        HistogramRegistry fRegistry_;
 
         // histograms with relative angles for events that passed cuts
         TH1F* fH_12_pass_;
@@ -94,9 +123,7 @@ class InitialCuts
         TH1F* fH_event_cuts_;
 
         bool DetectionCut_();
-        void FillValidEventHistograms_(const Event* event);
-        void FillInvalidEventHistograms_(const Event* event);
-        void FillDistributionHistograms_(const Event* event);
+        void AssignHistograms_();
 
         static unsigned objectID_;
 
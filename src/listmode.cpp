@@ -0,0 +1,449 @@
+/// @file listmode.cpp
+/// @date 19.10.2026
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "listmode.h"
+#ifndef LISTMODE_STANDALONE
+#include "event.h"
+#endif
+
+//records are written in the host byte order, which is little-endian on all supported platforms
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "List-mode files are little-endian, big-endian hosts are not supported.");
+
+//definitions of constants used by reference, e.g. in comparisons of tests
+const uint32_t ListModeHeader::kVersion;
+const size_t ListModeHeader::kSize;
+const uint64_t ListModeHeader::kStreamedRecords;
+
+namespace
+{
+    const char kMagic[8] = {'J', 'P', 'E', 'T', 'L', 'M', '\0', '\0'};
+    const size_t kPageSize = 4096;
+
+    ///
+    /// \brief HeaderError Checks magic, version and sizes of a header.
+    /// \param header Header to be checked.
+    /// \return Description of the problem, empty if the header is valid.
+    ///
+    std::string HeaderError(const ListModeHeader& header)
+    {
+        if(std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0)
+            return "Not a list-mode file: ";
+        if(header.version != ListModeHeader::kVersion || header.recordSize != sizeof(ListModeRecord))
+            return "Unsupported version of the list-mode file: ";
+        return "";
+    }
+}
+
+///
+/// \brief MakeListModeHeader Creates an empty header.
+/// \return Header with magic, version and sizes filled in, other fields are zero.
+///
+ListModeHeader MakeListModeHeader()
+{
+    ListModeHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = ListModeHeader::kVersion;
+    header.headerSize = ListModeHeader::kSize;
+    header.recordSize = sizeof(ListModeRecord);
+    return header;
+}
+
+#ifndef LISTMODE_STANDALONE
+///
+/// \brief MakeListModeRecord Converts an event to a list-mode record.
+/// \param event Pointer to Event object.
+/// \param record Reference to the record to be filled.
+/// \return False if the event did not pass cuts or any of the first two photons was not registered.
+///
+bool MakeListModeRecord(const Event* event, ListModeRecord& record)
+{
+    if(!event->GetPassFlag() || event->GetNumberOfDecayProducts()<2)
+        return false;
+    for(int ii=0; ii<2; ii++)
+    {
+        if(!event->GetCutPassingOf(ii) || !event->GetHitPointOf(ii))
+            return false;
+    }
+    record.eventId = event->fId;
+    record.flags = static_cast<uint32_t>(event->GetDecayType())<<8;
+    for(int ii=0; ii<2; ii++)
+    {
+        const TLorentzVector* hit = event->GetHitPointOf(ii);
+        record.x[ii] = hit->X();
+        record.y[ii] = hit->Y();
+        record.z[ii] = hit->Z();
+        record.t[ii] = hit->T();
+        record.edep[ii] = event->GetEdepSmearOf(ii);
+        record.edepTrue[ii] = event->GetEdepOf(ii);
+        if(event->GetPrimaryPhoton(ii))
+            record.flags |= ii==0 ? LM_FIRST_PRIMARY : LM_SECOND_PRIMARY;
+    }
+    record.weight = event->GetWeight();
+    return true;
+}
+#endif
+
+///
+/// \brief ListModeWriter::ListModeWriter Creates the file and writes a preliminary header.
+/// \param path Path of the file, an existing file is overwritten.
+/// \param header Header with parameters of the run, see MakeListModeHeader.
+/// \param bufferSize Size of the buffer, rounded up to a multiple of the page and record sizes.
+///
+ListModeWriter::ListModeWriter(const std::string& path, const ListModeHeader& header, size_t bufferSize) :
+    fFile_(-1),
+    fStream_(false),
+    fHeader_(header),
+    fNumberOfRecords_(0),
+    fBuffer_(nullptr),
+    fBufferSize_(0),
+    fUsed_(0),
+    fOffset_(ListModeHeader::kSize),
+    fPath_(path)
+{
+    fFile_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fFile_ < 0)
+        throw(std::string("[ERROR] Cannot create the list-mode file: ")+path);
+    try
+    {
+        Init_(bufferSize);
+    }
+    catch(std::string&)
+    {
+        close(fFile_);
+        throw;
+    }
+}
+
+///
+/// \brief ListModeWriter::ListModeWriter Starts a streamed run: writes the header with unknown number of records.
+/// Writes block when the reader of a pipe is slower than the simulation.
+/// \param file Open descriptor, e.g. STDOUT_FILENO or a named pipe opened for writing. It is not closed by the writer.
+/// \param header Header with parameters of the run, see MakeListModeHeader.
+/// \param bufferSize Size of the buffer, rounded up to a multiple of the page and record sizes.
+///
+ListModeWriter::ListModeWriter(int file, const ListModeHeader& header, size_t bufferSize) :
+    fFile_(file),
+    fStream_(true),
+    fHeader_(header),
+    fNumberOfRecords_(0),
+    fBuffer_(nullptr),
+    fBufferSize_(0),
+    fUsed_(0),
+    fOffset_(0),
+    fPath_("stream")
+{
+    Init_(bufferSize);
+}
+
+///
+/// \brief ListModeWriter::~ListModeWriter Destructor, closes the file if it is still open.
+///
+ListModeWriter::~ListModeWriter()
+{
+    try
+    {
+        Close();
+    }
+    catch(std::string& ex)
+    {
+        //destructors must not throw, the error is only reported
+        fprintf(stderr, "%s\n", ex.c_str());
+    }
+    free(fBuffer_);
+}
+
+///
+/// \brief ListModeWriter::Add Appends a record.
+/// \param record Record to be written.
+///
+void ListModeWriter::Add(const ListModeRecord& record)
+{
+    std::memcpy(fBuffer_+fUsed_, &record, sizeof(record));
+    fUsed_ += sizeof(record);
+    fNumberOfRecords_++;
+    if(fUsed_ == fBufferSize_)
+        Flush_();
+}
+
+#ifndef LISTMODE_STANDALONE
+///
+/// \brief ListModeWriter::Add Counts the event and appends it if it is an accepted coincidence.
+/// \param event Pointer to Event object.
+/// \return True if a record was written.
+///
+bool ListModeWriter::Add(const Event* event)
+{
+    fHeader_.numberOfEvents++;
+    ListModeRecord record;
+    if(!MakeListModeRecord(event, record))
+        return false;
+    Add(record);
+    return true;
+}
+#endif
+
+///
+/// \brief ListModeWriter::Close Writes buffered records and the final header, then closes the file.
+/// Streamed runs are ended with a record with the LM_END_OF_RUN flag instead.
+///
+void ListModeWriter::Close()
+{
+    if(fFile_ < 0)
+        return;
+    Flush_();
+    int status = 0;
+    if(fStream_)
+    {
+        ListModeRecord end;
+        std::memset(&end, 0, sizeof(end));
+        end.eventId = fHeader_.numberOfEvents;
+        end.flags = LM_END_OF_RUN;
+        WriteAll_(reinterpret_cast<const char*>(&end), sizeof(end), 0);
+    }
+    else
+    {
+        fHeader_.numberOfRecords = fNumberOfRecords_;
+        WriteAll_(reinterpret_cast<const char*>(&fHeader_), sizeof(fHeader_), 0);
+        status = close(fFile_);
+    }
+    fFile_ = -1;
+    if(status != 0)
+        throw(std::string("[ERROR] Cannot close the list-mode file: ")+fPath_);
+}
+
+///
+/// \brief ListModeWriter::Init_ Allocates the buffer and writes a preliminary header.
+/// \param bufferSize Requested size of the buffer.
+///
+void ListModeWriter::Init_(size_t bufferSize)
+{
+    fHeader_.numberOfEvents = 0;
+    fHeader_.numberOfRecords = fStream_ ? ListModeHeader::kStreamedRecords : 0;
+    //page size is a multiple of the record size, so records are never split between two writes
+    //and every full write starts at a page boundary
+    fBufferSize_ = bufferSize<kPageSize ? kPageSize : (bufferSize+kPageSize-1)/kPageSize*kPageSize;
+    if(posix_memalign(reinterpret_cast<void**>(&fBuffer_), kPageSize, fBufferSize_) != 0)
+    {
+        fBuffer_ = nullptr;
+        throw(std::string("[ERROR] Cannot allocate the list-mode buffer!"));
+    }
+    char page[ListModeHeader::kSize];
+    std::memset(page, 0, sizeof(page));
+    std::memcpy(page, &fHeader_, sizeof(fHeader_));
+    try
+    {
+        WriteAll_(page, sizeof(page), 0);
+    }
+    catch(std::string&)
+    {
+        free(fBuffer_);
+        fBuffer_ = nullptr;
+        throw;
+    }
+}
+
+///
+/// \brief ListModeWriter::Flush_ Writes the content of the buffer.
+///
+void ListModeWriter::Flush_()
+{
+    if(fUsed_ == 0)
+        return;
+    WriteAll_(fBuffer_, fUsed_, fOffset_);
+    fOffset_ += fUsed_;
+    fUsed_ = 0;
+}
+
+///
+/// \brief ListModeWriter::WriteAll_ Writes data at the given offset, repeating partial writes.
+/// \param data Pointer to data.
+/// \param size Number of bytes.
+/// \param offset Offset in the file, ignored for streams, which are written sequentially.
+///
+void ListModeWriter::WriteAll_(const char* data, size_t size, off_t offset)
+{
+    while(size > 0)
+    {
+        ssize_t written = fStream_ ? write(fFile_, data, size) : pwrite(fFile_, data, size, offset);
+        if(written < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            throw(std::string("[ERROR] Cannot write to the list-mode file: ")+fPath_+" ("+strerror(errno)+")");
+        }
+        data += written;
+        size -= written;
+        offset += written;
+    }
+}
+
+///
+/// \brief ListModeReader::ListModeReader Maps the file into memory and validates its header.
+/// \param path Path of the file.
+///
+ListModeReader::ListModeReader(const std::string& path) :
+    fData_(MAP_FAILED),
+    fSize_(0),
+    fHeader_(nullptr),
+    fRecords_(nullptr)
+{
+    int file = open(path.c_str(), O_RDONLY);
+    if(file < 0)
+        throw(std::string("[ERROR] Cannot open the list-mode file: ")+path);
+    struct stat info;
+    if(fstat(file, &info) != 0 || info.st_size < static_cast<off_t>(ListModeHeader::kSize))
+    {
+        close(file);
+        throw(std::string("[ERROR] File is too short to be a list-mode file: ")+path);
+    }
+    fSize_ = info.st_size;
+    fData_ = mmap(nullptr, fSize_, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); //the mapping stays valid
+    if(fData_ == MAP_FAILED)
+        throw(std::string("[ERROR] Cannot map the list-mode file: ")+path);
+    madvise(fData_, fSize_, MADV_SEQUENTIAL);
+    fHeader_ = static_cast<const ListModeHeader*>(fData_);
+    std::string error = HeaderError(*fHeader_);
+    if(error.empty() && fHeader_->numberOfRecords == ListModeHeader::kStreamedRecords)
+        error = "Streamed runs have to be read with ListModeStreamReader: ";
+    else if(error.empty() && fHeader_->headerSize+fHeader_->numberOfRecords*fHeader_->recordSize > fSize_)
+        error = "List-mode file is truncated: ";
+    if(!error.empty())
+    {
+        munmap(fData_, fSize_);
+        throw(std::string("[ERROR] ")+error+path);
+    }
+    fRecords_ = reinterpret_cast<const ListModeRecord*>(static_cast<const char*>(fData_)+fHeader_->headerSize);
+}
+
+///
+/// \brief ListModeReader::~ListModeReader Destructor, unmaps the file.
+///
+ListModeReader::~ListModeReader()
+{
+    if(fData_ != MAP_FAILED)
+        munmap(fData_, fSize_);
+}
+
+///
+/// \brief ListModeStreamReader::ListModeStreamReader Opens a stream or a file for sequential reading.
+/// \param path Path of the file or the named pipe, "-" for the standard input.
+/// \param bufferSize Size of the read buffer.
+///
+ListModeStreamReader::ListModeStreamReader(const std::string& path, size_t bufferSize) :
+    fFile_(-1),
+    fOwnsFile_(path != "-"),
+    fPath_(path),
+    fInRun_(false),
+    fRead_(0),
+    fBuffer_(bufferSize<sizeof(ListModeRecord) ? sizeof(ListModeRecord) : bufferSize),
+    fBegin_(0),
+    fEnd_(0)
+{
+    std::memset(&fHeader_, 0, sizeof(fHeader_));
+    fFile_ = fOwnsFile_ ? open(path.c_str(), O_RDONLY) : STDIN_FILENO;
+    if(fFile_ < 0)
+        throw(std::string("[ERROR] Cannot open the list-mode stream: ")+path);
+}
+
+///
+/// \brief ListModeStreamReader::~ListModeStreamReader Destructor, closes the file unless it is the standard input.
+///
+ListModeStreamReader::~ListModeStreamReader()
+{
+    if(fOwnsFile_)
+        close(fFile_);
+}
+
+///
+/// \brief ListModeStreamReader::NextRun Skips the rest of the current run and reads the header of the next one.
+/// \return False at the end of the stream.
+///
+bool ListModeStreamReader::NextRun()
+{
+    ListModeRecord record;
+    while(Next(record)) {}
+    char page[ListModeHeader::kSize];
+    size_t size = Read_(page, sizeof(page));
+    if(size == 0)
+        return false;
+    if(size < sizeof(page))
+        throw(std::string("[ERROR] List-mode stream is truncated: ")+fPath_);
+    std::memcpy(&fHeader_, page, sizeof(fHeader_));
+    std::string error = HeaderError(fHeader_);
+    if(error.empty() && fHeader_.headerSize != ListModeHeader::kSize)
+        error = "Unsupported header size of the list-mode stream: ";
+    if(!error.empty())
+        throw(std::string("[ERROR] ")+error+fPath_);
+    fInRun_ = true;
+    fRead_ = 0;
+    return true;
+}
+
+///
+/// \brief ListModeStreamReader::Next Reads the next record of the current run. Blocks until the writer provides it.
+/// \param record Reference to the record to be filled.
+/// \return False at the end of the run.
+///
+bool ListModeStreamReader::Next(ListModeRecord& record)
+{
+    if(!fInRun_)
+        return false;
+    if(fHeader_.numberOfRecords != ListModeHeader::kStreamedRecords && fRead_ == fHeader_.numberOfRecords)
+    {
+        fInRun_ = false;
+        return false;
+    }
+    if(Read_(reinterpret_cast<char*>(&record), sizeof(record)) < sizeof(record))
+        throw(std::string("[ERROR] List-mode stream is truncated: ")+fPath_);
+    if(record.flags & LM_END_OF_RUN)
+    {
+        fHeader_.numberOfEvents = record.eventId;
+        fHeader_.numberOfRecords = fRead_;
+        fInRun_ = false;
+        return false;
+    }
+    fRead_++;
+    return true;
+}
+
+///
+/// \brief ListModeStreamReader::Read_ Reads data through the buffer.
+/// \param data Pointer to the destination.
+/// \param size Number of bytes.
+/// \return Number of bytes read, smaller than size only at the end of the stream.
+///
+size_t ListModeStreamReader::Read_(char* data, size_t size)
+{
+    size_t done = 0;
+    while(done < size)
+    {
+        if(fBegin_ == fEnd_)
+        {
+            ssize_t received = read(fFile_, fBuffer_.data(), fBuffer_.size());
+            if(received < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+                throw(std::string("[ERROR] Cannot read the list-mode stream: ")+fPath_+" ("+strerror(errno)+")");
+            }
+            if(received == 0)
+                break;
+            fBegin_ = 0;
+            fEnd_ = received;
+        }
+        size_t chunk = size-done < fEnd_-fBegin_ ? size-done : fEnd_-fBegin_;
+        std::memcpy(data+done, fBuffer_.data()+fBegin_, chunk);
+        fBegin_ += chunk;
+        done += chunk;
+    }
+    return done;
+}
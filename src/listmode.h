@@ -0,0 +1,183 @@
+/// @file listmode.h
+/// @date 19.10.2026
+///
+/// List-mode output: a header of one page followed by fixed-size little-endian records, one per accepted coincidence.
+/// The reader does not depend on ROOT, compile listmode.cpp with -DLISTMODE_STANDALONE to use it outside the simulation.
+/// Streams (stdout, pipes) carry a sequence of runs: a header with numberOfRecords set to kStreamedRecords, records
+/// and a record with the LM_END_OF_RUN flag, see ListModeStreamReader.
+#ifndef LISTMODE_H
+#define LISTMODE_H
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <sys/types.h>
+
+class Event;
+
+///
+/// \brief The ListModeHeader struct Header of a list-mode file. It occupies the first kSize bytes of the file, so that records are page-aligned.
+///
+struct ListModeHeader
+{
+    static const uint32_t kVersion = 1;
+    static const size_t kSize = 4096;
+    static const uint64_t kStreamedRecords = ~0ull; //numberOfRecords of streamed runs, the end is marked by a record
+
+    char magic[8]; //"JPETLM\0\0"
+    uint32_t version;
+    uint32_t headerSize; //offset of the first record
+    uint32_t recordSize;
+    int32_t run; //index of the simulation run
+    int64_t seed; //seed from the parameter file, 0 means a random seed
+    uint64_t numberOfEvents; //number of simulated events, accepted or not
+    uint64_t numberOfRecords;
+    float R; //detector radius [mm]
+    float L; //detector length [mm]
+    float eff; //scintillator's efficiency
+    float sourceX; //source position [mm]
+    float sourceY;
+    float sourceZ;
+    float sourceRadius;
+    float smearLow; //limits of energy smearing [MeV]
+    float smearHigh;
+    uint32_t noOfGammas; //value of "gammas" from the parameter file
+};
+
+///
+/// \brief The ListModeFlag enum Bits of ListModeRecord::flags. Bits 8-15 hold the DecayType of the event.
+///
+enum ListModeFlag
+{
+    LM_FIRST_PRIMARY = 1, //first photon was not scattered
+    LM_SECOND_PRIMARY = 2, //second photon was not scattered
+    LM_END_OF_RUN = 0x10000 //last record of a streamed run, eventId holds the number of simulated events
+};
+
+///
+/// \brief The ListModeRecord struct Single coincidence: hit points, times and deposited energies of two annihilation photons.
+///
+struct ListModeRecord
+{
+    uint64_t eventId;
+    float x[2]; //hit points [mm]
+    float y[2];
+    float z[2];
+    float t[2]; //hit times, the same units as in Event
+    float edep[2]; //deposited energy with experimental smearing [MeV]
+    float edepTrue[2]; //deposited energy without smearing [MeV]
+    float weight;
+    uint32_t flags; //bitwise sum of ListModeFlag values and the decay type shifted by 8 bits
+
+    inline int GetDecayType() const {return (flags>>8) & 0xff;}
+};
+
+static_assert(sizeof(ListModeHeader) <= ListModeHeader::kSize, "List-mode header does not fit into its page.");
+static_assert(sizeof(ListModeRecord) == 64, "List-mode records must have a fixed size.");
+
+//creates a header with magic, version and sizes filled in
+ListModeHeader MakeListModeHeader();
+#ifndef LISTMODE_STANDALONE
+//converts an event to a record, returns false if the event is not an accepted coincidence of the first two photons
+bool MakeListModeRecord(const Event* event, ListModeRecord& record);
+#endif
+
+///
+/// \brief The ListModeWriter class Writes records through a large, page-aligned buffer. The header is rewritten with
+/// the final number of records when the file is closed.
+///
+class ListModeWriter
+{
+    public:
+        ListModeWriter(const std::string& path, const ListModeHeader& header, size_t bufferSize=kDefaultBufferSize);
+        //writes a streamed run to an open descriptor (stdout, pipe), which is not closed
+        ListModeWriter(int file, const ListModeHeader& header, size_t bufferSize=kDefaultBufferSize);
+        ~ListModeWriter();
+        void Add(const ListModeRecord& record);
+#ifndef LISTMODE_STANDALONE
+        //adds the event if it is an accepted coincidence, counts all events
+        bool Add(const Event* event);
+#endif
+        void Close();
+        inline uint64_t GetNumberOfRecords() const {return fNumberOfRecords_;}
+        inline bool IsStream() const {return fStream_;}
+        static const size_t kDefaultBufferSize = 4<<20; //4 MB
+
+    private:
+        ListModeWriter(const ListModeWriter&);
+        ListModeWriter& operator=(const ListModeWriter&);
+        void Init_(size_t bufferSize);
+        void Flush_();
+        void WriteAll_(const char* data, size_t size, off_t offset);
+
+        int fFile_; //file descriptor, -1 after closing
+        bool fStream_; //sequential writes, the header is not rewritten and the descriptor is not closed
+        ListModeHeader fHeader_;
+        uint64_t fNumberOfRecords_;
+        char* fBuffer_; //page-aligned
+        size_t fBufferSize_; //multiple of the record size and of the page size
+        size_t fUsed_;
+        off_t fOffset_; //offset in the file where the buffer is written
+        std::string fPath_;
+};
+
+///
+/// \brief The ListModeReader class Maps a list-mode file into memory, records are accessed without copying.
+///
+class ListModeReader
+{
+    public:
+        explicit ListModeReader(const std::string& path);
+        ~ListModeReader();
+        inline const ListModeHeader& GetHeader() const {return *fHeader_;}
+        inline uint64_t GetNumberOfRecords() const {return fHeader_->numberOfRecords;}
+        inline const ListModeRecord* GetRecords() const {return fRecords_;}
+        inline const ListModeRecord& operator[](uint64_t index) const {return fRecords_[index];}
+
+    private:
+        ListModeReader(const ListModeReader&);
+        ListModeReader& operator=(const ListModeReader&);
+
+        void* fData_;
+        size_t fSize_;
+        const ListModeHeader* fHeader_;
+        const ListModeRecord* fRecords_;
+};
+
+///
+/// \brief The ListModeStreamReader class Reads runs from a stream or a file sequentially, with a small buffer.
+/// Both streamed runs and regular list-mode files are accepted.
+///
+class ListModeStreamReader
+{
+    public:
+        //path "-" means the standard input
+        explicit ListModeStreamReader(const std::string& path, size_t bufferSize=1<<16);
+        ~ListModeStreamReader();
+        //reads the header of the next run, false at the end of the stream
+        bool NextRun();
+        //reads the next record of the current run, false at the end of the run
+        bool Next(ListModeRecord& record);
+        inline const ListModeHeader& GetHeader() const {return fHeader_;}
+        //number of records read from the current run
+        inline uint64_t GetNumberOfRecords() const {return fRead_;}
+        //number of events of the current run, known at its end for streamed runs
+        inline uint64_t GetNumberOfEvents() const {return fHeader_.numberOfEvents;}
+
+    private:
+        ListModeStreamReader(const ListModeStreamReader&);
+        ListModeStreamReader& operator=(const ListModeStreamReader&);
+        size_t Read_(char* data, size_t size);
+
+        int fFile_;
+        bool fOwnsFile_;
+        std::string fPath_;
+        ListModeHeader fHeader_;
+        bool fInRun_;
+        uint64_t fRead_;
+        std::vector<char> fBuffer_;
+        size_t fBegin_; //unread data in the buffer
+        size_t fEnd_;
+};
+
+#endif // LISTMODE_H
@@ -10,9 +10,17 @@
 /// To use, compile using Makefile, then simply run. See README.md for more details.
 
 #include <unistd.h>
+#include <fcntl.h>
+#include <csignal>
 #include <sys/stat.h>
 #include <sstream>
 #include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <thread>
+#include <algorithm>
+#include <sys/wait.h>
 #include "TGenPhaseSpace.h"
 #include "TFile.h"
 #include "TROOT.h"
@@ -23,9 +31,131 @@
 #include "initialcuts.h"
 #include "particlegenerator.h"
 #include "phantom.h"
+#include "acceptancemap.h"
+#include "detectorgeometry.h"
+#include "rawoutput.h"
+#include "flatevent.h"
+#include "listmode.h"
+#include "eventfilter.h"
+#include "chunkedtree.h"
+#include "ntuplewriter.h"
+#include "sinogram.h"
+#include "resultcache.h"
+#include "sourcelist.h"
+#include "stagetimer.h"
+#include "hitkernel.h"
 
 // Paths to folders containing results.
 static std::string generalPrefix("results/");
+// Number of events whose hit points are calculated together by simulateDecay.
+static const Int_t kEventBatchSize = 256;
+// Multi-component detector, nullptr if a single barrel (R, L) is used.
+static DetectorGeometry* detectorGeometry = nullptr;
+// Phantom shared by all runs, nullptr if usePhantom is disabled.
+static Phantom* phantom = nullptr;
+// Selection of events saved to the tree, compiled once from the "filter" parameter.
+static EventFilter eventFilter;
+// Manifest listing files of the tree, empty if the tree is not split into chunks.
+static std::string chunkManifest;
+// Descriptor of the list-mode stream shared by all runs (stdout or a named pipe), -1 if streaming is disabled.
+static int streamFile = -1;
+
+///
+/// \brief The CutCounters struct Numbers of events and gammas before and after cuts for one source and decay type.
+///
+struct CutCounters
+{
+    double x, y, z; //position of the source [mm]
+    std::string type;
+    std::string geometry; //"main" for the detector, name of the barrel for barrels compared with it
+    long long events;
+    long long gammas;
+    long long acceptedEvents;
+    long long acceptedGammas;
+    std::vector<double> reweightedEvents; //expected accepted events for every efficiency of reweightEff
+    std::vector<double> reweightedGammas; //expected accepted gammas for every efficiency of reweightEff
+};
+// Counters of all runs simulated by this process, used by the summary of a parameter sweep.
+static std::vector<CutCounters> cutCounters;
+// Cache of results of runs, nullptr if disabled.
+static ResultCache* resultCache = nullptr;
+
+///
+/// \brief writeCutCounters Saves counters of runs simulated by this process.
+/// \param path Path of the text file.
+/// \param first Index of the first saved counter, the previous ones are skipped.
+/// \return 0 on success, -1 if the file cannot be written.
+///
+int writeCutCounters(const std::string& path, size_t first = 0)
+{
+    std::ofstream file(path.c_str());
+    file<<"# x[mm] y[mm] z[mm] type geometry events gammas acceptedEvents acceptedGammas [reweightedEvents reweightedGammas]..."<<std::endl;
+    file<<std::setprecision(10);
+    for(size_t ii=first; ii<cutCounters.size(); ii++)
+    {
+        const CutCounters& c = cutCounters[ii];
+        file<<c.x<<" "<<c.y<<" "<<c.z<<" "<<c.type<<" "<<c.geometry<<" "<<c.events<<" "<<c.gammas<<" "<<c.acceptedEvents<<" "<<c.acceptedGammas;
+        for(size_t ee=0; ee<c.reweightedEvents.size(); ee++)
+            file<<" "<<c.reweightedEvents[ee]<<" "<<c.reweightedGammas[ee];
+        file<<std::endl;
+    }
+    if(!file)
+    {
+        std::cerr<<"[ERROR] Cannot write counters of cuts to: "<<path<<std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+///
+/// \brief readCutCounters Reads counters saved by writeCutCounters.
+/// \param path Path of the text file.
+/// \return Counters in the order of simulation, empty if the file does not exist.
+///
+std::vector<CutCounters> readCutCounters(const std::string& path)
+{
+    std::vector<CutCounters> counters;
+    std::ifstream file(path.c_str());
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(line.empty() || line[0]=='#')
+            continue;
+        std::istringstream fields(line);
+        CutCounters c;
+        if(fields>>c.x>>c.y>>c.z>>c.type>>c.geometry>>c.events>>c.gammas>>c.acceptedEvents>>c.acceptedGammas)
+        {
+            double events = 0, gammas = 0;
+            while(fields>>events>>gammas)
+            {
+                c.reweightedEvents.push_back(events);
+                c.reweightedGammas.push_back(gammas);
+            }
+            counters.push_back(c);
+        }
+    }
+    return counters;
+}
+
+///
+/// \brief makeCutCounters Copies counters of cuts of a finished run.
+/// \param source Fourvector with the position of the source.
+/// \param type_string Type of the decay.
+/// \param geometry Name of the detector, see CutCounters.
+/// \param cuts Cuts of the run.
+/// \return Counters of events and gammas, including the reweighted ones.
+///
+CutCounters makeCutCounters(const TLorentzVector& source, const std::string& type_string, const std::string& geometry, const InitialCuts& cuts)
+{
+    CutCounters counters = {source.X(), source.Y(), source.Z(), type_string, geometry, cuts.GetNumberOfEvents(), cuts.GetNumberOfGammas(),\
+                            cuts.GetAcceptedEvents(), cuts.GetAcceptedGammas()};
+    for(unsigned ii=0; ii<cuts.GetReweightEfficiencies().size(); ii++)
+    {
+        counters.reweightedEvents.push_back(cuts.GetReweightedEvents(ii));
+        counters.reweightedGammas.push_back(cuts.GetReweightedGammas(ii));
+    }
+    return counters;
+}
 
 ///
 /// \brief Small function to convert double numbers into strings with pretty appearence
@@ -38,6 +168,29 @@ std::string toStringPretty(const T a_value)
     return out.str();
 }
 
+///
+/// \brief barrelName Name of a barrel compared with the detector, used for directories, files and counters.
+/// \param R Radius of the barrel [mm].
+/// \param L Length of the barrel [mm].
+/// \return Name in the form barrel_R<R>_L<L>.
+///
+std::string barrelName(double R, double L)
+{
+    return std::string("barrel_R")+toStringPretty(R)+"_L"+toStringPretty(L);
+}
+
+///
+/// \brief isEventSaved Checks if an event is saved to the tree, according to eventType and filter.
+/// \param pManag ParamManager reference with the type of saved events.
+/// \param event Event after cuts.
+/// \return True if the event should be saved.
+///
+bool isEventSaved(const ParamManager& pManag, const Event* event)
+{
+    return ((pManag.GetEventTypeToSave()==PASS && event->GetPassFlag()) || (pManag.GetEventTypeToSave()==FAIL && !(event->GetPassFlag())) || \
+            (pManag.GetEventTypeToSave()==ALL)) && eventFilter.Accept(event);
+}
+
 ///
 /// \brief simulateDecay A function that performs run for many decays with one parameter set.
 /// \param Ps Fourmomentum of the source [GeV]
@@ -45,10 +198,16 @@ std::string toStringPretty(const T a_value)
 /// \param pManag ParamManager reference containing parameters of the simulation.
 /// \param type TWO, THREE or TWOandONE.
 /// \param filePrefix Prefix for all files.
-/// \param tree Instance of TTree to save results from this run.
+/// \param tree Tree of this run, possibly split into several files.
+/// \param ntuple RNTuple of this run, used instead of the tree with treeSchema := ntuple.
+/// \param listModes Writers of the list-mode file and/or stream of this run.
 ///
-void simulateDecay(TLorentzVector Ps, const TLorentzVector& source, const ParamManager& pManag, const DecayType type, const std::string filePrefix = "", TTree* tree = nullptr)
+void simulateDecay(TLorentzVector Ps, const TLorentzVector& source, const ParamManager& pManag, const DecayType type, const std::string filePrefix = "", ChunkedTree* tree = nullptr,\
+                   NTupleWriter* ntuple = nullptr, const std::vector<ListModeWriter*>& listModes = std::vector<ListModeWriter*>())
 {
+    //time of every stage is added to the times of this thread, reported by simulate
+    StageTimes& times = ThreadStageTimes();
+    StageClock clock(times);
     std::string type_string;
     int noOfGammas = 0;
     type_string = recognizeType(type, noOfGammas);
@@ -59,10 +218,34 @@ void simulateDecay(TLorentzVector Ps, const TLorentzVector& source, const ParamM
     phaseSpaceGen.SetDecay(Ps, noOfGammas, masses);
     // creating necessary objects
     Event* eventDecay = nullptr;//new Event;
-    PsDecay decay(type);
-    Phantom phantom(pManag.GetPhantomNaive511Prob(), pManag.GetPhantomNaivePromptProb(), pManag.GetPhantomSmear());
-    InitialCuts cuts(type, pManag.GetR(), pManag.GetL(), pManag.GetEff());
-    ComptonScattering cs(type, pManag.GetSmearLowLimit(), pManag.GetSmearHighLimit());
+    PsDecay decay(type, pManag.GetHistogramGroups());
+    InitialCuts cuts(type, pManag.GetR(), pManag.GetL(), pManag.GetEff(), pManag.GetHistogramGroups());
+    cuts.SetGeometry(detectorGeometry);
+    cuts.SetReweightEfficiencies(pManag.GetReweightEfficiencies());
+    //barrels compared with the detector have their own cuts and histograms, but share generated decays,
+    //so every additional barrel costs only the intersection test
+    std::vector<InitialCuts*> barrelCuts;
+    std::vector<std::string> barrelNames;
+    for(const auto& barrel : pManag.GetBarrels())
+    {
+        double R = barrel.first;
+        double L = barrel.second;
+        double r = source.T();
+        if((TMath::Abs(source.X())+r)*(TMath::Abs(source.X())+r)+(TMath::Abs(source.Y())+r)*(TMath::Abs(source.Y())+r) >= R*R || \
+           (TMath::Abs(source.Z())+r)>=L)
+        {
+            std::cerr<<"[WARNING] Source outside the barrel "<<barrelName(R, L)<<", it is skipped in this run."<<std::endl;
+            continue;
+        }
+        InitialCuts* barrelCut = new InitialCuts(type, R, L, pManag.GetEff(), pManag.GetHistogramGroups());
+        barrelCut->SetReweightEfficiencies(pManag.GetReweightEfficiencies());
+        if(pManag.IsSilentMode())
+            barrelCut->EnableSilentMode();
+        barrelCuts.push_back(barrelCut);
+        barrelNames.push_back(barrelName(R, L));
+    }
+    Event* barrelEvent = nullptr; //copy of the current event, cuts of barrels change hit points and flags
+    ComptonScattering cs(type, pManag.GetSmearLowLimit(), pManag.GetSmearHighLimit(), pManag.GetHistogramGroups());
     //setting SilentMode if necessary
     if(pManag.IsSilentMode())
     {
@@ -78,53 +261,220 @@ void simulateDecay(TLorentzVector Ps, const TLorentzVector& source, const ParamM
         std::cout<<"[INFO] Generation start!"<<std::endl;
     }
 
-    //***   EVENT LOOP  ***
-    for (Int_t n=0; n<pManag.GetSimEvents(); n++)
+    //sinogram of passing LORs, accumulated while events are generated
+    Sinogram* sinogram = nullptr;
+    if(pManag.IsSinogramEnabled() && Sinogram::IsSupported(type))
     {
+        const std::vector<int>& bins = pManag.GetSinogramBins();
+        sinogram = new Sinogram(type, bins[0], bins[1], bins[2], pManag.GetSinogramRadius(), pManag.GetL());
+    }
 
-       //generation of an Event
-       eventDecay = generateEvent(phaseSpaceGen, source, pManag, type);
-       //Filling histograms, event analysis
-       try
-       {
-           //Getting initial distributions
-           decay.AddEvent(eventDecay);
-           //Aplying Compton scattering in phantom
-           if(pManag.GetPhantomUse())
-                phantom.NaiveScatter(eventDecay);
-           //Applying cuts
-           cuts.AddCuts(eventDecay);
-           //Performing the Compton Scattering
-           cs.Scatter(eventDecay);
-           //we select what kind of events will be saved to the tree and save them
-       }
+    //flat branches are created once per tree, before the loop, because the first event may be filtered out,
+    //and again for every new file of a chunked tree; the split branch needs the address of a real event,
+    //otherwise ROOT creates its own one (shifting ids of events), so it is connected at the first saved event
+    FlatEvent flatEvent; //buffer of the flat tree schema
+    bool splitBranchConnected = false;
+    ChunkedTree::BranchSetup branchSetup = [&](TTree* newTree)
+    {
+        if(pManag.GetTreeSchema()==FLAT_TREE || pManag.GetTreeSchema()==SPARSE_TREE)
+            flatEvent.Branch(newTree, pManag.GetBasketSize(), pManag.GetTreeSchema()==SPARSE_TREE);
+        else if(eventDecay==nullptr)
+            return;
+        else if(newTree->GetBranch("event_split"))
+            newTree->SetBranchAddress("event_split", &eventDecay);
+        else
+        {
+            if(!pManag.IsSilentMode())
+                std::cout<<"[INFO] Creating a new branch for storing events.\n"<<std::endl;
+            newTree->Branch("event_split", "Event", &eventDecay, pManag.GetBasketSize(), 99);
+        }
+    };
+    if(tree!=nullptr)
+        tree->SetBranchSetup(branchSetup);
 
-       catch(std::string e)
+    clock.Lap(SETUP_STAGE);
+    //***   EVENT LOOP  ***
+    //events are generated in batches, so hit points of photons from many events are calculated at once
+    //and vector instructions of the hit point kernel work on full registers
+    std::vector<Event*> batch;
+    batch.reserve(kEventBatchSize);
+    std::vector<unsigned> firstPhotons; //index of the first photon of every event in the batch
+    firstPhotons.reserve(kEventBatchSize);
+    PhotonBatch photons;
+    photons.Reserve(kEventBatchSize*(noOfGammas+1));
+    HitBatch hits;
+    std::vector<HitBatch> barrelHits(barrelCuts.size());
+    for (Int_t first=0; first<pManag.GetSimEvents(); first+=kEventBatchSize)
+    {
+       const Int_t last = std::min(first+kEventBatchSize, pManag.GetSimEvents());
+       batch.clear();
+       firstPhotons.clear();
+       photons.Clear();
+       for (Int_t n=first; n<last; n++)
        {
-           std::cout<<e;
-           exit(-1);
+           //generation of an Event
+           eventDecay = generateEvent(phaseSpaceGen, source, pManag, type);
+           //Filling histograms, event analysis
+           try
+           {
+               //Getting initial distributions
+               decay.AddEvent(eventDecay);
+               clock.Lap(GENERATION_STAGE);
+               //Aplying Compton scattering in phantom
+               if(phantom!=nullptr)
+               {
+                    phantom->Apply(eventDecay);
+                    clock.Lap(PHANTOM_STAGE);
+               }
+           }
+           catch(std::string e)
+           {
+               std::cout<<e;
+               exit(-1);
+           }
+           firstPhotons.push_back(photons.Size());
+           eventDecay->AddPhotonsTo(photons);
+           batch.push_back(eventDecay);
        }
-       //writing to tree
-       if(tree!=nullptr && ((pManag.GetEventTypeToSave()==PASS && eventDecay->GetPassFlag()) || (pManag.GetEventTypeToSave()==FAIL && !(eventDecay->GetPassFlag())) || (pManag.GetEventTypeToSave()==ALL)))
+       //barrels share the photons of the batch, only the intersection test is repeated
+       cuts.CalculateHitPoints(photons, hits);
+       for(unsigned bb=0; bb<barrelCuts.size(); bb++)
+           barrelCuts[bb]->CalculateHitPoints(photons, barrelHits[bb]);
+       clock.Lap(CUTS_STAGE);
+       for(unsigned ii=0; ii<batch.size(); ii++)
        {
-           if(n==0)
+           eventDecay = batch[ii];
+           try
            {
-               if(!pManag.IsSilentMode())
-                   std::cout<<"[INFO] Creating a new branch for storing events.\n"<<std::endl;
-               tree->Branch("event_split", "Event", &eventDecay, 32000, 99);
+               //Applying cuts of compared barrels and then of the detector, which are used by the rest of the chain
+               for(unsigned bb=0; bb<barrelCuts.size(); bb++)
+               {
+                   if(barrelEvent)
+                       *barrelEvent = *eventDecay;
+                   else
+                       barrelEvent = new Event(*eventDecay);
+                   barrelEvent->AssignHitPoints(barrelHits[bb], firstPhotons[ii]);
+                   barrelCuts[bb]->AddCuts(barrelEvent, true);
+               }
+               eventDecay->AssignHitPoints(hits, firstPhotons[ii]);
+               cuts.AddCuts(eventDecay, true);
+               if(sinogram!=nullptr)
+                   sinogram->Add(eventDecay);
+               clock.Lap(CUTS_STAGE);
+               //Performing the Compton Scattering
+               cs.Scatter(eventDecay);
+               clock.Lap(COMPTON_STAGE);
+               //we select what kind of events will be saved to the tree and save them
            }
-           tree->Fill();
-       }
-       delete eventDecay;
 
+           catch(std::string e)
+           {
+               std::cout<<e;
+               exit(-1);
+           }
+           //writing accepted coincidences to the list-mode file and stream
+           if(!listModes.empty())
+           {
+               try
+               {
+                   for(auto listMode : listModes)
+                       listMode->Add(eventDecay);
+               }
+               catch(std::string e)
+               {
+                   std::cout<<e<<std::endl;
+                   exit(-1);
+               }
+           }
+           //writing to tree
+           if((tree!=nullptr || ntuple!=nullptr) && isEventSaved(pManag, eventDecay))
+           {
+               try
+               {
+                   if(pManag.GetTreeSchema()!=SPLIT_TREE)
+                       flatEvent.Assign(eventDecay, pManag.GetTreeSchema()==SPARSE_TREE);
+                   else if(!splitBranchConnected)
+                   {
+                       tree->SetBranchSetup(branchSetup);
+                       splitBranchConnected = true;
+                   }
+                   if(ntuple!=nullptr)
+                       ntuple->Fill(flatEvent);
+                   else
+                       tree->Fill();
+               }
+               catch(std::string e)
+               {
+                   std::cout<<e<<std::endl;
+                   exit(-1);
+               }
+           }
+           times.events++;
+           times.photons += eventDecay->GetNumberOfDecayProducts();
+           delete eventDecay;
+           clock.Lap(OUTPUT_STAGE);
+       }
     }
     //***   END OF EVENT LOOP   ***
+    delete barrelEvent;
+    if(tree!=nullptr)
+        tree->SetBranchSetup(ChunkedTree::BranchSetup()); //the setup refers to local variables
 
-    //Drawing results
-    decay.DrawHistograms(filePrefix, pManag.GetOutputType());
-    cuts.DrawHistograms(filePrefix, pManag.GetOutputType());
-    cs.DrawComptonHistograms(filePrefix, pManag.GetOutputType()); //Draw histograms with scattering angle and electron's energy distributions.
+    if(pManag.GetOutputType()==RAW)
+    {
+        //no canvases, histograms are stored as they are and can be drawn later by tools/renderer
+        TDirectory* parentDir = gDirectory;
+        TDirectory* rawDir = parentDir->mkdir(RawDirectoryName(type).c_str());
+        rawDir->cd();
+        decay.WriteHistograms();
+        cuts.WriteHistograms();
+        cs.WriteHistograms();
+        if(sinogram!=nullptr)
+            sinogram->Write();
+        for(unsigned bb=0; bb<barrelCuts.size(); bb++)
+        {
+            rawDir->mkdir(barrelNames[bb].c_str())->cd();
+            barrelCuts[bb]->WriteHistograms();
+        }
+        parentDir->cd();
+    }
+    else if(pManag.GetOutputType()!=NO_OUTPUT)
+    {
+        //Drawing results
+        decay.DrawHistograms(filePrefix, pManag.GetOutputType());
+        cuts.DrawHistograms(filePrefix, pManag.GetOutputType());
+        cs.DrawComptonHistograms(filePrefix, pManag.GetOutputType()); //Draw histograms with scattering angle and electron's energy distributions.
+        if(sinogram!=nullptr)
+        {
+            if(pManag.GetOutputType()==TREE || pManag.GetOutputType()==BOTH)
+                sinogram->Write();
+            if(pManag.GetOutputType()==PNG || pManag.GetOutputType()==BOTH)
+                sinogram->Draw(filePrefix);
+        }
+        //canvases of every barrel are stored in its own directory, because their names are the same
+        for(unsigned bb=0; bb<barrelCuts.size(); bb++)
+        {
+            TDirectory* parentDir = gDirectory;
+            if(pManag.GetOutputType()==TREE || pManag.GetOutputType()==BOTH)
+                parentDir->mkdir(barrelNames[bb].c_str())->cd();
+            barrelCuts[bb]->DrawHistograms(filePrefix+barrelNames[bb]+"_", pManag.GetOutputType());
+            parentDir->cd();
+        }
+    }
+    if(sinogram!=nullptr)
+    {
+        if(!pManag.IsSilentMode())
+            std::cout<<"[INFO] "<<sinogram->GetAcceptedLORs()<<" LORs accumulated in the sinogram."<<std::endl;
+        delete sinogram;
+    }
+    cutCounters.push_back(makeCutCounters(source, type_string, "main", cuts));
+    for(unsigned bb=0; bb<barrelCuts.size(); bb++)
+    {
+        cutCounters.push_back(makeCutCounters(source, type_string, barrelNames[bb], *barrelCuts[bb]));
+        delete barrelCuts[bb];
+    }
     delete[] masses;
+    clock.Lap(DRAWING_STAGE);
 }
 
 ///
@@ -133,9 +483,9 @@ void simulateDecay(TLorentzVector Ps, const TLorentzVector& source, const ParamM
 /// \param pManag ParamManager reference with all necessary parameters.
 /// \param treeFile Pointer to TFile object in which all data may be stored.
 /// \param outputFileAndDirName Name that will be used as output folder name (in PNG mode) and/or output file prefix (in TREE mode).
-/// \return Pointer to the TTree object.
+/// \return Pointer to the tree of this run, it has to be deleted by the caller.
 ///
-TTree* simulate(const int simRun, ParamManager& pManag, TFile* treeFile, std::string outputFileAndDirName="")
+ChunkedTree* simulate(const int simRun, ParamManager& pManag, TFile* treeFile, std::string outputFileAndDirName="")
 {
 
    // Settings
@@ -143,7 +493,9 @@ TTree* simulate(const int simRun, ParamManager& pManag, TFile* treeFile, std::st
    TLorentzVector sourcePos; //x,y,z,r !
    int noOfGammas = 0;
    std::string subDir;
-   TTree* tree = nullptr;
+   ChunkedTree* tree = nullptr;
+   NTupleWriter* ntuple = nullptr;
+   std::vector<ListModeWriter*> listModes;
    TDirectory* runDir = nullptr;
    TDirectory* histDir = nullptr;
    //reading source parameters
@@ -157,8 +509,8 @@ TTree* simulate(const int simRun, ParamManager& pManag, TFile* treeFile, std::st
    double pz = sourceParams[5];
    double r = TMath::Abs(sourceParams[6]);
 
-   //checking if source position is correct
-   if((TMath::Abs(x)+r)*(TMath::Abs(x)+r)+(TMath::Abs(y)+r)*(TMath::Abs(y)+r) >= pManag.GetR()*pManag.GetR() || (TMath::Abs(z)+r)>=pManag.GetL())
+   //checking if source position is correct (only for the single barrel)
+   if(!detectorGeometry && ((TMath::Abs(x)+r)*(TMath::Abs(x)+r)+(TMath::Abs(y)+r)*(TMath::Abs(y)+r) >= pManag.GetR()*pManag.GetR() || (TMath::Abs(z)+r)>=pManag.GetL()))
    {
        std::cerr<<"[ERROR] Source outside the barrel! Terminating current run!"<<std::endl;
        return nullptr;
@@ -171,58 +523,812 @@ TTree* simulate(const int simRun, ParamManager& pManag, TFile* treeFile, std::st
            +toStringPretty(px)+std::string("_")+toStringPretty(py)+std::string("_")+toStringPretty(pz)+std::string("/");
 
    //setting the right output
+   std::string imageDir;
    if(pManag.GetOutputType()==BOTH || pManag.GetOutputType()==PNG)
    {
         // creating new directories; see https://linux.die.net/man/3/mkdir
-       mkdir((generalPrefix+outputFileAndDirName+subDir).c_str(), ACCESSPERMS);
-       chmod((generalPrefix+outputFileAndDirName+subDir).c_str(), ACCESSPERMS);
+       imageDir = generalPrefix+outputFileAndDirName+subDir;
+       mkdir(imageDir.c_str(), ACCESSPERMS);
+       chmod(imageDir.c_str(), ACCESSPERMS);
    }
-   if(pManag.GetOutputType()==BOTH || pManag.GetOutputType()==TREE)
+
+   //every cached run gets its own seed, so that its results do not depend on other runs and can be reused
+   std::string cacheKey;
+   const size_t firstCounter = cutCounters.size();
+   if(resultCache)
+   {
+       cacheKey = ResultCache::GetKey(pManag, simRun, phantom ? phantom->GetMaterials() : nullptr);
+       gRandom->SetSeed(ResultCache::GetRunSeed(pManag, simRun));
+       if(resultCache->Contains(cacheKey))
+       {
+           TDirectory* cachedDir = nullptr;
+           if(pManag.GetOutputType()==BOTH || pManag.GetOutputType()==TREE || pManag.GetOutputType()==RAW)
+               cachedDir = treeFile->mkdir(subDir.c_str());
+           try
+           {
+               resultCache->Restore(cacheKey, cachedDir, imageDir);
+           }
+           catch(std::string e)
+           {
+               std::cerr<<e<<std::endl;
+               exit(-1);
+           }
+           std::vector<CutCounters> counters = readCutCounters(resultCache->GetEntryDir(cacheKey)+"counters.txt");
+           cutCounters.insert(cutCounters.end(), counters.begin(), counters.end());
+           std::cout<<"[INFO] Results of the run restored from the cache: "<<resultCache->GetEntryDir(cacheKey)<<std::endl;
+           if(cachedDir)
+               cachedDir->cd();
+           return nullptr;
+       }
+   }
+   if(pManag.GetOutputType()==BOTH || pManag.GetOutputType()==TREE || pManag.GetOutputType()==RAW)
    {
-       tree = new TTree("tree", "Tree with events and histograms");
        runDir = treeFile->mkdir(subDir.c_str());
        runDir->cd();
+       try
+       {
+           //chunks are named after the run directory and stored next to the main file,
+           //with eventType := none only histograms and sinograms are stored
+           if(pManag.GetEventTypeToSave()!=NONE)
+           {
+               if(pManag.GetTreeSchema()==RNTUPLE)
+                   ntuple = new NTupleWriter(runDir, "events", CompressionSettings(pManag.GetCompressionAlgorithm(), pManag.GetCompressionLevel()));
+               else if(!chunkManifest.empty())
+                   tree = new ChunkedTree(generalPrefix+outputFileAndDirName, subDir.substr(0, subDir.size()-1), chunkManifest, pManag);
+               else
+                   tree = new ChunkedTree(runDir, pManag);
+           }
+       }
+       catch(std::string e)
+       {
+           std::cerr<<e<<std::endl;
+           exit(-1);
+       }
        histDir = runDir->mkdir("Histograms");
        histDir->cd();
    }
 
+   if(pManag.IsListMode() || streamFile>=0)
+   {
+       ListModeHeader header = MakeListModeHeader();
+       header.run = simRun;
+       header.seed = pManag.GetSeed();
+       header.R = pManag.GetR();
+       header.L = pManag.GetL();
+       header.eff = pManag.GetEff();
+       header.sourceX = x;
+       header.sourceY = y;
+       header.sourceZ = z;
+       header.sourceRadius = r;
+       header.smearLow = pManag.GetSmearLowLimit();
+       header.smearHigh = pManag.GetSmearHighLimit();
+       header.noOfGammas = noOfGammas;
+       //one file per run, named after the run directory, and/or one streamed run
+       std::string listModeFile = generalPrefix+outputFileAndDirName+subDir.substr(0, subDir.size()-1)+".lm";
+       try
+       {
+           if(pManag.IsListMode())
+               listModes.push_back(new ListModeWriter(listModeFile, header));
+           if(streamFile>=0)
+               listModes.push_back(new ListModeWriter(streamFile, header));
+       }
+       catch(std::string e)
+       {
+           std::cerr<<e<<std::endl;
+           exit(-1);
+       }
+   }
+
+   //times of stages of this run, restored runs are not timed
+   StageTimes& times = ThreadStageTimes();
+   times.Reset();
    //Performing simulations based on the provided number of gammas
    if(noOfGammas==1)
    {
        std::cout<<"::::::::::::Simulating 1-gamma generation::::::::::::"<<std::endl;
-       simulateDecay(Ps, sourcePos, pManag, ONE, generalPrefix+outputFileAndDirName+subDir, tree);
+       simulateDecay(Ps, sourcePos, pManag, ONE, generalPrefix+outputFileAndDirName+subDir, tree, ntuple, listModes);
    }
    else if(noOfGammas==2)
    {
        std::cout<<"::::::::::::Simulating 2-gamma decays::::::::::::"<<std::endl;
-       simulateDecay(Ps, sourcePos, pManag, TWO, generalPrefix+outputFileAndDirName+subDir, tree);
+       simulateDecay(Ps, sourcePos, pManag, TWO, generalPrefix+outputFileAndDirName+subDir, tree, ntuple, listModes);
    }
    else if(noOfGammas==3)
    {
        std::cout<<"::::::::::::Simulating 3-gamma decays::::::::::::"<<std::endl;
-       simulateDecay(Ps, sourcePos, pManag, THREE, generalPrefix+outputFileAndDirName+subDir, tree);
+       simulateDecay(Ps, sourcePos, pManag, THREE, generalPrefix+outputFileAndDirName+subDir, tree, ntuple, listModes);
    }
    else if(noOfGammas==4)
    {
         std::cout<<"::::::::::::Simulating 2+1-gamma decays::::::::::::"<<std::endl;
-        simulateDecay(Ps, sourcePos, pManag, TWOandONE, generalPrefix+outputFileAndDirName+subDir, tree);
+        simulateDecay(Ps, sourcePos, pManag, TWOandONE, generalPrefix+outputFileAndDirName+subDir, tree, ntuple, listModes);
    }
    else if(noOfGammas==5)
    {
         std::cout<<"::::::::::::Simulating 2+N-gamma decays::::::::::::"<<std::endl;
-        simulateDecay(Ps, sourcePos, pManag, TWOandN, generalPrefix+outputFileAndDirName+subDir, tree);
+        simulateDecay(Ps, sourcePos, pManag, TWOandN, generalPrefix+outputFileAndDirName+subDir, tree, ntuple, listModes);
    }
    else
    {
        std::cout<<"::::::::::::Simulating both 2-gamma and 3-gammas decays::::::::::::"<<std::endl;
-       simulateDecay(Ps, sourcePos, pManag, TWO, generalPrefix+outputFileAndDirName+subDir, tree);
-       simulateDecay(Ps, sourcePos, pManag, THREE, generalPrefix+outputFileAndDirName+subDir, tree);
+       simulateDecay(Ps, sourcePos, pManag, TWO, generalPrefix+outputFileAndDirName+subDir, tree, ntuple, listModes);
+       simulateDecay(Ps, sourcePos, pManag, THREE, generalPrefix+outputFileAndDirName+subDir, tree, ntuple, listModes);
    }
-   if(pManag.GetOutputType()==BOTH || pManag.GetOutputType()==TREE)
+   StageClock clock(times);
+   for(auto listMode : listModes)
+   {
+       try
+       {
+           listMode->Close();
+       }
+       catch(std::string e)
+       {
+           std::cerr<<e<<std::endl;
+           exit(-1);
+       }
+       if(!pManag.IsSilentMode())
+           std::cout<<"[INFO] "<<listMode->GetNumberOfRecords()<<" coincidences written to the list-mode "\
+                    <<(listMode->IsStream() ? "stream." : "file.")<<std::endl;
+       delete listMode;
+   }
+   if(ntuple)
+   {
+       if(!pManag.IsSilentMode())
+           std::cout<<"[INFO] "<<ntuple->GetEntries()<<" events written to the RNTuple."<<std::endl;
+       delete ntuple; //commits the dataset
+   }
+   clock.Lap(OUTPUT_STAGE);
+   if(!cacheKey.empty())
+   {
+       //the tree has to be written before the run is copied to the cache
+       if(tree)
+       {
+           try
+           {
+               tree->Close();
+           }
+           catch(std::string e)
+           {
+               std::cerr<<e<<std::endl;
+               exit(-1);
+           }
+           delete tree;
+           tree = nullptr;
+       }
+       try
+       {
+           resultCache->Store(cacheKey, runDir, imageDir);
+           if(writeCutCounters(resultCache->GetEntryDir(cacheKey)+"counters.txt", firstCounter)==0)
+               resultCache->Commit(cacheKey);
+       }
+       catch(std::string e)
+       {
+           std::cerr<<e<<std::endl;
+           std::cerr<<"[WARNING] Results of the run are not cached."<<std::endl;
+       }
+   }
+   //the report is written after the run is cached, because times of restored runs would be misleading
+   if(!pManag.IsSilentMode())
+       times.Print();
+   //with output := none and a streamed list-mode file nothing is written to results/<name>/, so no report file is saved either
+   if(pManag.GetOutputType()!=NO_OUTPUT || pManag.IsListMode())
+   {
+       std::string timingFile = generalPrefix+outputFileAndDirName+subDir.substr(0, subDir.size()-1)+"_timing.json";
+       if(!times.Save(timingFile))
+           std::cerr<<"[WARNING] Cannot write the timing report: "<<timingFile<<std::endl;
+   }
+   if(pManag.GetOutputType()==BOTH || pManag.GetOutputType()==TREE || pManag.GetOutputType()==RAW)
+   {
        runDir->cd();
+       times.Write();
+   }
    return tree;
 }
 
+///
+/// \brief simulateAcceptance Reads geometric acceptance for all sources from cached acceptance maps instead of simulating events.
+/// Maps that are not in the cache are built (in parallel) and saved there.
+/// \param pManag ParamManager reference with all necessary parameters.
+/// \param outputDir Directory in which the table with results will be saved.
+///
+void simulateAcceptance(const ParamManager& pManag, const std::string& outputDir)
+{
+    std::vector<DecayType> types;
+    switch(pManag.GetNoOfGammas())
+    {
+        case 1: types.push_back(ONE); break;
+        case 2: types.push_back(TWO); break;
+        case 3: types.push_back(THREE); break;
+        case 4: types.push_back(TWOandONE); break;
+        case 5:
+            std::cerr<<"[WARNING] Acceptance maps for 2&N decays are not available, using 2-gamma map."<<std::endl;
+            types.push_back(TWO);
+            break;
+        default:
+            types.push_back(TWO);
+            types.push_back(THREE);
+    }
+    mkdir(pManag.GetCacheDir().c_str(), ACCESSPERMS);
+    AcceptanceGrid grid = AcceptanceMap::DefaultGrid(pManag.GetR(), pManag.GetL(), pManag.GetMapGridSize(0),\
+                                                     pManag.GetMapGridSize(1), pManag.GetMapGridSize(2));
+    //maps describe point sources of positronium at rest, other parameters of sources are not taken into account
+    for(int ii=0; ii<pManag.GetSimRuns(); ii++)
+    {
+        std::vector<double> sourceParams = pManag.GetDataAt(ii);
+        bool ignored = false;
+        for(unsigned kk=3; kk<sourceParams.size() && kk<7; kk++)
+            ignored |= sourceParams[kk]!=0.0;
+        if(ignored)
+            std::cerr<<"[WARNING] Acceptance maps ignore the momentum and radius of the source at ("<<sourceParams[0]<<", "\
+                     <<sourceParams[1]<<", "<<sourceParams[2]<<"), the acceptance of a point source at rest is given."<<std::endl;
+    }
+    std::ofstream table((outputDir+"acceptance.txt").c_str());
+    table<<"# X[mm] Y[mm] Z[mm] type acceptance"<<std::endl;
+    for(auto type : types)
+    {
+        int noOfGammas = 0;
+        std::string type_string = recognizeType(type, noOfGammas);
+        AcceptanceMap map(type, pManag.GetR(), pManag.GetL(), grid, pManag.GetMapSamples(), pManag.GetSeed());
+        map.LoadOrBuild(pManag.GetCacheDir(), pManag.GetThreads(), pManag.IsSilentMode());
+        for(int ii=0; ii<pManag.GetSimRuns(); ii++)
+        {
+            std::vector<double> sourceParams = pManag.GetDataAt(ii);
+            double acceptance = map.Interpolate(sourceParams[0], sourceParams[1], sourceParams[2]);
+            std::cout<<"[INFO] "<<type_string<<"-gamma acceptance at ("<<sourceParams[0]<<", "<<sourceParams[1]<<", "\
+                     <<sourceParams[2]<<") [mm]: "<<acceptance<<std::endl;
+            table<<sourceParams[0]<<" "<<sourceParams[1]<<" "<<sourceParams[2]<<" "<<type_string<<" "<<acceptance<<std::endl;
+        }
+    }
+}
+
+///
+/// \brief writeReweightingTable Saves acceptance of runs for every efficiency of reweightEff, computed from weights of
+/// geometrically accepted events (see InitialCuts::SetReweightEfficiencies).
+/// \param pManag ParamManager reference with efficiencies.
+/// \param path Path of the text file.
+/// \param first Index of the first counter of runs included in the table.
+///
+void writeReweightingTable(const ParamManager& pManag, const std::string& path, size_t first)
+{
+    const std::vector<double>& effs = pManag.GetReweightEfficiencies();
+    std::ofstream table(path.c_str());
+    table<<"# x[mm] y[mm] z[mm] type geometry eff events expectedEvents eventAcceptance gammaAcceptance"<<std::endl;
+    for(size_t ii=first; ii<cutCounters.size(); ii++)
+    {
+        const CutCounters& c = cutCounters[ii];
+        for(size_t ee=0; ee<effs.size() && ee<c.reweightedEvents.size(); ee++)
+        {
+            double eventAcceptance = c.events>0 ? c.reweightedEvents[ee]/c.events : 0.0;
+            double gammaAcceptance = c.gammas>0 ? c.reweightedGammas[ee]/c.gammas : 0.0;
+            table<<c.x<<" "<<c.y<<" "<<c.z<<" "<<c.type<<" "<<c.geometry<<" "<<effs[ee]<<" "<<c.events<<" "<<c.reweightedEvents[ee]<<" "\
+                 <<eventAcceptance<<" "<<gammaAcceptance<<std::endl;
+            if(!pManag.IsSilentMode())
+                std::cout<<"[INFO] "<<c.type<<"-gamma acceptance of "<<c.geometry<<" at ("<<c.x<<", "<<c.y<<", "<<c.z<<") [mm] for efficiency "\
+                         <<effs[ee]<<": "<<eventAcceptance<<std::endl;
+        }
+    }
+    if(!table)
+        std::cerr<<"[ERROR] Cannot write acceptance for reweighted efficiencies to: "<<path<<std::endl;
+    else
+        std::cout<<"[INFO] Acceptance for reweighted efficiencies saved to "<<path<<std::endl;
+}
+
+///
+/// \brief writeBarrelTable Saves acceptance of the detector and of all barrels compared with it for every run.
+/// \param pManag ParamManager reference with parameters of the simulation.
+/// \param path Path of the text file.
+/// \param first Index of the first counter of runs included in the table.
+///
+void writeBarrelTable(const ParamManager& pManag, const std::string& path, size_t first)
+{
+    std::ofstream table(path.c_str());
+    table<<"# x[mm] y[mm] z[mm] type geometry events acceptedEvents acceptedGammas eventAcceptance gammaAcceptance"<<std::endl;
+    for(size_t ii=first; ii<cutCounters.size(); ii++)
+    {
+        const CutCounters& c = cutCounters[ii];
+        double eventAcceptance = c.events>0 ? double(c.acceptedEvents)/c.events : 0.0;
+        table<<c.x<<" "<<c.y<<" "<<c.z<<" "<<c.type<<" "<<c.geometry<<" "<<c.events<<" "<<c.acceptedEvents<<" "<<c.acceptedGammas<<" "\
+             <<eventAcceptance<<" "<<(c.gammas>0 ? double(c.acceptedGammas)/c.gammas : 0.0)<<std::endl;
+        if(!pManag.IsSilentMode())
+            std::cout<<"[INFO] "<<c.type<<"-gamma acceptance of "<<c.geometry<<" at ("<<c.x<<", "<<c.y<<", "<<c.z<<") [mm]: "\
+                     <<eventAcceptance<<std::endl;
+    }
+    if(!table)
+        std::cerr<<"[ERROR] Cannot write acceptance of compared barrels to: "<<path<<std::endl;
+    else
+        std::cout<<"[INFO] Acceptance of compared barrels saved to "<<path<<std::endl;
+}
+
+///
+/// \brief The ScanChain struct Objects processing events of one decay type in the scan mode, shared by all sources.
+///
+struct ScanChain
+{
+    DecayType type;
+    std::string typeString;
+    int noOfGammas;
+    PsDecay* decay;
+    InitialCuts* cuts;
+    ComptonScattering* cs;
+};
+
+///
+/// \brief runScan Simulates all sources in one pass: events are saved to a single tree "scan/tree" with the index of the
+/// source in the "sourceIndex" branch, histograms are summed over all sources and counters of cuts of every source are
+/// written to results/<name>/scan_counters.txt. Sources are read one at a time from the "sources" file or taken from
+/// the parameter file, so the number of sources is limited only by time.
+/// \param par_man ParamManager reference with parameters of the scan.
+/// \param outputFileAndDirName Name of the output directory and file.
+/// \return 0 on success, -1 on errors.
+///
+int runScan(ParamManager& par_man, const std::string& outputFileAndDirName)
+{
+    const std::string outputDir = generalPrefix+outputFileAndDirName+"/";
+    const OutputOptions output = par_man.GetOutputType();
+    if(par_man.GetTreeSchema()==RNTUPLE)
+    {
+        std::cerr<<"[WARNING] RNTuples are not available in the scan mode, the flat tree schema is used."<<std::endl;
+        par_man.SetTreeSchema(FLAT_TREE);
+    }
+    if(par_man.IsListMode() || streamFile>=0 || par_man.IsSinogramEnabled() || !par_man.GetBarrels().empty())
+        std::cerr<<"[WARNING] List-mode output, sinograms and compared barrels are not available in the scan mode and are ignored."<<std::endl;
+    SourceList* sourceList = nullptr;
+    if(par_man.IsSourceFileSet())
+    {
+        try
+        {
+            sourceList = new SourceList(par_man.GetSourceFile());
+        }
+        catch(std::string e)
+        {
+            std::cerr<<e<<std::endl;
+            return -1;
+        }
+    }
+
+    TFile* treeFile = nullptr;
+    TDirectory* scanDir = nullptr;
+    TDirectory* histDir = nullptr;
+    ChunkedTree* tree = nullptr;
+    if(output!=PNG && output!=NO_OUTPUT)
+    {
+        treeFile = new TFile((outputDir+outputFileAndDirName+".root").c_str(), "recreate");
+        int compression = CompressionSettings(par_man.GetCompressionAlgorithm(), par_man.GetCompressionLevel());
+        if(compression>=0)
+            treeFile->SetCompressionSettings(compression);
+        scanDir = treeFile->mkdir("scan");
+        scanDir->cd();
+        try
+        {
+            if(par_man.GetEventTypeToSave()!=NONE)
+            {
+                if(par_man.IsChunked())
+                {
+                    chunkManifest = outputDir+outputFileAndDirName+"_chunks.txt";
+                    CreateChunkManifest(chunkManifest);
+                    tree = new ChunkedTree(outputDir, "scan", chunkManifest, par_man);
+                }
+                else
+                    tree = new ChunkedTree(scanDir, par_man);
+            }
+        }
+        catch(std::string e)
+        {
+            std::cerr<<e<<std::endl;
+            return -1;
+        }
+        histDir = scanDir->mkdir("Histograms");
+        histDir->cd();
+    }
+
+    std::vector<DecayType> types;
+    switch(par_man.GetNoOfGammas())
+    {
+        case 1: types.push_back(ONE); break;
+        case 2: types.push_back(TWO); break;
+        case 3: types.push_back(THREE); break;
+        case 4: types.push_back(TWOandONE); break;
+        case 5: types.push_back(TWOandN); break;
+        default:
+            types.push_back(TWO);
+            types.push_back(THREE);
+    }
+    std::vector<ScanChain> chains;
+    for(auto type : types)
+    {
+        ScanChain chain;
+        chain.type = type;
+        chain.typeString = recognizeType(type, chain.noOfGammas);
+        chain.decay = new PsDecay(type, par_man.GetHistogramGroups());
+        chain.cuts = new InitialCuts(type, par_man.GetR(), par_man.GetL(), par_man.GetEff(), par_man.GetHistogramGroups());
+        chain.cuts->SetGeometry(detectorGeometry);
+        chain.cuts->SetReweightEfficiencies(par_man.GetReweightEfficiencies());
+        chain.cs = new ComptonScattering(type, par_man.GetSmearLowLimit(), par_man.GetSmearHighLimit(), par_man.GetHistogramGroups());
+        if(par_man.IsSilentMode())
+        {
+            chain.decay->EnableSilentMode();
+            chain.cuts->EnableSilentMode();
+            chain.cs->EnableSilentMode();
+        }
+        chains.push_back(chain);
+    }
+
+    Event* eventDecay = nullptr;
+    Long64_t sourceIndex = 0;
+    FlatEvent flatEvent;
+    //the split branch needs the address of a real event, so it is created at the first saved event (see simulateDecay)
+    bool splitBranchConnected = false;
+    ChunkedTree::BranchSetup branchSetup = [&](TTree* newTree)
+    {
+        if(par_man.GetTreeSchema()==FLAT_TREE || par_man.GetTreeSchema()==SPARSE_TREE)
+            flatEvent.Branch(newTree, par_man.GetBasketSize(), par_man.GetTreeSchema()==SPARSE_TREE);
+        else if(eventDecay!=nullptr)
+            newTree->Branch("event_split", "Event", &eventDecay, par_man.GetBasketSize(), 99);
+        if(!newTree->GetBranch("sourceIndex"))
+            newTree->Branch("sourceIndex", &sourceIndex, "sourceIndex/L");
+    };
+    if(tree!=nullptr)
+        tree->SetBranchSetup(branchSetup);
+    const std::vector<double>& effs = par_man.GetReweightEfficiencies();
+    std::ofstream counters((outputDir+"scan_counters.txt").c_str());
+    counters<<"# index x[mm] y[mm] z[mm] type events gammas acceptedEvents acceptedGammas [reweightedEvents reweightedGammas]..."<<std::endl;
+    counters<<std::setprecision(10);
+
+    //the previous generator is replaced, not leaked
+    delete gRandom;
+    gRandom = new TRandom3(par_man.GetSeed());
+    std::vector<double> sourceParams;
+    long long skipped = 0;
+    for(sourceIndex=0; ; sourceIndex++)
+    {
+        try
+        {
+            if(sourceList ? !sourceList->Next(sourceParams) : sourceIndex>=par_man.GetSimRuns())
+                break;
+            if(!sourceList)
+                sourceParams = par_man.GetDataAt(sourceIndex);
+        }
+        catch(std::string e)
+        {
+            std::cerr<<e<<std::endl;
+            return -1;
+        }
+        sourceParams.resize(SourceList::kValues, 0.0);
+        double x = sourceParams[0];
+        double y = sourceParams[1];
+        double z = sourceParams[2];
+        double r = TMath::Abs(sourceParams[6]);
+        if(!detectorGeometry && ((TMath::Abs(x)+r)*(TMath::Abs(x)+r)+(TMath::Abs(y)+r)*(TMath::Abs(y)+r) >= par_man.GetR()*par_man.GetR() || (TMath::Abs(z)+r)>=par_man.GetL()))
+        {
+            skipped++;
+            continue;
+        }
+        TLorentzVector Ps(sourceParams[3]/1000000.0, sourceParams[4]/1000000.0, sourceParams[5]/1000000.0, 1.022/1000); //scaling back to GeV
+        TLorentzVector source(x, y, z, r);
+        for(auto& chain : chains)
+        {
+            double masses[3] = {0.0, 0.0, 0.0};
+            TGenPhaseSpace phaseSpaceGen;
+            phaseSpaceGen.SetDecay(Ps, chain.noOfGammas, masses);
+            //counters of a source are differences of counters of cuts, which are summed over all sources
+            const long long events = chain.cuts->GetNumberOfEvents();
+            const long long gammas = chain.cuts->GetNumberOfGammas();
+            const long long acceptedEvents = chain.cuts->GetAcceptedEvents();
+            const long long acceptedGammas = chain.cuts->GetAcceptedGammas();
+            std::vector<double> reweightedEvents(effs.size());
+            std::vector<double> reweightedGammas(effs.size());
+            for(unsigned ee=0; ee<effs.size(); ee++)
+            {
+                reweightedEvents[ee] = chain.cuts->GetReweightedEvents(ee);
+                reweightedGammas[ee] = chain.cuts->GetReweightedGammas(ee);
+            }
+            for(Int_t n=0; n<par_man.GetSimEvents(); n++)
+            {
+                try
+                {
+                    eventDecay = generateEvent(phaseSpaceGen, source, par_man, chain.type);
+                    chain.decay->AddEvent(eventDecay);
+                    if(phantom!=nullptr)
+                        phantom->Apply(eventDecay);
+                    chain.cuts->AddCuts(eventDecay);
+                    chain.cs->Scatter(eventDecay);
+                    if(tree!=nullptr && isEventSaved(par_man, eventDecay))
+                    {
+                        if(par_man.GetTreeSchema()!=SPLIT_TREE)
+                            flatEvent.Assign(eventDecay, par_man.GetTreeSchema()==SPARSE_TREE);
+                        else if(!splitBranchConnected)
+                        {
+                            tree->SetBranchSetup(branchSetup);
+                            splitBranchConnected = true;
+                        }
+                        tree->Fill();
+                    }
+                }
+                catch(std::string e)
+                {
+                    std::cerr<<e<<std::endl;
+                    exit(-1);
+                }
+                delete eventDecay;
+                eventDecay = nullptr;
+            }
+            counters<<sourceIndex<<" "<<x<<" "<<y<<" "<<z<<" "<<chain.typeString<<" "<<chain.cuts->GetNumberOfEvents()-events<<" "\
+                    <<chain.cuts->GetNumberOfGammas()-gammas<<" "<<chain.cuts->GetAcceptedEvents()-acceptedEvents<<" "\
+                    <<chain.cuts->GetAcceptedGammas()-acceptedGammas;
+            for(unsigned ee=0; ee<effs.size(); ee++)
+                counters<<" "<<chain.cuts->GetReweightedEvents(ee)-reweightedEvents[ee]<<" "<<chain.cuts->GetReweightedGammas(ee)-reweightedGammas[ee];
+            counters<<std::endl;
+        }
+        if(!par_man.IsSilentMode() && (sourceIndex+1)%10000==0)
+            std::cout<<"[INFO] "<<sourceIndex+1<<" sources simulated."<<std::endl;
+    }
+    std::cout<<"[INFO] "<<sourceIndex-skipped<<" sources simulated";
+    if(skipped>0)
+        std::cout<<", "<<skipped<<" sources outside the barrel skipped";
+    std::cout<<". Counters of cuts saved to "<<outputDir<<"scan_counters.txt"<<std::endl;
+    if(!counters)
+        std::cerr<<"[ERROR] Cannot write counters of cuts to: "<<outputDir<<"scan_counters.txt"<<std::endl;
+    delete sourceList;
+
+    if(tree)
+    {
+        tree->SetBranchSetup(ChunkedTree::BranchSetup()); //the setup refers to local variables
+        try
+        {
+            tree->Close();
+        }
+        catch(std::string e)
+        {
+            std::cerr<<e<<std::endl;
+            return -1;
+        }
+        if(!par_man.IsSilentMode())
+            std::cout<<"[INFO] "<<tree->GetEntries()<<" events of all sources saved to the tree."<<std::endl;
+        delete tree;
+    }
+    std::string imageDir = outputDir+"scan/";
+    if(output==PNG || output==BOTH)
+    {
+        mkdir(imageDir.c_str(), ACCESSPERMS);
+        chmod(imageDir.c_str(), ACCESSPERMS);
+    }
+    for(auto& chain : chains)
+    {
+        if(output==RAW)
+        {
+            TDirectory* rawDir = histDir->mkdir(RawDirectoryName(chain.type).c_str());
+            rawDir->cd();
+            chain.decay->WriteHistograms();
+            chain.cuts->WriteHistograms();
+            chain.cs->WriteHistograms();
+        }
+        else if(output!=NO_OUTPUT)
+        {
+            if(histDir)
+                histDir->cd();
+            chain.decay->DrawHistograms(imageDir, output);
+            chain.cuts->DrawHistograms(imageDir, output);
+            chain.cs->DrawComptonHistograms(imageDir, output);
+        }
+        delete chain.decay;
+        delete chain.cuts;
+        delete chain.cs;
+    }
+    if(treeFile)
+    {
+        treeFile->Write();
+        treeFile->Close();
+        delete treeFile;
+    }
+    return 0;
+}
+
+///
+/// \brief runSimulation Simulates all runs with one set of parameters and stores them in results/<name>/<name>.root.
+/// \param par_man ParamManager reference with parameters of the simulation.
+/// \param outputFileAndDirName Name of the output directory and file.
+/// \return 0 on success, -1 if the output cannot be created.
+///
+int runSimulation(ParamManager& par_man, const std::string& outputFileAndDirName)
+{
+    if(par_man.IsScanMode())
+        return runScan(par_man, outputFileAndDirName);
+    TFile *treeFile = nullptr;
+    ChunkedTree *tree = nullptr;
+    if(par_man.GetOutputType() != PNG && par_man.GetOutputType() != NO_OUTPUT) //if necessary, create a file to store a tree
+    {
+      treeFile = new TFile((generalPrefix+outputFileAndDirName+"/"+outputFileAndDirName+".root").c_str(), "recreate");
+      int compression = CompressionSettings(par_man.GetCompressionAlgorithm(), par_man.GetCompressionLevel());
+      if(compression>=0)
+          treeFile->SetCompressionSettings(compression);
+      treeFile->cd();
+      if(par_man.GetTreeSchema()==RNTUPLE && !NTupleWriter::IsAvailable())
+      {
+          std::cerr<<"[ERROR] treeSchema := ntuple requires ROOT 6.32 or newer!"<<std::endl;
+          return -1;
+      }
+      if(par_man.IsChunked() && par_man.GetTreeSchema()==RNTUPLE)
+          std::cerr<<"[WARNING] RNTuple output is not split into chunks, chunkEvents and chunkSize are ignored."<<std::endl;
+      else if(par_man.IsChunked() && par_man.GetEventTypeToSave()!=NONE)
+      {
+          chunkManifest = generalPrefix+outputFileAndDirName+"/"+outputFileAndDirName+"_chunks.txt";
+          try
+          {
+              CreateChunkManifest(chunkManifest);
+          }
+          catch(std::string e)
+          {
+              std::cerr<<e<<std::endl;
+              return -1;
+          }
+      }
+    }
+
+    //setting the seed for global pseudo-random number generator, the previous generator is replaced, not leaked
+    delete gRandom;
+    gRandom = new TRandom3(par_man.GetSeed());
+    const size_t firstCounter = cutCounters.size();
+    //loop with simulation runs
+    for(int ii=0; ii< (par_man.GetSimRuns()); ii++)
+    {
+        std::cout<<":::::::::::: START OF RUN NO: "<<ii+1<<" ::::::::::::"<<std::endl;
+        tree = simulate(ii, par_man, treeFile, outputFileAndDirName+"/");
+        if(tree)
+        {
+            try
+            {
+                tree->Close();
+            }
+            catch(std::string e)
+            {
+                std::cerr<<e<<std::endl;
+                return -1;
+            }
+            if(tree->IsChunked() && !par_man.IsSilentMode())
+                std::cout<<"[INFO] "<<tree->GetEntries()<<" events saved in "<<tree->GetNumberOfChunks()<<" files listed in "<<chunkManifest<<std::endl;
+            delete tree;
+        }
+        std::cout<<":::::::::::: END OF RUN NO:  "<<ii+1<<" ::::::::::::"<<"\n"<<std::endl;
+    }
+    if(treeFile)
+    {
+        treeFile->Write();
+        treeFile->Close();
+        delete treeFile;
+    }
+    if(!par_man.GetBarrels().empty())
+        writeBarrelTable(par_man, generalPrefix+outputFileAndDirName+"/barrels.txt", firstCounter);
+    if(par_man.IsEffReweighting())
+        writeReweightingTable(par_man, generalPrefix+outputFileAndDirName+"/efficiency_reweighting.txt", firstCounter);
+    return 0;
+}
+
+///
+/// \brief sweepPointName Name of the output directory and file of a point of the sweep.
+/// \param outputFileAndDirName Name of the sweep.
+/// \param point Index of the point.
+/// \return Name in the form <name>_pNNNN.
+///
+std::string sweepPointName(const std::string& outputFileAndDirName, int point)
+{
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), "_p%04d", point);
+    return outputFileAndDirName+suffix;
+}
+
+///
+/// \brief runSweep Simulates all points of the parameter sweep in separate processes, at most "threads" of them at once.
+/// Every point is stored as a separate simulation in results/<name>_pNNNN/, the table with counters of cuts of all points
+/// is saved to results/<name>/sweep_summary.txt.
+/// \param par_man ParamManager reference with the sweep.
+/// \param outputFileAndDirName Name of the sweep.
+/// \return 0 if all points were simulated, -1 otherwise.
+///
+int runSweep(ParamManager& par_man, const std::string& outputFileAndDirName)
+{
+    const int nPoints = par_man.GetNumberOfSweepPoints();
+    const unsigned maxProcesses = par_man.GetThreads()>0 ? par_man.GetThreads() : std::max(1u, std::thread::hardware_concurrency());
+    std::cout<<"[INFO] Simulating "<<nPoints<<" points of the sweep in up to "<<maxProcesses<<" processes."<<std::endl;
+    std::map<pid_t, int> running; //process of every simulated point
+    int failed = 0;
+    int next = 0;
+    while(next<nPoints || !running.empty())
+    {
+        if(next<nPoints && running.size()<maxProcesses)
+        {
+            //buffered output would be written by both processes
+            std::cout.flush();
+            std::cerr.flush();
+            pid_t pid = fork();
+            if(pid==0)
+            {
+                std::string pointName = sweepPointName(outputFileAndDirName, next);
+                mkdir((generalPrefix+pointName).c_str(), ACCESSPERMS);
+                chmod((generalPrefix+pointName).c_str(), ACCESSPERMS);
+                int status = -1;
+                try
+                {
+                    ParamManager point = par_man.GetSweepPoint(next);
+                    status = runSimulation(point, pointName);
+                }
+                catch(std::string e)
+                {
+                    std::cerr<<e<<std::endl;
+                }
+                if(status==0)
+                    status = writeCutCounters(generalPrefix+pointName+"/counters.txt");
+                std::cout.flush();
+                std::cerr.flush();
+                _exit(status==0 ? 0 : 1);
+            }
+            else if(pid<0)
+            {
+                std::cerr<<"[ERROR] Cannot start the process of the sweep point "<<next<<"!"<<std::endl;
+                failed++;
+            }
+            else
+                running[pid] = next;
+            next++;
+        }
+        else
+        {
+            int status = 0;
+            pid_t pid = wait(&status);
+            if(pid<0)
+                break;
+            if(!WIFEXITED(status) || WEXITSTATUS(status)!=0)
+            {
+                std::cerr<<"[ERROR] Simulation of the sweep point "<<running[pid]<<" failed!"<<std::endl;
+                failed++;
+            }
+            else
+                std::cout<<"[INFO] Sweep point "<<running[pid]<<" finished."<<std::endl;
+            running.erase(pid);
+        }
+    }
+
+    //one row per point, source and decay type
+    const std::vector<SweepAxis>& axes = par_man.GetSweepAxes();
+    std::string summaryPath = generalPrefix+outputFileAndDirName+"/sweep_summary.txt";
+    std::ofstream summary(summaryPath.c_str());
+    std::ostringstream header;
+    header<<"# point";
+    for(unsigned aa=0; aa<axes.size(); aa++)
+        header<<" "<<axes[aa].name;
+    header<<" x[mm] y[mm] z[mm] type geometry events acceptedEvents acceptedGammas eventAcceptance gammaAcceptance";
+    summary<<header.str()<<std::endl;
+    std::cout<<"[INFO] Summary of the sweep:\n"<<header.str()<<std::endl;
+    for(int ii=0; ii<nPoints; ii++)
+    {
+        //values of scanned parameters, the last one changes the fastest as in ParamManager::GetSweepPoint
+        std::vector<double> pointValues(axes.size());
+        for(int aa=axes.size()-1, index=ii; aa>=0; aa--)
+        {
+            pointValues[aa] = axes[aa].values[index%axes[aa].values.size()];
+            index /= axes[aa].values.size();
+        }
+        std::ostringstream values;
+        values<<ii;
+        for(unsigned aa=0; aa<axes.size(); aa++)
+            values<<" "<<pointValues[aa];
+        std::vector<CutCounters> counters = readCutCounters(generalPrefix+sweepPointName(outputFileAndDirName, ii)+"/counters.txt");
+        for(unsigned cc=0; cc<counters.size(); cc++)
+        {
+            const CutCounters& c = counters[cc];
+            std::ostringstream row;
+            row<<values.str()<<" "<<c.x<<" "<<c.y<<" "<<c.z<<" "<<c.type<<" "<<c.geometry<<" "<<c.events<<" "<<c.acceptedEvents<<" "<<c.acceptedGammas\
+               <<" "<<(c.events>0 ? double(c.acceptedEvents)/c.events : 0.0)<<" "<<(c.gammas>0 ? double(c.acceptedGammas)/c.gammas : 0.0);
+            summary<<row.str()<<std::endl;
+            std::cout<<row.str()<<std::endl;
+        }
+    }
+    if(!summary)
+        std::cerr<<"[ERROR] Cannot write the summary of the sweep to: "<<summaryPath<<std::endl;
+    else
+        std::cout<<"[INFO] Summary of the sweep saved to "<<summaryPath<<std::endl;
+    return failed==0 ? 0 : -1;
+}
+
 ///
 /// \brief main Main function of the program.
 /// \param argc Number of provided arguments.
@@ -231,6 +1337,15 @@ TTree* simulate(const int simRun, ParamManager& pManag, TFile* treeFile, std::st
 ///
 int main(int argc, char* argv[])
 {
+  //the target of the stream is read first, because the standard output is redirected before anything is printed
+  std::string streamTarget;
+  for(int nn=1; nn+1<argc; nn++)
+  {
+      if(std::string(argv[nn]) == "-s")
+          streamTarget = argv[nn+1];
+  }
+  if(streamTarget == "-")
+      std::cout.rdbuf(std::cerr.rdbuf()); //messages go to stderr, stdout carries only list-mode records
   PrintConstants(); //prints physics constants values implemented in code
   ParamManager par_man;
   bool pars_imported = false;
@@ -268,6 +1383,11 @@ int main(int argc, char* argv[])
               par_man.Import2nNdata(argv[nn+1]);
               nn +=1;
           }
+          else if(std::string(argv[nn]) == "-s")
+          {
+              //already read, list-mode records are streamed to stdout ("-") or to a named pipe
+              nn +=1;
+          }
       }
   }
 
@@ -282,40 +1402,122 @@ int main(int argc, char* argv[])
       par_man.Import2nNdata();
       par_man.Print2nNdata();
   }
+  if(par_man.IsSourceFileSet() && !par_man.IsScanMode())
+  {
+      //every source is a separate run with its own directories, so the whole list is loaded
+      std::vector<std::vector<double> > sources;
+      try
+      {
+          SourceList sourceList(par_man.GetSourceFile());
+          std::vector<double> source;
+          while(sourceList.Next(source))
+              sources.push_back(source);
+      }
+      catch(std::string e)
+      {
+          std::cerr<<e<<std::endl;
+          return -1;
+      }
+      if(sources.size()>10000)
+          std::cerr<<"[WARNING] "<<sources.size()<<" sources are simulated in separate runs, consider scan := 1."<<std::endl;
+      par_man.SetSources(sources);
+  }
   //creating directories for storing the results
-  mkdir(generalPrefix.c_str(), ACCESSPERMS);
-  chmod(generalPrefix.c_str(), ACCESSPERMS);
-  mkdir((generalPrefix+outputFileAndDirName).c_str(), ACCESSPERMS);
-  chmod((generalPrefix+outputFileAndDirName).c_str(), ACCESSPERMS);
-
-  TFile *treeFile = nullptr;
-  TTree *tree = nullptr;
-  if(par_man.GetOutputType() != PNG) //if necessary, create a file to store a tree
+  if(par_man.GetOutputType()!=NO_OUTPUT || par_man.IsListMode() || par_man.IsAcceptanceMapMode() || par_man.IsSweep() || \
+     par_man.IsEffReweighting() || !par_man.GetBarrels().empty())
+  {
+      mkdir(generalPrefix.c_str(), ACCESSPERMS);
+      chmod(generalPrefix.c_str(), ACCESSPERMS);
+      mkdir((generalPrefix+outputFileAndDirName).c_str(), ACCESSPERMS);
+      chmod((generalPrefix+outputFileAndDirName).c_str(), ACCESSPERMS);
+  }
+
+  if(par_man.IsAcceptanceMapMode())
+  {
+      if(par_man.IsSweep())
+          std::cerr<<"[WARNING] Parameter sweeps are not supported in the acceptance map mode, the first values are used."<<std::endl;
+      if(par_man.IsEffReweighting())
+          std::cerr<<"[WARNING] Acceptance maps are geometric, reweightEff is ignored."<<std::endl;
+      if(!par_man.GetBarrels().empty())
+          std::cerr<<"[WARNING] Compared barrels are not supported in the acceptance map mode and are ignored."<<std::endl;
+      simulateAcceptance(par_man, generalPrefix+outputFileAndDirName+"/");
+      std::cout<<"\n:::::::::::: END OF PROGRAM. ::::::::::::\n"<<std::endl;
+      return 0;
+  }
+
+  if(par_man.IsGeometryFileSet())
   {
-    treeFile = new TFile((generalPrefix+outputFileAndDirName+"/"+outputFileAndDirName+".root").c_str(), "recreate");
-    treeFile->cd();
+      try
+      {
+          detectorGeometry = new DetectorGeometry;
+          detectorGeometry->Import(par_man.GetGeometryFile());
+          detectorGeometry->Print();
+      }
+      catch(std::string e)
+      {
+          std::cerr<<"[ERROR] "<<e<<std::endl;
+          return -1;
+      }
   }
 
-  //setting the seed for global pseudo-random number generator
-  gRandom = new TRandom3(par_man.GetSeed());
-  //loop with simulation runs
-  for(int ii=0; ii< (par_man.GetSimRuns()); ii++)
+  //the phantom is built once, its volume and tables are shared by all runs
+  if(par_man.GetPhantomUse())
   {
-      std::cout<<":::::::::::: START OF RUN NO: "<<ii+1<<" ::::::::::::"<<std::endl;
-      tree = simulate(ii, par_man, treeFile, outputFileAndDirName+"/");
-      if(tree)
+      try
+      {
+          phantom = new Phantom(par_man);
+      }
+      catch(std::string e)
       {
-          tree->Write();
-          delete tree;
+          std::cerr<<e<<std::endl;
+          return -1;
       }
-      std::cout<<":::::::::::: END OF RUN NO:  "<<ii+1<<" ::::::::::::"<<"\n"<<std::endl;
   }
-  if(treeFile)
+
+  try
+  {
+      eventFilter = EventFilter(par_man.GetFilter());
+  }
+  catch(std::string e)
+  {
+      std::cerr<<"[ERROR] "<<e<<std::endl;
+      return -1;
+  }
+
+  if(par_man.IsResultCache())
+  {
+      if(par_man.GetSeed()==0)
+          std::cerr<<"[WARNING] Results can be cached only with a fixed seed! Result cache disabled."<<std::endl;
+      else if(par_man.IsListMode() || !streamTarget.empty() || par_man.IsChunked() || par_man.GetTreeSchema()==RNTUPLE || par_man.IsScanMode())
+          std::cerr<<"[WARNING] Result cache does not support list-mode output, chunked trees, RNTuples and the scan mode! Result cache disabled."<<std::endl;
+      else
+          resultCache = new ResultCache(par_man.GetCacheDir());
+  }
+  if(par_man.IsSweep() && !streamTarget.empty())
+  {
+      std::cerr<<"[ERROR] List-mode records of a parameter sweep cannot be streamed, use listMode := 1 instead!"<<std::endl;
+      return -1;
+  }
+  if(!streamTarget.empty())
   {
-      treeFile->Write();
-      treeFile->Close();
-      delete treeFile;
+      //a reader that quits is reported as an error of write() instead of killing the process
+      signal(SIGPIPE, SIG_IGN);
+      if(streamTarget != "-")
+          std::cout<<"[INFO] Waiting for a reader of the stream "<<streamTarget<<std::endl;
+      streamFile = streamTarget == "-" ? STDOUT_FILENO : open(streamTarget.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if(streamFile<0)
+      {
+          std::cerr<<"[ERROR] Cannot open the stream: "<<streamTarget<<std::endl;
+          return -1;
+      }
   }
+
+  int status = par_man.IsSweep() ? runSweep(par_man, outputFileAndDirName) : runSimulation(par_man, outputFileAndDirName);
+  if(streamFile>=0 && streamFile!=STDOUT_FILENO)
+      close(streamFile);
+  delete detectorGeometry;
+  delete phantom;
+  delete resultCache;
   std::cout<<"\n:::::::::::: END OF PROGRAM. ::::::::::::\n"<<std::endl;
-  return 0;
+  return status;
 }
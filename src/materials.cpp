@@ -0,0 +1,424 @@
+/// @file materials.cpp
+/// @date 19.10.2026
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#include "TMath.h"
+#include "constants.h"
+#include "hash.h"
+#include "materials.h"
+
+//identifies files with cached tables
+static const char kTableMagic[8] = {'J', 'P', 'E', 'T', 'M', 'A', 'T', '1'};
+//logarithms of limits of the energy grid [MeV]
+static const double kLogEMin = std::log(1e-3);
+static const double kLogEMax = std::log(10.0);
+static const double kLogStep = (kLogEMax-kLogEMin)/(MaterialTable::kGridPoints-1);
+//coefficients smaller than that are stored as that, so that their logarithms are finite
+static const double kMinCoefficient = 1e-30;
+static const double kAvogadro = 6.02214076e23;
+static const double kBarn = 1e-24; //[cm^2]
+//standard atomic weights of elements 1-92
+static const double kAtomicWeights[] = {1.008, 4.0026, 6.94, 9.0122, 10.81, 12.011, 14.007, 15.999, 18.998, 20.180,
+    22.990, 24.305, 26.982, 28.085, 30.974, 32.06, 35.45, 39.948, 39.098, 40.078, 44.956, 47.867, 50.942, 51.996, 54.938,
+    55.845, 58.933, 58.693, 63.546, 65.38, 69.723, 72.630, 74.922, 78.971, 79.904, 83.798, 85.468, 87.62, 88.906, 91.224,
+    92.906, 95.95, 98.0, 101.07, 102.91, 106.42, 107.87, 112.41, 114.82, 118.71, 121.76, 127.60, 126.90, 131.29, 132.91,
+    137.33, 138.91, 140.12, 140.91, 144.24, 145.0, 150.36, 151.96, 157.25, 158.93, 162.50, 164.93, 167.26, 168.93, 173.05,
+    174.97, 178.49, 180.95, 183.84, 186.21, 190.23, 192.22, 195.08, 196.97, 200.59, 204.38, 207.2, 208.98, 209.0, 210.0,
+    222.0, 223.0, 226.0, 227.0, 232.04, 231.04, 238.03};
+static const int kMaxZ = sizeof(kAtomicWeights)/sizeof(kAtomicWeights[0]);
+
+///
+/// \brief water Definition of water, which is always available.
+///
+static Material water()
+{
+    Material material;
+    material.name = "water";
+    material.density = 1.0;
+    material.elements.push_back(std::make_pair(1, 0.111894));
+    material.elements.push_back(std::make_pair(8, 0.888106));
+    return material;
+}
+
+///
+/// \brief MaterialTable::MaterialTable Constructor of a table with water only, coefficients are not computed yet.
+///
+MaterialTable::MaterialTable() :
+    fComputed_(false)
+{
+    AddMaterial(water());
+}
+
+///
+/// \brief MaterialTable::MaterialTable Constructor of a table with water and materials defined in a file, coefficients are
+/// not computed yet.
+/// \param definitions Path of the file with definitions of materials.
+///
+MaterialTable::MaterialTable(const std::string& definitions) :
+    fComputed_(false)
+{
+    AddMaterial(water());
+    ReadDefinitions_(definitions);
+}
+
+///
+/// \brief MaterialTable::ReadDefinitions_ Reads definitions of materials.
+/// \param definitions Path of the file.
+///
+void MaterialTable::ReadDefinitions_(const std::string& definitions)
+{
+    std::ifstream file(definitions.c_str());
+    if(!file)
+        throw(std::string("[ERROR] Cannot open the file with materials: ")+definitions);
+    std::string line;
+    while(std::getline(file, line))
+    {
+        size_t start = line.find_first_not_of(" \t\r");
+        if(start==std::string::npos || line[start]=='#')
+            continue;
+        std::istringstream fields(line.substr(0, line.find('#')));
+        Material material;
+        std::string token;
+        if(!(fields>>material.name>>material.density) || material.density<=0)
+            throw(std::string("[ERROR] Invalid material in ")+definitions+": "+line);
+        double sum = 0.0;
+        while(fields>>token)
+        {
+            int Z = 0;
+            double fraction = 0.0;
+            char separator = 0;
+            std::istringstream element(token);
+            if(token.compare(0, 6, "table:")==0 && material.elements.empty())
+                material.table = token.substr(6);
+            else if((element>>Z>>separator>>fraction) && separator==':' && Z>=1 && Z<=kMaxZ && fraction>0 && material.table.empty())
+            {
+                material.elements.push_back(std::make_pair(Z, fraction));
+                sum += fraction;
+            }
+            else
+                throw(std::string("[ERROR] Invalid element of material in ")+definitions+": "+line);
+        }
+        if(material.table.empty() && material.elements.empty())
+            throw(std::string("[ERROR] Material without elements in ")+definitions+": "+line);
+        //mass fractions are normalized, so that rounded compositions can be used
+        for(unsigned ii=0; ii<material.elements.size(); ii++)
+            material.elements[ii].second /= sum;
+        AddMaterial(material);
+    }
+}
+
+///
+/// \brief MaterialTable::AddMaterial Adds a material or replaces the one with the same name.
+/// \param material Definition of the material.
+///
+void MaterialTable::AddMaterial(const Material& material)
+{
+    int index = GetIndex(material.name);
+    if(index>=0)
+        fMaterials_[index] = material;
+    else
+        fMaterials_.push_back(material);
+    fComputed_ = false;
+}
+
+///
+/// \brief MaterialTable::GetIndex Finds a material.
+/// \param name Name of the material.
+/// \return Index of the material, -1 if it is not defined.
+///
+int MaterialTable::GetIndex(const std::string& name) const
+{
+    for(unsigned ii=0; ii<fMaterials_.size(); ii++)
+        if(fMaterials_[ii].name==name)
+            return ii;
+    return -1;
+}
+
+///
+/// \brief MaterialTable::GetGridEnergy Energy of a point of the grid.
+/// \param point Index of the point.
+/// \return Energy in MeV.
+///
+double MaterialTable::GetGridEnergy(int point)
+{
+    return std::exp(kLogEMin+point*kLogStep);
+}
+
+///
+/// \brief MaterialTable::KleinNishina Total Klein-Nishina cross section of a free electron.
+/// \param E Energy of the photon in MeV.
+/// \return Cross section in cm^2.
+///
+double MaterialTable::KleinNishina(double E)
+{
+    const double rElectron = 2.8179403262e-13; //classical electron radius in cm
+    double k = E/static_cast<double>(e_mass_MeV);
+    if(k<1e-3)
+    {
+        //Thomson limit, the full formula loses precision
+        return 8.0/3.0*TMath::Pi()*rElectron*rElectron*(1.0-2.0*k);
+    }
+    double k2 = 1.0+2.0*k;
+    double logk2 = std::log(k2);
+    return 2.0*TMath::Pi()*rElectron*rElectron*((1.0+k)/(k*k)*(2.0*(1.0+k)/k2-logk2/k)+logk2/(2.0*k)-(1.0+3.0*k)/(k2*k2));
+}
+
+///
+/// \brief MaterialTable::CrossSection Cross section of an atom.
+/// \param Z Atomic number.
+/// \param type Type of the interaction, TOTAL_ATTENUATION gives the sum of all types.
+/// \param E Energy of the photon in MeV.
+/// \return Cross section in cm^2.
+///
+double MaterialTable::CrossSection(int Z, InteractionType type, double E)
+{
+    const double ratio = E/0.1; //parametrizations are fitted at 100 keV
+    switch(type)
+    {
+        case PHOTOELECTRIC:
+            return 1.07e-5*kBarn*std::pow(Z, 4.3)/(ratio*ratio*ratio);
+        case COMPTON:
+            return Z*KleinNishina(E);
+        case RAYLEIGH:
+            return 8.3e-4*kBarn*std::pow(Z, 2.5)/(ratio*ratio);
+        default:
+            return CrossSection(Z, PHOTOELECTRIC, E)+CrossSection(Z, COMPTON, E)+CrossSection(Z, RAYLEIGH, E);
+    }
+}
+
+///
+/// \brief MaterialTable::ReadTable_ Reads mass attenuation coefficients exported from XCOM and interpolates them
+/// on the grid (log-log, the first and the last segment are extrapolated).
+/// \param material Material with the path of the table.
+/// \param massCoefficients Output, kGridPoints values of photoelectric, Compton and Rayleigh coefficients [cm^2/g].
+///
+void MaterialTable::ReadTable_(const Material& material, double* massCoefficients) const
+{
+    std::ifstream file(material.table.c_str());
+    if(!file)
+        throw(std::string("[ERROR] Cannot open the table of material ")+material.name+": "+material.table);
+    std::vector<double> logE;
+    std::vector<double> logMu[3]; //photoelectric, Compton, Rayleigh
+    std::string line;
+    while(std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        double values[4];
+        if(!(fields>>values[0]>>values[1]>>values[2]>>values[3]) || values[0]<=0)
+            continue; //headers
+        //duplicated energies of absorption edges are shifted slightly, so that the grid is increasing
+        double energy = std::log(values[0]);
+        if(!logE.empty() && energy<=logE.back())
+            energy = logE.back()+1e-9;
+        logE.push_back(energy);
+        logMu[PHOTOELECTRIC].push_back(std::log(std::max(values[3], kMinCoefficient)));
+        logMu[COMPTON].push_back(std::log(std::max(values[2], kMinCoefficient)));
+        logMu[RAYLEIGH].push_back(std::log(std::max(values[1], kMinCoefficient)));
+    }
+    if(logE.size()<2)
+        throw(std::string("[ERROR] Table of material ")+material.name+" has less than 2 energies: "+material.table);
+    unsigned segment = 0;
+    for(int ii=0; ii<kGridPoints; ii++)
+    {
+        double energy = kLogEMin+ii*kLogStep;
+        while(segment+2<logE.size() && energy>logE[segment+1])
+            segment++;
+        double fraction = (energy-logE[segment])/(logE[segment+1]-logE[segment]);
+        for(int type=0; type<3; type++)
+        {
+            const std::vector<double>& mu = logMu[type];
+            massCoefficients[type*kGridPoints+ii] = std::exp(mu[segment]+fraction*(mu[segment+1]-mu[segment]));
+        }
+    }
+}
+
+///
+/// \brief MaterialTable::Compute Computes coefficients of all materials on the grid.
+///
+void MaterialTable::Compute()
+{
+    fLogMu_.assign(fMaterials_.size()*kColumns*kGridPoints, 0.0);
+    std::vector<double> massCoefficients(3*kGridPoints);
+    for(unsigned mm=0; mm<fMaterials_.size(); mm++)
+    {
+        const Material& material = fMaterials_[mm];
+        if(!material.table.empty())
+            ReadTable_(material, massCoefficients.data());
+        else
+        {
+            std::fill(massCoefficients.begin(), massCoefficients.end(), 0.0);
+            for(unsigned ee=0; ee<material.elements.size(); ee++)
+            {
+                int Z = material.elements[ee].first;
+                double atomsPerGram = material.elements[ee].second*kAvogadro/kAtomicWeights[Z-1];
+                for(int type=0; type<3; type++)
+                    for(int ii=0; ii<kGridPoints; ii++)
+                        massCoefficients[type*kGridPoints+ii] += atomsPerGram*CrossSection(Z, static_cast<InteractionType>(type), \
+                                                                                           GetGridEnergy(ii));
+            }
+        }
+        //[cm^2/g]*[g/cm^3] gives 1/cm, coefficients are stored in 1/mm
+        for(int ii=0; ii<kGridPoints; ii++)
+        {
+            double total = 0.0;
+            for(int type=0; type<3; type++)
+            {
+                double mu = massCoefficients[type*kGridPoints+ii]*material.density/10.0;
+                total += mu;
+                fLogMu_[(mm*kColumns+type)*kGridPoints+ii] = std::log(std::max(mu, kMinCoefficient));
+            }
+            fLogMu_[(mm*kColumns+TOTAL_ATTENUATION)*kGridPoints+ii] = std::log(std::max(total, kMinCoefficient));
+        }
+    }
+    fComputed_ = true;
+}
+
+///
+/// \brief MaterialTable::GetAttenuation Linear attenuation coefficient, interpolated log-log between points of the grid.
+/// \param material Index of the material.
+/// \param E Energy of the photon in MeV.
+/// \param type Type of the interaction.
+/// \return Attenuation coefficient in 1/mm.
+///
+double MaterialTable::GetAttenuation(int material, double E, InteractionType type) const
+{
+    double position = (std::log(E)-kLogEMin)/kLogStep;
+    int point = std::min(std::max(static_cast<int>(position), 0), kGridPoints-2);
+    double fraction = position-point;
+    const double* column = Column_(material, type);
+    return std::exp(column[point]+fraction*(column[point+1]-column[point]));
+}
+
+///
+/// \brief MaterialTable::GetAttenuations Linear attenuation coefficients of all types of interactions.
+/// \param material Index of the material.
+/// \param E Energy of the photon in MeV.
+/// \param mu Output, kColumns coefficients in 1/mm ordered as InteractionType.
+///
+void MaterialTable::GetAttenuations(int material, double E, double* mu) const
+{
+    double position = (std::log(E)-kLogEMin)/kLogStep;
+    int point = std::min(std::max(static_cast<int>(position), 0), kGridPoints-2);
+    double fraction = position-point;
+    for(int type=0; type<kColumns; type++)
+    {
+        const double* column = Column_(material, type);
+        mu[type] = std::exp(column[point]+fraction*(column[point+1]-column[point]));
+    }
+}
+
+///
+/// \brief MaterialTable::GetKey Describes everything the table depends on, including contents of loaded tables.
+/// \return Human-readable key, stored also in the cache file.
+///
+std::string MaterialTable::GetKey() const
+{
+    std::ostringstream key;
+    key<<std::setprecision(10);
+    key<<"version=1 grid="<<kGridPoints<<","<<kLogEMin<<","<<kLogEMax;
+    for(unsigned ii=0; ii<fMaterials_.size(); ii++)
+    {
+        const Material& material = fMaterials_[ii];
+        key<<" "<<material.name<<"="<<material.density;
+        for(unsigned ee=0; ee<material.elements.size(); ee++)
+            key<<","<<material.elements[ee].first<<":"<<material.elements[ee].second;
+        if(!material.table.empty())
+        {
+            std::ifstream file(material.table.c_str(), std::ios::binary);
+            std::ostringstream contents;
+            contents<<file.rdbuf();
+            key<<",table:"<<std::hex<<fnv1a(contents.str())<<std::dec;
+        }
+    }
+    return key.str();
+}
+
+///
+/// \brief MaterialTable::GetCacheFileName
+/// \return Name of the file (without directory) in which the table is cached.
+///
+std::string MaterialTable::GetCacheFileName() const
+{
+    std::ostringstream name;
+    name<<"materials_"<<std::hex<<std::setw(16)<<std::setfill('0')<<fnv1a(GetKey())<<".bin";
+    return name.str();
+}
+
+///
+/// \brief MaterialTable::Save Writes the table to the cache directory.
+/// \param cacheDir Path to the cache directory (with trailing slash).
+/// \return True if succeeded.
+///
+bool MaterialTable::Save(const std::string& cacheDir) const
+{
+    if(!fComputed_)
+        return false;
+    std::ofstream out((cacheDir+GetCacheFileName()).c_str(), std::ios::binary);
+    if(!out)
+        return false;
+    std::string key = GetKey();
+    uint32_t keyLength = key.size();
+    uint64_t noOfValues = fLogMu_.size();
+    out.write(kTableMagic, sizeof(kTableMagic));
+    out.write(reinterpret_cast<const char*>(&keyLength), sizeof(keyLength));
+    out.write(key.data(), keyLength);
+    out.write(reinterpret_cast<const char*>(&noOfValues), sizeof(noOfValues));
+    out.write(reinterpret_cast<const char*>(fLogMu_.data()), noOfValues*sizeof(double));
+    return out.good();
+}
+
+///
+/// \brief MaterialTable::Load Reads the table from the cache directory. The key stored in the file must match the key of this table.
+/// \param cacheDir Path to the cache directory (with trailing slash).
+/// \return True if the table was found and loaded.
+///
+bool MaterialTable::Load(const std::string& cacheDir)
+{
+    std::ifstream in((cacheDir+GetCacheFileName()).c_str(), std::ios::binary);
+    if(!in)
+        return false;
+    char magic[sizeof(kTableMagic)];
+    uint32_t keyLength = 0;
+    uint64_t noOfValues = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&keyLength), sizeof(keyLength));
+    if(!in || std::memcmp(magic, kTableMagic, sizeof(kTableMagic))!=0 || keyLength>65536)
+        return false;
+    std::string key(keyLength, ' ');
+    in.read(&key[0], keyLength);
+    in.read(reinterpret_cast<char*>(&noOfValues), sizeof(noOfValues));
+    if(!in || key!=GetKey() || noOfValues!=fMaterials_.size()*kColumns*kGridPoints)
+        return false;
+    fLogMu_.resize(noOfValues);
+    in.read(reinterpret_cast<char*>(fLogMu_.data()), noOfValues*sizeof(double));
+    fComputed_ = in.good();
+    return fComputed_;
+}
+
+///
+/// \brief MaterialTable::LoadOrCompute Loads the table from cache, computes and caches it if it is not there.
+/// \param cacheDir Path to the cache directory (with trailing slash).
+/// \param silent If true, less output is printed.
+///
+void MaterialTable::LoadOrCompute(const std::string& cacheDir, bool silent)
+{
+    if(Load(cacheDir))
+    {
+        if(!silent) std::cout<<"[INFO] Tables of materials loaded from cache: "<<cacheDir+GetCacheFileName()<<std::endl;
+        return;
+    }
+    Compute();
+    if(Save(cacheDir))
+    {
+        if(!silent) std::cout<<"[INFO] Tables of materials saved to cache: "<<cacheDir+GetCacheFileName()<<std::endl;
+    }
+    else
+        std::cerr<<"[WARNING] Unable to save tables of materials to: "<<cacheDir+GetCacheFileName()<<std::endl;
+}
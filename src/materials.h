@@ -0,0 +1,84 @@
+/// @file materials.h
+/// @date 19.10.2026
+///
+/// Attenuation coefficients of materials tabulated on a logarithmic energy grid, so that transport of photons queries
+/// them with a log-log interpolation instead of evaluating cross sections. Materials are defined in a text file
+/// (see materials.mat), one per line: name density[g/cm^3] Z:massFraction ..., or name density table:path, where path
+/// is a table of mass attenuation coefficients exported from NIST XCOM (energy [MeV], coherent, incoherent and
+/// photoelectric [cm^2/g], further columns are ignored). Water is always defined.
+#ifndef MATERIALS_H
+#define MATERIALS_H
+#include <string>
+#include <vector>
+#include <utility>
+
+///
+/// \brief The InteractionType enum Columns of tables of attenuation coefficients.
+///
+enum InteractionType
+{
+    PHOTOELECTRIC = 0,
+    COMPTON = 1,
+    RAYLEIGH = 2,
+    TOTAL_ATTENUATION = 3
+};
+
+///
+/// \brief The Material struct Definition of a material.
+///
+struct Material
+{
+    std::string name;
+    double density; //[g/cm^3]
+    std::vector<std::pair<int, double>> elements; //atomic numbers and mass fractions, empty if the table is loaded
+    std::string table; //file with mass attenuation coefficients, empty if they are computed from elements
+};
+
+///
+/// \brief The MaterialTable class Attenuation coefficients of materials. Coefficients computed from elements use the
+/// Klein-Nishina cross section of free electrons and approximate photoelectric (Z^4.3/E^3) and Rayleigh (Z^2.5/E^2)
+/// cross sections fitted to XCOM at 100 keV, good for light materials; tables should be loaded for heavy ones.
+/// Tables are computed once and cached on disk, see LoadOrCompute.
+///
+class MaterialTable
+{
+    public:
+        static const int kGridPoints = 401; //logarithmic grid from 1 keV to 10 MeV, 100 points per decade
+        static const int kColumns = 4; //values of InteractionType
+
+        MaterialTable(); //water only
+        explicit MaterialTable(const std::string& definitions); //water and materials from the file
+        //adds a material or replaces the one with the same name, coefficients have to be computed again
+        void AddMaterial(const Material& material);
+        void Compute();
+        //load/save from/to the cache directory, file name is derived from the key
+        bool Load(const std::string& cacheDir);
+        bool Save(const std::string& cacheDir) const;
+        void LoadOrCompute(const std::string& cacheDir, bool silent=false);
+        std::string GetKey() const;
+        std::string GetCacheFileName() const;
+        //index of the material with the given name, -1 if it is not defined
+        int GetIndex(const std::string& name) const;
+        inline int GetNumberOfMaterials() const {return fMaterials_.size();}
+        inline const Material& GetMaterial(int index) const {return fMaterials_[index];}
+        inline bool IsComputed() const {return fComputed_;}
+        //attenuation coefficient in 1/mm for photons of energy E in MeV
+        double GetAttenuation(int material, double E, InteractionType type=TOTAL_ATTENUATION) const;
+        //all kColumns coefficients in 1/mm at once
+        void GetAttenuations(int material, double E, double* mu) const;
+        //cross sections in cm^2 per atom of the element Z and per free electron for photons of energy E in MeV
+        static double CrossSection(int Z, InteractionType type, double E);
+        static double KleinNishina(double E);
+        static double GetGridEnergy(int point);
+
+    private:
+        void ReadDefinitions_(const std::string& definitions);
+        void ReadTable_(const Material& material, double* massCoefficients) const;
+        inline const double* Column_(int material, int type) const {return &fLogMu_[(material*kColumns+type)*kGridPoints];}
+
+        std::vector<Material> fMaterials_;
+        std::vector<double> fLogMu_; //logarithms of coefficients in 1/mm, index (material*kColumns+type)*kGridPoints+point
+        bool fComputed_;
+};
+
+#endif // MATERIALS_H
@@ -0,0 +1,144 @@
+/// @file ntuplewriter.cpp
+/// @date 19.10.2026
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include "ntuplewriter.h"
+
+#if ROOT_VERSION_CODE >= NTUPLE_MIN_ROOT_VERSION
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+#include <ROOT/RNTupleWriteOptions.hxx>
+
+namespace
+{
+//the classes left the Experimental namespace in ROOT 6.36
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,36,0)
+    using ROOT::RNTupleModel;
+    using ROOT::RNTupleWriter;
+    using ROOT::RNTupleWriteOptions;
+#else
+    using ROOT::Experimental::RNTupleModel;
+    using ROOT::Experimental::RNTupleWriter;
+    using ROOT::Experimental::RNTupleWriteOptions;
+#endif
+
+    typedef Float_t (FlatEvent::*PhotonArray)[FlatEvent::kMaxPhotons];
+
+    ///
+    /// \brief The PhotonColumn_ struct Per-photon array of FlatEvent and the field it is copied to.
+    ///
+    struct PhotonColumn_
+    {
+        PhotonArray member;
+        std::shared_ptr<std::vector<float>> field;
+    };
+}
+
+///
+/// \brief The NTupleWriter::Fields_ struct Writer and values of fields of the default entry.
+///
+struct NTupleWriter::Fields_
+{
+    std::unique_ptr<RNTupleWriter> writer;
+    std::shared_ptr<std::int64_t> id;
+    std::shared_ptr<int> decayType;
+    std::shared_ptr<float> weight;
+    std::shared_ptr<int> flags;
+    std::vector<PhotonColumn_> photonColumns;
+    std::shared_ptr<std::vector<int>> photonFlags;
+};
+#else
+struct NTupleWriter::Fields_
+{
+};
+#endif
+
+///
+/// \brief NTupleWriter::NTupleWriter Creates the model and appends the RNTuple to the directory.
+/// \param dir Directory of an open file in which the RNTuple is stored.
+/// \param name Name of the RNTuple.
+/// \param compression Compression settings (100*algorithm+level), negative for the RNTuple default.
+///
+NTupleWriter::NTupleWriter(TDirectory* dir, const std::string& name, int compression) :
+    fFields_(new Fields_),
+    fEntries_(0)
+{
+#if ROOT_VERSION_CODE >= NTUPLE_MIN_ROOT_VERSION
+    std::unique_ptr<RNTupleModel> model = RNTupleModel::Create();
+    fFields_->id = model->MakeField<std::int64_t>("id");
+    fFields_->decayType = model->MakeField<int>("decayType");
+    fFields_->weight = model->MakeField<float>("weight");
+    fFields_->flags = model->MakeField<int>("flags");
+    const std::vector<std::pair<const char*, PhotonArray>> columns = {
+        {"px", &FlatEvent::px}, {"py", &FlatEvent::py}, {"pz", &FlatEvent::pz}, {"E", &FlatEvent::E},
+        {"x0", &FlatEvent::x0}, {"y0", &FlatEvent::y0}, {"z0", &FlatEvent::z0},
+        {"hitX", &FlatEvent::hitX}, {"hitY", &FlatEvent::hitY}, {"hitZ", &FlatEvent::hitZ}, {"hitT", &FlatEvent::hitT},
+        {"edep", &FlatEvent::edep}, {"edepSmear", &FlatEvent::edepSmear}
+    };
+    for(const auto& column : columns)
+        fFields_->photonColumns.push_back({column.second, model->MakeField<std::vector<float>>(column.first)});
+    fFields_->photonFlags = model->MakeField<std::vector<int>>("photonFlags");
+    RNTupleWriteOptions options;
+    if(compression>=0)
+        options.SetCompression(compression);
+    fFields_->writer = RNTupleWriter::Append(std::move(model), name, *dir, options);
+#else
+    (void)dir;
+    (void)name;
+    (void)compression;
+    throw(std::string("[ERROR] RNTuple output requires ROOT 6.32 or newer!"));
+#endif
+}
+
+///
+/// \brief NTupleWriter::~NTupleWriter Destructor, commits the dataset if it was not closed.
+///
+NTupleWriter::~NTupleWriter()
+{
+    Close();
+}
+
+///
+/// \brief NTupleWriter::Fill Copies the event to the fields and fills an entry.
+/// \param event Event converted with FlatEvent::Assign.
+///
+void NTupleWriter::Fill(const FlatEvent& event)
+{
+#if ROOT_VERSION_CODE >= NTUPLE_MIN_ROOT_VERSION
+    *fFields_->id = event.id;
+    *fFields_->decayType = event.decayType;
+    *fFields_->weight = event.weight;
+    *fFields_->flags = event.flags;
+    for(auto& column : fFields_->photonColumns)
+        column.field->assign(event.*column.member, event.*column.member+event.nPhotons);
+    fFields_->photonFlags->assign(event.photonFlags, event.photonFlags+event.nPhotons);
+    fFields_->writer->Fill();
+    fEntries_++;
+#else
+    (void)event;
+#endif
+}
+
+///
+/// \brief NTupleWriter::Close Writes remaining clusters and the footer of the RNTuple.
+///
+void NTupleWriter::Close()
+{
+#if ROOT_VERSION_CODE >= NTUPLE_MIN_ROOT_VERSION
+    fFields_->writer.reset();
+#endif
+}
+
+///
+/// \brief NTupleWriter::IsAvailable Checks whether RNTuple output was compiled in.
+/// \return True for ROOT 6.32 or newer.
+///
+bool NTupleWriter::IsAvailable()
+{
+#if ROOT_VERSION_CODE >= NTUPLE_MIN_ROOT_VERSION
+    return true;
+#else
+    return false;
+#endif
+}
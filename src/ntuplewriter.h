@@ -0,0 +1,39 @@
+/// @file ntuplewriter.h
+/// @date 19.10.2026
+#ifndef NTUPLEWRITER_H
+#define NTUPLEWRITER_H
+#include <memory>
+#include <string>
+#include "RVersion.h"
+#include "TDirectory.h"
+#include "flatevent.h"
+
+//RNTupleWriter::Append to a directory of an open file is available since ROOT 6.32
+#define NTUPLE_MIN_ROOT_VERSION ROOT_VERSION(6,32,0)
+
+///
+/// \brief The NTupleWriter class Writes events as an RNTuple with the fields of the flat tree schema. Per-photon values
+/// are collections of nPhotons elements, so nPhotons itself is not stored. With ROOT older than 6.32 the constructor throws.
+///
+class NTupleWriter
+{
+    public:
+        NTupleWriter(TDirectory* dir, const std::string& name, int compression=-1);
+        ~NTupleWriter();
+        void Fill(const FlatEvent& event);
+        //commits the dataset, nothing can be filled afterwards
+        void Close();
+        inline Long64_t GetEntries() const {return fEntries_;}
+        //false if ROOT does not support RNTuple output
+        static bool IsAvailable();
+
+    private:
+        NTupleWriter(const NTupleWriter&);
+        NTupleWriter& operator=(const NTupleWriter&);
+
+        struct Fields_; //RNTuple objects, defined in the source file to keep this header independent of the ROOT version
+        std::unique_ptr<Fields_> fFields_;
+        Long64_t fEntries_;
+};
+
+#endif // NTUPLEWRITER_H
@@ -8,8 +8,13 @@
 #include <iterator>
 #include <cstring>
 #include <algorithm>
+#include <stdexcept>
+#include <cstdlib>
+#include <cmath>
+#include <iomanip>
 #include <TMath.h>
 #include "parammanager.h"
+#include "histogramregistry.h"
 
 ///
 /// \brief ParamManager::ParamManager Basic constructor.
@@ -32,9 +37,36 @@ ParamManager::ParamManager() :
     fPPhantom511_(0.0),
     fPPhantomPrompt_(0.0),
     fPhantomSmear_(false),
+    fPhantomShape_(-1),
+    fPhantomVolume_(""),
+    fPhantomMaterials_(""),
+    fAcceptanceMap_(false),
+    fMapSamples_(100000),
+    fThreads_(0),
+    fCacheDir_("cache/"),
+    fResultCache_(false),
+    fGeometryFile_(""),
+    fMaterialsFile_(""),
+    fSourceFile_(""),
+    fScanMode_(false),
+    fHistogramGroups_(ALL_HISTOGRAMS),
     fOutput_(PNG),
-    fEventTypeToSave_(ALL)
-    {}
+    fEventTypeToSave_(ALL),
+    fTreeSchema_(SPLIT_TREE),
+    fCompressionAlgorithm_(DEFAULT_COMPRESSION),
+    fCompressionLevel_(1),
+    fBasketSize_(32000),
+    fAutoFlush_(-30000000),
+    fAutoSave_(-300000000),
+    fListMode_(false),
+    fFilter_(""),
+    fChunkEvents_(0),
+    fChunkSize_(0.0),
+    fSinogramRadius_(0.0)
+    {
+        fMapGrid_[0]=fMapGrid_[1]=fMapGrid_[2]=21;
+        fPhantomSize_[0]=fPhantomSize_[1]=fPhantomSize_[2]=0.0;
+    }
 
 ///
 /// \brief ParamManager::ParamManager Copy constructor.
@@ -46,7 +78,8 @@ ParamManager::ParamManager(const ParamManager &est)
     fSimRuns_=est.fSimRuns_;
     fNoOfGammas_=est.fNoOfGammas_;
     fEff_=est.fEff_;
-    fR_=est.fP_;
+    fReweightEff_=est.fReweightEff_;
+    fR_=est.fR_;
     fL_=est.fL_;
     fE_=est.fE_;
     fP_=est.fP_;
@@ -57,16 +90,44 @@ ParamManager::ParamManager(const ParamManager &est)
     f2nNdataImported_=est.f2nNdataImported_;
     fOutput_=est.fOutput_;
     fEventTypeToSave_=est.fEventTypeToSave_;
+    fTreeSchema_=est.fTreeSchema_;
+    fCompressionAlgorithm_=est.fCompressionAlgorithm_;
+    fCompressionLevel_=est.fCompressionLevel_;
+    fBasketSize_=est.fBasketSize_;
+    fAutoFlush_=est.fAutoFlush_;
+    fAutoSave_=est.fAutoSave_;
+    fListMode_=est.fListMode_;
+    fFilter_=est.fFilter_;
+    fChunkEvents_=est.fChunkEvents_;
+    fChunkSize_=est.fChunkSize_;
+    fSinogramBins_=est.fSinogramBins_;
+    fSinogramRadius_=est.fSinogramRadius_;
+    fSweep_=est.fSweep_;
     fData_.resize(est.fData_.size());
     std::copy(est.fData_.begin(), est.fData_.end(), fData_.begin());
     fDecayBranchProbability_.resize(est.fDecayBranchProbability_.size());
     std::copy(est.fDecayBranchProbability_.begin(), est.fDecayBranchProbability_.end(), fDecayBranchProbability_.begin());
-    for(unsigned ii=0; ii<fGammaEnergy_.size(); ii++)
-        fGammaEnergy_.push_back(est.fGammaEnergy_[ii]);
+    fGammaEnergy_=est.fGammaEnergy_;
     fPPhantom511_=est.fPPhantom511_;
     fPPhantomPrompt_=est.fPPhantomPrompt_;
     fUsePhantom_=est.fUsePhantom_;
     fPhantomSmear_=est.fPhantomSmear_;
+    fPhantomShape_=est.fPhantomShape_;
+    std::copy(est.fPhantomSize_, est.fPhantomSize_+3, fPhantomSize_);
+    fPhantomVolume_=est.fPhantomVolume_;
+    fPhantomMaterials_=est.fPhantomMaterials_;
+    fAcceptanceMap_=est.fAcceptanceMap_;
+    std::copy(est.fMapGrid_, est.fMapGrid_+3, fMapGrid_);
+    fMapSamples_=est.fMapSamples_;
+    fThreads_=est.fThreads_;
+    fCacheDir_=est.fCacheDir_;
+    fResultCache_=est.fResultCache_;
+    fGeometryFile_=est.fGeometryFile_;
+    fMaterialsFile_=est.fMaterialsFile_;
+    fBarrels_=est.fBarrels_;
+    fSourceFile_=est.fSourceFile_;
+    fScanMode_=est.fScanMode_;
+    fHistogramGroups_=est.fHistogramGroups_;
 }
 
 ///
@@ -80,7 +141,8 @@ ParamManager & ParamManager::operator= (const ParamManager &est) {
     fSimRuns_=est.fSimRuns_;
     fNoOfGammas_=est.fNoOfGammas_;
     fEff_=est.fEff_;
-    fR_=est.fP_;
+    fReweightEff_=est.fReweightEff_;
+    fR_=est.fR_;
     fL_=est.fL_;
     fE_=est.fE_;
     fP_=est.fP_;
@@ -91,16 +153,44 @@ ParamManager & ParamManager::operator= (const ParamManager &est) {
     f2nNdataImported_=est.f2nNdataImported_;
     fOutput_=est.fOutput_;
     fEventTypeToSave_=est.fEventTypeToSave_;
+    fTreeSchema_=est.fTreeSchema_;
+    fCompressionAlgorithm_=est.fCompressionAlgorithm_;
+    fCompressionLevel_=est.fCompressionLevel_;
+    fBasketSize_=est.fBasketSize_;
+    fAutoFlush_=est.fAutoFlush_;
+    fAutoSave_=est.fAutoSave_;
+    fListMode_=est.fListMode_;
+    fFilter_=est.fFilter_;
+    fChunkEvents_=est.fChunkEvents_;
+    fChunkSize_=est.fChunkSize_;
+    fSinogramBins_=est.fSinogramBins_;
+    fSinogramRadius_=est.fSinogramRadius_;
+    fSweep_=est.fSweep_;
     fData_.resize(est.fData_.size());
     std::copy(est.fData_.begin(), est.fData_.end(), fData_.begin());
     fDecayBranchProbability_.resize(est.fDecayBranchProbability_.size());
     std::copy(est.fDecayBranchProbability_.begin(), est.fDecayBranchProbability_.end(), fDecayBranchProbability_.begin());
-    for(unsigned ii=0; ii<fGammaEnergy_.size(); ii++)
-        fGammaEnergy_.push_back(est.fGammaEnergy_[ii]);
+    fGammaEnergy_=est.fGammaEnergy_;
     fPPhantom511_=est.fPPhantom511_;
     fPPhantomPrompt_=est.fPPhantomPrompt_;
     fUsePhantom_=est.fUsePhantom_;
     fPhantomSmear_=est.fPhantomSmear_;
+    fPhantomShape_=est.fPhantomShape_;
+    std::copy(est.fPhantomSize_, est.fPhantomSize_+3, fPhantomSize_);
+    fPhantomVolume_=est.fPhantomVolume_;
+    fPhantomMaterials_=est.fPhantomMaterials_;
+    fAcceptanceMap_=est.fAcceptanceMap_;
+    std::copy(est.fMapGrid_, est.fMapGrid_+3, fMapGrid_);
+    fMapSamples_=est.fMapSamples_;
+    fThreads_=est.fThreads_;
+    fCacheDir_=est.fCacheDir_;
+    fResultCache_=est.fResultCache_;
+    fGeometryFile_=est.fGeometryFile_;
+    fMaterialsFile_=est.fMaterialsFile_;
+    fBarrels_=est.fBarrels_;
+    fSourceFile_=est.fSourceFile_;
+    fScanMode_=est.fScanMode_;
+    fHistogramGroups_=est.fHistogramGroups_;
     return *this;
 }
 
@@ -112,15 +202,24 @@ ParamManager & ParamManager::operator= (const ParamManager &est) {
 bool ParamManager::operator==(const ParamManager &est) const
 {
     bool params = ((est.fData_ == fData_) && (fSimEvents_==est.fSimEvents_) && (fSimRuns_==est.fSimRuns_) && \
-            (fEff_==est.fEff_) && (fL_==est.fL_) && (fR_==est.fR_) && (fNoOfGammas_==est.fNoOfGammas_) && \
+            (fEff_==est.fEff_) && (fReweightEff_==est.fReweightEff_) && (fL_==est.fL_) && (fR_==est.fR_) && (fNoOfGammas_==est.fNoOfGammas_) && \
             (fE_==est.fE_) && (fP_==est.fP_) && (fSilentMode_==est.fSilentMode_) && fOutput_==est.fOutput_)&&\
-            (fEventTypeToSave_==est.fEventTypeToSave_) && (fSmearLowLimit_==est.fSmearLowLimit_) && \
+            (fEventTypeToSave_==est.fEventTypeToSave_) && (fTreeSchema_==est.fTreeSchema_) && \
+            (fCompressionAlgorithm_==est.fCompressionAlgorithm_) && (fCompressionLevel_==est.fCompressionLevel_) && \
+            (fBasketSize_==est.fBasketSize_) && (fAutoFlush_==est.fAutoFlush_) && (fAutoSave_==est.fAutoSave_) && \
+            (fListMode_==est.fListMode_) && (fFilter_==est.fFilter_) && (fChunkEvents_==est.fChunkEvents_) && \
+            (fChunkSize_==est.fChunkSize_) && (fSinogramBins_==est.fSinogramBins_) && \
+            (fSinogramRadius_==est.fSinogramRadius_) && (fSweep_==est.fSweep_) && (fSmearLowLimit_==est.fSmearLowLimit_) && \
             (fSmearHighLimit_==est.fSmearHighLimit_) && (f2nNdataImported_==est.f2nNdataImported_) && fSeed_==est.fSeed_ && \
-            (fUsePhantom_==est.fUsePhantom_) && (fPPhantom511_==fPPhantom511_) && (fPhantomSmear_==est.fPhantomSmear_) &&\
-            (fPPhantomPrompt_==fPPhantomPrompt_);
-    return params && std::equal(fData_.begin(), fData_.end(), est.fData_.begin())\
-            && std::equal(fDecayBranchProbability_.begin(), fDecayBranchProbability_.end(), est.fDecayBranchProbability_.begin())\
-            && std::equal(fGammaEnergy_.begin(), fGammaEnergy_.end(), est.fGammaEnergy_.begin());
+            (fUsePhantom_==est.fUsePhantom_) && (fPPhantom511_==est.fPPhantom511_) && (fPhantomSmear_==est.fPhantomSmear_) &&\
+            (fPhantomShape_==est.fPhantomShape_) && std::equal(fPhantomSize_, fPhantomSize_+3, est.fPhantomSize_) && \
+            (fPhantomVolume_==est.fPhantomVolume_) && (fPhantomMaterials_==est.fPhantomMaterials_) && \
+            (fPPhantomPrompt_==est.fPPhantomPrompt_) && (fAcceptanceMap_==est.fAcceptanceMap_) && \
+            std::equal(fMapGrid_, fMapGrid_+3, est.fMapGrid_) && (fMapSamples_==est.fMapSamples_) && \
+            (fThreads_==est.fThreads_) && (fCacheDir_==est.fCacheDir_) && (fResultCache_==est.fResultCache_) && \
+            (fGeometryFile_==est.fGeometryFile_) && (fMaterialsFile_==est.fMaterialsFile_) && (fBarrels_==est.fBarrels_) && \
+            (fSourceFile_==est.fSourceFile_) && (fScanMode_==est.fScanMode_) && (fHistogramGroups_==est.fHistogramGroups_);
+    return params && (fDecayBranchProbability_==est.fDecayBranchProbability_) && (fGammaEnergy_==est.fGammaEnergy_);
 }
 
 
@@ -201,28 +300,51 @@ void ParamManager::ImportParams(const std::string& inFile)
               {
                  token.push_back(segment);
               }
+              //values of multi-valued parameters end where the comment starts
+              std::vector<std::string> values;
+              for(unsigned ii=2; ii<token.size() && token[ii][0]!='#'; ii++)
+                 values.push_back(token[ii]);
+              //R, L, eff, E, p, smearLow and smearHigh accept ranges start:stop:step and lists of values, see SetSweepAxis
               if(token[0]=="eff")
-                fEff_ = atof(token[2].c_str());
+                fEff_ = ImportSweepable_(token[0], values);
+              else if(token[0]=="reweightEff")
+              {
+                  try
+                  {
+                      std::vector<double> effs;
+                      if(token[2]!="none")
+                          effs = ParseSweepValues(values);
+                      for(unsigned ii=0; ii<effs.size(); ii++)
+                          if(effs[ii]<0.0 || effs[ii]>1.0)
+                              throw(std::string("[ERROR] Efficiency outside [0, 1]: ")+std::to_string(effs[ii]));
+                      fReweightEff_ = effs;
+                  }
+                  catch(std::string& ex)
+                  {
+                      std::cerr<<"[WARNING] "<<ex<<" Reweighting is disabled."<<std::endl;
+                      fReweightEff_.clear();
+                  }
+              }
               else if (token[0]=="events")
                 fSimEvents_ = atoi(token[2].c_str());
               else if (token[0]=="R")
-                fR_ = atof(token[2].c_str());
+                fR_ = ImportSweepable_(token[0], values);
               else if (token[0]=="L")
-                fL_ = atof((token[2].c_str()));
+                fL_ = ImportSweepable_(token[0], values);
               else if (token[0]=="gammas")
                 {
                   fNoOfGammas_=atoi(token[2].c_str());
                 }
               else if (token[0]=="E")
-                fE_=atof(token[2].c_str());
+                fE_ = ImportSweepable_(token[0], values);
               else if (token[0]=="p")
-                fP_=atof(token[2].c_str());
+                fP_ = ImportSweepable_(token[0], values);
               else if (token[0]=="seed")
                 fSeed_=atof(token[2].c_str());
               else if(token[0]=="smearLow")
-                fSmearLowLimit_=atof(token[2].c_str());
+                fSmearLowLimit_ = ImportSweepable_(token[0], values);
               else if(token[0]=="smearHigh")
-                fSmearHighLimit_=atof(token[2].c_str());
+                fSmearHighLimit_ = ImportSweepable_(token[0], values);
               else if (token[0]=="silent")
                 fSilentMode_= atoi(token[2].c_str()) == 0 ? false : true;
               else if(token[0]=="pPhantom511")
@@ -233,6 +355,98 @@ void ParamManager::ImportParams(const std::string& inFile)
                 fUsePhantom_ = atoi(token[2].c_str()) == 0 ? false :true;
               else if(token[0]=="phantomSmear")
                 fPhantomSmear_ = atoi(token[2].c_str()) == 0 ? false :true;
+              else if(token[0]=="phantom")
+              {
+                  //shape and its dimensions A B C in mm, or voxel with the label volume and the table of materials
+                  const char* shapes[] = {"cylinder", "ellipsoid", "box"};
+                  int shape = -1;
+                  for(int ii=0; ii<3 && !values.empty(); ii++)
+                      if(values[0]==shapes[ii])
+                          shape = ii;
+                  if(!values.empty() && values[0]=="naive")
+                  {
+                      fPhantomShape_ = -1;
+                      fPhantomVolume_ = fPhantomMaterials_ = "";
+                  }
+                  else if(!values.empty() && values[0]=="voxel" && values.size()==3)
+                  {
+                      fPhantomShape_ = 3;
+                      fPhantomVolume_ = values[1];
+                      fPhantomMaterials_ = values[2];
+                  }
+                  else if(shape>=0 && values.size()==4 && atof(values[1].c_str())>0 && atof(values[2].c_str())>0 \
+                          && atof(values[3].c_str())>0)
+                  {
+                      fPhantomShape_ = shape;
+                      fPhantomVolume_ = fPhantomMaterials_ = "";
+                      for(int ii=0; ii<3; ii++)
+                          fPhantomSize_[ii] = atof(values[ii+1].c_str());
+                  }
+                  else
+                  {
+                      std::cerr<<"[WARNING] phantom requires \"naive\", a shape (cylinder, ellipsoid, box) and 3 positive "\
+                                 "dimensions A B C, or \"voxel\" with a label volume and a table of materials! Setting to default (naive)."<<std::endl;
+                      fPhantomShape_ = -1;
+                      fPhantomVolume_ = fPhantomMaterials_ = "";
+                  }
+              }
+              else if(token[0]=="acceptanceMap")
+                fAcceptanceMap_ = atoi(token[2].c_str()) == 0 ? false :true;
+              else if(token[0]=="mapGrid")
+              {
+                  if(values.size()==3)
+                      for(int ii=0; ii<3; ii++)
+                          fMapGrid_[ii] = atoi(values[ii].c_str());
+                  else
+                      std::cerr<<"[WARNING] mapGrid requires 3 values: nx ny nz!"<<std::endl;
+              }
+              else if(token[0]=="mapSamples")
+                fMapSamples_ = atoi(token[2].c_str());
+              else if(token[0]=="threads")
+                fThreads_ = atoi(token[2].c_str());
+              else if(token[0]=="cacheDir")
+              {
+                  fCacheDir_ = token[2];
+                  if(fCacheDir_.back()!='/')
+                      fCacheDir_ += "/";
+              }
+              else if(token[0]=="resultCache")
+                fResultCache_ = atoi(token[2].c_str()) == 0 ? false : true;
+              else if(token[0]=="geometry")
+                fGeometryFile_ = token[2]=="none" ? "" : token[2];
+              else if(token[0]=="materials")
+                fMaterialsFile_ = token[2]=="none" ? "" : token[2];
+              else if(token[0]=="sources")
+                fSourceFile_ = token[2]=="none" ? "" : token[2];
+              else if(token[0]=="scan")
+                fScanMode_ = atoi(token[2].c_str()) == 0 ? false : true;
+              else if(token[0]=="barrels")
+              {
+                  //pairs R,L separated by spaces
+                  fBarrels_.clear();
+                  for(unsigned ii=0; ii<values.size() && values[ii]!="none"; ii++)
+                  {
+                      double R = 0, L = 0;
+                      char separator = 0;
+                      std::istringstream pair(values[ii]);
+                      if((pair>>R>>separator>>L) && separator==',' && pair.peek()==EOF && R>0 && L>0)
+                          fBarrels_.push_back(std::make_pair(R, L));
+                      else
+                          std::cerr<<"[WARNING] Invalid barrel, expected R,L with positive values: "<<values[ii]<<std::endl;
+                  }
+              }
+              else if(token[0]=="histograms")
+              {
+                  try
+                  {
+                      fHistogramGroups_ = HistogramRegistry::ParseGroups(values);
+                  }
+                  catch(std::string& ex)
+                  {
+                      std::cerr<<"[WARNING] "<<ex<<" Setting to default (all)."<<std::endl;
+                      fHistogramGroups_ = ALL_HISTOGRAMS;
+                  }
+              }
               else if (token[0]=="output")
               {
                   if(token[2]=="tree")
@@ -241,6 +455,10 @@ void ParamManager::ImportParams(const std::string& inFile)
                       fOutput_=PNG;
                   else if(token[2]=="both")
                       fOutput_=BOTH;
+                  else if(token[2]=="raw")
+                      fOutput_=RAW;
+                  else if(token[2]=="none")
+                      fOutput_=NO_OUTPUT;
                   else
                   {
                       std::cerr<<"[WARNING] Unrecognized output type! Setting to default (png)."<<std::endl;
@@ -255,12 +473,89 @@ void ParamManager::ImportParams(const std::string& inFile)
                       fEventTypeToSave_=PASS;
                   else if(token[2]=="fail")
                       fEventTypeToSave_=FAIL;
+                  else if(token[2]=="none")
+                      fEventTypeToSave_=NONE;
                   else
                   {
                       std::cerr<<"[WARNING] Unrecognized event type to save! Setting to default (all)."<<std::endl;
                       fEventTypeToSave_=ALL;
                   }
               }
+              else if (token[0]=="compression")
+              {
+                  try
+                  {
+                      fCompressionAlgorithm_ = ParseCompressionAlgorithm(values.at(0));
+                      if(values.size()>1)
+                          fCompressionLevel_ = atoi(values[1].c_str());
+                  }
+                  catch(std::string& ex)
+                  {
+                      std::cerr<<"[WARNING] "<<ex<<" Setting to default."<<std::endl;
+                      fCompressionAlgorithm_ = DEFAULT_COMPRESSION;
+                  }
+                  catch(std::out_of_range&)
+                  {
+                      std::cerr<<"[WARNING] compression requires an algorithm and optionally a level!"<<std::endl;
+                  }
+              }
+              else if (token[0]=="basketSize")
+                fBasketSize_ = atoi(token[2].c_str());
+              else if (token[0]=="autoFlush")
+                fAutoFlush_ = atoll(token[2].c_str());
+              else if (token[0]=="autoSave")
+                fAutoSave_ = atoll(token[2].c_str());
+              else if (token[0]=="filter")
+              {
+                  //the expression may contain spaces, it ends where the comment starts
+                  fFilter_.clear();
+                  for(unsigned ii=0; ii<values.size(); ii++)
+                      fFilter_ += (ii>0 ? " " : "")+values[ii];
+                  if(fFilter_=="none")
+                      fFilter_.clear();
+              }
+              else if (token[0]=="chunkEvents")
+                fChunkEvents_ = atoll(token[2].c_str());
+              else if (token[0]=="chunkSize")
+                fChunkSize_ = atof(token[2].c_str());
+              else if (token[0]=="sinogram")
+              {
+                  //radial, angular and axial bins, optionally followed by the radial range
+                  fSinogramBins_.clear();
+                  fSinogramRadius_ = 0.0;
+                  if(values.size()>=3)
+                  {
+                      for(int ii=0; ii<3; ii++)
+                          fSinogramBins_.push_back(atoi(values[ii].c_str()));
+                      if(values.size()>3)
+                          fSinogramRadius_ = atof(values[3].c_str());
+                      if(fSinogramBins_[0]<=0 || fSinogramBins_[1]<=0 || fSinogramBins_[2]<=0)
+                      {
+                          std::cerr<<"[WARNING] Numbers of bins of the sinogram have to be positive! Sinogram disabled."<<std::endl;
+                          fSinogramBins_.clear();
+                      }
+                  }
+                  else if(values.size()!=1 || atoi(values[0].c_str())!=0)
+                      std::cerr<<"[WARNING] sinogram requires numbers of radial, angular and axial bins! Sinogram disabled."<<std::endl;
+              }
+              else if (token[0]=="listMode")
+                fListMode_ = atoi(token[2].c_str()) == 0 ? false : true;
+              else if (token[0]=="treeSchema")
+              {
+                  if(token[2]=="split")
+                      fTreeSchema_=SPLIT_TREE;
+                  else if(token[2]=="flat")
+                      fTreeSchema_=FLAT_TREE;
+                  else if(token[2]=="ntuple")
+                      fTreeSchema_=RNTUPLE;
+                  else if(token[2]=="sparse")
+                      fTreeSchema_=SPARSE_TREE;
+                  else
+                  {
+                      std::cerr<<"[WARNING] Unrecognized tree schema! Setting to default (split)."<<std::endl;
+                      fTreeSchema_=SPLIT_TREE;
+                  }
+              }
               else
                 std::cerr<<"[WARNING] Unrecognized parameter in the param file: \""<<token[0]<<"\""<<std::endl;
           }
@@ -329,10 +624,31 @@ void ParamManager::PrintParams()
     else
         std::cout<<"[INFO] No of decay products: "<<fNoOfGammas_<<std::endl;
     std::cout<<"[INFO] Events to generate: "<<fSimEvents_<<std::endl;
-    std::cout<<"[INFO] Runs to simulate: "<<fSimRuns_<<std::endl;
+    if(!fSourceFile_.empty())
+        std::cout<<"[INFO] Sources are read from: "<<fSourceFile_<<std::endl;
+    else
+        std::cout<<"[INFO] Runs to simulate: "<<fSimRuns_<<std::endl;
+    if(fScanMode_)
+        std::cout<<"[INFO] Scan mode: all sources are saved to one tree with a source index."<<std::endl;
     std::cout<<"[INFO] Detector radius: "<<fR_<<" [mm]"<<std::endl;
     std::cout<<"[INFO] Detector length: "<<fL_<<" [mm]"<<std::endl;
+    if(!fGeometryFile_.empty())
+        std::cout<<"[INFO] Detector geometry file: "<<fGeometryFile_<<" (R and L are ignored by cuts)"<<std::endl;
+    if(!fBarrels_.empty())
+    {
+        std::cout<<"[INFO] Barrels compared with the detector (R, L) [mm]:";
+        for(unsigned ii=0; ii<fBarrels_.size(); ii++)
+            std::cout<<" ("<<fBarrels_[ii].first<<", "<<fBarrels_[ii].second<<")";
+        std::cout<<std::endl;
+    }
     std::cout<<"[INFO] Scintillator's efficiency: "<<fEff_<<std::endl;
+    if(!fReweightEff_.empty())
+    {
+        std::cout<<"[INFO] Efficiency applied as weights of geometrically accepted events, acceptance computed for:";
+        for(unsigned ii=0; ii<fReweightEff_.size(); ii++)
+            std::cout<<" "<<fReweightEff_[ii];
+        std::cout<<std::endl;
+    }
     if(fNoOfGammas_==4)
     {
         std::cout<<"[INFO] Energy of single gamma: "<<fE_<<" [keV]"<<std::endl;
@@ -342,9 +658,26 @@ void ParamManager::PrintParams()
     if(fUsePhantom_)
     {
         std::cout<<"ENABLED"<<std::endl;
-        std::cout<<"[INFO] Probability to naively scatter inside the phantom: "<<
-                   "\n\t* 511 keV: "<<fPPhantom511_<<
-                   "\n\t* prompt : "<<fPPhantomPrompt_<<std::endl;
+        if(fPhantomShape_==3)
+        {
+            std::cout<<"[INFO] Voxelized phantom: "<<fPhantomVolume_<<", materials: "<<fPhantomMaterials_<<std::endl;
+        }
+        if(fPhantomShape_>=0 && !fMaterialsFile_.empty())
+        {
+            std::cout<<"[INFO] Definitions of materials: "<<fMaterialsFile_<<std::endl;
+        }
+        if(fPhantomShape_>=0 && fPhantomShape_<3)
+        {
+            const char* shapes[] = {"cylinder", "ellipsoid", "box"};
+            std::cout<<"[INFO] Water phantom: "<<shapes[fPhantomShape_]<<" "<<fPhantomSize_[0]<<" x "<<fPhantomSize_[1]<<" x "
+                     <<fPhantomSize_[2]<<" [mm]"<<std::endl;
+        }
+        else if(fPhantomShape_<0)
+        {
+            std::cout<<"[INFO] Probability to naively scatter inside the phantom: "<<
+                       "\n\t* 511 keV: "<<fPPhantom511_<<
+                       "\n\t* prompt : "<<fPPhantomPrompt_<<std::endl;
+        }
         std::cout<<"[INFO] Energy smearing inside phantom: ";
         if(fPhantomSmear_)
             std::cout<<"ENABLED"<<std::endl;
@@ -355,6 +688,12 @@ void ParamManager::PrintParams()
     {
         std::cout<<"DISABLED"<<std::endl;
     }
+    if(fAcceptanceMap_)
+    {
+        std::cout<<"[INFO] Acceptance map mode: ENABLED, grid "<<fMapGrid_[0]<<"x"<<fMapGrid_[1]<<"x"<<fMapGrid_[2]\
+                 <<", "<<fMapSamples_<<" decays per point"<<std::endl;
+        std::cout<<"[INFO] Cache directory: "<<fCacheDir_<<std::endl;
+    }
     std::string seedToShow = fSeed_==0 ? "random" : std::to_string(fSeed_);
     std::cout<<"[INFO] Seed: "<<seedToShow<<std::endl;
     std::cout<<"[INFO] Smearing lower limit: "<<fSmearLowLimit_<<" [MeV]"<<std::endl;
@@ -374,9 +713,16 @@ void ParamManager::PrintParams()
         case BOTH:
             std::cout<<"ROOT TREE & PNG IMAGES"<<std::endl;
             break;
+        case RAW:
+            std::cout<<"ROOT TREE & RAW HISTOGRAMS"<<std::endl;
+            break;
+        case NO_OUTPUT:
+            std::cout<<"NONE"<<std::endl;
+            break;
         default:
             break;
     }
+    std::cout<<"[INFO] Histograms: "<<HistogramRegistry::GroupNames(fHistogramGroups_)<<std::endl;
     std::cout<<"[INFO] Event type saved to tree: ";
     switch (fEventTypeToSave_)
     {
@@ -389,9 +735,35 @@ void ParamManager::PrintParams()
         case FAIL:
             std::cout<<"FAIL"<<std::endl;
             break;
+        case NONE:
+            std::cout<<"NONE"<<std::endl;
+            break;
         default:
             break;
     }
+    std::cout<<"[INFO] Tree schema: "<<(fTreeSchema_==FLAT_TREE ? "FLAT" : (fTreeSchema_==RNTUPLE ? "RNTUPLE" : \
+                                                           (fTreeSchema_==SPARSE_TREE ? "SPARSE" : "SPLIT")))<<std::endl;
+    std::cout<<"[INFO] Compression: "<<CompressionAlgorithmName(fCompressionAlgorithm_);
+    if(fCompressionAlgorithm_!=DEFAULT_COMPRESSION)
+        std::cout<<" level "<<fCompressionLevel_;
+    std::cout<<", basket size: "<<fBasketSize_<<" B, auto flush: "<<fAutoFlush_<<", auto save: "<<fAutoSave_<<std::endl;
+    if(fListMode_)
+        std::cout<<"[INFO] Accepted coincidences are written to list-mode files."<<std::endl;
+    std::cout<<"[INFO] Filter of saved events: "<<(fFilter_.empty() ? "none" : fFilter_)<<std::endl;
+    if(fSinogramBins_.size()==3)
+        std::cout<<"[INFO] Sinogram: "<<fSinogramBins_[0]<<" radial bins up to "<<GetSinogramRadius()<<" mm, "<<fSinogramBins_[1]\
+                 <<" angles, "<<fSinogramBins_[2]<<" slices"<<std::endl;
+    for(unsigned ii=0; ii<fSweep_.size(); ii++)
+    {
+        std::cout<<"[INFO] Sweep of "<<fSweep_[ii].name<<":";
+        for(unsigned jj=0; jj<fSweep_[ii].values.size(); jj++)
+            std::cout<<" "<<fSweep_[ii].values[jj];
+        std::cout<<std::endl;
+    }
+    if(!fSweep_.empty())
+        std::cout<<"[INFO] Sweep grid points: "<<GetNumberOfSweepPoints()<<std::endl;
+    if(fChunkEvents_>0 || fChunkSize_>0)
+        std::cout<<"[INFO] Tree is split into files of at most "<<fChunkEvents_<<" events and "<<fChunkSize_<<" GB (0 - no limit)."<<std::endl;
 }
 
 ///
@@ -428,6 +800,49 @@ std::vector<double> ParamManager::GetDataAt(const int index) const
     return data;
 }
 
+///
+/// \brief ParamManager::GetRunKey Describes everything that affects results of a single run: physics and detector
+/// parameters, the seed, settings of the output and the line with source parameters. Settings which do not change
+/// results (e.g. silent mode, threads) and other runs are not included.
+/// \param index Number of the run.
+/// \return Human-readable key, see ResultCache.
+///
+std::string ParamManager::GetRunKey(const int index) const
+{
+    std::ostringstream key;
+    key<<std::setprecision(10);
+    key<<"events="<<fSimEvents_<<" gammas="<<fNoOfGammas_<<" eff="<<fEff_<<" R="<<fR_<<" L="<<fL_<<" E="<<fE_<<" p="<<fP_\
+       <<" smear=["<<fSmearLowLimit_<<","<<fSmearHighLimit_<<"] seed="<<fSeed_<<" phantom="<<fUsePhantom_<<","<<fPPhantom511_\
+       <<","<<fPPhantomPrompt_<<","<<fPhantomSmear_<<","<<fPhantomShape_<<","<<fPhantomSize_[0]<<","<<fPhantomSize_[1]\
+       <<","<<fPhantomSize_[2]<<","<<fPhantomVolume_<<","<<fPhantomMaterials_<<","<<fMaterialsFile_<<" geometry="<<fGeometryFile_<<" histograms="<<fHistogramGroups_\
+       <<" output="<<fOutput_<<" eventType="<<fEventTypeToSave_<<" schema="<<fTreeSchema_<<" compression="<<fCompressionAlgorithm_\
+       <<","<<fCompressionLevel_<<" baskets="<<fBasketSize_<<","<<fAutoFlush_<<","<<fAutoSave_<<" filter="<<fFilter_<<" sinogram=";
+    for(unsigned ii=0; ii<fSinogramBins_.size(); ii++)
+        key<<fSinogramBins_[ii]<<",";
+    key<<fSinogramRadius_<<" barrels=";
+    for(unsigned ii=0; ii<fBarrels_.size(); ii++)
+        key<<fBarrels_[ii].first<<","<<fBarrels_[ii].second<<";";
+    key<<" reweightEff=";
+    for(unsigned ii=0; ii<fReweightEff_.size(); ii++)
+        key<<fReweightEff_[ii]<<",";
+    key<<" source=";
+    std::vector<double> source = GetDataAt(index);
+    for(unsigned ii=0; ii<source.size(); ii++)
+        key<<source[ii]<<(ii+1<source.size() ? "," : "");
+    if(fNoOfGammas_==5)
+    {
+        key<<" branches=";
+        for(unsigned ii=0; ii<fDecayBranchProbability_.size(); ii++)
+        {
+            key<<fDecayBranchProbability_[ii];
+            for(unsigned jj=0; jj<fGammaEnergy_[ii].size(); jj++)
+                key<<":"<<fGammaEnergy_[ii][jj];
+            key<<";";
+        }
+    }
+    return key.str();
+}
+
 ///
 /// \brief ParamManager::ValidatePromptData_ Cheks if decay branch probabilities sum to 1. If not, then it renormalizes it.
 ///
@@ -445,3 +860,150 @@ void ParamManager::ValidatePromptData_()
     }
 
 }
+
+///
+/// \brief ParamManager::ParseSweepValues Converts values of a sweepable parameter to a list of numbers. Every value
+/// is a number, a comma-separated list of numbers or a range start:stop:step which includes stop if it is reached.
+/// \param values Values given after ":=", e.g. {"400:500:10"}, {"0.2,0.3"} or {"400", "450"}.
+/// \return Numbers in the given order.
+///
+std::vector<double> ParamManager::ParseSweepValues(const std::vector<std::string>& values)
+{
+    std::vector<double> result;
+    for(unsigned ii=0; ii<values.size(); ii++)
+    {
+        std::istringstream list(values[ii]);
+        std::string item;
+        while(std::getline(list, item, ','))
+        {
+            if(item.empty())
+                continue;
+            std::vector<double> range;
+            std::istringstream fields(item);
+            std::string field;
+            while(std::getline(fields, field, ':'))
+            {
+                char* end = nullptr;
+                range.push_back(strtod(field.c_str(), &end));
+                if(field.empty() || *end!='\0')
+                    throw(std::string("[ERROR] Invalid value of a parameter: ")+item);
+            }
+            if(range.size()==1)
+                result.push_back(range[0]);
+            else if(range.size()==3 && range[2]>0 && range[1]>=range[0])
+            {
+                //values are computed from the index, so that rounding errors do not accumulate
+                int steps = static_cast<int>(std::floor((range[1]-range[0])/range[2]+1e-9));
+                for(int jj=0; jj<=steps; jj++)
+                    result.push_back(range[0]+jj*range[2]);
+            }
+            else
+                throw(std::string("[ERROR] Invalid range, expected start:stop:step with step > 0 and stop >= start: ")+item);
+        }
+    }
+    if(result.empty())
+        throw(std::string("[ERROR] Parameter without a value!"));
+    return result;
+}
+
+///
+/// \brief ParamManager::SetSweepAxis Sets values scanned for a parameter, the parameter is set to the first of them.
+/// A single value removes the parameter from the sweep.
+/// \param name Key of the parameter: R, L, eff, E, p, smearLow or smearHigh.
+/// \param values Values of the parameter, not empty.
+///
+void ParamManager::SetSweepAxis(const std::string& name, const std::vector<double>& values)
+{
+    if(values.empty())
+        throw(std::string("[ERROR] Sweep of ")+name+" without values!");
+    SetSweptParam_(name, values[0]);
+    for(unsigned ii=0; ii<fSweep_.size(); ii++)
+    {
+        if(fSweep_[ii].name==name)
+        {
+            fSweep_.erase(fSweep_.begin()+ii);
+            break;
+        }
+    }
+    if(values.size()>1)
+    {
+        SweepAxis axis = {name, values};
+        fSweep_.push_back(axis);
+    }
+}
+
+///
+/// \brief ParamManager::GetNumberOfSweepPoints Returns the size of the grid of the sweep.
+/// \return Product of numbers of values of all scanned parameters, 1 if there is no sweep.
+///
+int ParamManager::GetNumberOfSweepPoints() const
+{
+    int points = 1;
+    for(unsigned ii=0; ii<fSweep_.size(); ii++)
+        points *= fSweep_[ii].values.size();
+    return points;
+}
+
+///
+/// \brief ParamManager::GetSweepPoint Returns parameters of a single point of the grid. The last scanned parameter
+/// changes the fastest.
+/// \param index Index of the grid point, from 0 to GetNumberOfSweepPoints()-1.
+/// \return Copy of this ParamManager with scanned parameters set to the values of the point and without the sweep.
+///
+ParamManager ParamManager::GetSweepPoint(int index) const
+{
+    if(index<0 || index>=GetNumberOfSweepPoints())
+        throw(std::string("[ERROR] Invalid index of a sweep point: ")+std::to_string(index));
+    ParamManager point(*this);
+    point.fSweep_.clear();
+    for(int ii=fSweep_.size()-1; ii>=0; ii--)
+    {
+        int size = fSweep_[ii].values.size();
+        point.SetSweptParam_(fSweep_[ii].name, fSweep_[ii].values[index%size]);
+        index /= size;
+    }
+    return point;
+}
+
+///
+/// \brief ParamManager::ImportSweepable_ Parses the value of a parameter which can be scanned.
+/// \param name Key of the parameter.
+/// \param values Values given in the param file.
+/// \return The first value, which is used if the parameter is not scanned.
+///
+float ParamManager::ImportSweepable_(const std::string& name, const std::vector<std::string>& values)
+{
+    try
+    {
+        SetSweepAxis(name, ParseSweepValues(values));
+    }
+    catch(std::string& ex)
+    {
+        std::cerr<<"[WARNING] "<<ex<<" Value of "<<name<<" is not changed."<<std::endl;
+    }
+    if(name=="R") return fR_;
+    else if(name=="L") return fL_;
+    else if(name=="eff") return fEff_;
+    else if(name=="E") return fE_;
+    else if(name=="p") return fP_;
+    else if(name=="smearLow") return fSmearLowLimit_;
+    return fSmearHighLimit_;
+}
+
+///
+/// \brief ParamManager::SetSweptParam_ Sets a parameter which can be scanned.
+/// \param name Key of the parameter.
+/// \param value New value.
+///
+void ParamManager::SetSweptParam_(const std::string& name, double value)
+{
+    if(name=="R") fR_ = value;
+    else if(name=="L") fL_ = value;
+    else if(name=="eff") fEff_ = value;
+    else if(name=="E") fE_ = value;
+    else if(name=="p") fP_ = value;
+    else if(name=="smearLow") fSmearLowLimit_ = value;
+    else if(name=="smearHigh") fSmearHighLimit_ = value;
+    else
+        throw(std::string("[ERROR] Parameter cannot be scanned: ")+name);
+}
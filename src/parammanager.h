@@ -5,6 +5,8 @@
 #define PARAMMANAGER_H
 #include <string>
 #include <vector>
+#include <utility>
+#include "compression.h"
 
 ///
 /// \brief The OutputOptions enum Specifies type of output.
@@ -13,7 +15,9 @@ enum OutputOptions
 {
     TREE = 0,
     PNG = 1,
-    BOTH = 2
+    BOTH = 2,
+    RAW = 3, //ROOT tree and raw histograms without canvases, images can be produced later by tools/renderer
+    NO_OUTPUT = 4 //nothing is written to disk, used with list-mode files or streams
 };
 
 ///
@@ -23,7 +27,30 @@ enum EventTypeToSave
 {
     PASS = 0,
     FAIL = 1,
-    ALL = 2
+    ALL = 2,
+    NONE = 3 //no events are saved, e.g. when only sinograms are needed
+};
+
+///
+/// \brief The TreeSchema enum Specifies layout of events stored inside a TTree.
+///
+enum TreeSchema
+{
+    SPLIT_TREE = 0, //Event objects split into sub-branches
+    FLAT_TREE = 1, //fixed-width leaves and per-photon arrays, see flatevent.h
+    RNTUPLE = 2, //RNTuple with the fields of the flat schema instead of a TTree, see ntuplewriter.h
+    SPARSE_TREE = 3 //flat schema with detected photons only and the number of emitted photons
+};
+
+///
+/// \brief The SweepAxis struct Values of one detector parameter scanned by a sweep, e.g. R := 400:500:10.
+///
+struct SweepAxis
+{
+    std::string name; //key in the param file: R, L, eff, E, p, smearLow or smearHigh
+    std::vector<double> values;
+
+    inline bool operator==(const SweepAxis& axis) const {return name==axis.name && values==axis.values;}
 };
 
 class TwoAndNTestFixture; // for testing
@@ -43,6 +70,8 @@ class ParamManager
         inline int GetSimRuns() const {return fSimRuns_;}
         inline int GetNoOfGammas() const {return fNoOfGammas_;}
         inline float GetEff() const {return fEff_;}
+        inline bool IsEffReweighting() const {return !fReweightEff_.empty();}
+        inline const std::vector<double>& GetReweightEfficiencies() const {return fReweightEff_;}
         inline float GetR() const {return fR_;}
         inline float GetL() const {return fL_;}
         inline float GetE() const {return fE_;} //in keV
@@ -64,10 +93,32 @@ class ParamManager
         inline double GetPhantomNaivePromptProb() const {return fPPhantomPrompt_;}
         inline double GetPhantomUse() const {return fUsePhantom_;}
         inline bool GetPhantomSmear() const {return fPhantomSmear_;}
+        inline bool IsPhantomGeometric() const {return fPhantomShape_>=0;}
+        inline int GetPhantomShape() const {return fPhantomShape_;}
+        inline double GetPhantomSize(const unsigned axis) const {return axis<3 ? fPhantomSize_[axis] : 0.0;}
+        inline std::string GetPhantomVolume() const {return fPhantomVolume_;}
+        inline std::string GetPhantomMaterials() const {return fPhantomMaterials_;}
+        inline bool IsAcceptanceMapMode() const {return fAcceptanceMap_;}
+        inline int GetMapGridSize(const unsigned axis) const {return axis<3 ? fMapGrid_[axis] : 0;}
+        inline int GetMapSamples() const {return fMapSamples_;}
+        inline unsigned GetThreads() const {return fThreads_;}
+        inline const std::string& GetCacheDir() const {return fCacheDir_;}
+        inline bool IsResultCache() const {return fResultCache_;}
+        inline const std::string& GetGeometryFile() const {return fGeometryFile_;}
+        //list of sources read lazily, see sourcelist.h
+        inline const std::string& GetSourceFile() const {return fSourceFile_;}
+        inline bool IsSourceFileSet() const {return !fSourceFile_.empty();}
+        inline bool IsScanMode() const {return fScanMode_;}
+        inline bool IsGeometryFileSet() const {return !fGeometryFile_.empty();}
+        inline const std::string& GetMaterialsFile() const {return fMaterialsFile_;}
+        //additional barrels (R, L) evaluated with the same generated decays, see simulateDecay
+        inline const std::vector<std::pair<double, double> >& GetBarrels() const {return fBarrels_;}
+        inline unsigned GetHistogramGroups() const {return fHistogramGroups_;}
         //////////////////////////////////
         inline void SetR(float r) {fR_=r;}
         inline void SetL(float l) {fL_=l;}
         inline void SetEff(float eff) {fEff_=eff;}
+        inline void SetReweightEfficiencies(const std::vector<double>& effs) {fReweightEff_=effs;}
         inline void SetE(float e) {fE_=e;} //in keV
         inline void SetP(float p) {fP_=p;}
         inline void SetSmearLowLimit(float limit) {fSmearLowLimit_=limit;}
@@ -79,13 +130,67 @@ class ParamManager
         inline void SetOutputType(OutputOptions type) {fOutput_=type;}
         inline EventTypeToSave GetEventTypeToSave() const {return fEventTypeToSave_;}
         inline void SetEventTypeToSave(EventTypeToSave type) {fEventTypeToSave_=type;}
+        inline TreeSchema GetTreeSchema() const {return fTreeSchema_;}
+        inline void SetTreeSchema(TreeSchema schema) {fTreeSchema_=schema;}
+        inline CompressionAlgorithm GetCompressionAlgorithm() const {return fCompressionAlgorithm_;}
+        inline int GetCompressionLevel() const {return fCompressionLevel_;}
+        inline void SetCompression(CompressionAlgorithm algorithm, int level) {fCompressionAlgorithm_=algorithm; fCompressionLevel_=level;}
+        inline int GetBasketSize() const {return fBasketSize_;}
+        inline void SetBasketSize(int size) {fBasketSize_=size;}
+        inline long long GetAutoFlush() const {return fAutoFlush_;}
+        inline void SetAutoFlush(long long autoFlush) {fAutoFlush_=autoFlush;}
+        inline long long GetAutoSave() const {return fAutoSave_;}
+        inline void SetAutoSave(long long autoSave) {fAutoSave_=autoSave;}
+        inline bool IsListMode() const {return fListMode_;}
+        inline void SetListMode(bool isListMode) {fListMode_=isListMode;}
+        inline const std::string& GetFilter() const {return fFilter_;}
+        inline void SetFilter(const std::string& filter) {fFilter_=filter;}
+        inline long long GetChunkEvents() const {return fChunkEvents_;}
+        inline void SetChunkEvents(long long chunkEvents) {fChunkEvents_=chunkEvents;}
+        inline double GetChunkSize() const {return fChunkSize_;}
+        inline void SetChunkSize(double chunkSize) {fChunkSize_=chunkSize;}
+        inline bool IsChunked() const {return fChunkEvents_>0 || fChunkSize_>0;}
+        inline bool IsSinogramEnabled() const {return fSinogramBins_.size()==3;}
+        inline const std::vector<int>& GetSinogramBins() const {return fSinogramBins_;}
+        inline void SetSinogramBins(const std::vector<int>& bins) {fSinogramBins_=bins;}
+        inline double GetSinogramRadius() const {return fSinogramRadius_>0 ? fSinogramRadius_ : fR_;}
+        inline void SetSinogramRadius(double radius) {fSinogramRadius_=radius;}
         inline void SetSeed(int seed){fSeed_=seed;}
         inline void SetUseOfPhantom(bool isPhantom){fUsePhantom_=isPhantom;}
         inline void SetPhantomNaive511Prob(double p){fPPhantom511_=p;}
         inline void SetPhantomNaivePromptProb(double p){fPPhantomPrompt_=p;}
         inline void SetPhantomSmear(bool isSmear){fPhantomSmear_=isSmear;}
+        //shape -1 is the naive phantom, otherwise a value of PhantomType, see phantom.h
+        inline void SetPhantomShape(int shape, double a, double b, double c)
+            {fPhantomShape_=shape; fPhantomVolume_=fPhantomMaterials_=""; fPhantomSize_[0]=a; fPhantomSize_[1]=b; fPhantomSize_[2]=c;}
+        //voxelized phantom: label volume and table of materials, see voxelphantom.h
+        inline void SetPhantomVoxels(const std::string& volume, const std::string& materials)
+            {fPhantomShape_=3; fPhantomVolume_=volume; fPhantomMaterials_=materials;}
+        inline void SetAcceptanceMapMode(bool isMap){fAcceptanceMap_=isMap;}
+        inline void SetMapGridSize(int nx, int ny, int nz){fMapGrid_[0]=nx; fMapGrid_[1]=ny; fMapGrid_[2]=nz;}
+        inline void SetMapSamples(int samples){fMapSamples_=samples;}
+        inline void SetThreads(unsigned threads){fThreads_=threads;}
+        inline void SetCacheDir(const std::string& dir){fCacheDir_=dir;}
+        inline void SetResultCache(bool isCache){fResultCache_=isCache;}
+        inline void SetGeometryFile(const std::string& file){fGeometryFile_=file;}
+        inline void SetMaterialsFile(const std::string& file){fMaterialsFile_=file;}
+        inline void SetSourceFile(const std::string& file){fSourceFile_=file;}
+        inline void SetScanMode(bool isScan){fScanMode_=isScan;}
+        //replaces sources given in the parameter file
+        inline void SetSources(const std::vector<std::vector<double> >& sources){fData_=sources; fSimRuns_=fData_.size();}
+        inline void SetBarrels(const std::vector<std::pair<double, double> >& barrels){fBarrels_=barrels;}
+        inline void SetHistogramGroups(unsigned groups){fHistogramGroups_=groups;}
+        //parameter sweeps
+        inline bool IsSweep() const {return !fSweep_.empty();}
+        inline const std::vector<SweepAxis>& GetSweepAxes() const {return fSweep_;}
+        void SetSweepAxis(const std::string& name, const std::vector<double>& values);
+        int GetNumberOfSweepPoints() const;
+        ParamManager GetSweepPoint(int index) const;
+        static std::vector<double> ParseSweepValues(const std::vector<std::string>& values);
         //access source parameters
         std::vector<double> GetDataAt(const int index=0) const;
+        //describes all parameters which affect results of a single run
+        std::string GetRunKey(const int index) const;
 
         //import parameters from external file
 
@@ -101,6 +206,7 @@ class ParamManager
         int fSimRuns_; //calculated as the number of sets of source parameters
         int fNoOfGammas_;
         float fEff_; //scintillator's efficiency
+        std::vector<double> fReweightEff_; //efficiencies applied as weights of geometrically accepted events, empty - efficiency cut
         float fL_; //detector length
         float fR_; //detector radius
         float fE_; //energy in keV of additional gamma emitted in 2+1 event mode or gamma in 1-gamma mode
@@ -114,14 +220,45 @@ class ParamManager
         double fPPhantom511_; //probability for a 511 keV phantom to scatter inside a phantom in naive mode
         double fPPhantomPrompt_; //probability for a prompt phantom to scatter inside a phantom in naive mode
         bool fPhantomSmear_;
+        int fPhantomShape_; //-1 for the naive phantom, otherwise a value of PhantomType
+        double fPhantomSize_[3]; //dimensions A, B, C of the geometric phantom [mm]
+        std::string fPhantomVolume_; //label volume of the voxelized phantom
+        std::string fPhantomMaterials_; //table of materials of the voxelized phantom
+        bool fAcceptanceMap_; //if true, acceptance is interpolated from cached maps instead of simulating events
+        int fMapGrid_[3]; //number of acceptance map grid points along X, Y and Z
+        int fMapSamples_; //number of decays simulated in every grid point of acceptance map
+        unsigned fThreads_; //number of threads used by parallel parts of the program, 0 means all available
+        std::string fCacheDir_; //directory for cached results
+        bool fResultCache_; //if true, results of runs are reused from the cache directory, see resultcache.h
+        std::string fGeometryFile_; //file with multi-component detector geometry, empty means single barrel (R, L)
+        std::string fMaterialsFile_; //file with definitions of materials, empty means water only, see materials.h
+        std::vector<std::pair<double, double> > fBarrels_; //radii and lengths of barrels compared with the main detector
+        std::string fSourceFile_; //text or binary list of sources used instead of source lines, empty - not used
+        bool fScanMode_; //if true, all sources are simulated into one tree with a source index, see runScan
+        unsigned fHistogramGroups_; //groups of histograms to be filled, bitwise sum of HistogramGroup values
 
         OutputOptions fOutput_; //what kind of output will be produced
         EventTypeToSave fEventTypeToSave_; //what kind of events should be saved
+        TreeSchema fTreeSchema_; //layout of events in the tree
+        CompressionAlgorithm fCompressionAlgorithm_; //compression of the output file
+        int fCompressionLevel_; //from 0 (no compression) to 9
+        int fBasketSize_; //size of baskets of tree branches [bytes]
+        long long fAutoFlush_; //see TTree::SetAutoFlush: >0 number of entries, <0 number of bytes, 0 disabled
+        long long fAutoSave_; //see TTree::SetAutoSave, the same convention
+        bool fListMode_; //if true, accepted coincidences are written to binary list-mode files
+        std::string fFilter_; //expression selecting events saved to the tree, see eventfilter.h, empty means all
+        long long fChunkEvents_; //a new file of the tree is started every N saved events, 0 disables
+        double fChunkSize_; //a new file of the tree is started when the current one exceeds N GB, 0 disables
+        std::vector<int> fSinogramBins_; //radial, angular and axial bins of the sinogram, empty if disabled
+        double fSinogramRadius_; //range of the radial offset of the sinogram [mm], 0 means the detector radius
+        std::vector<SweepAxis> fSweep_; //scanned parameters, the grid contains all combinations of their values
         std::vector<std::vector<double> > fData_; //this is where source parameters are stored
         //fields to store info for 2&N decays
         std::vector<double> fDecayBranchProbability_; //probability that a certain decay branch will be realized (can be abundance also)
         std::vector<std::vector<double> > fGammaEnergy_; //keV
         void ValidatePromptData_(); //validate the 2&N data
+        float ImportSweepable_(const std::string& name, const std::vector<std::string>& values);
+        void SetSweptParam_(const std::string& name, double value);
 
         friend class TwoAndNTestFixture; // for testing
 };
@@ -1,5 +1,15 @@
 #include "phantom.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <memory>
+#include <sys/stat.h>
 #include <TLorentzVector.h>
+#include "TRandom.h"
+#include "TMath.h"
+#include "constants.h"
+#include "comptonsampler.h"
+#include "voxelphantom.h"
 
 ///
 /// \brief Phantom::Phantom Full constructor.
@@ -15,10 +25,14 @@ fA_(a),
 fB_(b),
 fC_(c),
 fSmear_(isSmear),
+fNaive_(false),
 fNaiveProb511_(0),
 fNaiveProbprompt_(0)
 {
-    cs = nullptr;
+    fVoxels_ = nullptr;
+    fMaterials_ = new MaterialTable();
+    fMaterials_->Compute();
+    fMaterial_ = fMaterials_->GetIndex("water");
 }
 
 ///
@@ -33,24 +47,236 @@ fA_(0.0),
 fB_(0.0),
 fC_(0.0),
 fSmear_(isSmear),
+fNaive_(true),
 fNaiveProb511_(p511),
 fNaiveProbprompt_(pPrompt)
 {
-    cs = nullptr;
+    fVoxels_ = nullptr;
+    fMaterials_ = nullptr;
+    fMaterial_ = 0;
+}
+
+///
+/// \brief Phantom::Phantom Creates the phantom described by parameters: naive if its shape is not set, geometric otherwise.
+/// \param pManag ParamManager reference with parameters of the phantom.
+///
+Phantom::Phantom(const ParamManager& pManag) :
+fType_(pManag.IsPhantomGeometric() ? static_cast<PhantomType>(pManag.GetPhantomShape()) : Elipsoid),
+fA_(pManag.GetPhantomSize(0)),
+fB_(pManag.GetPhantomSize(1)),
+fC_(pManag.GetPhantomSize(2)),
+fSmear_(pManag.GetPhantomSmear()),
+fNaive_(!pManag.IsPhantomGeometric()),
+fNaiveProb511_(pManag.GetPhantomNaive511Prob()),
+fNaiveProbprompt_(pManag.GetPhantomNaivePromptProb())
+{
+    fVoxels_ = nullptr;
+    fMaterials_ = nullptr;
+    fMaterial_ = 0;
+    if(fNaive_)
+        return;
+    //the table is owned by the phantom only when the voxel volume was loaded, so that nothing leaks if it throws
+    std::unique_ptr<MaterialTable> materials(pManag.GetMaterialsFile().empty() ? new MaterialTable() : new MaterialTable(pManag.GetMaterialsFile()));
+    mkdir(pManag.GetCacheDir().c_str(), ACCESSPERMS);
+    materials->LoadOrCompute(pManag.GetCacheDir(), pManag.IsSilentMode());
+    fMaterial_ = materials->GetIndex("water");
+    if(fType_==Voxel)
+        fVoxels_ = new VoxelPhantom(pManag.GetPhantomVolume(), pManag.GetPhantomMaterials(), *materials);
+    fMaterials_ = materials.release();
 }
 
 Phantom::~Phantom()
 {
-    if(cs) delete cs;
+    if(fVoxels_) delete fVoxels_;
+    if(fMaterials_) delete fMaterials_;
 }
 
 ///
-/// \brief Phantom::Scatter Phantom simulation -- NOT IMPLEMENTED!
-/// \param event
+/// \brief Phantom::Apply Scatters photons inside the phantom, with the model selected by its constructor.
+/// \param event Pointer to Event class object, for which in-phantom scattering is done.
+///
+void Phantom::Apply(Event* event)
+{
+    if(fNaive_)
+        NaiveScatter(event);
+    else
+        Scatter(event);
+}
+
+///
+/// \brief Phantom::Scatter Tracks photons through the water-filled phantom. Free paths are sampled from the attenuation
+/// coefficient at the current energy and compared with the analytic length of the chord, so photons that leave the phantom
+/// cost one intersection test. At every interaction the photon is Compton- or Rayleigh-scattered, or absorbed, see Interact.
+/// Scattered photons start from the last interaction point, at the time of flight along the path travelled inside the phantom,
+/// which is added to their hit times.
+/// Voxelized phantoms are tracked by VoxelPhantom::Scatter.
+/// \param event Pointer to Event class object, for which in-phantom scattering is done.
 ///
 void Phantom::Scatter(Event* event)
 {
+    if(fVoxels_)
+    {
+        fVoxels_->Scatter(event);
+        return;
+    }
+    for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
+    {
+        TLorentzVector* momentum = event->GetFourMomentumOf(ii);
+        double E = momentum->E();
+        double p = momentum->P();
+        if(E<=0.0 || p<=0.0)
+            continue;
+        double dir[3] = {momentum->X()/p, momentum->Y()/p, momentum->Z()/p};
+        const TLorentzVector* emission = event->GetEmissionPointOf(ii);
+        double point[3] = {emission->X(), emission->Y(), emission->Z()};
+        int interactions = 0;
+        bool absorbed = false;
+        double travelled = 0.0; //path from the emission point to the last interaction [mm]
+        double tIn = 0.0, tOut = 0.0;
+        double mu[MaterialTable::kColumns];
+        while(interactions<kMaxInteractions && !absorbed && Intersect(point, dir, tIn, tOut))
+        {
+            fMaterials_->GetAttenuations(fMaterial_, E, mu);
+            double path = std::max(tIn, 0.0) + gRandom->Exp(1.0/mu[TOTAL_ATTENUATION]);
+            if(path>=tOut)
+                break; //photon leaves the phantom
+            for(int jj=0; jj<3; jj++)
+                point[jj] += path*dir[jj];
+            travelled += path;
+            absorbed = !Interact(mu, E, dir);
+            interactions++;
+        }
+        if(absorbed)
+            Absorb(event, ii, point, emission->T()+FlightTime(travelled));
+        else if(interactions>0)
+        {
+            TLorentzVector newMomentum(dir[0]*E, dir[1]*E, dir[2]*E, E);
+            TLorentzVector newPoint(point[0], point[1], point[2], emission->T()+FlightTime(travelled));
+            event->SetFourMomentumOf(ii, newMomentum);
+            event->SetEmissionPointOf(ii, newPoint);
+            event->SetPrimaryPhoton(ii, false);
+        }
+    }
+}
+
+///
+/// \brief Phantom::Intersect Calculates the chord of a ray through the phantom in closed form: slabs for the box and
+/// the bases of the cylinder, a quadratic equation for the ellipsoid and the side of the cylinder.
+/// \param point Starting point of the ray [mm].
+/// \param dir Normalized direction of the ray.
+/// \param tIn Distance at which the ray enters the phantom, negative if the point is inside.
+/// \param tOut Distance at which the ray leaves the phantom.
+/// \return True if the phantom lies (at least partially) in front of the point.
+///
+bool Phantom::Intersect(const double* point, const double* dir, double& tIn, double& tOut) const
+{
+    const double size[3] = {fA_, fB_, fC_};
+    tIn = -std::numeric_limits<double>::infinity();
+    tOut = std::numeric_limits<double>::infinity();
+    //slabs limiting the box in all directions and the cylinder along Z
+    for(int ii=(fType_==Box ? 0 : (fType_==Cylinder ? 2 : 3)); ii<3; ii++)
+    {
+        if(dir[ii]==0.0)
+        {
+            if(std::fabs(point[ii])>size[ii])
+                return false;
+            continue;
+        }
+        double t1 = (-size[ii]-point[ii])/dir[ii];
+        double t2 = (size[ii]-point[ii])/dir[ii];
+        if(t1>t2)
+            std::swap(t1, t2);
+        tIn = std::max(tIn, t1);
+        tOut = std::min(tOut, t2);
+    }
+    if(fType_!=Box)
+    {
+        //x^2/A^2 + y^2/B^2 (+ z^2/C^2) = 1 in coordinates scaled by dimensions
+        const int axes = fType_==Cylinder ? 2 : 3;
+        double a = 0.0, halfB = 0.0, c = -1.0;
+        for(int ii=0; ii<axes; ii++)
+        {
+            double p = point[ii]/size[ii];
+            double d = dir[ii]/size[ii];
+            a += d*d;
+            halfB += p*d;
+            c += p*p;
+        }
+        if(a==0.0)
+        {
+            //ray parallel to the axis of the cylinder
+            if(c>0.0)
+                return false;
+        }
+        else
+        {
+            double discriminant = halfB*halfB-a*c;
+            if(discriminant<0.0)
+                return false;
+            double root = std::sqrt(discriminant);
+            tIn = std::max(tIn, (-halfB-root)/a);
+            tOut = std::min(tOut, (-halfB+root)/a);
+        }
+    }
+    return tOut>tIn && tOut>0.0;
+}
+
+///
+/// \brief Phantom::Interact Chooses the type of the interaction with probabilities proportional to attenuation coefficients.
+/// Compton scattering reduces the energy and changes the direction by the Klein-Nishina angle, Rayleigh scattering changes
+/// only the direction (by the Thomson angle, form factors are neglected), the photoelectric effect absorbs the photon.
+/// \param mu Attenuation coefficients at the energy of the photon, see MaterialTable::GetAttenuations.
+/// \param E Energy of the photon in MeV, updated.
+/// \param dir Normalized direction of the photon, updated.
+/// \return False if the photon was absorbed.
+///
+bool Phantom::Interact(const double* mu, double& E, double* dir)
+{
+    double choice = gRandom->Rndm()*mu[TOTAL_ATTENUATION];
+    if(choice<mu[PHOTOELECTRIC])
+        return false;
+    double cosTheta = 1.0;
+    if(choice<mu[PHOTOELECTRIC]+mu[COMPTON])
+    {
+        cosTheta = ComptonSampler::SampleCosTheta(E);
+        E = ComptonSampler::ScatteredEnergy(E, cosTheta);
+    }
+    else
+    {
+        //(1+cos^2)/2 sampled by rejection
+        do
+            cosTheta = 2.0*gRandom->Rndm()-1.0;
+        while(2.0*gRandom->Rndm()>1.0+cosTheta*cosTheta);
+    }
+    ComptonSampler::RotateDirection(dir, cosTheta, 2.0*TMath::Pi()*gRandom->Rndm());
+    return true;
+}
 
+///
+/// \brief Phantom::Absorb Marks a photon as absorbed: its four-momentum is set to zero, so it misses the detector, and it
+/// is moved to the point of absorption.
+/// \param event Pointer to Event class object.
+/// \param index Index of the photon.
+/// \param point Point of absorption [mm].
+/// \param time Time of absorption, see FlightTime.
+///
+void Phantom::Absorb(Event* event, int index, const double* point, double time)
+{
+    TLorentzVector zero(0.0, 0.0, 0.0, 0.0);
+    TLorentzVector newPoint(point[0], point[1], point[2], time);
+    event->SetFourMomentumOf(index, zero);
+    event->SetEmissionPointOf(index, newPoint);
+    event->SetPrimaryPhoton(index, false);
+}
+
+///
+/// \brief Phantom::FlightTime Time in which a photon travels the given path, in the same units as hit times (see CalculateHitPointsBatch).
+/// \param path Length of the path [mm].
+/// \return Time of flight.
+///
+double Phantom::FlightTime(double path)
+{
+    return path*1000000.0/light_speed_SI;
 }
 
 ///
@@ -59,11 +285,6 @@ void Phantom::Scatter(Event* event)
 ///
 void Phantom::NaiveScatter(Event* event)
 {
-    if(cs==nullptr)
-    {
-        //create ne ComptonScattering object to perform in-phantom scattering
-        cs = new ComptonScattering(event->GetDecayType());
-    }
     //loop over photons
     for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
     {
@@ -71,7 +292,7 @@ void Phantom::NaiveScatter(Event* event)
         double prob = ii < noOf511 ? fNaiveProb511_ : fNaiveProbprompt_;
         if(gRandom->Uniform(0.0, 1.0)<prob)
         {
-            cs->Scatter(event, ii);
+            ComptonSampler::Scatter(event, ii, 0.0, 2.0);
             TLorentzVector* v = event->GetFourMomentumOf(ii);
             double newE = 0.0;
             if(fSmear_)
@@ -1,33 +1,63 @@
 #ifndef PHANTOM_H
 #define PHANTOM_H
 #include "event.h"
-#include "comptonscattering.h"
+#include "parammanager.h"
+#include "materials.h"
 
 enum PhantomType
 {
     Cylinder = 0,
     Elipsoid = 1,
-    Box = 2
+    Box = 2,
+    Voxel = 3 //voxelized phantom, see voxelphantom.h
 };
 
+class VoxelPhantom;
+
+///
+/// \brief The Phantom class Scattering of photons inside a phantom. Geometric phantoms are centred at the origin:
+/// an elliptic cylinder with semi-axes A, B in XY and half-length C along Z, an ellipsoid with semi-axes A, B, C
+/// or a box with half-sizes A, B, C [mm], filled with water. Voxelized phantoms are tracked by VoxelPhantom.
+///
 class Phantom
 {
     public:
         Phantom(PhantomType type = Box, double a=1, double b=1, double c=1, bool isSmear=false);
         Phantom(double p511, double pPrompt, bool isSmear); // NaiveConstructor
+        explicit Phantom(const ParamManager& pManag); //naive or geometric phantom, depending on parameters
         ~Phantom();
-        void Scatter(Event* event);
+        void Apply(Event* event); //Scatter or NaiveScatter, depending on the type of the phantom
+        void Scatter(Event* event); //photons are tracked through the phantom
         void NaiveScatter(Event* event); //naive scattering, only energy of photons is altered
+        //distances along the ray point+t*dir (dir normalized) at which it enters and leaves the phantom
+        bool Intersect(const double* point, const double* dir, double& tIn, double& tOut) const;
+        inline bool IsNaive() const {return fNaive_;}
+        inline const MaterialTable* GetMaterials() const {return fMaterials_;}
+        //interaction of a photon chosen according to attenuation coefficients mu (see MaterialTable::GetAttenuations),
+        //energy and direction are updated, returns false if the photon was absorbed
+        static bool Interact(const double* mu, double& E, double* dir);
+        //absorbed photons have zero four-momentum, so they never reach the detector
+        static void Absorb(Event* event, int index, const double* point, double time);
+        //time of flight over a path [mm] in units of hit times, added to the start time of photons scattered inside the phantom
+        static double FlightTime(double path);
+
+        static const int kMaxInteractions = 20; //photons are not tracked after so many interactions
     private:
+        Phantom(const Phantom&);
+        Phantom& operator=(const Phantom&);
+
         //dimensions of the phantom in mm
         PhantomType fType_; //type of the phantom
         double fA_; //dimension A
         double fB_; //dimension B
         double fC_; //dimension C
         bool fSmear_; //Apply smearing
+        bool fNaive_; //true if only NaiveScatter is used
         double fNaiveProb511_; //probability to scatter inside a phantom for 511 keV photons
         double fNaiveProbprompt_; //probability to scatter inside a phantom for prompt photons
-        ComptonScattering* cs;
+        VoxelPhantom* fVoxels_; //label volume and materials of the voxelized phantom, nullptr for other types
+        MaterialTable* fMaterials_; //attenuation coefficients, nullptr for the naive phantom
+        int fMaterial_; //index of the material of the geometric phantom
 
 };
 
@@ -15,6 +15,7 @@
 #include "event.h"
 #include "comptonscattering.h"
 #include "parammanager.h"
+#include "histogramregistry.h"
 
 class TwoAndNTestFixture; //for testing
 
@@ -24,12 +25,17 @@ class TwoAndNTestFixture; //for testing
 class PsDecay
 {
     public:
-        PsDecay(DecayType type=TWO);
+        PsDecay(DecayType type=TWO, unsigned histogramGroups=ALL_HISTOGRAMS);
         PsDecay(const PsDecay&);
         PsDecay& operator=(const PsDecay& est);
         ~PsDecay();
         void AddEvent(const Event* event) const;
         void DrawHistograms(std::string prefix="RM", OutputOptions output=PNG);
+        //writing histograms without drawing (RAW output) and reading them back (tools/renderer)
+        void WriteHistograms() const;
+        //histogram fills are buffered, flushing is needed only when histograms are accessed directly
+        inline void FlushHistograms() const {fRegistry_.Flush();}
+        void ReadHistograms(TDirectory* dir);
 
         //silent mode switch on/off
         inline void EnableSilentMode(){fSilentMode_=true;}
@@ -40,6 +46,8 @@ class PsDecay
 
         DecayType fDecayType_;
         std::string fTypeString_;
+        //owns all histograms, pointers below are only shortcuts and are nullptr for disabled groups
+        mutable HistogramRegistry fRegistry_;
 
         // histograms with relative angles for all events generated
         TH1F* fH_12_; //used when TWO or TWOandONE
@@ -58,6 +66,8 @@ class PsDecay
         TH1F* fH_phi_;
         TH1F* fH_cosTheta_;
 
+        void AssignHistograms_();
+
         friend class TwoAndNTestFixture; // for testing
 
         static unsigned objectID_;
@@ -0,0 +1,70 @@
+/// @file rawoutput.cpp
+/// @date 19.10.2026
+#include "TParameter.h"
+#include "rawoutput.h"
+
+static const std::string kRawDirectoryPrefix = "decay";
+
+///
+/// \brief WriteRawHistogram Writes the histogram to the current directory without drawing it.
+/// \param hist Histogram to be written, nullptr is skipped.
+/// \param key Name of the key, independent of the histogram's name.
+///
+void WriteRawHistogram(const TH1* hist, const std::string& key)
+{
+    if(hist)
+        hist->Write(key.c_str());
+}
+
+///
+/// \brief WriteRawValue Writes a single number to the current directory.
+/// \param value Value to be written.
+/// \param key Name of the key.
+///
+void WriteRawValue(double value, const std::string& key)
+{
+    TParameter<double> par(key.c_str(), value);
+    par.Write();
+}
+
+///
+/// \brief ReadRawValue Reads a number written by WriteRawValue.
+/// \param dir Directory to read from.
+/// \param key Name of the key.
+/// \param defaultValue Value returned when the key is missing.
+/// \return Stored value.
+///
+double ReadRawValue(TDirectory* dir, const std::string& key, double defaultValue)
+{
+    TParameter<double>* par = dynamic_cast<TParameter<double>*>(dir->Get(key.c_str()));
+    if(!par)
+        return defaultValue;
+    double value = par->GetVal();
+    delete par;
+    return value;
+}
+
+///
+/// \brief RawDirectoryName Name of the directory in which raw histograms of the given decay type are stored.
+/// \param type Type of the decay.
+/// \return Name of the directory.
+///
+std::string RawDirectoryName(DecayType type)
+{
+    return kRawDirectoryPrefix+std::to_string(type);
+}
+
+///
+/// \brief DecayTypeFromRawDirectory Recognizes decay type from the name of the directory with raw histograms.
+/// \param name Name of the directory.
+/// \return Type of the decay, WRONG if the name was not created by RawDirectoryName.
+///
+DecayType DecayTypeFromRawDirectory(const std::string& name)
+{
+    if(name.compare(0, kRawDirectoryPrefix.size(), kRawDirectoryPrefix)!=0 || name.size()==kRawDirectoryPrefix.size())
+        return WRONG;
+    int type = atoi(name.substr(kRawDirectoryPrefix.size()).c_str());
+    if(type<ONE || type>TWOandN)
+        return WRONG;
+    return static_cast<DecayType>(type);
+}
@@ -0,0 +1,40 @@
+/// @file rawoutput.h
+/// @date 19.10.2026
+#ifndef RAWOUTPUT_H
+#define RAWOUTPUT_H
+#include <string>
+#include "TH1.h"
+#include "TDirectory.h"
+#include "event.h"
+
+//writes the histogram to the current directory under the given key, nullptr is skipped
+void WriteRawHistogram(const TH1* hist, const std::string& key);
+//writes a single number to the current directory under the given key
+void WriteRawValue(double value, const std::string& key);
+//reads a number written by WriteRawValue, returns defaultValue if it is missing
+double ReadRawValue(TDirectory* dir, const std::string& key, double defaultValue=0.0);
+//name of the directory with raw histograms of one decay type and the reverse operation
+std::string RawDirectoryName(DecayType type);
+DecayType DecayTypeFromRawDirectory(const std::string& name);
+
+///
+/// \brief ReadRawHistogram Replaces a histogram with the one stored in a directory. The old histogram is deleted.
+/// \param dir Directory with histograms written by WriteRawHistogram.
+/// \param key Key of the histogram.
+/// \param hist Reference to the pointer to be replaced, it is not changed if the key is missing.
+/// \return True if the histogram was found.
+///
+template<class T>
+bool ReadRawHistogram(TDirectory* dir, const std::string& key, T*& hist)
+{
+    T* stored = dynamic_cast<T*>(dir->Get(key.c_str()));
+    if(!stored)
+        return false;
+    stored->SetDirectory(nullptr); //from now on the histogram is owned by the caller
+    if(hist)
+        delete hist;
+    hist = stored;
+    return true;
+}
+
+#endif // RAWOUTPUT_H
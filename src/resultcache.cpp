@@ -0,0 +1,252 @@
+/// @file resultcache.cpp
+/// @date 19.10.2026
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <set>
+#include <cstdio>
+#include <cstdint>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "TFile.h"
+#include "TKey.h"
+#include "TTree.h"
+#include "TClass.h"
+#include "TList.h"
+#include "hash.h"
+#include "resultcache.h"
+
+///
+/// \brief readFile Reads the whole file.
+/// \param path Path to the file.
+/// \return Content of the file, empty if it cannot be read.
+///
+static std::string readFile(const std::string& path)
+{
+    std::ifstream file(path.c_str(), std::ios::binary);
+    std::ostringstream content;
+    content<<file.rdbuf();
+    return content.str();
+}
+
+///
+/// \brief copyFiles Copies regular files from one directory to another, subdirectories are skipped.
+/// \param from Source directory, ending with '/'.
+/// \param to Existing target directory, ending with '/'.
+///
+static void copyFiles(const std::string& from, const std::string& to)
+{
+    DIR* dir = opendir(from.c_str());
+    if(!dir)
+        return;
+    while(dirent* entry = readdir(dir))
+    {
+        std::string name(entry->d_name);
+        struct stat info;
+        if(stat((from+name).c_str(), &info)!=0 || !S_ISREG(info.st_mode))
+            continue;
+        std::ifstream in((from+name).c_str(), std::ios::binary);
+        std::ofstream out((to+name).c_str(), std::ios::binary);
+        out<<in.rdbuf();
+        if(!out)
+        {
+            closedir(dir);
+            throw(std::string("[ERROR] Cannot copy the file: ")+from+name);
+        }
+    }
+    closedir(dir);
+}
+
+///
+/// \brief copyDirectory Copies the latest cycle of every object from one ROOT directory to another, recursively.
+/// Trees are cloned without unpacking baskets.
+/// \param from Source directory.
+/// \param to Target directory.
+///
+static void copyDirectory(TDirectory* from, TDirectory* to)
+{
+    std::set<std::string> copied;
+    TIter next(from->GetListOfKeys());
+    while(TKey* key = static_cast<TKey*>(next()))
+    {
+        //keys are sorted by cycle, the latest one comes first
+        if(!copied.insert(key->GetName()).second)
+            continue;
+        TClass* type = TClass::GetClass(key->GetClassName());
+        if(type && type->InheritsFrom("TDirectory"))
+        {
+            TDirectory* source = from->GetDirectory(key->GetName());
+            TDirectory* target = to->GetDirectory(key->GetName());
+            if(!target)
+                target = to->mkdir(key->GetName(), key->GetTitle());
+            copyDirectory(source, target);
+        }
+        else if(type && type->InheritsFrom("TTree"))
+        {
+            TTree* tree = static_cast<TTree*>(key->ReadObj());
+            to->cd();
+            TTree* clone = tree->CloneTree(-1, "fast");
+            clone->Write(key->GetName());
+            delete clone;
+            delete tree;
+        }
+        else
+        {
+            TObject* object = key->ReadObj();
+            to->WriteTObject(object, key->GetName());
+            delete object;
+        }
+    }
+}
+
+///
+/// \brief ResultCache::ResultCache Constructor, creates the directory of entries if necessary.
+/// \param cacheDir Cache directory of the simulation, ending with '/'.
+///
+ResultCache::ResultCache(const std::string& cacheDir) :
+    fDir_(cacheDir+"runs/")
+{
+    mkdir(cacheDir.c_str(), ACCESSPERMS);
+    mkdir(fDir_.c_str(), ACCESSPERMS);
+}
+
+///
+/// \brief ResultCache::GetKey Describes everything the run depends on.
+/// \param pManag ParamManager reference with parameters of the simulation.
+/// \param simRun Index of the run (line with source parameters).
+/// \param materials Tables of attenuation coefficients loaded by the phantom, nullptr if they are not used.
+/// \return Human-readable key.
+///
+std::string ResultCache::GetKey(const ParamManager& pManag, int simRun, const MaterialTable* materials)
+{
+    std::ostringstream key;
+    key<<pManag.GetRunKey(simRun);
+    if(pManag.IsGeometryFileSet())
+        key<<" geometryHash="<<std::hex<<fnv1a(readFile(pManag.GetGeometryFile()))<<std::dec;
+    if(pManag.GetPhantomUse() && !pManag.GetPhantomVolume().empty())
+        key<<" phantomHash="<<std::hex<<fnv1a(readFile(pManag.GetPhantomVolume()))<<","\
+           <<fnv1a(readFile(pManag.GetPhantomMaterials()))<<std::dec;
+    if(pManag.GetPhantomUse() && materials!=nullptr)
+        key<<" materials={"<<materials->GetKey()<<"}";
+    key<<" code="<<GetCodeVersion();
+    return key.str();
+}
+
+///
+/// \brief ResultCache::GetRunSeed Derives the seed of the run from its parameters and the seed given by the user.
+/// \param pManag ParamManager reference with parameters of the simulation.
+/// \param simRun Index of the run.
+/// \return Seed different from 0 (0 would mean a random seed for TRandom3).
+///
+unsigned ResultCache::GetRunSeed(const ParamManager& pManag, int simRun)
+{
+    return static_cast<unsigned>(fnv1a(pManag.GetRunKey(simRun))%0xfffffffeULL)+1;
+}
+
+///
+/// \brief ResultCache::GetCodeVersion Identifies the build of the program.
+/// \return Size and modification time of the executable, or the time of compilation if they are unknown.
+///
+std::string ResultCache::GetCodeVersion()
+{
+    struct stat info;
+    std::ostringstream version;
+    if(stat("/proc/self/exe", &info)==0)
+        version<<info.st_size<<"@"<<info.st_mtime;
+    else
+        version<<__DATE__<<" "<<__TIME__;
+    return version.str();
+}
+
+///
+/// \brief ResultCache::GetEntryDir Directory of the entry with the given key.
+/// \param key Key created by GetKey.
+/// \return Path ending with '/'.
+///
+std::string ResultCache::GetEntryDir(const std::string& key) const
+{
+    std::ostringstream name;
+    name<<fDir_<<std::hex<<std::setw(16)<<std::setfill('0')<<fnv1a(key)<<"/";
+    return name.str();
+}
+
+///
+/// \brief ResultCache::Contains Checks if a complete entry with exactly the same key exists.
+/// \param key Key created by GetKey.
+/// \return True if results of the run can be restored.
+///
+bool ResultCache::Contains(const std::string& key) const
+{
+    return readFile(GetEntryDir(key)+"key.txt")==key;
+}
+
+///
+/// \brief ResultCache::Store Copies results of the run to the entry. The entry is used only after Commit.
+/// \param key Key created by GetKey.
+/// \param runDir ROOT directory of the run, nullptr if there is no ROOT output.
+/// \param imageDir Directory with images of the run ending with '/', empty if there are no images.
+///
+void ResultCache::Store(const std::string& key, TDirectory* runDir, const std::string& imageDir) const
+{
+    std::string entry = GetEntryDir(key);
+    mkdir(entry.c_str(), ACCESSPERMS);
+    std::remove((entry+"key.txt").c_str()); //the previous entry is invalid from now on
+    std::remove((entry+"run.root").c_str());
+    if(runDir)
+    {
+        TDirectory* previous = gDirectory;
+        TFile file((entry+"run.root").c_str(), "recreate");
+        if(file.IsZombie())
+        {
+            previous->cd();
+            throw(std::string("[ERROR] Cannot create the file in the cache: ")+entry+"run.root");
+        }
+        copyDirectory(runDir, &file);
+        file.Close();
+        previous->cd();
+    }
+    if(!imageDir.empty())
+    {
+        mkdir((entry+"images/").c_str(), ACCESSPERMS);
+        copyFiles(imageDir, entry+"images/");
+    }
+}
+
+///
+/// \brief ResultCache::Restore Copies results of the run from the entry.
+/// \param key Key created by GetKey.
+/// \param runDir ROOT directory of the run, nullptr if there is no ROOT output.
+/// \param imageDir Existing directory for images of the run ending with '/', empty if there are no images.
+///
+void ResultCache::Restore(const std::string& key, TDirectory* runDir, const std::string& imageDir) const
+{
+    std::string entry = GetEntryDir(key);
+    if(runDir)
+    {
+        TDirectory* previous = gDirectory;
+        TFile file((entry+"run.root").c_str(), "read");
+        if(file.IsZombie())
+        {
+            previous->cd();
+            throw(std::string("[ERROR] Cannot read the file from the cache: ")+entry+"run.root");
+        }
+        copyDirectory(&file, runDir);
+        file.Close();
+        previous->cd();
+    }
+    if(!imageDir.empty())
+        copyFiles(entry+"images/", imageDir);
+}
+
+///
+/// \brief ResultCache::Commit Writes the key to the entry, which makes it available for Contains and Restore.
+/// \param key Key created by GetKey.
+///
+void ResultCache::Commit(const std::string& key) const
+{
+    std::string path = GetEntryDir(key)+"key.txt";
+    std::ofstream file(path.c_str(), std::ios::binary);
+    file<<key;
+    if(!file)
+        throw(std::string("[ERROR] Cannot write to the cache: ")+path);
+}
@@ -0,0 +1,39 @@
+/// @file resultcache.h
+/// @date 19.10.2026
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+#include <string>
+#include "TDirectory.h"
+#include "parammanager.h"
+#include "materials.h"
+
+///
+/// \brief The ResultCache class Results of single runs stored on disk under a hash of everything they depend on:
+/// parameters, the source line, 2&N data, the geometry file and the version of the program. Every entry is a directory
+/// <cacheDir>runs/<hash>/ with a copy of the ROOT directory of the run (run.root), images of the run (images/) and
+/// a file with the key, which is written last, so interrupted entries are never used.
+///
+class ResultCache
+{
+    public:
+        explicit ResultCache(const std::string& cacheDir);
+        //human-readable description of the run, stored in the entry to detect collisions of hashes,
+        //materials are the tables of the phantom in use (nullptr without a phantom or for the naive one)
+        static std::string GetKey(const ParamManager& pManag, int simRun, const MaterialTable* materials=nullptr);
+        //seed of the run derived from its parameters, so that runs do not depend on each other
+        static unsigned GetRunSeed(const ParamManager& pManag, int simRun);
+        //size and modification time of the executable, results of other builds are not reused
+        static std::string GetCodeVersion();
+        std::string GetEntryDir(const std::string& key) const;
+        bool Contains(const std::string& key) const;
+        //copies the run directory (may be nullptr) and images from imageDir (may be empty) to/from the entry
+        void Store(const std::string& key, TDirectory* runDir, const std::string& imageDir) const;
+        void Restore(const std::string& key, TDirectory* runDir, const std::string& imageDir) const;
+        //marks the entry as complete
+        void Commit(const std::string& key) const;
+
+    private:
+        std::string fDir_; //directory with entries, ending with '/'
+};
+
+#endif // RESULTCACHE_H
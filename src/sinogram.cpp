@@ -0,0 +1,115 @@
+/// @file sinogram.cpp
+/// @date 19.10.2026
+#include <cmath>
+#include "TMath.h"
+#include "TH2.h"
+#include "TImage.h"
+#include "TCanvas.h"
+#include "sinogram.h"
+#include "particlegenerator.h"
+
+///
+/// \brief Sinogram::Sinogram Creates an empty sinogram.
+/// \param type Type of the decay, used in names of the histogram and the image.
+/// \param nRadial Number of bins of the radial offset.
+/// \param nAngles Number of bins of the angle in [0, pi).
+/// \param nSlices Number of axial slices.
+/// \param maxRadius Range of the radial offset is [-maxRadius, maxRadius] [mm].
+/// \param L Length of the detector, slices cover [-L/2, L/2] [mm].
+///
+Sinogram::Sinogram(DecayType type, int nRadial, int nAngles, int nSlices, double maxRadius, double L) :
+    fHistogram_(nullptr),
+    fAcceptedLORs_(0)
+{
+    int noOfGammas = 0;
+    fTypeString_ = recognizeType(type, noOfGammas);
+    fHistogram_ = new TH3F(("sinogram_"+std::to_string(type)).c_str(), "Sinogram;s [mm];#phi [rad];z [mm]", nRadial, -maxRadius, maxRadius,\
+                           nAngles, 0.0, TMath::Pi(), nSlices, -L/2.0, L/2.0);
+    fHistogram_->SetDirectory(nullptr); //owned by this object, written explicitly
+}
+
+///
+/// \brief Sinogram::~Sinogram Destructor.
+///
+Sinogram::~Sinogram()
+{
+    delete fHistogram_;
+}
+
+///
+/// \brief Sinogram::IsSupported Checks if the decay produces a pair of back-to-back photons as the first two products.
+/// \param type Type of the decay.
+/// \return True for 2-gamma, 2&1 and 2&N decays.
+///
+bool Sinogram::IsSupported(DecayType type)
+{
+    return type==TWO || type==TWOandONE || type==TWOandN;
+}
+
+///
+/// \brief Sinogram::ProjectLOR Calculates sinogram coordinates of the line through two points in the transverse plane.
+/// \param x1 X coordinate of the first point.
+/// \param y1 Y coordinate of the first point.
+/// \param x2 X coordinate of the second point.
+/// \param y2 Y coordinate of the second point.
+/// \param s Signed distance of the line from the axis.
+/// \param phi Angle of the normal to the line, in [0, pi).
+///
+void Sinogram::ProjectLOR(double x1, double y1, double x2, double y2, double& s, double& phi)
+{
+    //normal to the direction (dx, dy) is (-dy, dx)
+    phi = std::atan2(x2-x1, y1-y2);
+    if(phi<0.0)
+        phi += TMath::Pi();
+    if(phi>=TMath::Pi())
+        phi -= TMath::Pi();
+    s = x1*std::cos(phi)+y1*std::sin(phi);
+}
+
+///
+/// \brief Sinogram::Add Adds the LOR joining hit points of the two annihilation photons, weighted with the event's weight.
+/// \param event Pointer to Event object after InitialCuts::AddCuts.
+/// \return False if any of the two photons did not pass cuts.
+///
+bool Sinogram::Add(const Event* event)
+{
+    if(event->GetNumberOfDecayProducts()<2 || !event->GetCutPassingOf(0) || !event->GetCutPassingOf(1))
+        return false;
+    const TLorentzVector* first = event->GetHitPointOf(0);
+    const TLorentzVector* second = event->GetHitPointOf(1);
+    if(!first || !second)
+        return false;
+    double s = 0.0;
+    double phi = 0.0;
+    ProjectLOR(first->X(), first->Y(), second->X(), second->Y(), s, phi);
+    fHistogram_->Fill(s, phi, 0.5*(first->Z()+second->Z()), event->GetWeight());
+    fAcceptedLORs_++;
+    return true;
+}
+
+///
+/// \brief Sinogram::Write Writes the histogram to the current directory.
+///
+void Sinogram::Write() const
+{
+    fHistogram_->Write();
+}
+
+///
+/// \brief Sinogram::Draw Saves the sinogram summed over all slices as a PNG image.
+/// \param filePrefix Prefix of the image's path.
+///
+void Sinogram::Draw(const std::string& filePrefix) const
+{
+    TH1* projection = fHistogram_->Project3D("yx");
+    projection->SetDirectory(nullptr);
+    projection->SetStats(false);
+    TCanvas* c = new TCanvas((fTypeString_+"-gammas_sinogram").c_str(), "Sinogram", 1000, 800);
+    projection->Draw("colz");
+    TImage *img = TImage::Create();
+    img->FromPad(c);
+    img->WriteImage((filePrefix+fTypeString_+"-gammas_sinogram.png").c_str());
+    delete img;
+    delete c;
+    delete projection;
+}
@@ -0,0 +1,42 @@
+/// @file sinogram.h
+/// @date 19.10.2026
+#ifndef SINOGRAM_H
+#define SINOGRAM_H
+#include <string>
+#include "TH3.h"
+#include "event.h"
+#include "parammanager.h"
+
+///
+/// \brief The Sinogram class Accumulates lines of response (LORs) of coincidences of the two annihilation photons into
+/// a histogram of radial offset, angle and axial slice, so that events do not have to be stored to build sinograms.
+/// Oblique LORs are assigned to the slice of the mean z of both hits (single-slice rebinning).
+///
+class Sinogram
+{
+    public:
+        Sinogram(DecayType type, int nRadial, int nAngles, int nSlices, double maxRadius, double L);
+        ~Sinogram();
+        //adds the LOR of the first two photons if both passed cuts, returns false if the event was skipped
+        bool Add(const Event* event);
+        //writes the histogram to the current directory
+        void Write() const;
+        //saves an image of the sinogram summed over slices
+        void Draw(const std::string& filePrefix) const;
+        inline const TH3F* GetHistogram() const {return fHistogram_;}
+        inline long long GetAcceptedLORs() const {return fAcceptedLORs_;}
+        //sinograms are built only for decays with two back-to-back photons
+        static bool IsSupported(DecayType type);
+        //radial offset s and angle phi in [0, pi) of the line through two points, s = x*cos(phi)+y*sin(phi)
+        static void ProjectLOR(double x1, double y1, double x2, double y2, double& s, double& phi);
+
+    private:
+        Sinogram(const Sinogram&);
+        Sinogram& operator=(const Sinogram&);
+
+        TH3F* fHistogram_; //x: radial offset [mm], y: angle [rad], z: axial position [mm]
+        std::string fTypeString_;
+        long long fAcceptedLORs_;
+};
+
+#endif // SINOGRAM_H
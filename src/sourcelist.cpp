@@ -0,0 +1,193 @@
+/// @file sourcelist.cpp
+/// @date 19.10.2026
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cstddef>
+#include <cctype>
+#include "sourcelist.h"
+
+//sources are written in the host byte order, which is little-endian on all supported platforms
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Binary lists of sources are little-endian, big-endian hosts are not supported.");
+static_assert(sizeof(SourceListHeader) == 24, "Header of binary lists of sources must have a fixed size.");
+
+namespace
+{
+    const char kMagic[8] = {'J', 'P', 'E', 'T', 'S', 'R', 'C', '\0'};
+    const uint32_t kVersion = 1;
+}
+
+///
+/// \brief SourceList::SourceList Opens a list of sources, the format is recognized by the magic of binary lists.
+/// \param path Path of the list.
+///
+SourceList::SourceList(const std::string& path) :
+    fPath_(path),
+    fFile_(path.c_str(), std::ios::binary),
+    fBinary_(false),
+    fRead_(0),
+    fLine_(0)
+{
+    if(!fFile_)
+        throw(std::string("[ERROR] Cannot open the list of sources: ")+path);
+    std::memset(&fHeader_, 0, sizeof(fHeader_));
+    fFile_.read(reinterpret_cast<char*>(&fHeader_), sizeof(fHeader_));
+    if(fFile_.gcount()==sizeof(fHeader_) && std::memcmp(fHeader_.magic, kMagic, sizeof(kMagic))==0)
+    {
+        if(fHeader_.version!=kVersion || fHeader_.valuesPerSource!=kValues)
+            throw(std::string("[ERROR] Unsupported version of the list of sources: ")+path);
+        fBinary_ = true;
+    }
+    Rewind();
+}
+
+///
+/// \brief SourceList::Rewind Moves to the first source of the list.
+///
+void SourceList::Rewind()
+{
+    fFile_.clear();
+    fFile_.seekg(fBinary_ ? sizeof(fHeader_) : 0, std::ios::beg);
+    fRead_ = 0;
+    fLine_ = 0;
+}
+
+///
+/// \brief SourceList::Next Reads the next source.
+/// \param source Vector set to kValues parameters of the source: x, y, z, px, py, pz and radius.
+/// \return False if there are no more sources.
+///
+bool SourceList::Next(std::vector<double>& source)
+{
+    if(!fBinary_)
+        return NextText_(source);
+    if(static_cast<uint64_t>(fRead_)>=fHeader_.numberOfSources)
+        return false;
+    source.resize(kValues);
+    fFile_.read(reinterpret_cast<char*>(source.data()), kValues*sizeof(double));
+    if(fFile_.gcount()!=kValues*sizeof(double))
+        throw(std::string("[ERROR] Truncated list of sources: ")+fPath_);
+    fRead_++;
+    return true;
+}
+
+///
+/// \brief SourceList::NextText_ Reads the next line with a source from a text list.
+/// \param source Vector set to parameters of the source.
+/// \return False at the end of the file.
+///
+bool SourceList::NextText_(std::vector<double>& source)
+{
+    std::string line;
+    while(std::getline(fFile_, line))
+    {
+        fLine_++;
+        size_t start = line.find_first_not_of(" \t\r");
+        if(start==std::string::npos || line[start]=='#')
+            continue;
+        //column names of a CSV file
+        if(fRead_==0 && std::isalpha(static_cast<unsigned char>(line[start])))
+            continue;
+        source.assign(kValues, 0.0);
+        const char* current = line.c_str()+start;
+        int values = 0;
+        while(*current!='\0' && *current!='#' && *current!='\r')
+        {
+            char* end = nullptr;
+            double value = strtod(current, &end);
+            if(end==current || values==kValues)
+                throw(std::string("[ERROR] Invalid source in line ")+std::to_string(fLine_)+" of "+fPath_+": "+line);
+            source[values++] = value;
+            current = end;
+            while(*current==' ' || *current=='\t' || *current==',')
+                current++;
+        }
+        if(values<3)
+            throw(std::string("[ERROR] Source without a position in line ")+std::to_string(fLine_)+" of "+fPath_+": "+line);
+        fRead_++;
+        return true;
+    }
+    return false;
+}
+
+///
+/// \brief SourceListWriter::SourceListWriter Creates a binary list of sources, an existing file is overwritten.
+/// \param path Path of the list.
+///
+SourceListWriter::SourceListWriter(const std::string& path) :
+    fPath_(path),
+    fFile_(path.c_str(), std::ios::binary | std::ios::trunc),
+    fSources_(0)
+{
+    SourceListHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.valuesPerSource = SourceList::kValues;
+    fFile_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if(!fFile_)
+        throw(std::string("[ERROR] Cannot create the list of sources: ")+path);
+}
+
+///
+/// \brief SourceListWriter::~SourceListWriter Destructor, closes the list if it was not closed.
+///
+SourceListWriter::~SourceListWriter()
+{
+    try
+    {
+        Close();
+    }
+    catch(std::string& ex)
+    {
+        //destructors must not throw, the error is only reported
+        fprintf(stderr, "%s\n", ex.c_str());
+    }
+}
+
+///
+/// \brief SourceListWriter::Add Appends a source.
+/// \param source Parameters of the source, missing values are written as 0.
+///
+void SourceListWriter::Add(const std::vector<double>& source)
+{
+    double values[SourceList::kValues] = {0.0};
+    for(unsigned ii=0; ii<source.size() && ii<SourceList::kValues; ii++)
+        values[ii] = source[ii];
+    fFile_.write(reinterpret_cast<const char*>(values), sizeof(values));
+    if(!fFile_)
+        throw(std::string("[ERROR] Cannot write to the list of sources: ")+fPath_);
+    fSources_++;
+}
+
+///
+/// \brief SourceListWriter::Close Stores the number of sources in the header and closes the file.
+///
+void SourceListWriter::Close()
+{
+    if(!fFile_.is_open())
+        return;
+    uint64_t sources = fSources_;
+    fFile_.seekp(offsetof(SourceListHeader, numberOfSources), std::ios::beg);
+    fFile_.write(reinterpret_cast<const char*>(&sources), sizeof(sources));
+    fFile_.close();
+    if(!fFile_)
+        throw(std::string("[ERROR] Cannot close the list of sources: ")+fPath_);
+}
+
+///
+/// \brief ConvertSourceList Converts a text list of sources to the binary format, one source at a time.
+/// \param textPath Path of the text list.
+/// \param binaryPath Path of the created binary list.
+/// \return Number of converted sources.
+///
+long long ConvertSourceList(const std::string& textPath, const std::string& binaryPath)
+{
+    SourceList input(textPath);
+    SourceListWriter output(binaryPath);
+    std::vector<double> source;
+    while(input.Next(source))
+        output.Add(source);
+    output.Close();
+    return output.GetNumberOfSources();
+}
@@ -0,0 +1,81 @@
+/// @file sourcelist.h
+/// @date 19.10.2026
+///
+/// Lists of sources read point by point, so that scans of millions of source positions do not have to fit into memory.
+/// Text lists contain one source per line: x y z [px py pz r], separated by spaces or commas (CSV), missing values are 0.
+/// Lines starting with '#' and a header line of a CSV file are skipped. Binary lists start with a SourceListHeader
+/// followed by kValues little-endian doubles per source, see SourceListWriter.
+#ifndef SOURCELIST_H
+#define SOURCELIST_H
+#include <string>
+#include <fstream>
+#include <vector>
+#include <cstdint>
+
+///
+/// \brief The SourceListHeader struct Header of a binary list of sources.
+///
+struct SourceListHeader
+{
+    char magic[8]; //"JPETSRC\0"
+    uint32_t version;
+    uint32_t valuesPerSource;
+    uint64_t numberOfSources;
+};
+
+///
+/// \brief The SourceList class Sequential reader of text and binary lists of sources.
+///
+class SourceList
+{
+    public:
+        static const int kValues = 7; //x, y, z [mm], px, py, pz [keV/c], radius [mm]
+
+        explicit SourceList(const std::string& path);
+        //reads the next source, returns false at the end of the list
+        bool Next(std::vector<double>& source);
+        void Rewind();
+        inline bool IsBinary() const {return fBinary_;}
+        //number of sources read since the beginning of the list
+        inline long long GetNumberOfRead() const {return fRead_;}
+        //number of sources declared in the header of a binary list, -1 for text lists
+        inline long long GetNumberOfSources() const {return fBinary_ ? static_cast<long long>(fHeader_.numberOfSources) : -1;}
+
+    private:
+        SourceList(const SourceList&);
+        SourceList& operator=(const SourceList&);
+        bool NextText_(std::vector<double>& source);
+
+        std::string fPath_;
+        std::ifstream fFile_;
+        bool fBinary_;
+        SourceListHeader fHeader_;
+        long long fRead_;
+        long long fLine_; //number of the last read line of a text list
+};
+
+///
+/// \brief The SourceListWriter class Writes binary lists of sources, the number of sources is stored by Close.
+///
+class SourceListWriter
+{
+    public:
+        explicit SourceListWriter(const std::string& path);
+        ~SourceListWriter();
+        void Add(const std::vector<double>& source);
+        void Close();
+        inline long long GetNumberOfSources() const {return fSources_;}
+
+    private:
+        SourceListWriter(const SourceListWriter&);
+        SourceListWriter& operator=(const SourceListWriter&);
+
+        std::string fPath_;
+        std::ofstream fFile_;
+        long long fSources_;
+};
+
+//converts a text list of sources to the binary format
+long long ConvertSourceList(const std::string& textPath, const std::string& binaryPath);
+
+#endif // SOURCELIST_H
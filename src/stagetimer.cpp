@@ -0,0 +1,134 @@
+/// @file stagetimer.cpp
+/// @date 19.10.2026
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include "TNamed.h"
+#include "stagetimer.h"
+
+///
+/// \brief StageTimes::StageTimes Creates empty times.
+///
+StageTimes::StageTimes()
+{
+    Reset();
+}
+
+///
+/// \brief StageTimes::Reset Sets all times and counters to zero.
+///
+void StageTimes::Reset()
+{
+    for(int ii=0; ii<NUMBER_OF_STAGES; ii++)
+        seconds[ii] = 0.0;
+    events = 0;
+    photons = 0;
+}
+
+///
+/// \brief StageTimes::Add Adds times and counters, e.g. of another thread or run.
+/// \param times Times to be added.
+///
+void StageTimes::Add(const StageTimes& times)
+{
+    for(int ii=0; ii<NUMBER_OF_STAGES; ii++)
+        seconds[ii] += times.seconds[ii];
+    events += times.events;
+    photons += times.photons;
+}
+
+///
+/// \brief StageTimes::GetTotal Time spent in all stages.
+/// \return Time in seconds.
+///
+double StageTimes::GetTotal() const
+{
+    double total = 0.0;
+    for(int ii=0; ii<NUMBER_OF_STAGES; ii++)
+        total += seconds[ii];
+    return total;
+}
+
+///
+/// \brief StageTimes::GetStageName Name of a stage used in reports.
+/// \param stage Stage.
+/// \return Name of the stage.
+///
+const char* StageTimes::GetStageName(SimulationStage stage)
+{
+    static const char* names[NUMBER_OF_STAGES] = {"setup", "generation", "phantom", "cuts", "compton", "output", "drawing"};
+    return stage>=0 && stage<NUMBER_OF_STAGES ? names[stage] : "unknown";
+}
+
+///
+/// \brief StageTimes::ToJSON Creates the report.
+/// \return JSON object with the total time, rates and seconds and fractions of all stages.
+///
+std::string StageTimes::ToJSON() const
+{
+    double total = GetTotal();
+    std::ostringstream json;
+    json.precision(6);
+    json<<"{\"seconds\": "<<total<<", \"events\": "<<events<<", \"photons\": "<<photons;
+    json<<", \"eventsPerSecond\": "<<(total>0.0 ? events/total : 0.0)<<", \"photonsPerSecond\": "<<(total>0.0 ? photons/total : 0.0);
+    json<<", \"stages\": {";
+    for(int ii=0; ii<NUMBER_OF_STAGES; ii++)
+    {
+        json<<(ii>0 ? ", " : "")<<"\""<<GetStageName(static_cast<SimulationStage>(ii))<<"\": {\"seconds\": "<<seconds[ii]\
+            <<", \"fraction\": "<<(total>0.0 ? seconds[ii]/total : 0.0)<<"}";
+    }
+    json<<"}}";
+    return json.str();
+}
+
+///
+/// \brief StageTimes::Print Prints time per stage, events/s and photons/s.
+///
+void StageTimes::Print() const
+{
+    double total = GetTotal();
+    char line[128];
+    std::cout<<"[INFO] Time per stage:"<<std::endl;
+    for(int ii=0; ii<NUMBER_OF_STAGES; ii++)
+    {
+        snprintf(line, sizeof(line), "         %-12s %10.3f s %6.1f%%", GetStageName(static_cast<SimulationStage>(ii)), seconds[ii],\
+                 total>0.0 ? 100.0*seconds[ii]/total : 0.0);
+        std::cout<<line<<std::endl;
+    }
+    snprintf(line, sizeof(line), "[INFO] %.3f s in total, %.4g events/s, %.4g photons/s", total, total>0.0 ? events/total : 0.0,\
+             total>0.0 ? photons/total : 0.0);
+    std::cout<<line<<std::endl;
+}
+
+///
+/// \brief StageTimes::Save Writes the report to a file.
+/// \param path Path of the JSON file, an existing file is overwritten.
+/// \return False if the file cannot be written.
+///
+bool StageTimes::Save(const std::string& path) const
+{
+    std::ofstream file(path.c_str(), std::ios::trunc);
+    file<<ToJSON()<<std::endl;
+    return static_cast<bool>(file);
+}
+
+///
+/// \brief StageTimes::Write Writes the report to the current ROOT directory.
+/// \param key Name of the TNamed, its title is the JSON report.
+///
+void StageTimes::Write(const std::string& key) const
+{
+    TNamed report(key.c_str(), ToJSON().c_str());
+    report.Write();
+}
+
+///
+/// \brief ThreadStageTimes Times accumulated by the calling thread, so that stages can be timed without locks.
+/// \return Reference to the times of the thread.
+///
+StageTimes& ThreadStageTimes()
+{
+    static thread_local StageTimes times;
+    return times;
+}
@@ -0,0 +1,73 @@
+/// @file stagetimer.h
+/// @date 19.10.2026
+///
+/// Timing of stages of the simulation. Every thread accumulates its own StageTimes (see ThreadStageTimes), so timers
+/// never synchronize, and a StageClock charges the time elapsed since its previous lap to the given stage, which costs
+/// one read of std::chrono::steady_clock per stage.
+#ifndef STAGETIMER_H
+#define STAGETIMER_H
+#include <string>
+#include <chrono>
+
+///
+/// \brief The SimulationStage enum Stages of a run, in the order of the event loop.
+///
+enum SimulationStage
+{
+    SETUP_STAGE = 0, //creating generators, cuts, phantoms and histograms
+    GENERATION_STAGE = 1, //generating decays and initial histograms
+    PHANTOM_STAGE = 2,
+    CUTS_STAGE = 3, //cuts of the detector and of compared barrels, sinograms
+    COMPTON_STAGE = 4,
+    OUTPUT_STAGE = 5, //list-mode records, filling trees and RNTuples
+    DRAWING_STAGE = 6, //drawing and writing histograms
+    NUMBER_OF_STAGES = 7
+};
+
+///
+/// \brief The StageTimes struct Time spent in every stage and the number of simulated events and photons.
+///
+struct StageTimes
+{
+    double seconds[NUMBER_OF_STAGES];
+    long long events;
+    long long photons;
+
+    StageTimes();
+    void Reset();
+    void Add(const StageTimes& times);
+    double GetTotal() const;
+    //report with seconds and fractions of stages, events/s and photons/s computed from the total time
+    std::string ToJSON() const;
+    void Print() const;
+    //writes the report to a JSON file, returns false on failure
+    bool Save(const std::string& path) const;
+    //writes the report as a TNamed with the JSON as its title to the current directory
+    void Write(const std::string& key="timing") const;
+    static const char* GetStageName(SimulationStage stage);
+};
+
+//times accumulated by the calling thread
+StageTimes& ThreadStageTimes();
+
+///
+/// \brief The StageClock class Charges elapsed time to stages of a StageTimes.
+///
+class StageClock
+{
+    public:
+        explicit StageClock(StageTimes& times) : fTimes_(times), fLast_(std::chrono::steady_clock::now()) {}
+        //adds the time since the previous lap (or construction) to the stage
+        inline void Lap(SimulationStage stage)
+        {
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            fTimes_.seconds[stage] += std::chrono::duration<double>(now-fLast_).count();
+            fLast_ = now;
+        }
+
+    private:
+        StageTimes& fTimes_;
+        std::chrono::steady_clock::time_point fLast_;
+};
+
+#endif // STAGETIMER_H
@@ -0,0 +1,306 @@
+/// @file voxelphantom.cpp
+/// @date 19.10.2026
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "TRandom.h"
+#include "voxelphantom.h"
+#include "phantom.h"
+
+//volumes are written in the host byte order, which is little-endian on all supported platforms
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Voxel volumes are little-endian, big-endian hosts are not supported.");
+static_assert(sizeof(VoxelVolumeHeader) == 80, "Header of voxel volumes must have a fixed size.");
+
+namespace
+{
+    const char kMagic[8] = {'J', 'P', 'E', 'T', 'V', 'O', 'X', '\0'};
+}
+
+///
+/// \brief VoxelPhantom::VoxelPhantom Maps the label volume into memory and loads the table of materials. Every label present
+/// in the volume must have a material.
+/// \param volume Path of the label volume.
+/// \param materials Path of the table assigning materials to labels.
+/// \param table Computed attenuation coefficients of materials.
+///
+VoxelPhantom::VoxelPhantom(const std::string& volume, const std::string& materials, const MaterialTable& table) :
+    fData_(MAP_FAILED),
+    fSize_(0),
+    fHeader_(nullptr),
+    fLabels_(nullptr),
+    fTable_(table)
+{
+    LoadMaterials_(materials);
+    int file = open(volume.c_str(), O_RDONLY);
+    if(file < 0)
+        throw(std::string("[ERROR] Cannot open the voxel volume: ")+volume);
+    struct stat info;
+    if(fstat(file, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(VoxelVolumeHeader)))
+    {
+        close(file);
+        throw(std::string("[ERROR] File is too short to be a voxel volume: ")+volume);
+    }
+    fSize_ = info.st_size;
+    fData_ = mmap(nullptr, fSize_, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); //the mapping stays valid
+    if(fData_ == MAP_FAILED)
+        throw(std::string("[ERROR] Cannot map the voxel volume: ")+volume);
+    fHeader_ = static_cast<const VoxelVolumeHeader*>(fData_);
+    std::string error;
+    const uint64_t voxels = static_cast<uint64_t>(fHeader_->size[0])*fHeader_->size[1]*fHeader_->size[2];
+    if(std::memcmp(fHeader_->magic, kMagic, sizeof(kMagic)) != 0 || fHeader_->version != VoxelVolumeHeader::kVersion)
+        error = "Unsupported format of the voxel volume: ";
+    else if(voxels == 0 || fHeader_->voxel[0] <= 0 || fHeader_->voxel[1] <= 0 || fHeader_->voxel[2] <= 0)
+        error = "Voxel volume without voxels: ";
+    else if(fHeader_->headerSize < sizeof(VoxelVolumeHeader) || fHeader_->headerSize+voxels > fSize_)
+        error = "Voxel volume is truncated: ";
+    if(error.empty())
+    {
+        fLabels_ = static_cast<const uint8_t*>(fData_)+fHeader_->headerSize;
+        //the majorant is taken over labels which are present, one pass over the volume
+        bool present[kLabels] = {false};
+        for(uint64_t ii=0; ii<voxels; ii++)
+            present[fLabels_[ii]] = true;
+        for(int ii=0; ii<kLabels && error.empty(); ii++)
+        {
+            if(!present[ii])
+                continue;
+            if(fMaterial_[ii] < 0)
+                error = "Label "+std::to_string(ii)+" of the voxel volume has no material: ";
+            fPresent_.push_back(ii);
+        }
+    }
+    if(!error.empty())
+    {
+        munmap(fData_, fSize_);
+        throw(std::string("[ERROR] ")+error+volume);
+    }
+    madvise(fData_, fSize_, MADV_RANDOM);
+}
+
+///
+/// \brief VoxelPhantom::~VoxelPhantom Destructor, unmaps the volume.
+///
+VoxelPhantom::~VoxelPhantom()
+{
+    if(fData_ != MAP_FAILED)
+        munmap(fData_, fSize_);
+}
+
+///
+/// \brief VoxelPhantom::LoadMaterials_ Reads the table assigning materials to labels.
+/// \param materials Path of the table.
+///
+void VoxelPhantom::LoadMaterials_(const std::string& materials)
+{
+    if(!fTable_.IsComputed())
+        throw(std::string("[ERROR] Attenuation coefficients of materials are not computed."));
+    std::fill(fMaterial_, fMaterial_+kLabels, -1);
+    std::fill(fScale_, fScale_+kLabels, 0.0);
+    std::ifstream file(materials.c_str());
+    if(!file)
+        throw(std::string("[ERROR] Cannot open the table of materials: ")+materials);
+    std::string line;
+    while(std::getline(file, line))
+    {
+        size_t start = line.find_first_not_of(" \t\r");
+        if(start == std::string::npos || line[start] == '#')
+            continue;
+        std::istringstream fields(line.substr(0, line.find('#')));
+        int label = -1;
+        std::string name;
+        if(!(fields>>label>>name) || label < 0 || label >= kLabels)
+            throw(std::string("[ERROR] Invalid material in ")+materials+": "+line);
+        int material = fTable_.GetIndex(name);
+        if(material < 0)
+            throw(std::string("[ERROR] Material ")+name+" is not defined, in "+materials+": "+line);
+        double density = fTable_.GetMaterial(material).density;
+        if(!(fields>>density))
+            density = fTable_.GetMaterial(material).density;
+        if(density < 0)
+            throw(std::string("[ERROR] Negative density in ")+materials+": "+line);
+        fMaterial_[label] = material;
+        fScale_[label] = density/fTable_.GetMaterial(material).density;
+    }
+}
+
+///
+/// \brief VoxelPhantom::GetLabel Finds the voxel containing the point.
+/// \param point Point [mm].
+/// \return Label of the voxel, -1 if the point lies outside of the volume.
+///
+int VoxelPhantom::GetLabel(const double* point) const
+{
+    uint64_t index = 0;
+    uint64_t stride = 1;
+    for(int ii=0; ii<3; ii++)
+    {
+        double position = (point[ii]-fHeader_->origin[ii])/fHeader_->voxel[ii];
+        if(!(position >= 0.0 && position < fHeader_->size[ii]))
+            return -1;
+        index += stride*static_cast<uint64_t>(position);
+        stride *= fHeader_->size[ii];
+    }
+    return fLabels_[index];
+}
+
+///
+/// \brief VoxelPhantom::GetAttenuationCoefficient Total attenuation coefficient of the material of voxels with the given label.
+/// \param label Label of voxels.
+/// \param E Energy of the photon in MeV.
+/// \return Attenuation coefficient in 1/mm, 0 for labels without a material.
+///
+double VoxelPhantom::GetAttenuationCoefficient(int label, double E) const
+{
+    if(label < 0 || label >= kLabels || fMaterial_[label] < 0)
+        return 0.0;
+    return fScale_[label]*fTable_.GetAttenuation(fMaterial_[label], E);
+}
+
+///
+/// \brief VoxelPhantom::GetMajorant Majorant attenuation coefficient used to sample flights of photons.
+/// \param E Energy of the photon in MeV.
+/// \return Attenuation coefficient in 1/mm.
+///
+double VoxelPhantom::GetMajorant(double E) const
+{
+    double majorant = 0.0;
+    for(unsigned ii=0; ii<fPresent_.size(); ii++)
+        majorant = std::max(majorant, GetAttenuationCoefficient(fPresent_[ii], E));
+    return majorant;
+}
+
+///
+/// \brief VoxelPhantom::IntersectVolume_ Calculates the chord of a ray through the bounding box of the volume.
+/// \param point Starting point of the ray [mm].
+/// \param dir Normalized direction of the ray.
+/// \param tIn Distance at which the ray enters the volume, negative if the point is inside.
+/// \param tOut Distance at which the ray leaves the volume.
+/// \return True if the volume lies (at least partially) in front of the point.
+///
+bool VoxelPhantom::IntersectVolume_(const double* point, const double* dir, double& tIn, double& tOut) const
+{
+    tIn = -std::numeric_limits<double>::infinity();
+    tOut = std::numeric_limits<double>::infinity();
+    for(int ii=0; ii<3; ii++)
+    {
+        double low = fHeader_->origin[ii];
+        double high = low+fHeader_->size[ii]*fHeader_->voxel[ii];
+        if(dir[ii] == 0.0)
+        {
+            if(point[ii] < low || point[ii] > high)
+                return false;
+            continue;
+        }
+        double t1 = (low-point[ii])/dir[ii];
+        double t2 = (high-point[ii])/dir[ii];
+        if(t1 > t2)
+            std::swap(t1, t2);
+        tIn = std::max(tIn, t1);
+        tOut = std::min(tOut, t2);
+    }
+    return tOut > tIn && tOut > 0.0;
+}
+
+///
+/// \brief VoxelPhantom::Scatter Tracks photons through the volume with Woodcock tracking. Flights are sampled with the majorant
+/// coefficient; at the end of every flight the voxel is looked up and the collision is accepted with the probability
+/// mu/majorant, otherwise it is virtual and the photon flies on unchanged. Real collisions are handled by Phantom::Interact.
+/// Scattered photons start from the last interaction point, delayed by the time of flight along the path travelled in the volume.
+/// \param event Pointer to Event class object, for which in-phantom scattering is done.
+///
+void VoxelPhantom::Scatter(Event* event) const
+{
+    for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
+    {
+        TLorentzVector* momentum = event->GetFourMomentumOf(ii);
+        double E = momentum->E();
+        double p = momentum->P();
+        if(E <= 0.0 || p <= 0.0)
+            continue;
+        double dir[3] = {momentum->X()/p, momentum->Y()/p, momentum->Z()/p};
+        const TLorentzVector* emission = event->GetEmissionPointOf(ii);
+        double point[3] = {emission->X(), emission->Y(), emission->Z()};
+        int interactions = 0;
+        bool absorbed = false;
+        double travelled = 0.0; //path from the emission point to the last real collision [mm]
+        double tIn = 0.0, tOut = 0.0;
+        double mu[MaterialTable::kColumns];
+        while(interactions < kMaxInteractions && !absorbed && IntersectVolume_(point, dir, tIn, tOut))
+        {
+            const double majorant = GetMajorant(E);
+            if(majorant <= 0.0)
+                break;
+            double t = std::max(tIn, 0.0);
+            bool collision = false;
+            while(!collision)
+            {
+                t += gRandom->Exp(1.0/majorant);
+                if(t >= tOut)
+                    break; //photon leaves the volume
+                double position[3] = {point[0]+t*dir[0], point[1]+t*dir[1], point[2]+t*dir[2]};
+                int label = GetLabel(position);
+                if(label < 0)
+                    continue;
+                fTable_.GetAttenuations(fMaterial_[label], E, mu);
+                for(int jj=0; jj<MaterialTable::kColumns; jj++)
+                    mu[jj] *= fScale_[label];
+                if(gRandom->Rndm()*majorant < mu[TOTAL_ATTENUATION])
+                {
+                    collision = true;
+                    std::copy(position, position+3, point);
+                    travelled += t;
+                }
+            }
+            if(!collision)
+                break;
+            absorbed = !Phantom::Interact(mu, E, dir);
+            interactions++;
+        }
+        if(absorbed)
+            Phantom::Absorb(event, ii, point, emission->T()+Phantom::FlightTime(travelled));
+        else if(interactions > 0)
+        {
+            TLorentzVector newMomentum(dir[0]*E, dir[1]*E, dir[2]*E, E);
+            TLorentzVector newPoint(point[0], point[1], point[2], emission->T()+Phantom::FlightTime(travelled));
+            event->SetFourMomentumOf(ii, newMomentum);
+            event->SetEmissionPointOf(ii, newPoint);
+            event->SetPrimaryPhoton(ii, false);
+        }
+    }
+}
+
+///
+/// \brief WriteVoxelVolume Creates a label volume, an existing file is overwritten.
+/// \param path Path of the volume.
+/// \param size Number of voxels along X, Y and Z.
+/// \param voxel Size of a voxel along X, Y and Z [mm].
+/// \param origin Corner of the first voxel [mm].
+/// \param labels Labels of voxels, X index running fastest.
+///
+void WriteVoxelVolume(const std::string& path, const uint32_t* size, const double* voxel, const double* origin, \
+                      const std::vector<uint8_t>& labels)
+{
+    if(labels.size() != static_cast<uint64_t>(size[0])*size[1]*size[2])
+        throw(std::string("[ERROR] Number of labels does not match the size of the voxel volume: ")+path);
+    VoxelVolumeHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = VoxelVolumeHeader::kVersion;
+    header.headerSize = sizeof(header);
+    std::copy(size, size+3, header.size);
+    std::copy(voxel, voxel+3, header.voxel);
+    std::copy(origin, origin+3, header.origin);
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(labels.data()), labels.size());
+    if(!file)
+        throw(std::string("[ERROR] Cannot write the voxel volume: ")+path);
+}
@@ -0,0 +1,79 @@
+/// @file voxelphantom.h
+/// @date 19.10.2026
+///
+/// Voxelized phantoms: a label volume mapped into memory and a table of materials assigned to labels.
+/// The volume starts with a VoxelVolumeHeader followed by nx*ny*nz one-byte labels, X index running fastest,
+/// see WriteVoxelVolume. The table of materials assigns materials to labels, one per line: label material [density],
+/// where material is defined in a MaterialTable (see materials.h) and the optional density [g/cm^3] overrides
+/// the density of its definition; lines starting with '#' are skipped.
+#ifndef VOXELPHANTOM_H
+#define VOXELPHANTOM_H
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "event.h"
+#include "materials.h"
+
+///
+/// \brief The VoxelVolumeHeader struct Header of a label volume.
+///
+struct VoxelVolumeHeader
+{
+    static const uint32_t kVersion = 1;
+
+    char magic[8]; //"JPETVOX\0"
+    uint32_t version;
+    uint32_t headerSize; //offset of the first label
+    uint32_t size[3]; //number of voxels along X, Y and Z
+    uint32_t reserved;
+    double voxel[3]; //size of a voxel along X, Y and Z [mm]
+    double origin[3]; //corner of the first voxel [mm]
+};
+
+///
+/// \brief The VoxelPhantom class Photon transport through a voxelized phantom with Woodcock (delta) tracking: flights are
+/// sampled with the majorant attenuation coefficient of the whole volume and a collision is real with the probability
+/// equal to the ratio of the local and the majorant coefficient, so boundaries of voxels are never crossed explicitly.
+///
+class VoxelPhantom
+{
+    public:
+        static const int kLabels = 256;
+        static const int kMaxInteractions = 20; //photons are not tracked after so many interactions
+
+        //the table of materials has to stay valid as long as the phantom is used
+        VoxelPhantom(const std::string& volume, const std::string& materials, const MaterialTable& table);
+        ~VoxelPhantom();
+        void Scatter(Event* event) const;
+        //label of the voxel containing the point, -1 outside of the volume
+        int GetLabel(const double* point) const;
+        //attenuation coefficient in 1/mm of the material with the given label for photons of energy E in MeV
+        double GetAttenuationCoefficient(int label, double E) const;
+        //majorant attenuation coefficient in 1/mm, maximum over materials present in the volume
+        double GetMajorant(double E) const;
+        inline const VoxelVolumeHeader& GetHeader() const {return *fHeader_;}
+        //index of the material in the MaterialTable, -1 for labels without a material
+        inline int GetMaterial(int label) const {return fMaterial_[label];}
+
+    private:
+        VoxelPhantom(const VoxelPhantom&);
+        VoxelPhantom& operator=(const VoxelPhantom&);
+        void LoadMaterials_(const std::string& materials);
+        bool IntersectVolume_(const double* point, const double* dir, double& tIn, double& tOut) const;
+
+        void* fData_;
+        size_t fSize_;
+        const VoxelVolumeHeader* fHeader_;
+        const uint8_t* fLabels_;
+        const MaterialTable& fTable_;
+        int fMaterial_[kLabels]; //indices of materials, -1 for labels without a material
+        double fScale_[kLabels]; //ratios of densities of voxels and definitions of materials
+        std::vector<int> fPresent_; //labels present in the volume
+};
+
+//creates a label volume, labels are ordered with X index running fastest
+void WriteVoxelVolume(const std::string& path, const uint32_t* size, const double* voxel, const double* origin, \
+                      const std::vector<uint8_t>& labels);
+
+#endif // VOXELPHANTOM_H
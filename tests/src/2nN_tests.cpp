@@ -130,6 +130,7 @@ TEST_F(TwoAndNTestFixture, ParticleGeneration)
             FAIL();
         }
     }
+    decay->FlushHistograms();
     double max = hist->GetBinContent(hist->GetMaximumBin());
     double all = hist->Integral();
     ASSERT_NEAR(20.0/52.0, max/all, 10e-3);
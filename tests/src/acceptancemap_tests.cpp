@@ -0,0 +1,124 @@
+/// @file acceptancemap_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check the geometric acceptance maps and their cache.
+#include "gtest/gtest.h"
+#include "../../src/acceptancemap.h"
+#include "../../src/initialcuts.h"
+#include "TMath.h"
+#include "TGenPhaseSpace.h"
+#include <sys/stat.h>
+#define BOOST_NO_CXX11_SCOPED_ENUMS //CXX11 support hacks
+#include "boost/filesystem.hpp"
+#undef BOOST_NO_CXX11_SCOPED_ENUMS
+
+///
+/// \brief TEST (AcceptanceMapTest, CenterOfTheBarrel) Compares acceptance in the center of the barrel with the analytic value.
+///
+TEST (AcceptanceMapTest, CenterOfTheBarrel)
+{
+    double R = 437.3;
+    double L = 500;
+    //probability for a single gamma to hit the detector when source is in the center
+    double pForGammaToPass = L/2/TMath::Sqrt(R*R+0.25*L*L);
+    AcceptanceGrid grid = AcceptanceMap::DefaultGrid(R, L, 3, 3, 3);
+    AcceptanceMap map1(ONE, R, L, grid, 100000);
+    map1.Build(2);
+    EXPECT_NEAR(map1.Interpolate(0.0, 0.0, 0.0), pForGammaToPass, 0.01);
+    //back-to-back photons from the center hit or miss together
+    AcceptanceMap map2(TWO, R, L, grid, 100000);
+    map2.Build(2);
+    EXPECT_NEAR(map2.Interpolate(0.0, 0.0, 0.0), pForGammaToPass, 0.01);
+    //prompt photon is not required to reconstruct an event, as in InitialCuts
+    AcceptanceMap map21(TWOandONE, R, L, grid, 100000);
+    map21.Build(2);
+    EXPECT_NEAR(map21.Interpolate(0.0, 0.0, 0.0), pForGammaToPass, 0.01);
+    //sources outside the barrel have no acceptance, but grid points there hold the acceptance at the wall
+    EXPECT_EQ(map2.Interpolate(R, R, 0.0), 0.0);
+    EXPECT_GT(map2.GetValueAt(0, 0, 1), 0.0);
+}
+
+///
+/// \brief TEST (AcceptanceMapTest, NearTheWall) Interpolation close to the wall of the barrel, between grid points inside
+/// and outside it, agrees with acceptance computed directly in the same point.
+///
+TEST (AcceptanceMapTest, NearTheWall)
+{
+    double R = 437.3;
+    double L = 500;
+    AcceptanceMap map(TWO, R, L, AcceptanceMap::DefaultGrid(R, L, 5, 5, 5), 100000);
+    map.Build(2);
+    const double points[2][3] = {{300.0, 0.0, 0.0}, {250.0, 250.0, 100.0}};
+    for(int ii=0; ii<2; ii++)
+    {
+        const double* p = points[ii];
+        AcceptanceGrid single = {1, 1, 1, p[0], p[0], p[1], p[1], p[2], p[2]};
+        AcceptanceMap direct(TWO, R, L, single, 100000);
+        direct.Build(1);
+        EXPECT_NEAR(map.Interpolate(p[0], p[1], p[2]), direct.GetValueAt(0, 0, 0), 0.04);
+    }
+}
+
+///
+/// \brief TEST (AcceptanceMapTest, CacheRoundTrip) Checks if a saved map is found only for the same key and gives the same values.
+///
+TEST (AcceptanceMapTest, CacheRoundTrip)
+{
+    std::string cacheDir = "acceptance_test_cache/";
+    mkdir(cacheDir.c_str(), ACCESSPERMS);
+    AcceptanceGrid grid = AcceptanceMap::DefaultGrid(437.3, 500, 5, 5, 3);
+    AcceptanceMap map(THREE, 437.3, 500, grid, 2000, 5);
+    map.LoadOrBuild(cacheDir, 0, true);
+    AcceptanceMap loaded(THREE, 437.3, 500, grid, 2000, 5);
+    ASSERT_TRUE(loaded.Load(cacheDir));
+    EXPECT_DOUBLE_EQ(map.Interpolate(10.0, -20.0, 30.0), loaded.Interpolate(10.0, -20.0, 30.0));
+    AcceptanceMap otherL(THREE, 437.3, 600, grid, 2000, 5);
+    EXPECT_FALSE(otherL.Load(cacheDir));
+    //the result must not depend on the number of threads
+    AcceptanceMap singleThread(THREE, 437.3, 500, grid, 2000, 5);
+    singleThread.Build(1);
+    EXPECT_DOUBLE_EQ(map.GetValueAt(2, 2, 1), singleThread.GetValueAt(2, 2, 1));
+    boost::filesystem::remove_all(cacheDir);
+}
+
+///
+/// \brief TEST (AcceptanceMapTest, ThreeGammaWeights) Compares the 3-gamma map with the weighted acceptance of events
+/// generated by TGenPhaseSpace and passed through InitialCuts, as in the event loop.
+///
+TEST (AcceptanceMapTest, ThreeGammaWeights)
+{
+    double R = 437.3;
+    double L = 500;
+    AcceptanceGrid grid = AcceptanceMap::DefaultGrid(R, L, 3, 3, 3);
+    AcceptanceMap map(THREE, R, L, grid, 200000);
+    map.Build(2);
+
+    TLorentzVector Ps(0.000000001, 0.000000001, 0.000000001, 1.022/1000);
+    double masses[3] = {0.0, 0.0, 0.0};
+    TGenPhaseSpace generator;
+    generator.SetDecay(Ps, 3, masses);
+    InitialCuts cuts(THREE, R, L, 1.0);
+    cuts.EnableSilentMode();
+    std::vector<TLorentzVector*> sourcePar;
+    std::vector<TLorentzVector*> fourMomenta(3, nullptr);
+    for(int ii=0; ii<3; ii++)
+        sourcePar.push_back(new TLorentzVector(0.0, 0.0, 0.0, 0.0));
+    double accepted = 0.0;
+    double total = 0.0;
+    for(int n=0; n<200000; n++)
+    {
+        double weight = generator.Generate();
+        for(int ii=0; ii<3; ii++)
+            fourMomenta[ii] = generator.GetDecay(ii);
+        Event event(&sourcePar, &fourMomenta, weight, THREE);
+        cuts.AddCuts(&event);
+        total += weight;
+        if(event.GetPassFlag())
+            accepted += weight;
+    }
+    EXPECT_NEAR(map.Interpolate(0.0, 0.0, 0.0), accepted/total, 0.01);
+    for(int ii=0; ii<3; ii++)
+        delete sourcePar[ii];
+}
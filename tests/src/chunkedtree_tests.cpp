@@ -0,0 +1,61 @@
+/// @file chunkedtree_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check splitting of the tree into chunks and reading them back as a chain.
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "../../src/chunkedtree.h"
+
+///
+/// \brief TEST (ChunkedTreeTest, EventLimit) Chunks hold at most chunkEvents entries and are chained in order.
+///
+TEST (ChunkedTreeTest, EventLimit)
+{
+    const std::string manifest = "chunkedtree_test_chunks.txt";
+    ParamManager pManag;
+    pManag.SetChunkEvents(10);
+    CreateChunkManifest(manifest);
+    Int_t value = 0;
+    {
+        ChunkedTree tree("", "chunkedtree_test", manifest, pManag);
+        EXPECT_TRUE(tree.IsChunked());
+        tree.SetBranchSetup([&](TTree* newTree){newTree->Branch("value", &value, "value/I");});
+        for(value=0; value<25; value++)
+            tree.Fill();
+        tree.Close();
+        EXPECT_EQ(tree.GetNumberOfChunks(), 3);
+        EXPECT_EQ(tree.GetEntries(), 25);
+    }
+    std::ifstream file(manifest.c_str());
+    std::string line;
+    std::vector<Long64_t> entries;
+    while(std::getline(file, line))
+    {
+        std::string run, chunk;
+        Long64_t n = 0;
+        if(line[0]!='#' && std::istringstream(line)>>run>>chunk>>n)
+            entries.push_back(n);
+    }
+    EXPECT_EQ(entries, std::vector<Long64_t>({10, 10, 5}));
+
+    std::unique_ptr<TChain> chain(MakeChunkChain(manifest, "chunkedtree_test"));
+    ASSERT_EQ(chain->GetEntries(), 25);
+    Int_t read = -1;
+    chain->SetBranchAddress("value", &read);
+    for(Long64_t ii=0; ii<chain->GetEntries(); ii++)
+    {
+        chain->GetEntry(ii);
+        EXPECT_EQ(read, ii);
+    }
+    std::unique_ptr<TChain> other(MakeChunkChain(manifest, "other_run"));
+    EXPECT_EQ(other->GetEntries(), 0);
+    for(int ii=0; ii<3; ii++)
+        std::remove(("chunkedtree_test_000"+std::to_string(ii)+".root").c_str());
+    std::remove(manifest.c_str());
+    EXPECT_THROW(MakeChunkChain(manifest), std::string);
+}
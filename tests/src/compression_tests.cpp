@@ -0,0 +1,24 @@
+/// @file compression_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check conversion of compression parameters to ROOT settings.
+#include "gtest/gtest.h"
+#include "../../src/compression.h"
+
+///
+/// \brief TEST (CompressionTest, Settings) Checks names of algorithms and values passed to ROOT.
+///
+TEST (CompressionTest, Settings)
+{
+    EXPECT_EQ(ParseCompressionAlgorithm("zstd"), ZSTD);
+    EXPECT_EQ(ParseCompressionAlgorithm("lz4"), LZ4);
+    EXPECT_EQ(CompressionAlgorithmName(LZMA), "lzma");
+    EXPECT_EQ(CompressionAlgorithmName(ParseCompressionAlgorithm("zlib")), "zlib");
+    EXPECT_THROW(ParseCompressionAlgorithm("gzip"), std::string);
+    EXPECT_EQ(CompressionSettings(ZSTD, 5), 505);
+    EXPECT_EQ(CompressionSettings(LZ4, 12), 409); //level is clamped
+    EXPECT_EQ(CompressionSettings(ZLIB, 0), 100); //no compression
+    EXPECT_EQ(CompressionSettings(DEFAULT_COMPRESSION, 5), -1);
+}
@@ -0,0 +1,87 @@
+/// @file comptonsampler_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check sampling of Compton scattering without histograms.
+/// Some of the tests can fail due to statistical reasons, but not more often than 1 per 100 test runs.
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "gtest/gtest.h"
+#include "../../src/comptonsampler.h"
+#include "../../src/event.h"
+
+///
+/// \brief TEST (ComptonSamplerTest, Angle) Sampled angles follow the Klein-Nishina distribution.
+///
+TEST (ComptonSamplerTest, Angle)
+{
+    const int nBins = 10;
+    const int nSamples = 200000;
+    const double E = 0.511;
+    std::vector<double> sampled(nBins, 0.0), expected(nBins, 0.0);
+    for(int ii=0; ii<nSamples; ii++)
+    {
+        double cosTheta = ComptonSampler::SampleCosTheta(E);
+        ASSERT_GE(cosTheta, -1.0);
+        ASSERT_LE(cosTheta, 1.0);
+        sampled[std::min(nBins-1, static_cast<int>((cosTheta+1.0)*nBins/2.0))] += 1.0/nSamples;
+    }
+    //Klein-Nishina formula integrated numerically over cos(theta)
+    double sum = 0.0;
+    for(int ii=0; ii<nBins*100; ii++)
+    {
+        double cosTheta = -1.0+(ii+0.5)/(nBins*50.0);
+        double P = 1.0/(1.0+E/0.5109989461*(1.0-cosTheta));
+        double value = P*P*(P+1.0/P-(1.0-cosTheta*cosTheta));
+        expected[ii/100] += value;
+        sum += value;
+    }
+    for(int ii=0; ii<nBins; ii++)
+        EXPECT_NEAR(sampled[ii], expected[ii]/sum, 0.005);
+}
+
+///
+/// \brief TEST (ComptonSamplerTest, Kinematics) Energies of the scattered photon and of the electron follow the Compton formula
+/// and rotated directions keep the scattering angle.
+///
+TEST (ComptonSamplerTest, Kinematics)
+{
+    const double E = 0.511;
+    EXPECT_DOUBLE_EQ(ComptonSampler::ScatteredEnergy(E, 1.0), E);
+    EXPECT_NEAR(ComptonSampler::ScatteredEnergy(E, -1.0), E/3.0, 1e-4); //backscattering of 511 keV photons
+    EXPECT_NEAR(ComptonSampler::ElectronEnergy(E, -1.0), 2.0*E/3.0, 1e-4); //Compton edge
+    const double dirs[2][3] = {{0.0, 0.0, 1.0}, {0.6, 0.0, 0.8}};
+    for(int ii=0; ii<2; ii++)
+    {
+        double dir[3] = {dirs[ii][0], dirs[ii][1], dirs[ii][2]};
+        ComptonSampler::RotateDirection(dir, 0.3, 1.0);
+        EXPECT_NEAR(dir[0]*dirs[ii][0]+dir[1]*dirs[ii][1]+dir[2]*dirs[ii][2], 0.3, 1e-12);
+        EXPECT_NEAR(dir[0]*dir[0]+dir[1]*dir[1]+dir[2]*dir[2], 1.0, 1e-12);
+    }
+}
+
+///
+/// \brief TEST (ComptonSamplerTest, Scatter) Deposited energies are set below the Compton edge and only photons passing cuts are scattered.
+///
+TEST (ComptonSamplerTest, Scatter)
+{
+    TLorentzVector source(0.0, 0.0, 0.0, 0.0);
+    double E = 0.511/1000; //Event expects GeV
+    TLorentzVector first(E, 0.0, 0.0, E);
+    TLorentzVector second(-E, 0.0, 0.0, E);
+    std::vector<TLorentzVector*> sourcePar = {&source, &source};
+    std::vector<TLorentzVector*> fourMomenta = {&first, &second};
+    Event event(&sourcePar, &fourMomenta, 1.0, TWO);
+    for(int ii=0; ii<1000; ii++)
+    {
+        ASSERT_TRUE(ComptonSampler::Scatter(&event, 0, 0.0, 0.0)); //no smearing
+        EXPECT_GE(event.GetEdepOf(0), 0.0);
+        EXPECT_LE(event.GetEdepOf(0), 2.0*0.511/3.0+1e-6);
+        EXPECT_DOUBLE_EQ(event.GetEdepSmearOf(0), event.GetEdepOf(0));
+    }
+    EXPECT_NEAR(event.GetFourMomentumOf(0)->E(), 0.511, 1e-9); //photon is not changed
+    event.SetCutPassing(1, false);
+    EXPECT_FALSE(ComptonSampler::Scatter(&event, 1, 0.0, 2.0));
+}
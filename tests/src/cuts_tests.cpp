@@ -11,6 +11,7 @@
 #include "gtest/gtest.h"
 #include "../../src/initialcuts.h"
 #include "../../src/event.h"
+#include "../../src/hitkernel.h"
 #include "TGenPhaseSpace.h"
 #include "TRandom3.h"
 #include <sys/stat.h>
@@ -407,3 +408,168 @@ TEST_F(cutsTestFixture, DiskAccessAndInitialCutsNoOfHistograms)
     boost::filesystem::remove_all("test_tmp");
     ASSERT_FALSE(boost::filesystem::exists("test_tmp")); //check if the folder was removed*/
 }
+
+///
+/// \brief TEST_F (cutsTestFixture, EfficiencyReweighting) Checks that with reweighting all geometrically accepted events pass
+/// and that expected numbers of accepted events agree with the random detection cut.
+///
+TEST_F (cutsTestFixture, EfficiencyReweighting)
+{
+    int simSteps = 30007;
+    double R = pManag->GetR();
+    double L = pManag->GetL();
+    std::vector<double> effs = {1.0, 0.5, 0.0};
+    std::vector<TLorentzVector*> sourcePar;
+    std::vector<TLorentzVector*> fourMomenta;
+    for(int ii=0; ii<3; ii++)
+    {
+        sourcePar.push_back(new TLorentzVector(0.0, 0.0, 0.0, 0.0));
+        fourMomenta.push_back(nullptr);
+    }
+    InitialCuts reweighted(THREE, R, L, 0.5);
+    reweighted.EnableSilentMode();
+    reweighted.SetReweightEfficiencies(effs);
+    InitialCuts random(THREE, R, L, 0.5);
+    random.EnableSilentMode();
+    event->SetDecay(Ps, 3, masses3);
+    for (int n=0; n<simSteps; n++)
+    {
+       double weight = event->Generate();
+       for(int ii=0; ii<3; ii++)
+           fourMomenta[ii]=event->GetDecay(ii);
+       Event* first = new Event(&sourcePar, &fourMomenta, weight, THREE);
+       Event* second = new Event(&sourcePar, &fourMomenta, weight, THREE);
+       reweighted.AddCuts(first);
+       random.AddCuts(second);
+       if(first->GetPassFlag())
+           EXPECT_DOUBLE_EQ(first->GetWeight(), weight*0.125); //0.5^3
+       else
+           EXPECT_DOUBLE_EQ(first->GetWeight(), weight);
+       delete first;
+       delete second;
+    }
+    //with efficiency 1 the reweighted counters are just the geometric ones
+    EXPECT_DOUBLE_EQ(reweighted.GetReweightedEvents(0), reweighted.GetAcceptedEvents());
+    EXPECT_DOUBLE_EQ(reweighted.GetReweightedGammas(0), reweighted.GetAcceptedGammas());
+    EXPECT_DOUBLE_EQ(reweighted.GetReweightedEvents(1), 0.125*reweighted.GetAcceptedEvents());
+    EXPECT_DOUBLE_EQ(reweighted.GetReweightedGammas(1), 0.5*reweighted.GetAcceptedGammas());
+    EXPECT_DOUBLE_EQ(reweighted.GetReweightedEvents(2), 0.0);
+    //the same acceptance as with the random cut, within statistical errors
+    EXPECT_NEAR(reweighted.GetReweightedEvents(1)/simSteps, (double)random.GetAcceptedEvents()/simSteps, 0.01);
+    EXPECT_NEAR(reweighted.GetReweightedGammas(1)/simSteps/3.0, (double)random.GetAcceptedGammas()/simSteps/3.0, 0.01);
+    for(int ii=0; ii<3; ii++)
+        delete sourcePar[ii];
+}
+
+///
+/// \brief TEST_F (cutsTestFixture, BarrelsShareDecays) Checks that cuts of several barrels applied to copies of the same
+/// events give the same results as separate runs, and that copies keep hit points and flags.
+///
+TEST_F (cutsTestFixture, BarrelsShareDecays)
+{
+    int simSteps = 10007;
+    double R = pManag->GetR();
+    double L = pManag->GetL();
+    std::vector<TLorentzVector*> sourcePar;
+    std::vector<TLorentzVector*> fourMomenta;
+    for(int ii=0; ii<2; ii++)
+    {
+        sourcePar.push_back(new TLorentzVector(0.0, 0.0, 100.0, 0.0));
+        fourMomenta.push_back(nullptr);
+    }
+    InitialCuts detector(TWO, R, L, 1.0);
+    InitialCuts same(TWO, R, L, 1.0);
+    InitialCuts longer(TWO, R, 2*L, 1.0);
+    detector.EnableSilentMode();
+    same.EnableSilentMode();
+    longer.EnableSilentMode();
+    event->SetDecay(Ps, 2, masses2);
+    Event* copy = nullptr;
+    for (int n=0; n<simSteps; n++)
+    {
+       double weight = event->Generate();
+       for(int ii=0; ii<2; ii++)
+           fourMomenta[ii]=event->GetDecay(ii);
+       Event* eventDecay = new Event(&sourcePar, &fourMomenta, weight, TWO);
+       if(copy)
+           *copy = *eventDecay;
+       else
+           copy = new Event(*eventDecay);
+       longer.AddCuts(copy);
+       *copy = *eventDecay;
+       same.AddCuts(copy);
+       detector.AddCuts(eventDecay);
+       ASSERT_EQ(copy->GetPassFlag(), eventDecay->GetPassFlag());
+       Event second(*eventDecay);
+       EXPECT_DOUBLE_EQ(second.GetWeight(), weight);
+       EXPECT_EQ(second.GetPassFlag(), eventDecay->GetPassFlag());
+       ASSERT_NE(second.GetHitPointOf(0), nullptr);
+       EXPECT_DOUBLE_EQ(second.GetHitPointOf(0)->Z(), eventDecay->GetHitPointOf(0)->Z());
+       delete eventDecay;
+    }
+    delete copy;
+    EXPECT_EQ(same.GetAcceptedEvents(), detector.GetAcceptedEvents());
+    EXPECT_EQ(same.GetAcceptedGammas(), detector.GetAcceptedGammas());
+    EXPECT_GT(longer.GetAcceptedEvents(), detector.GetAcceptedEvents());
+    EXPECT_EQ(longer.GetNumberOfEvents(), simSteps);
+    for(int ii=0; ii<2; ii++)
+        delete sourcePar[ii];
+}
+
+///
+/// \brief TEST_F (cutsTestFixture, BatchedHitPoints) Checks that hit points calculated for a batch of many events
+/// and assigned to them give the same results of cuts as hit points calculated for every event separately.
+///
+TEST_F (cutsTestFixture, BatchedHitPoints)
+{
+    const int batchSize = 64;
+    std::vector<TLorentzVector*> sourcePar;
+    std::vector<TLorentzVector*> fourMomenta;
+    for(int ii=0; ii<3; ii++)
+    {
+        sourcePar.push_back(new TLorentzVector(50.0, -20.0, 300.0, 0.0));
+        fourMomenta.push_back(nullptr);
+    }
+    InitialCuts separate(THREE, pManag->GetR(), pManag->GetL(), 1.0);
+    InitialCuts batched(THREE, pManag->GetR(), pManag->GetL(), 1.0);
+    separate.EnableSilentMode();
+    batched.EnableSilentMode();
+    event->SetDecay(Ps, 3, masses3);
+    std::vector<Event*> batch;
+    std::vector<unsigned> firstPhotons;
+    PhotonBatch photons;
+    HitBatch hits;
+    for (int n=0; n<10; n++)
+    {
+        batch.clear();
+        firstPhotons.clear();
+        photons.Clear();
+        for(int ee=0; ee<batchSize; ee++)
+        {
+            double weight = event->Generate();
+            for(int ii=0; ii<3; ii++)
+                fourMomenta[ii]=event->GetDecay(ii);
+            batch.push_back(new Event(&sourcePar, &fourMomenta, weight, THREE));
+            firstPhotons.push_back(photons.Size());
+            batch.back()->AddPhotonsTo(photons);
+        }
+        ASSERT_EQ(photons.Size(), 3u*batchSize);
+        batched.CalculateHitPoints(photons, hits);
+        for(int ee=0; ee<batchSize; ee++)
+        {
+            Event copy(*batch[ee]);
+            separate.AddCuts(&copy);
+            batch[ee]->AssignHitPoints(hits, firstPhotons[ee]);
+            batched.AddCuts(batch[ee], true);
+            ASSERT_EQ(copy.GetPassFlag(), batch[ee]->GetPassFlag());
+            for(int ii=0; ii<3; ii++)
+                EXPECT_NEAR(copy.GetHitPointOf(ii)->Z(), batch[ee]->GetHitPointOf(ii)->Z(), 1e-9);
+            delete batch[ee];
+        }
+    }
+    EXPECT_EQ(batched.GetNumberOfEvents(), 10*batchSize);
+    EXPECT_EQ(batched.GetAcceptedEvents(), separate.GetAcceptedEvents());
+    EXPECT_EQ(batched.GetAcceptedGammas(), separate.GetAcceptedGammas());
+    for(int ii=0; ii<3; ii++)
+        delete sourcePar[ii];
+}
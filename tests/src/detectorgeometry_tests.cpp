@@ -0,0 +1,121 @@
+/// @file detectorgeometry_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check intersections of photons with multi-component detector geometry.
+#include "gtest/gtest.h"
+#include "../../src/detectorgeometry.h"
+#include "../../src/hitkernel.h"
+#include "TRandom3.h"
+#include "TMath.h"
+#include <fstream>
+#include <cstdio>
+
+///
+/// \brief TEST (DetectorGeometryTest, SingleBarrel) Geometry with one barrel has to give the same hit points as the cylinder kernel.
+///
+TEST (DetectorGeometryTest, SingleBarrel)
+{
+    double R = 437.3;
+    double L = 500;
+    DetectorGeometry geometry;
+    geometry.AddBarrel(R, -L/2, L/2);
+    geometry.Build();
+    TRandom3 rand(3);
+    PhotonBatch photons;
+    for(int ii=0; ii<5000; ii++)
+    {
+        double theta = TMath::ACos(rand.Uniform(-1.0, 1.0));
+        double phi = rand.Uniform(0.0, 2*TMath::Pi());
+        photons.Push(rand.Uniform(-100.0, 100.0), rand.Uniform(-100.0, 100.0), rand.Uniform(-100.0, 100.0),\
+                     0.511*TMath::Sin(theta)*TMath::Cos(phi), 0.511*TMath::Sin(theta)*TMath::Sin(phi), 0.511*TMath::Cos(theta), 0.511);
+    }
+    HitBatch expected;
+    HitBatch hits;
+    CalculateHitPointsBatch(photons, R, L, expected);
+    geometry.CalculateHitPoints(photons, hits);
+    for(unsigned ii=0; ii<photons.Size(); ii++)
+    {
+        EXPECT_EQ(hits.miss[ii], expected.miss[ii]);
+        EXPECT_NEAR(hits.x[ii], expected.x[ii], 1e-6);
+        EXPECT_NEAR(hits.y[ii], expected.y[ii], 1e-6);
+        EXPECT_NEAR(hits.z[ii], expected.z[ii], 1e-6);
+        EXPECT_NEAR(hits.t[ii], expected.t[ii], 1e-6);
+    }
+}
+
+///
+/// \brief TEST (DetectorGeometryTest, RingOfModules) Checks hits in modules and in gaps between rings.
+///
+TEST (DetectorGeometryTest, RingOfModules)
+{
+    DetectorGeometry geometry;
+    geometry.AddRing(24, 400, 10, 30, 100, -110);
+    geometry.AddRing(24, 400, 10, 30, 100, 110);
+    geometry.Build();
+    ASSERT_EQ(geometry.GetNumberOfComponents(), 48);
+    double origin[3] = {0.0, 0.0, 0.0};
+    //towards the center of the first module of the second ring, hits its inner face
+    double dir1[3] = {400.0, 0.0, 110.0};
+    GeometryHit hit = geometry.Intersect(origin, dir1);
+    EXPECT_EQ(hit.component, 24);
+    EXPECT_NEAR(hit.t, 390.0/400.0, 1e-9);
+    //through the axial gap between rings
+    double dir2[3] = {1.0, 0.0, 0.0};
+    EXPECT_EQ(geometry.Intersect(origin, dir2).component, -1);
+    //along the axis
+    double dir3[3] = {0.0, 0.0, 1.0};
+    EXPECT_EQ(geometry.Intersect(origin, dir3).component, -1);
+}
+
+///
+/// \brief TEST (DetectorGeometryTest, BVHEqualsBruteForce) BVH traversal must find the same first hit as checking all components.
+///
+TEST (DetectorGeometryTest, BVHEqualsBruteForce)
+{
+    TRandom3 rand(11);
+    DetectorGeometry geometry;
+    geometry.AddBarrel(300, -200, 200);
+    geometry.AddRing(36, 500, 15, 25, 200, 0, 10);
+    for(int ii=0; ii<500; ii++)
+        geometry.AddBox(rand.Uniform(-600, 600), rand.Uniform(-600, 600), rand.Uniform(-600, 600), rand.Uniform(1, 30), \
+                        rand.Uniform(1, 30), rand.Uniform(1, 30), rand.Uniform(0, 360), rand.Uniform(0, 360));
+    geometry.Build();
+    for(int ii=0; ii<20000; ii++)
+    {
+        double origin[3] = {rand.Uniform(-100, 100), rand.Uniform(-100, 100), rand.Uniform(-100, 100)};
+        double theta = TMath::ACos(rand.Uniform(-1.0, 1.0));
+        double phi = rand.Uniform(0.0, 2*TMath::Pi());
+        double direction[3] = {TMath::Sin(theta)*TMath::Cos(phi), TMath::Sin(theta)*TMath::Sin(phi), TMath::Cos(theta)};
+        GeometryHit bvh = geometry.Intersect(origin, direction);
+        GeometryHit brute = geometry.IntersectBruteForce(origin, direction);
+        ASSERT_EQ(bvh.component, brute.component);
+        if(bvh.component>=0)
+        {
+            EXPECT_NEAR(bvh.t, brute.t, 1e-9);
+        }
+    }
+}
+
+///
+/// \brief TEST (DetectorGeometryTest, Import) Reads geometry from a file.
+///
+TEST (DetectorGeometryTest, Import)
+{
+    std::string fileName = "test_geometry.geo";
+    std::ofstream out(fileName.c_str());
+    out<<"#comment\nbarrel 437.3 -250 250\nbox 0 0 400 10 10 10 45 0 #cube\nring 8 600 10 20 30\n";
+    out.close();
+    DetectorGeometry geometry;
+    geometry.Import(fileName);
+    EXPECT_TRUE(geometry.IsBuilt());
+    EXPECT_EQ(geometry.GetNumberOfComponents(), 10);
+    EXPECT_EQ(geometry.GetComponent(1).type, BOX);
+    std::ofstream bad(fileName.c_str());
+    bad<<"sphere 10\n";
+    bad.close();
+    DetectorGeometry wrong;
+    EXPECT_THROW(wrong.Import(fileName), std::string);
+    std::remove(fileName.c_str());
+}
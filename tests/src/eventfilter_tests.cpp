@@ -0,0 +1,110 @@
+/// @file eventfilter_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check parsing and evaluation of filter expressions.
+#include <memory>
+#include "gtest/gtest.h"
+#include "../../src/eventfilter.h"
+#include "../../src/event.h"
+
+namespace
+{
+    ///
+    /// \brief MakeEvent Creates a back-to-back 2-gamma event with an additional prompt photon.
+    ///
+    Event* MakeEvent()
+    {
+        static TLorentzVector source(0.0, 0.0, 0.0, 0.0);
+        double E = 0.511/1000; //Event expects GeV
+        double EPrompt = 1.157/1000;
+        static TLorentzVector first, second, third;
+        first.SetPxPyPzE(E, 0.0, 0.0, E);
+        second.SetPxPyPzE(-E, 0.0, 0.0, E);
+        third.SetPxPyPzE(0.0, EPrompt, 0.0, EPrompt);
+        std::vector<TLorentzVector*> sourcePar = {&source, &source, &source};
+        std::vector<TLorentzVector*> fourMomenta = {&first, &second, &third};
+        return new Event(&sourcePar, &fourMomenta, 1.0, TWOandONE);
+    }
+}
+
+///
+/// \brief TEST (EventFilterTest, Empty) Empty expressions accept all events.
+///
+TEST (EventFilterTest, Empty)
+{
+    std::unique_ptr<Event> eventPtr(MakeEvent());
+    Event& event = *eventPtr;
+    EXPECT_TRUE(EventFilter().Accept(&event));
+    EXPECT_TRUE(EventFilter("none").Accept(&event));
+    EXPECT_TRUE(EventFilter("  ").IsEmpty());
+}
+
+///
+/// \brief TEST (EventFilterTest, SyntaxErrors) Invalid expressions are rejected when the filter is compiled.
+///
+TEST (EventFilterTest, SyntaxErrors)
+{
+    EXPECT_THROW(EventFilter("nPassed >="), std::string);
+    EXPECT_THROW(EventFilter("(nPassed > 1"), std::string);
+    EXPECT_THROW(EventFilter("unknown > 1"), std::string);
+    EXPECT_THROW(EventFilter("edep > 0.2"), std::string); //photon variable outside any/all/count
+    EXPECT_THROW(EventFilter("any(all(passed))"), std::string);
+    EXPECT_THROW(EventFilter("nPassed > 1 nPhotons"), std::string);
+}
+
+///
+/// \brief TEST (EventFilterTest, EventVariables) Variables describing the whole event.
+///
+TEST (EventFilterTest, EventVariables)
+{
+    std::unique_ptr<Event> eventPtr(MakeEvent());
+    Event& event = *eventPtr;
+    EXPECT_TRUE(EventFilter("nPhotons == 3 && nPrompt == 1 && prompt").Accept(&event));
+    EXPECT_TRUE(EventFilter("nPassed == 3 && pass && weight == 1").Accept(&event));
+    EXPECT_FALSE(EventFilter("!prompt").Accept(&event));
+    event.SetCutPassing(0, false);
+    event.DeducePassFlag();
+    EXPECT_TRUE(EventFilter("nPassed == 2 && !pass").Accept(&event));
+    EXPECT_TRUE(EventFilter("2*nPassed - 1 == nPhotons + -(-1) - 1 - 1/1 + 1").Accept(&event));
+}
+
+///
+/// \brief TEST (EventFilterTest, PhotonVariables) Quantifiers over photons and comparisons with missing values.
+///
+TEST (EventFilterTest, PhotonVariables)
+{
+    std::unique_ptr<Event> eventPtr(MakeEvent());
+    Event& event = *eventPtr;
+    EXPECT_TRUE(EventFilter("any(E > 1) && count(abs(E - 0.511) < 1e-6) == 2").Accept(&event));
+    EXPECT_TRUE(EventFilter("all(index >= 2 || !prompt)").Accept(&event));
+    EXPECT_FALSE(EventFilter("any(hitZ == hitZ)").Accept(&event)); //hit points were not calculated
+    EXPECT_TRUE(EventFilter("all(!(hitZ < 0) && !(hitZ >= 0))").Accept(&event)); //both comparisons are false
+    event.CalculateHitPoints(437.3, 500);
+    EXPECT_TRUE(EventFilter("count(abs(hitX) > 437) == 2").Accept(&event));
+    event.SetEdepSmearOf(0, 0.3);
+    event.SetEdepSmearOf(1, 0.1);
+    EXPECT_TRUE(EventFilter("count(edepSmear > 0.2) == 1").Accept(&event));
+    EXPECT_FALSE(EventFilter("all(prompt || edepSmear > 0.2)").Accept(&event));
+}
+
+///
+/// \brief TEST (EventFilterTest, MissedPhoton) Coordinates of photons which missed the detector are missing values.
+///
+TEST (EventFilterTest, MissedPhoton)
+{
+    TLorentzVector source(0.0, 0.0, 0.0, 0.0);
+    double E = 0.511/1000; //Event expects GeV
+    TLorentzVector first(0.0, 0.0, E, E); //along the axis of the barrel, misses it
+    TLorentzVector second(-E, 0.0, 0.0, E);
+    std::vector<TLorentzVector*> sourcePar = {&source, &source};
+    std::vector<TLorentzVector*> fourMomenta = {&first, &second};
+    Event event(&sourcePar, &fourMomenta, 1.0, TWO);
+    event.CalculateHitPoints(437.3, 500);
+    EXPECT_FALSE(event.HasHit(0));
+    EXPECT_TRUE(event.HasHit(1));
+    EXPECT_TRUE(EventFilter("count(hitZ == hitZ) == 1").Accept(&event));
+    EXPECT_FALSE(EventFilter("any(hitZ < 0)").Accept(&event));
+    EXPECT_FALSE(EventFilter("any(hitX > 0 || hitY < -1000 || hitT < 0)").Accept(&event));
+}
@@ -0,0 +1,183 @@
+/// @file flatevent_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check conversion of events to the flat tree schema.
+#include "gtest/gtest.h"
+#include "../../src/flatevent.h"
+#include "../../src/event.h"
+
+namespace
+{
+    ///
+    /// \brief MakeEvent Creates an event with nPhotons gammas emitted from (1, 2, 3) along the X axis.
+    /// \param nPhotons Number of gammas.
+    /// \return New Event object, has to be deleted by the caller.
+    ///
+    Event* MakeEvent(int nPhotons)
+    {
+        TLorentzVector source(1.0, 2.0, 3.0, 0.0);
+        std::vector<TLorentzVector> momenta;
+        std::vector<TLorentzVector*> sourcePar;
+        std::vector<TLorentzVector*> fourMomenta;
+        for(int ii=0; ii<nPhotons; ii++)
+        {
+            double E = (0.1+0.1*ii)/1000; //Event expects GeV
+            momenta.push_back(TLorentzVector(E, 0.0, 0.0, E));
+        }
+        for(int ii=0; ii<nPhotons; ii++)
+        {
+            sourcePar.push_back(&source);
+            fourMomenta.push_back(&momenta[ii]);
+        }
+        return new Event(&sourcePar, &fourMomenta, 0.5, TWO);
+    }
+}
+
+///
+/// \brief TEST (FlatEventTest, Assign) Checks if all fields of the event are copied.
+///
+TEST (FlatEventTest, Assign)
+{
+    Event* event = MakeEvent(2);
+    event->SetCutPassing(1, false);
+    event->SetPrimaryPhoton(0, false);
+    event->SetEdepOf(0, 0.25);
+    event->SetEdepSmearOf(0, 0.3);
+    event->DeducePassFlag();
+    FlatEvent flat;
+    flat.Assign(event);
+    EXPECT_EQ(flat.id, event->fId);
+    EXPECT_EQ(flat.decayType, TWO);
+    EXPECT_FLOAT_EQ(flat.weight, 0.5);
+    EXPECT_EQ(flat.flags & EVENT_PASSED, event->GetPassFlag() ? EVENT_PASSED : 0);
+    ASSERT_EQ(flat.nPhotons, 2);
+    EXPECT_FLOAT_EQ(flat.E[1], 0.2);
+    EXPECT_FLOAT_EQ(flat.px[0], 0.1);
+    EXPECT_FLOAT_EQ(flat.y0[1], 2.0);
+    EXPECT_FLOAT_EQ(flat.edep[0], 0.25);
+    EXPECT_FLOAT_EQ(flat.edepSmear[0], 0.3);
+    EXPECT_EQ(flat.photonFlags[0], PHOTON_PASSED);
+    EXPECT_EQ(flat.photonFlags[1], PHOTON_PRIMARY);
+    delete event;
+}
+
+///
+/// \brief TEST (FlatEventTest, MissedPhoton) Photons which missed the detector have no hit flag and zero hit points.
+///
+TEST (FlatEventTest, MissedPhoton)
+{
+    Event* event = MakeEvent(2);
+    TLorentzVector alongZ(0.0, 0.0, 0.1/1000, 0.1/1000);
+    event->SetFourMomentumOf(0, alongZ); //leaves the barrel through its end
+    event->CalculateHitPoints(437.3, 500);
+    FlatEvent flat;
+    flat.Assign(event);
+    ASSERT_EQ(flat.nPhotons, 2);
+    EXPECT_EQ(flat.photonFlags[0] & PHOTON_HIT, 0);
+    EXPECT_FLOAT_EQ(flat.hitX[0], 0.0);
+    EXPECT_FLOAT_EQ(flat.hitZ[0], 0.0);
+    EXPECT_FLOAT_EQ(flat.hitT[0], 0.0);
+    EXPECT_EQ(flat.photonFlags[1] & PHOTON_HIT, PHOTON_HIT);
+    EXPECT_NEAR(flat.hitX[1], 437.3, 0.01);
+    flat.Assign(event, true);
+    ASSERT_EQ(flat.nPhotons, 1);
+    EXPECT_EQ(flat.photonIndex[0], 1);
+    delete event;
+}
+
+///
+/// \brief TEST (FlatEventTest, TreeRoundTrip) Events written with the flat schema are read back unchanged.
+///
+TEST (FlatEventTest, TreeRoundTrip)
+{
+    TTree tree("flat_test", "flat_test");
+    FlatEvent flat;
+    flat.Branch(&tree);
+    for(int nn=1; nn<=3; nn++)
+    {
+        Event* event = MakeEvent(nn);
+        flat.Assign(event);
+        tree.Fill();
+        delete event;
+    }
+    ASSERT_TRUE(FlatEvent::IsFlatTree(&tree));
+    FlatEvent read;
+    ASSERT_TRUE(read.SetBranchAddresses(&tree));
+    ASSERT_EQ(tree.GetEntries(), 3);
+    for(int nn=0; nn<3; nn++)
+    {
+        tree.GetEntry(nn);
+        ASSERT_EQ(read.nPhotons, nn+1);
+        for(int ii=0; ii<read.nPhotons; ii++)
+        {
+            EXPECT_FLOAT_EQ(read.E[ii], 0.1+0.1*ii);
+            EXPECT_FLOAT_EQ(read.z0[ii], 3.0);
+        }
+    }
+}
+
+///
+/// \brief TEST (FlatEventTest, TooManyPhotons) Events which do not fit into the arrays are rejected.
+///
+TEST (FlatEventTest, TooManyPhotons)
+{
+    Event* event = MakeEvent(FlatEvent::kMaxPhotons+1);
+    FlatEvent flat;
+    EXPECT_THROW(flat.Assign(event), std::string);
+    delete event;
+}
+
+///
+/// \brief TEST (FlatEventTest, Sparse) Only detected photons are stored by the sparse schema.
+///
+TEST (FlatEventTest, Sparse)
+{
+    Event* event = MakeEvent(3);
+    FlatEvent flat;
+    flat.Assign(event, true);
+    EXPECT_EQ(flat.nEmitted, 3);
+    EXPECT_EQ(flat.nPhotons, 0); //hit points were not calculated
+    event->CalculateHitPoints(437.3, 500);
+    event->SetCutPassing(1, false);
+    flat.Assign(event, true);
+    EXPECT_EQ(flat.nEmitted, 3);
+    ASSERT_EQ(flat.nPhotons, 2);
+    EXPECT_EQ(flat.photonIndex[0], 0);
+    EXPECT_EQ(flat.photonIndex[1], 2);
+    EXPECT_FLOAT_EQ(flat.E[1], 0.3);
+    EXPECT_EQ(flat.photonFlags[1] & (PHOTON_PASSED | PHOTON_HIT), PHOTON_PASSED | PHOTON_HIT);
+
+    TTree tree("sparse_test", "sparse_test");
+    flat.Branch(&tree, 32000, true);
+    tree.Fill();
+    ASSERT_TRUE(FlatEvent::IsFlatTree(&tree));
+    ASSERT_TRUE(FlatEvent::IsSparseTree(&tree));
+    FlatEvent read;
+    ASSERT_TRUE(read.SetBranchAddresses(&tree));
+    tree.GetEntry(0);
+    EXPECT_EQ(read.nEmitted, 3);
+    ASSERT_EQ(read.nPhotons, 2);
+    EXPECT_EQ(read.photonIndex[1], 2);
+    EXPECT_NEAR(read.hitX[1], 437.3, 0.01);
+    delete event;
+}
+
+///
+/// \brief TEST (FlatEventTest, SparseManyPhotons) Events with more emitted photons than the arrays hold are stored
+/// if few of them were detected.
+///
+TEST (FlatEventTest, SparseManyPhotons)
+{
+    Event* event = MakeEvent(FlatEvent::kMaxPhotons+8);
+    event->CalculateHitPoints(437.3, 500);
+    for(int ii=2; ii<event->GetNumberOfDecayProducts(); ii++)
+        event->SetCutPassing(ii, false);
+    FlatEvent flat;
+    ASSERT_NO_THROW(flat.Assign(event, true));
+    EXPECT_EQ(flat.nEmitted, FlatEvent::kMaxPhotons+8);
+    EXPECT_EQ(flat.nPhotons, 2);
+    EXPECT_THROW(flat.Assign(event), std::string);
+    delete event;
+}
@@ -0,0 +1,174 @@
+/// @file histogramregistry_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check booking and filling of histograms declared in HistogramRegistry.
+#include "gtest/gtest.h"
+#include "../../src/histogramregistry.h"
+#include "../../src/initialcuts.h"
+#include "../../src/event.h"
+#include "TRandom3.h"
+
+namespace
+{
+    ///
+    /// \brief MakeTwoGammaEvent Creates a back-to-back 2-gamma event emitted from the center.
+    /// \param cosTheta Cosine of the polar angle of the first gamma.
+    /// \return New Event object, has to be deleted by the caller.
+    ///
+    Event* MakeTwoGammaEvent(double cosTheta)
+    {
+        double sinTheta = TMath::Sqrt(1.0-cosTheta*cosTheta);
+        TLorentzVector source(0.0, 0.0, 0.0, 0.0);
+        double E = 0.511/1000; //Event expects GeV
+        TLorentzVector first(E*sinTheta, 0.0, E*cosTheta, E);
+        TLorentzVector second(-E*sinTheta, 0.0, -E*cosTheta, E);
+        std::vector<TLorentzVector*> sourcePar = {&source, &source};
+        std::vector<TLorentzVector*> fourMomenta = {&first, &second};
+        return new Event(&sourcePar, &fourMomenta, 1.0, TWO);
+    }
+}
+
+///
+/// \brief TEST (HistogramRegistryTest, ParseGroups) Checks conversion between names of groups and flags.
+///
+TEST (HistogramRegistryTest, ParseGroups)
+{
+    EXPECT_EQ(HistogramRegistry::ParseGroups({"all"}), (unsigned)ALL_HISTOGRAMS);
+    EXPECT_EQ(HistogramRegistry::ParseGroups({"none"}), (unsigned)NO_HISTOGRAMS);
+    EXPECT_EQ(HistogramRegistry::ParseGroups({"angles", "pass"}), (unsigned)(ANGLE_HISTOGRAMS | PASS_HISTOGRAMS));
+    EXPECT_EQ(HistogramRegistry::GroupNames(ENERGY_HISTOGRAMS | COMPTON_HISTOGRAMS), "energies compton");
+    EXPECT_EQ(HistogramRegistry::GroupNames(ALL_HISTOGRAMS), "all");
+    EXPECT_THROW(HistogramRegistry::ParseGroups({"angels"}), std::string);
+}
+
+///
+/// \brief TEST (HistogramRegistryTest, DisabledGroups) Histograms are booked only if all of their groups are enabled.
+///
+TEST (HistogramRegistryTest, DisabledGroups)
+{
+    HistogramRegistry registry(ANGLE_HISTOGRAMS | PASS_HISTOGRAMS, "_disabled");
+    EventFillExpression fill = [](HistogramFiller& h, const Event* event){h.Fill(RelativeAngle(event, 0, 1));};
+    EXPECT_NE(registry.AddEventHistogram(Histogram1D("angle_pass", ANGLE_HISTOGRAMS | PASS_HISTOGRAMS, 10, 0, 3.2), fill), nullptr);
+    EXPECT_EQ(registry.AddEventHistogram(Histogram1D("angle_fail", ANGLE_HISTOGRAMS | FAIL_HISTOGRAMS, 10, 0, 3.2), fill), nullptr);
+    EXPECT_EQ(registry.AddEventHistogram(Histogram1D("energy", ENERGY_HISTOGRAMS, 10, 0, 1), fill), nullptr);
+    EXPECT_EQ(registry.GetNumberOfHistograms(), 1);
+    EXPECT_FALSE(registry.HasPhotonHistograms());
+    EXPECT_EQ(registry.Get("angle_fail"), nullptr);
+}
+
+///
+/// \brief TEST (HistogramRegistryTest, FillAndSkip) Checks event and photon fills and skipping of groups.
+///
+TEST (HistogramRegistryTest, FillAndSkip)
+{
+    HistogramRegistry registry(ALL_HISTOGRAMS, "_fill");
+    TH1* angle = registry.AddEventHistogram(Histogram1D("angle", ANGLE_HISTOGRAMS, 10, 0, 3.2),\
+        [](HistogramFiller& h, const Event* event){h.Fill(RelativeAngle(event, 0, 1));});
+    TH1* energy = registry.AddPhotonHistogram(Histogram1D("energy", ENERGY_HISTOGRAMS | PASS_HISTOGRAMS, 10, 0, 1),\
+        [](HistogramFiller& h, const Event* event, int ii){h.Fill(event->GetFourMomentumOf(ii)->Energy());});
+    TH1* cosines = registry.AddPhotonHistogram(Histogram2D("cosines", ANGLE_HISTOGRAMS, 10, -1, 1, 10, -1, 1),\
+        [](HistogramFiller& h, const Event* event, int ii){h.Fill(event->GetFourMomentumOf(ii)->CosTheta(), ii, 1.0);});
+    ASSERT_NE(angle, nullptr);
+    ASSERT_NE(energy, nullptr);
+    ASSERT_NE(cosines, nullptr);
+    Event* event = MakeTwoGammaEvent(0.3);
+    registry.Fill(event);
+    for(int ii=0; ii<event->GetNumberOfDecayProducts(); ii++)
+        registry.FillPhoton(event, ii, ii==0 ? NO_HISTOGRAMS : PASS_HISTOGRAMS);
+    delete event;
+    EXPECT_EQ(angle->GetEntries(), 0); //fills are buffered
+    registry.Flush();
+    EXPECT_EQ(angle->GetEntries(), 1);
+    EXPECT_NEAR(angle->GetMean(), TMath::Pi(), 1e-6);
+    EXPECT_EQ(energy->GetEntries(), 1); //second photon skipped
+    EXPECT_EQ(cosines->GetEntries(), 2);
+    EXPECT_EQ(registry.Get("energy"), energy);
+}
+
+///
+/// \brief TEST (HistogramRegistryTest, DeepCopy) Copies own their histograms and share fill expressions.
+///
+TEST (HistogramRegistryTest, DeepCopy)
+{
+    HistogramRegistry registry(ALL_HISTOGRAMS, "_copy");
+    registry.AddEventHistogram(Histogram1D("angle", ANGLE_HISTOGRAMS, 10, 0, 3.2),\
+        [](HistogramFiller& h, const Event* event){h.Fill(RelativeAngle(event, 0, 1));});
+    HistogramRegistry copy(registry);
+    ASSERT_NE(copy.Get("angle"), nullptr);
+    EXPECT_NE(copy.Get("angle"), registry.Get("angle"));
+    Event* event = MakeTwoGammaEvent(-0.5);
+    copy.Fill(event);
+    delete event;
+    copy.Flush();
+    registry.Flush();
+    EXPECT_EQ(copy.Get("angle")->GetEntries(), 1);
+    EXPECT_EQ(registry.Get("angle")->GetEntries(), 0);
+}
+
+///
+/// \brief TEST (HistogramRegistryTest, BufferedFills) Buffered fills flushed with FillN give the same histograms as direct fills.
+///
+TEST (HistogramRegistryTest, BufferedFills)
+{
+    TH1F direct1D("direct1D", "direct1D", 50, -1, 1);
+    TH2F direct2D("direct2D", "direct2D", 20, -1, 1, 20, -1, 1);
+    TH1F* buffered1D = new TH1F("buffered1D", "buffered1D", 50, -1, 1);
+    TH2F* buffered2D = new TH2F("buffered2D", "buffered2D", 20, -1, 1, 20, -1, 1);
+    HistogramFiller filler1D(buffered1D, 100);
+    HistogramFiller filler2D(buffered2D, 100);
+    TRandom3 values(3);
+    for(int ii=0; ii<1050; ii++) //not a multiple of the buffer size
+    {
+        double x = values.Uniform(-1.2, 1.2);
+        double y = values.Uniform(-1.2, 1.2);
+        double w = values.Uniform(0.5, 1.5);
+        direct1D.Fill(x, w);
+        direct2D.Fill(x, y, w);
+        filler1D.Fill(x, w);
+        filler2D.Fill(x, y, w);
+    }
+    EXPECT_EQ(filler1D.GetBufferedEntries(), 50u);
+    filler1D.Flush();
+    filler2D.Flush();
+    EXPECT_EQ(filler1D.GetBufferedEntries(), 0u);
+    EXPECT_EQ(buffered1D->GetEntries(), direct1D.GetEntries());
+    EXPECT_EQ(buffered2D->GetEntries(), direct2D.GetEntries());
+    for(int bin=0; bin<=51; bin++)
+        EXPECT_FLOAT_EQ(buffered1D->GetBinContent(bin), direct1D.GetBinContent(bin));
+    for(int bin=0; bin<direct2D.GetNcells(); bin++)
+        EXPECT_FLOAT_EQ(buffered2D->GetBinContent(bin), direct2D.GetBinContent(bin));
+    EXPECT_FLOAT_EQ(buffered1D->GetMean(), direct1D.GetMean());
+    delete buffered1D;
+    delete buffered2D;
+}
+
+///
+/// \brief TEST (HistogramRegistryTest, CutsWithoutHistograms) Disabling histograms must not change the results of cuts.
+///
+TEST (HistogramRegistryTest, CutsWithoutHistograms)
+{
+    InitialCuts all(TWO, 437.3, 500, 0.5);
+    InitialCuts none(TWO, 437.3, 500, 0.5, NO_HISTOGRAMS);
+    all.EnableSilentMode();
+    none.EnableSilentMode();
+    TRandom3 directions(7);
+    std::vector<double> cosines;
+    for(int ii=0; ii<2000; ii++)
+        cosines.push_back(directions.Uniform(-1.0, 1.0));
+    for(int pass=0; pass<2; pass++)
+    {
+        InitialCuts& cuts = pass==0 ? all : none;
+        gRandom->SetSeed(11);
+        for(unsigned ii=0; ii<cosines.size(); ii++)
+        {
+            Event* event = MakeTwoGammaEvent(cosines[ii]);
+            cuts.AddCuts(event);
+            delete event;
+        }
+    }
+    EXPECT_GT(all.GetAcceptedEvents(), 0);
+    EXPECT_EQ(all.GetAcceptedEvents(), none.GetAcceptedEvents());
+    EXPECT_EQ(all.GetAcceptedGammas(), none.GetAcceptedGammas());
+}
@@ -0,0 +1,81 @@
+/// @file hitkernel_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check if the vectorized hit point kernel gives the same results as the scalar one
+/// and as the Event class.
+#include "gtest/gtest.h"
+#include "../../src/hitkernel.h"
+#include "../../src/event.h"
+#include "TRandom3.h"
+#include <TLorentzVector.h>
+
+///
+/// \brief TEST (HitKernelTest, BatchEqualsScalar) Compares results of CalculateHitPointsBatch and CalculateHitPointsScalar for random photons.
+///
+TEST (HitKernelTest, BatchEqualsScalar)
+{
+    TRandom3 rand(17);
+    PhotonBatch photons;
+    int noOfPhotons = 10007; //not divisible by the vector width
+    for(int ii=0; ii<noOfPhotons; ii++)
+    {
+        double theta = TMath::ACos(rand.Uniform(-1.0, 1.0));
+        double phi = rand.Uniform(0.0, 2*TMath::Pi());
+        if(ii%100==0)
+            theta = 0.0; //photons along the detector's axis always miss
+        photons.Push(rand.Uniform(-100.0, 100.0), rand.Uniform(-100.0, 100.0), rand.Uniform(-100.0, 100.0),\
+                     0.511*TMath::Sin(theta)*TMath::Cos(phi), 0.511*TMath::Sin(theta)*TMath::Sin(phi), 0.511*TMath::Cos(theta), 0.511);
+    }
+    HitBatch batch;
+    HitBatch scalar;
+    CalculateHitPointsBatch(photons, 437.3, 500, batch);
+    scalar.Resize(photons.Size());
+    CalculateHitPointsScalar(photons, 437.3, 500, scalar);
+    ASSERT_EQ(batch.Size(), photons.Size());
+    for(int ii=0; ii<noOfPhotons; ii++)
+    {
+        EXPECT_EQ(batch.miss[ii], scalar.miss[ii]);
+        EXPECT_NEAR(batch.x[ii], scalar.x[ii], 1e-9);
+        EXPECT_NEAR(batch.y[ii], scalar.y[ii], 1e-9);
+        EXPECT_NEAR(batch.z[ii], scalar.z[ii], 1e-9);
+        EXPECT_NEAR(batch.t[ii], scalar.t[ii], 1e-9);
+        if(ii%100==0)
+        {
+            EXPECT_EQ(batch.miss[ii], 1);
+        }
+    }
+}
+
+///
+/// \brief TEST (HitKernelTest, EventHitPoints) Checks hit points calculated by Event for photons emitted from the center of the barrel.
+///
+TEST (HitKernelTest, EventHitPoints)
+{
+    double R = 437.3;
+    double L = 500;
+    std::vector<TLorentzVector*> sourcePar;
+    std::vector<TLorentzVector*> fourMomenta;
+    for(int ii=0; ii<3; ii++)
+        sourcePar.push_back(new TLorentzVector(0.0, 0.0, 0.0, 0.0));
+    fourMomenta.push_back(new TLorentzVector(0.000511, 0.0, 0.0, 0.000511)); //hits at (R, 0, 0)
+    fourMomenta.push_back(new TLorentzVector(0.0, 0.0, 0.000511, 0.000511)); //along the axis, misses
+    fourMomenta.push_back(new TLorentzVector(0.0, 0.000511, 0.000511, 0.000722)); //45 degrees, misses because R > L/2
+    Event event(&sourcePar, &fourMomenta, 1.0, THREE);
+    event.CalculateHitPoints(R, L);
+    EXPECT_NEAR(event.GetHitPointOf(0)->X(), R, 1e-9);
+    EXPECT_NEAR(event.GetHitPointOf(0)->Y(), 0.0, 1e-9);
+    EXPECT_NEAR(event.GetHitPhiOf(0), 0.0, 1e-9);
+    EXPECT_NEAR(event.GetHitThetaOf(0), TMath::Pi()/2.0, 1e-9);
+    EXPECT_EQ(event.GetHitPhiOf(1), -4);
+    EXPECT_EQ(event.GetHitPhiOf(2), -4);
+    //calculating again must not append new hit points
+    event.CalculateHitPoints(R, L);
+    EXPECT_EQ(event.GetHitPointOf(3), nullptr);
+    for(int ii=0; ii<3; ii++)
+    {
+        delete sourcePar[ii];
+        delete fourMomenta[ii];
+    }
+}
@@ -0,0 +1,164 @@
+/// @file listmode_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check writing and reading of list-mode files.
+#include <cstdio>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "../../src/listmode.h"
+#include "../../src/event.h"
+
+///
+/// \brief TEST (ListModeTest, RoundTrip) Records written through a small buffer are read back unchanged.
+///
+TEST (ListModeTest, RoundTrip)
+{
+    const std::string path = "listmode_test.lm";
+    const int nRecords = 1000; //several flushes of the smallest buffer
+    ListModeHeader header = MakeListModeHeader();
+    header.run = 3;
+    header.seed = 12345;
+    header.R = 437.3;
+    {
+        ListModeWriter writer(path, header, 1);
+        for(int ii=0; ii<nRecords; ii++)
+        {
+            ListModeRecord record = {};
+            record.eventId = ii;
+            record.x[0] = ii;
+            record.edep[1] = 0.5*ii;
+            record.flags = LM_FIRST_PRIMARY | (TWO<<8);
+            writer.Add(record);
+        }
+        EXPECT_EQ(writer.GetNumberOfRecords(), (uint64_t)nRecords);
+    } //closed by the destructor
+    ListModeReader reader(path);
+    EXPECT_EQ(reader.GetHeader().run, 3);
+    EXPECT_EQ(reader.GetHeader().seed, 12345);
+    EXPECT_FLOAT_EQ(reader.GetHeader().R, 437.3);
+    ASSERT_EQ(reader.GetNumberOfRecords(), (uint64_t)nRecords);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(reader.GetRecords())%ListModeHeader::kSize, 0u); //records are page-aligned
+    for(int ii=0; ii<nRecords; ii++)
+    {
+        ASSERT_EQ(reader[ii].eventId, (uint64_t)ii);
+        EXPECT_FLOAT_EQ(reader[ii].x[0], ii);
+        EXPECT_FLOAT_EQ(reader[ii].edep[1], 0.5*ii);
+        EXPECT_EQ(reader[ii].GetDecayType(), TWO);
+    }
+    std::remove(path.c_str());
+}
+
+///
+/// \brief TEST (ListModeTest, FromEvent) Only accepted coincidences are converted to records.
+///
+TEST (ListModeTest, FromEvent)
+{
+    TLorentzVector source(0.0, 0.0, 0.0, 0.0);
+    double E = 0.511/1000; //Event expects GeV
+    TLorentzVector first(E, 0.0, 0.0, E);
+    TLorentzVector second(-E, 0.0, 0.0, E);
+    std::vector<TLorentzVector*> sourcePar = {&source, &source};
+    std::vector<TLorentzVector*> fourMomenta = {&first, &second};
+    Event event(&sourcePar, &fourMomenta, 1.0, TWO);
+    ListModeRecord record;
+    EXPECT_FALSE(MakeListModeRecord(&event, record)); //hit points were not calculated
+    event.CalculateHitPoints(437.3, 500);
+    event.SetEdepSmearOf(0, 0.3);
+    ASSERT_TRUE(MakeListModeRecord(&event, record));
+    EXPECT_EQ(record.eventId, (uint64_t)event.fId);
+    EXPECT_NEAR(record.x[0], 437.3, 1e-3);
+    EXPECT_NEAR(record.x[1], -437.3, 1e-3);
+    EXPECT_FLOAT_EQ(record.edep[0], 0.3);
+    EXPECT_EQ(record.flags & (LM_FIRST_PRIMARY | LM_SECOND_PRIMARY), (uint32_t)(LM_FIRST_PRIMARY | LM_SECOND_PRIMARY));
+    event.SetCutPassing(1, false);
+    event.DeducePassFlag();
+    EXPECT_FALSE(MakeListModeRecord(&event, record));
+}
+
+///
+/// \brief TEST (ListModeTest, InvalidFile) Files without the list-mode header are rejected.
+///
+TEST (ListModeTest, InvalidFile)
+{
+    const std::string path = "listmode_invalid.lm";
+    std::ofstream file(path.c_str());
+    file<<std::string(ListModeHeader::kSize, 'x');
+    file.close();
+    EXPECT_THROW(ListModeReader reader(path), std::string);
+    EXPECT_THROW(ListModeReader reader("listmode_missing.lm"), std::string);
+    std::remove(path.c_str());
+}
+
+///
+/// \brief TEST (ListModeTest, Stream) Streamed runs are written sequentially and read back run by run.
+///
+TEST (ListModeTest, Stream)
+{
+    const std::string path = "listmode_stream.lm";
+    int file = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(file, 0);
+    const int nRecords[2] = {100, 3};
+    for(int run=0; run<2; run++)
+    {
+        ListModeHeader header = MakeListModeHeader();
+        header.run = run;
+        ListModeWriter writer(file, header, 1);
+        EXPECT_TRUE(writer.IsStream());
+        for(int ii=0; ii<nRecords[run]; ii++)
+        {
+            ListModeRecord record = {};
+            record.eventId = ii;
+            writer.Add(record);
+        }
+        writer.Close();
+    }
+    close(file);
+    EXPECT_THROW(ListModeReader reader(path), std::string); //streamed runs cannot be mapped
+
+    ListModeStreamReader reader(path, 100); //buffer smaller than the header
+    for(int run=0; run<2; run++)
+    {
+        ASSERT_TRUE(reader.NextRun());
+        EXPECT_EQ(reader.GetHeader().run, run);
+        EXPECT_EQ(reader.GetHeader().numberOfRecords, ListModeHeader::kStreamedRecords);
+        ListModeRecord record;
+        uint64_t read = 0;
+        while(reader.Next(record))
+            EXPECT_EQ(record.eventId, read++);
+        EXPECT_EQ(read, (uint64_t)nRecords[run]);
+        EXPECT_EQ(reader.GetNumberOfRecords(), (uint64_t)nRecords[run]);
+    }
+    EXPECT_FALSE(reader.NextRun());
+    std::remove(path.c_str());
+}
+
+///
+/// \brief TEST (ListModeTest, StreamReaderOfFile) Regular list-mode files can be read sequentially as well.
+///
+TEST (ListModeTest, StreamReaderOfFile)
+{
+    const std::string path = "listmode_sequential.lm";
+    {
+        ListModeWriter writer(path, MakeListModeHeader());
+        for(int ii=0; ii<10; ii++)
+        {
+            ListModeRecord record = {};
+            record.eventId = ii;
+            writer.Add(record);
+        }
+    }
+    ListModeStreamReader reader(path);
+    ASSERT_TRUE(reader.NextRun());
+    EXPECT_EQ(reader.GetHeader().numberOfRecords, 10u);
+    ListModeRecord record;
+    int read = 0;
+    while(reader.Next(record))
+        read++;
+    EXPECT_EQ(read, 10);
+    EXPECT_FALSE(reader.NextRun());
+    std::remove(path.c_str());
+}
@@ -0,0 +1,148 @@
+/// @file materials_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check definitions of materials and tables of their attenuation coefficients.
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+#include "gtest/gtest.h"
+#include "../../src/materials.h"
+
+///
+/// \brief TEST (MaterialsTest, Water) Coefficients of water are close to the reference and add up to the total.
+///
+TEST (MaterialsTest, Water)
+{
+    MaterialTable table;
+    table.Compute();
+    int water = table.GetIndex("water");
+    ASSERT_EQ(water, 0);
+    EXPECT_EQ(table.GetIndex("unobtainium"), -1);
+    EXPECT_NEAR(table.GetAttenuation(water, 0.511), 0.0096, 0.0003); //NIST XCOM: 0.00959 1/mm
+    EXPECT_NEAR(table.GetAttenuation(water, 0.511, COMPTON)/table.GetAttenuation(water, 0.511), 1.0, 0.01);
+    const double energies[3] = {0.02, 0.1, 0.511};
+    for(int ii=0; ii<3; ii++)
+    {
+        double mu[MaterialTable::kColumns];
+        table.GetAttenuations(water, energies[ii], mu);
+        EXPECT_NEAR(mu[PHOTOELECTRIC]+mu[COMPTON]+mu[RAYLEIGH], mu[TOTAL_ATTENUATION], 1e-3*mu[TOTAL_ATTENUATION]);
+        EXPECT_DOUBLE_EQ(mu[TOTAL_ATTENUATION], table.GetAttenuation(water, energies[ii]));
+    }
+    //photoelectric effect dominates at low energies
+    EXPECT_GT(table.GetAttenuation(water, 0.01, PHOTOELECTRIC), table.GetAttenuation(water, 0.01, COMPTON));
+}
+
+///
+/// \brief TEST (MaterialsTest, Interpolation) Interpolated Compton coefficients decrease monotonically between points of the grid.
+///
+TEST (MaterialsTest, Interpolation)
+{
+    MaterialTable table;
+    table.Compute();
+    for(int point=100; point<MaterialTable::kGridPoints-1; point+=50)
+    {
+        double E = MaterialTable::GetGridEnergy(point);
+        double mu = table.GetAttenuation(0, E, COMPTON);
+        double next = table.GetAttenuation(0, MaterialTable::GetGridEnergy(point+1), COMPTON);
+        double middle = table.GetAttenuation(0, std::sqrt(E*MaterialTable::GetGridEnergy(point+1)), COMPTON);
+        EXPECT_GE(mu, middle);
+        EXPECT_GE(middle, next);
+    }
+    EXPECT_NEAR(MaterialTable::GetGridEnergy(0), 0.001, 1e-12);
+    EXPECT_NEAR(MaterialTable::GetGridEnergy(MaterialTable::kGridPoints-1), 10.0, 1e-9);
+}
+
+///
+/// \brief TEST (MaterialsTest, Definitions) Materials are read from a file, invalid definitions are rejected.
+///
+TEST (MaterialsTest, Definitions)
+{
+    const std::string path = "materials_test.mat";
+    std::ofstream file(path.c_str());
+    file<<"# name density Z:fraction\nbone 1.92 1:0.034 6:0.155 8:0.435 20:0.225 # rounded\nlead 11.35 82:1\n";
+    file.close();
+    MaterialTable table(path);
+    table.Compute();
+    ASSERT_EQ(table.GetNumberOfMaterials(), 3);
+    int lead = table.GetIndex("lead");
+    ASSERT_GE(lead, 0);
+    double sum = 0.0;
+    for(unsigned ii=0; ii<table.GetMaterial(table.GetIndex("bone")).elements.size(); ii++)
+        sum += table.GetMaterial(table.GetIndex("bone")).elements[ii].second;
+    EXPECT_NEAR(sum, 1.0, 1e-12); //fractions are normalized
+    EXPECT_GT(table.GetAttenuation(lead, 0.511), 10.0*table.GetAttenuation(0, 0.511));
+
+    const char* invalid[3] = {"bone -1 1:1\n", "bone 1.0 1-1\n", "bone 1.0\n"};
+    for(int ii=0; ii<3; ii++)
+    {
+        file.open(path.c_str());
+        file<<invalid[ii];
+        file.close();
+        EXPECT_THROW(MaterialTable table(path), std::string);
+    }
+    EXPECT_THROW(MaterialTable table("materials_missing.mat"), std::string);
+    std::remove(path.c_str());
+}
+
+///
+/// \brief TEST (MaterialsTest, Table) Coefficients of a material can be read from a table exported from XCOM.
+///
+TEST (MaterialsTest, Table)
+{
+    const std::string path = "materials_table.mat";
+    const std::string xcom = "materials_table.txt";
+    std::ofstream file(xcom.c_str());
+    file<<"Photon Coherent Incoher. Photoel. Total\nEnergy Scatter. Scatter. Absorb. w/ Coherent\n(MeV) (cm2/g) (cm2/g) (cm2/g) (cm2/g)\n";
+    file<<"1.000E-01 1.0E-02 1.6E-01 2.0E-03 1.7E-01\n1.000E+00 1.0E-04 7.0E-02 1.0E-06 7.0E-02\n";
+    file.close();
+    file.open(path.c_str());
+    file<<"custom 2.0 table:"<<xcom<<"\n";
+    file.close();
+    MaterialTable table(path);
+    table.Compute();
+    int custom = table.GetIndex("custom");
+    ASSERT_GE(custom, 0);
+    EXPECT_NEAR(table.GetAttenuation(custom, 0.1, COMPTON), 0.2*0.16, 1e-3*0.2*0.16);
+    EXPECT_NEAR(table.GetAttenuation(custom, 1.0, RAYLEIGH), 0.2*1e-4, 1e-3*0.2*1e-4);
+    //log-log interpolation between the tabulated energies
+    EXPECT_NEAR(table.GetAttenuation(custom, std::sqrt(0.1), COMPTON), 0.2*std::sqrt(0.16*0.07), 1e-3*0.2*0.106);
+    std::string key = table.GetKey();
+    file.open(xcom.c_str(), std::ios::app);
+    file<<"1.000E+01 1.0E-06 2.0E-02 1.0E-08 2.0E-02\n";
+    file.close();
+    EXPECT_NE(MaterialTable(path).GetKey(), key); //contents of tables are a part of the key
+    std::remove(path.c_str());
+    std::remove(xcom.c_str());
+}
+
+///
+/// \brief TEST (MaterialsTest, Cache) Computed tables are saved to the cache and loaded back unchanged.
+///
+TEST (MaterialsTest, Cache)
+{
+    const std::string cacheDir = "materials_cache/";
+    mkdir(cacheDir.c_str(), 0755);
+    MaterialTable computed;
+    computed.Compute();
+    ASSERT_TRUE(computed.Save(cacheDir));
+    MaterialTable loaded;
+    EXPECT_FALSE(loaded.IsComputed());
+    ASSERT_TRUE(loaded.Load(cacheDir));
+    EXPECT_TRUE(loaded.IsComputed());
+    for(int point=0; point<MaterialTable::kGridPoints; point+=40)
+    {
+        double E = MaterialTable::GetGridEnergy(point);
+        EXPECT_DOUBLE_EQ(loaded.GetAttenuation(0, E), computed.GetAttenuation(0, E));
+    }
+    Material lead;
+    lead.name = "lead";
+    lead.density = 11.35;
+    lead.elements.push_back(std::make_pair(82, 1.0));
+    loaded.AddMaterial(lead);
+    EXPECT_FALSE(loaded.Load(cacheDir)); //different key
+    std::remove((cacheDir+computed.GetCacheFileName()).c_str());
+    rmdir(cacheDir.c_str());
+}
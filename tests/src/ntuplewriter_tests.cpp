@@ -0,0 +1,62 @@
+/// @file ntuplewriter_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check writing of events to an RNTuple.
+#include <cstdio>
+#include "gtest/gtest.h"
+#include "TFile.h"
+#include "../../src/ntuplewriter.h"
+#if ROOT_VERSION_CODE >= NTUPLE_MIN_ROOT_VERSION
+#include <ROOT/RNTupleReader.hxx>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,36,0)
+using ROOT::RNTupleReader;
+#else
+using ROOT::Experimental::RNTupleReader;
+#endif
+#endif
+
+///
+/// \brief TEST (NTupleWriterTest, RoundTrip) Per-photon fields have nPhotons elements and keep their values.
+///
+TEST (NTupleWriterTest, RoundTrip)
+{
+    const std::string path = "ntuplewriter_test.root";
+    TFile file(path.c_str(), "recreate");
+    if(!NTupleWriter::IsAvailable())
+    {
+        EXPECT_THROW(NTupleWriter writer(&file, "events"), std::string);
+        file.Close();
+        std::remove(path.c_str());
+        return;
+    }
+    FlatEvent flat = FlatEvent();
+    {
+        NTupleWriter writer(&file, "events");
+        for(int ii=0; ii<10; ii++)
+        {
+            flat.id = ii;
+            flat.nPhotons = 1+ii%3;
+            for(int jj=0; jj<flat.nPhotons; jj++)
+                flat.E[jj] = ii+0.5*jj;
+            writer.Fill(flat);
+        }
+        EXPECT_EQ(writer.GetEntries(), 10);
+    }
+    file.Close();
+#if ROOT_VERSION_CODE >= NTUPLE_MIN_ROOT_VERSION
+    auto reader = RNTupleReader::Open("events", path);
+    ASSERT_EQ(reader->GetNEntries(), 10u);
+    auto id = reader->GetView<std::int64_t>("id");
+    auto energies = reader->GetView<std::vector<float>>("E");
+    for(int ii=0; ii<10; ii++)
+    {
+        EXPECT_EQ(id(ii), ii);
+        ASSERT_EQ(energies(ii).size(), 1u+ii%3);
+        for(unsigned jj=0; jj<energies(ii).size(); jj++)
+            EXPECT_FLOAT_EQ(energies(ii)[jj], ii+0.5*jj);
+    }
+#endif
+    std::remove(path.c_str());
+}
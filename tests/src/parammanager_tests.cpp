@@ -0,0 +1,129 @@
+/// @file parammanager_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check copying of parameters and parameter sweeps.
+#include <cstdio>
+#include <fstream>
+#include "gtest/gtest.h"
+#include "../../src/parammanager.h"
+
+///
+/// \brief TEST (ParamManagerTest, Copy) Copies are equal to the original.
+///
+TEST (ParamManagerTest, Copy)
+{
+    ParamManager pManag;
+    pManag.SetR(123.0);
+    pManag.SetP(0.5);
+    pManag.SetPhantomNaive511Prob(0.25);
+    ParamManager copy(pManag);
+    EXPECT_FLOAT_EQ(copy.GetR(), 123.0);
+    EXPECT_TRUE(copy==pManag);
+    ParamManager assigned;
+    assigned = pManag;
+    EXPECT_FLOAT_EQ(assigned.GetR(), 123.0);
+    EXPECT_TRUE(assigned==pManag);
+    assigned.SetPhantomNaive511Prob(0.5);
+    EXPECT_FALSE(assigned==pManag);
+}
+
+///
+/// \brief TEST (ParamManagerTest, ParseSweepValues) Numbers, lists and ranges are expanded.
+///
+TEST (ParamManagerTest, ParseSweepValues)
+{
+    std::vector<double> values = ParamManager::ParseSweepValues({"400:500:10"});
+    ASSERT_EQ(values.size(), 11u);
+    EXPECT_DOUBLE_EQ(values[0], 400.0);
+    EXPECT_DOUBLE_EQ(values[10], 500.0);
+    values = ParamManager::ParseSweepValues({"0.1:0.3:0.1"}); //the end is included despite rounding
+    ASSERT_EQ(values.size(), 3u);
+    EXPECT_DOUBLE_EQ(values[2], 0.1+2*0.1);
+    values = ParamManager::ParseSweepValues({"0.2,0.3", "0.5"});
+    ASSERT_EQ(values.size(), 3u);
+    EXPECT_DOUBLE_EQ(values[2], 0.5);
+    EXPECT_EQ(ParamManager::ParseSweepValues({"437.3"}).size(), 1u);
+    EXPECT_THROW(ParamManager::ParseSweepValues({"500:400:10"}), std::string);
+    EXPECT_THROW(ParamManager::ParseSweepValues({"400:500:0"}), std::string);
+    EXPECT_THROW(ParamManager::ParseSweepValues({"400:500"}), std::string);
+    EXPECT_THROW(ParamManager::ParseSweepValues({"abc"}), std::string);
+}
+
+///
+/// \brief TEST (ParamManagerTest, SweepGrid) Grid points contain all combinations of scanned values.
+///
+TEST (ParamManagerTest, SweepGrid)
+{
+    const std::string path = "parammanager_sweep.par";
+    std::ofstream file(path.c_str());
+    file<<"silent := 1\nR := 400:500:50 #radius\nL := 500\neff := 0.2,0.4\n0 0 0 0 0 0 1\n";
+    file.close();
+    ParamManager pManag;
+    pManag.ImportParams(path);
+    std::remove(path.c_str());
+    ASSERT_TRUE(pManag.IsSweep());
+    ASSERT_EQ(pManag.GetSweepAxes().size(), 2u);
+    EXPECT_EQ(pManag.GetNumberOfSweepPoints(), 6);
+    EXPECT_FLOAT_EQ(pManag.GetR(), 400.0); //the first values are used outside the sweep
+    EXPECT_FLOAT_EQ(pManag.GetEff(), 0.2);
+    ParamManager point = pManag.GetSweepPoint(3);
+    EXPECT_FALSE(point.IsSweep());
+    EXPECT_FLOAT_EQ(point.GetR(), 450.0);
+    EXPECT_FLOAT_EQ(point.GetEff(), 0.4);
+    EXPECT_FLOAT_EQ(point.GetL(), 500.0);
+    EXPECT_EQ(point.GetSimRuns(), 1);
+    EXPECT_THROW(pManag.GetSweepPoint(6), std::string);
+    pManag.SetSweepAxis("R", {437.3});
+    EXPECT_EQ(pManag.GetNumberOfSweepPoints(), 2);
+    EXPECT_THROW(pManag.SetSweepAxis("events", {1, 2}), std::string);
+}
+
+///
+/// \brief TEST (ParamManagerTest, ReweightEfficiencies) Efficiencies outside [0, 1] disable reweighting.
+///
+TEST (ParamManagerTest, ReweightEfficiencies)
+{
+    const std::string path = "parammanager_reweight.par";
+    std::ofstream file(path.c_str());
+    file<<"silent := 1\nreweightEff := 0.1:0.3:0.1 0.9 #comment\n0 0 0 0 0 0 1\n";
+    file.close();
+    ParamManager pManag;
+    pManag.ImportParams(path);
+    ASSERT_TRUE(pManag.IsEffReweighting());
+    ASSERT_EQ(pManag.GetReweightEfficiencies().size(), 4u);
+    EXPECT_DOUBLE_EQ(pManag.GetReweightEfficiencies()[2], 0.3);
+    EXPECT_DOUBLE_EQ(pManag.GetReweightEfficiencies()[3], 0.9);
+    ParamManager withoutReweighting(pManag);
+    withoutReweighting.SetReweightEfficiencies(std::vector<double>());
+    EXPECT_NE(pManag.GetRunKey(0), withoutReweighting.GetRunKey(0));
+    file.open(path.c_str());
+    file<<"silent := 1\nreweightEff := 0.5,1.5\n0 0 0 0 0 0 1\n";
+    file.close();
+    pManag.ImportParams(path);
+    std::remove(path.c_str());
+    EXPECT_FALSE(pManag.IsEffReweighting());
+}
+
+///
+/// \brief TEST (ParamManagerTest, Barrels) Pairs R,L are parsed and invalid ones are skipped.
+///
+TEST (ParamManagerTest, Barrels)
+{
+    const std::string path = "parammanager_barrels.par";
+    std::ofstream file(path.c_str());
+    file<<"silent := 1\nbarrels := 400,500 450.5,600 300 -1,2 #comment\n0 0 0 0 0 0 1\n";
+    file.close();
+    ParamManager pManag;
+    pManag.ImportParams(path);
+    std::remove(path.c_str());
+    ASSERT_EQ(pManag.GetBarrels().size(), 2u);
+    EXPECT_DOUBLE_EQ(pManag.GetBarrels()[1].first, 450.5);
+    EXPECT_DOUBLE_EQ(pManag.GetBarrels()[1].second, 600.0);
+    ParamManager copy(pManag);
+    EXPECT_TRUE(copy==pManag);
+    copy.SetBarrels(std::vector<std::pair<double, double> >());
+    EXPECT_FALSE(copy==pManag);
+    EXPECT_NE(copy.GetRunKey(0), pManag.GetRunKey(0));
+}
@@ -0,0 +1,155 @@
+/// @file phantom_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check the geometric phantom: chords of rays, sampling of interactions and transport of photons.
+/// Some of the tests can fail due to statistical reasons, but not more often than 1 per 100 test runs.
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "gtest/gtest.h"
+#include "../../src/phantom.h"
+#include "../../src/event.h"
+
+///
+/// \brief TEST (PhantomTest, Intersect) Chords of rays through all shapes are calculated in closed form.
+///
+TEST (PhantomTest, Intersect)
+{
+    double tIn = 0, tOut = 0;
+    const double origin[3] = {0.0, 0.0, 0.0};
+    const double outside[3] = {-300.0, 0.0, 0.0};
+    const double aside[3] = {200.0, 0.0, 0.0};
+    const double x[3] = {1.0, 0.0, 0.0};
+    const double y[3] = {0.0, 1.0, 0.0};
+    const double z[3] = {0.0, 0.0, 1.0};
+
+    Phantom cylinder(Cylinder, 100, 100, 150);
+    ASSERT_TRUE(cylinder.Intersect(origin, x, tIn, tOut));
+    EXPECT_DOUBLE_EQ(tIn, -100.0);
+    EXPECT_DOUBLE_EQ(tOut, 100.0);
+    ASSERT_TRUE(cylinder.Intersect(outside, x, tIn, tOut));
+    EXPECT_DOUBLE_EQ(tIn, 200.0);
+    EXPECT_DOUBLE_EQ(tOut, 400.0);
+    ASSERT_TRUE(cylinder.Intersect(origin, z, tIn, tOut));
+    EXPECT_DOUBLE_EQ(tOut, 150.0);
+    EXPECT_FALSE(cylinder.Intersect(aside, z, tIn, tOut));
+    EXPECT_FALSE(cylinder.Intersect(aside, x, tIn, tOut)); //phantom is behind the point
+
+    Phantom ellipsoid(Elipsoid, 100, 50, 30);
+    ASSERT_TRUE(ellipsoid.Intersect(origin, y, tIn, tOut));
+    EXPECT_DOUBLE_EQ(tOut, 50.0);
+    ASSERT_TRUE(ellipsoid.Intersect(origin, z, tIn, tOut));
+    EXPECT_DOUBLE_EQ(tOut, 30.0);
+
+    Phantom box(Box, 10, 20, 30);
+    const double corner[3] = {-50.0, 5.0, 5.0};
+    ASSERT_TRUE(box.Intersect(corner, x, tIn, tOut));
+    EXPECT_DOUBLE_EQ(tIn, 40.0);
+    EXPECT_DOUBLE_EQ(tOut, 60.0);
+    EXPECT_FALSE(box.Intersect(aside, y, tIn, tOut));
+}
+
+///
+/// \brief TEST (PhantomTest, Interact) Photons are absorbed, Compton- and Rayleigh-scattered according to attenuation coefficients.
+///
+TEST (PhantomTest, Interact)
+{
+    double mu[MaterialTable::kColumns] = {0.0, 1.0, 0.0, 1.0}; //Compton scattering only
+    double E = 0.511;
+    double dir[3] = {0.0, 0.0, 1.0};
+    EXPECT_TRUE(Phantom::Interact(mu, E, dir));
+    EXPECT_LT(E, 0.511);
+    EXPECT_NEAR(dir[0]*dir[0]+dir[1]*dir[1]+dir[2]*dir[2], 1.0, 1e-12);
+    mu[COMPTON] = 0.0;
+    mu[RAYLEIGH] = 1.0; //energy is not changed
+    E = 0.511;
+    EXPECT_TRUE(Phantom::Interact(mu, E, dir));
+    EXPECT_DOUBLE_EQ(E, 0.511);
+    mu[RAYLEIGH] = 0.0;
+    mu[PHOTOELECTRIC] = 1.0;
+    EXPECT_FALSE(Phantom::Interact(mu, E, dir));
+}
+
+///
+/// \brief TEST (PhantomTest, Scatter) Fraction of photons leaving the phantom without interactions follows the attenuation law
+/// and photons which miss the phantom are not altered.
+///
+TEST (PhantomTest, Scatter)
+{
+    const double E = 0.511;
+    const double R = 100.0;
+    const int nEvents = 20000;
+    Phantom phantom(Cylinder, R, R, 150);
+    TLorentzVector source(0.0, 0.0, 0.0, 0.0);
+    TLorentzVector momentum(E/1000, 0.0, 0.0, E/1000); //Event expects GeV
+    std::vector<TLorentzVector*> sourcePar = {&source};
+    std::vector<TLorentzVector*> fourMomenta = {&momentum};
+    int primary = 0;
+    for(int ii=0; ii<nEvents; ii++)
+    {
+        Event event(&sourcePar, &fourMomenta, 1.0, ONE);
+        phantom.Scatter(&event);
+        if(event.GetPrimaryPhoton(0))
+        {
+            primary++;
+            EXPECT_DOUBLE_EQ(event.GetFourMomentumOf(0)->E(), E);
+        }
+        else
+        {
+            EXPECT_LE(event.GetFourMomentumOf(0)->E(), E); //Rayleigh scattering does not change the energy
+            EXPECT_NEAR(event.GetFourMomentumOf(0)->P(), event.GetFourMomentumOf(0)->E(), 1e-9);
+            EXPECT_LE(event.GetEmissionPointOf(0)->Perp(), R+1e-6); //scattered or absorbed inside the phantom
+        }
+    }
+    const MaterialTable* materials = phantom.GetMaterials();
+    double mu = materials->GetAttenuation(materials->GetIndex("water"), E);
+    EXPECT_NEAR(primary/static_cast<double>(nEvents), std::exp(-mu*R), 0.015);
+
+    TLorentzVector away(500.0, 0.0, 0.0, 0.0);
+    std::vector<TLorentzVector*> awayPar = {&away};
+    Event missed(&awayPar, &fourMomenta, 1.0, ONE);
+    phantom.Scatter(&missed);
+    EXPECT_TRUE(missed.GetPrimaryPhoton(0));
+    EXPECT_DOUBLE_EQ(missed.GetEmissionPointOf(0)->X(), 500.0);
+    EXPECT_DOUBLE_EQ(missed.GetFourMomentumOf(0)->E(), E);
+}
+
+///
+/// \brief TEST (PhantomTest, FlightTime) Photons scattered inside the phantom start later by the time of flight along the path
+/// travelled in it, which is included in their hit times.
+///
+TEST (PhantomTest, FlightTime)
+{
+    const double E = 0.511;
+    const double R = 100.0;
+    Phantom phantom(Cylinder, R, R, 150);
+    TLorentzVector source(0.0, 0.0, 0.0, 0.0);
+    TLorentzVector momentum(E/1000, 0.0, 0.0, E/1000); //Event expects GeV
+    std::vector<TLorentzVector*> sourcePar = {&source};
+    std::vector<TLorentzVector*> fourMomenta = {&momentum};
+    int scattered = 0;
+    for(int ii=0; ii<2000; ii++)
+    {
+        Event event(&sourcePar, &fourMomenta, 1.0, ONE);
+        phantom.Scatter(&event);
+        const TLorentzVector* start = event.GetEmissionPointOf(0);
+        if(event.GetPrimaryPhoton(0))
+        {
+            EXPECT_DOUBLE_EQ(start->T(), 0.0);
+            continue;
+        }
+        //the path is not shorter than the distance from the source
+        EXPECT_GE(start->T(), Phantom::FlightTime(start->Vect().Mag())-1e-12);
+        event.CalculateHitPoints(437.3, 10000.0);
+        if(!event.HasHit(0))
+            continue;
+        scattered++;
+        const TLorentzVector* hit = event.GetHitPointOf(0);
+        EXPECT_NEAR(hit->T(), start->T()+Phantom::FlightTime((hit->Vect()-start->Vect()).Mag()), 1e-9);
+        EXPECT_GT(hit->T(), Phantom::FlightTime(hit->Vect().Mag()));
+    }
+    EXPECT_GT(scattered, 0);
+    EXPECT_NEAR(Phantom::FlightTime(299.792458), 1.0, 1e-12); //light travels 30 cm in 1 ns
+}
@@ -0,0 +1,88 @@
+/// @file resultcache_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check keys of cached runs and storing and restoring of their results.
+#include <cstdio>
+#include <fstream>
+#include "gtest/gtest.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TTree.h"
+#include "../../src/resultcache.h"
+
+///
+/// \brief TEST (ResultCacheTest, Keys) Keys and seeds of runs depend only on their own parameters.
+///
+TEST (ResultCacheTest, Keys)
+{
+    const std::string path = "resultcache_test.par";
+    std::ofstream file(path.c_str());
+    file<<"silent := 1\nseed := 7\n0 0 0 0 0 0 1\n10 0 0 0 0 0 1\n";
+    file.close();
+    ParamManager pManag;
+    pManag.ImportParams(path);
+    std::remove(path.c_str());
+    std::string first = ResultCache::GetKey(pManag, 0);
+    EXPECT_EQ(first, ResultCache::GetKey(pManag, 0));
+    EXPECT_NE(first, ResultCache::GetKey(pManag, 1));
+    EXPECT_NE(ResultCache::GetRunSeed(pManag, 0), ResultCache::GetRunSeed(pManag, 1));
+    EXPECT_NE(ResultCache::GetRunSeed(pManag, 0), 0u);
+    ParamManager changed(pManag);
+    changed.SetR(400.0);
+    EXPECT_NE(first, ResultCache::GetKey(changed, 0));
+    changed = pManag;
+    changed.SetThreads(3); //does not change results
+    EXPECT_EQ(first, ResultCache::GetKey(changed, 0));
+    //tables of materials are a part of the key only if the phantom is used
+    MaterialTable materials;
+    EXPECT_EQ(first, ResultCache::GetKey(changed, 0, &materials));
+    changed.SetUseOfPhantom(true);
+    EXPECT_NE(ResultCache::GetKey(changed, 0), ResultCache::GetKey(changed, 0, &materials));
+}
+
+///
+/// \brief TEST (ResultCacheTest, StoreAndRestore) Directories with trees and histograms are restored after Commit only.
+///
+TEST (ResultCacheTest, StoreAndRestore)
+{
+    ResultCache cache("resultcache_test_dir/");
+    const std::string key = "run key";
+    EXPECT_FALSE(cache.Contains(key));
+    TFile output("resultcache_test_output.root", "recreate");
+    TDirectory* runDir = output.mkdir("run");
+    TDirectory* histDir = runDir->mkdir("Histograms");
+    histDir->cd();
+    TH1F hist("hist", "hist", 10, 0, 10);
+    hist.Fill(3.0);
+    hist.Write();
+    runDir->cd();
+    Int_t value = 0;
+    TTree* tree = new TTree("tree", "tree");
+    tree->Branch("value", &value, "value/I");
+    for(value=0; value<5; value++)
+        tree->Fill();
+    tree->Write();
+    delete tree;
+    cache.Store(key, runDir, "");
+    EXPECT_FALSE(cache.Contains(key)); //not committed yet
+    cache.Commit(key);
+    EXPECT_TRUE(cache.Contains(key));
+    EXPECT_FALSE(cache.Contains(key+" "));
+
+    TDirectory* restored = output.mkdir("restored");
+    cache.Restore(key, restored, "");
+    TTree* restoredTree = nullptr;
+    restored->GetObject("tree", restoredTree);
+    ASSERT_NE(restoredTree, nullptr);
+    EXPECT_EQ(restoredTree->GetEntries(), 5);
+    TH1F* restoredHist = nullptr;
+    restored->GetObject("Histograms/hist", restoredHist);
+    ASSERT_NE(restoredHist, nullptr);
+    EXPECT_DOUBLE_EQ(restoredHist->GetBinContent(restoredHist->FindBin(3.0)), 1.0);
+    output.Close();
+    std::remove("resultcache_test_output.root");
+    std::remove((cache.GetEntryDir(key)+"key.txt").c_str());
+    std::remove((cache.GetEntryDir(key)+"run.root").c_str());
+}
@@ -0,0 +1,58 @@
+/// @file sinogram_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check projection of LORs and accumulation of sinograms.
+#include <memory>
+#include "gtest/gtest.h"
+#include "TMath.h"
+#include "../../src/sinogram.h"
+
+///
+/// \brief TEST (SinogramTest, ProjectLOR) Radial offsets and angles of simple lines.
+///
+TEST (SinogramTest, ProjectLOR)
+{
+    double s = 0.0;
+    double phi = 0.0;
+    Sinogram::ProjectLOR(-5.0, 10.0, 5.0, 10.0, s, phi); //horizontal line y=10
+    EXPECT_NEAR(phi, TMath::Pi()/2, 1e-9);
+    EXPECT_NEAR(s, 10.0, 1e-9);
+    Sinogram::ProjectLOR(5.0, 10.0, -5.0, 10.0, s, phi); //order of points does not matter
+    EXPECT_NEAR(phi, TMath::Pi()/2, 1e-9);
+    EXPECT_NEAR(s, 10.0, 1e-9);
+    Sinogram::ProjectLOR(3.0, -5.0, 3.0, 5.0, s, phi); //vertical line x=3
+    EXPECT_NEAR(phi, 0.0, 1e-9);
+    EXPECT_NEAR(s, 3.0, 1e-9);
+    Sinogram::ProjectLOR(-1.0, -1.0, 1.0, 1.0, s, phi); //diagonal through the centre
+    EXPECT_GE(phi, 0.0);
+    EXPECT_LT(phi, TMath::Pi());
+    EXPECT_NEAR(s, 0.0, 1e-9);
+}
+
+///
+/// \brief TEST (SinogramTest, Add) Only events with both photons detected are accumulated.
+///
+TEST (SinogramTest, Add)
+{
+    EXPECT_TRUE(Sinogram::IsSupported(TWO));
+    EXPECT_FALSE(Sinogram::IsSupported(THREE));
+    Sinogram sinogram(TWO, 10, 8, 5, 100.0, 500.0);
+    TLorentzVector source(0.0, 0.0, 0.0, 0.0);
+    double E = 0.511/1000; //Event expects GeV
+    TLorentzVector first(E, 0.0, 0.0, E);
+    TLorentzVector second(-E, 0.0, 0.0, E);
+    std::vector<TLorentzVector*> sourcePar = {&source, &source};
+    std::vector<TLorentzVector*> fourMomenta = {&first, &second};
+    std::unique_ptr<Event> event(new Event(&sourcePar, &fourMomenta, 1.0, TWO));
+    EXPECT_FALSE(sinogram.Add(event.get())); //hit points were not calculated
+    event->CalculateHitPoints(437.3, 500);
+    ASSERT_TRUE(sinogram.Add(event.get()));
+    EXPECT_EQ(sinogram.GetAcceptedLORs(), 1);
+    const TH3F* histogram = sinogram.GetHistogram();
+    EXPECT_DOUBLE_EQ(histogram->GetBinContent(histogram->FindFixBin(0.0, TMath::Pi()/2, 0.0)), 1.0);
+    event->SetCutPassing(1, false);
+    EXPECT_FALSE(sinogram.Add(event.get()));
+    EXPECT_EQ(sinogram.GetAcceptedLORs(), 1);
+}
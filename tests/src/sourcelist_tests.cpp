@@ -0,0 +1,85 @@
+/// @file sourcelist_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check reading of text and binary lists of sources.
+#include <cstdio>
+#include <fstream>
+#include "gtest/gtest.h"
+#include "../../src/sourcelist.h"
+
+///
+/// \brief TEST (SourceListTest, Text) Comments, CSV headers and missing values are handled, sources are read one by one.
+///
+TEST (SourceListTest, Text)
+{
+    const std::string path = "sourcelist_test.csv";
+    std::ofstream file(path.c_str());
+    file<<"x,y,z,px,py,pz,r\n# comment\n\n1,2,3\n4 5 6 7 8 9 10 #comment\r\n-1.5e1,0,0,0,0,0,2\n";
+    file.close();
+    SourceList list(path);
+    EXPECT_FALSE(list.IsBinary());
+    EXPECT_EQ(list.GetNumberOfSources(), -1);
+    std::vector<double> source;
+    ASSERT_TRUE(list.Next(source));
+    ASSERT_EQ(source.size(), (size_t)SourceList::kValues);
+    EXPECT_DOUBLE_EQ(source[2], 3.0);
+    EXPECT_DOUBLE_EQ(source[6], 0.0); //missing values are 0
+    ASSERT_TRUE(list.Next(source));
+    EXPECT_DOUBLE_EQ(source[6], 10.0);
+    ASSERT_TRUE(list.Next(source));
+    EXPECT_DOUBLE_EQ(source[0], -15.0);
+    EXPECT_FALSE(list.Next(source));
+    EXPECT_EQ(list.GetNumberOfRead(), 3);
+    list.Rewind();
+    ASSERT_TRUE(list.Next(source));
+    EXPECT_DOUBLE_EQ(source[0], 1.0);
+    std::remove(path.c_str());
+}
+
+///
+/// \brief TEST (SourceListTest, Binary) Text lists converted to the binary format give the same sources.
+///
+TEST (SourceListTest, Binary)
+{
+    const std::string textPath = "sourcelist_test.txt";
+    const std::string binaryPath = "sourcelist_test.src";
+    std::ofstream file(textPath.c_str());
+    for(int ii=0; ii<1000; ii++)
+        file<<ii<<" "<<-ii<<" "<<0.5*ii<<" 0 0 0 1\n";
+    file.close();
+    EXPECT_EQ(ConvertSourceList(textPath, binaryPath), 1000);
+    SourceList text(textPath);
+    SourceList binary(binaryPath);
+    EXPECT_TRUE(binary.IsBinary());
+    EXPECT_EQ(binary.GetNumberOfSources(), 1000);
+    std::vector<double> fromText, fromBinary;
+    while(text.Next(fromText))
+    {
+        ASSERT_TRUE(binary.Next(fromBinary));
+        EXPECT_EQ(fromText, fromBinary);
+    }
+    EXPECT_FALSE(binary.Next(fromBinary));
+    std::remove(textPath.c_str());
+    std::remove(binaryPath.c_str());
+}
+
+///
+/// \brief TEST (SourceListTest, Invalid) Invalid lines and missing files are reported.
+///
+TEST (SourceListTest, Invalid)
+{
+    EXPECT_THROW(SourceList list("sourcelist_missing.txt"), std::string);
+    const std::string path = "sourcelist_invalid.txt";
+    std::ofstream file(path.c_str());
+    file<<"1 2 3\n1 2 x\n1 2\n1 2 3 4 5 6 7 8\n";
+    file.close();
+    SourceList list(path);
+    std::vector<double> source;
+    EXPECT_TRUE(list.Next(source));
+    EXPECT_THROW(list.Next(source), std::string);
+    EXPECT_THROW(list.Next(source), std::string);
+    EXPECT_THROW(list.Next(source), std::string);
+    std::remove(path.c_str());
+}
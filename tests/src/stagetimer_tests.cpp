@@ -0,0 +1,76 @@
+/// @file stagetimer_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check timing of stages of the simulation and the timing report.
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include "gtest/gtest.h"
+#include "../../src/stagetimer.h"
+
+///
+/// \brief TEST (StageTimerTest, Lap) Elapsed time is charged to stages in the order of laps.
+///
+TEST (StageTimerTest, Lap)
+{
+    StageTimes times;
+    StageClock clock(times);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    clock.Lap(GENERATION_STAGE);
+    clock.Lap(CUTS_STAGE);
+    EXPECT_GE(times.seconds[GENERATION_STAGE], 0.02);
+    EXPECT_LT(times.seconds[CUTS_STAGE], times.seconds[GENERATION_STAGE]);
+    EXPECT_EQ(times.seconds[SETUP_STAGE], 0.0);
+    EXPECT_DOUBLE_EQ(times.GetTotal(), times.seconds[GENERATION_STAGE]+times.seconds[CUTS_STAGE]);
+    StageTimes sum;
+    sum.Add(times);
+    sum.Add(times);
+    EXPECT_DOUBLE_EQ(sum.seconds[GENERATION_STAGE], 2.0*times.seconds[GENERATION_STAGE]);
+    sum.Reset();
+    EXPECT_EQ(sum.GetTotal(), 0.0);
+}
+
+///
+/// \brief TEST (StageTimerTest, Threads) Every thread accumulates its own times.
+///
+TEST (StageTimerTest, Threads)
+{
+    ThreadStageTimes().Reset();
+    ThreadStageTimes().events = 5;
+    long long otherEvents = -1;
+    std::thread other([&otherEvents]()
+    {
+        ThreadStageTimes().events += 7;
+        otherEvents = ThreadStageTimes().events;
+    });
+    other.join();
+    EXPECT_EQ(otherEvents, 7);
+    EXPECT_EQ(ThreadStageTimes().events, 5);
+}
+
+///
+/// \brief TEST (StageTimerTest, Report) The report contains all stages and rates computed from the total time.
+///
+TEST (StageTimerTest, Report)
+{
+    StageTimes times;
+    times.seconds[GENERATION_STAGE] = 1.5;
+    times.seconds[DRAWING_STAGE] = 0.5;
+    times.events = 1000;
+    times.photons = 2000;
+    std::string json = times.ToJSON();
+    for(int ii=0; ii<NUMBER_OF_STAGES; ii++)
+        EXPECT_NE(json.find(std::string("\"")+StageTimes::GetStageName(static_cast<SimulationStage>(ii))+"\""), std::string::npos);
+    EXPECT_NE(json.find("\"eventsPerSecond\": 500"), std::string::npos);
+    EXPECT_NE(json.find("\"photonsPerSecond\": 1000"), std::string::npos);
+    EXPECT_NE(json.find("\"generation\": {\"seconds\": 1.5, \"fraction\": 0.75}"), std::string::npos);
+    const std::string path = "stagetimer_test.json";
+    ASSERT_TRUE(times.Save(path));
+    std::ifstream file(path.c_str());
+    std::string saved;
+    std::getline(file, saved);
+    EXPECT_EQ(saved, json);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,108 @@
+/// @file voxelphantom_tests.cpp
+/// @date 19.10.2026
+/// @version 1.0
+///
+/// @section DESCRIPTION
+/// The following tests check loading of voxelized phantoms and Woodcock tracking of photons through them.
+/// Some of the tests can fail due to statistical reasons, but not more often than 1 per 100 test runs.
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "gtest/gtest.h"
+#include "../../src/voxelphantom.h"
+#include "../../src/phantom.h"
+#include "../../src/event.h"
+
+///
+/// \brief writeSlabs Creates a volume of 10x10x10 voxels of 10 mm centred at the origin, in which voxels with x<0 have label 1
+/// and the others label 2, and a table assigning water of the given densities to both labels.
+///
+static void writeSlabs(const std::string& volume, const std::string& materials, double density1, double density2)
+{
+    const uint32_t size[3] = {10, 10, 10};
+    const double voxel[3] = {10.0, 10.0, 10.0};
+    const double origin[3] = {-50.0, -50.0, -50.0};
+    std::vector<uint8_t> labels(1000);
+    for(unsigned ii=0; ii<labels.size(); ii++)
+        labels[ii] = ii%10<5 ? 1 : 2;
+    WriteVoxelVolume(volume, size, voxel, origin, labels);
+    std::ofstream table(materials.c_str());
+    table<<"# label material density\n0 water 0.001\n1 water "<<density1<<"\n2 water "<<density2<<" #lung\n";
+}
+
+///
+/// \brief TEST (VoxelPhantomTest, Load) Labels are looked up in the mapped volume, invalid volumes are rejected.
+///
+TEST (VoxelPhantomTest, Load)
+{
+    const std::string volume = "voxel_test.vox";
+    const std::string materials = "voxel_test_materials.txt";
+    writeSlabs(volume, materials, 1.0, 0.25);
+    MaterialTable table;
+    table.Compute();
+    const int water = table.GetIndex("water");
+    {
+        VoxelPhantom phantom(volume, materials, table);
+        EXPECT_EQ(phantom.GetHeader().size[2], 10u);
+        const double left[3] = {-1.0, 20.0, -45.0};
+        const double right[3] = {1.0, 20.0, 45.0};
+        const double outside[3] = {51.0, 0.0, 0.0};
+        EXPECT_EQ(phantom.GetLabel(left), 1);
+        EXPECT_EQ(phantom.GetLabel(right), 2);
+        EXPECT_EQ(phantom.GetLabel(outside), -1);
+        EXPECT_EQ(phantom.GetMaterial(2), water);
+        EXPECT_DOUBLE_EQ(phantom.GetMajorant(0.511), table.GetAttenuation(water, 0.511)); //label 0 is not present
+        EXPECT_DOUBLE_EQ(phantom.GetAttenuationCoefficient(2, 0.511), 0.25*table.GetAttenuation(water, 0.511));
+    }
+    std::ofstream labels(materials.c_str());
+    labels<<"1 water 1.0\n";
+    labels.close();
+    EXPECT_THROW(VoxelPhantom phantom(volume, materials, table), std::string); //label 2 has no material
+    EXPECT_THROW(VoxelPhantom phantom(materials, materials, table), std::string); //not a volume
+    labels.open(materials.c_str());
+    labels<<"1 water 1.0\n2 bone\n";
+    labels.close();
+    EXPECT_THROW(VoxelPhantom phantom(volume, materials, table), std::string); //material is not defined
+    std::remove(volume.c_str());
+    std::remove(materials.c_str());
+}
+
+///
+/// \brief TEST (VoxelPhantomTest, Transmission) Fraction of photons crossing both materials without interactions follows
+/// the attenuation law, although flights are sampled with the majorant.
+///
+TEST (VoxelPhantomTest, Transmission)
+{
+    const std::string volume = "voxel_transmission.vox";
+    const std::string materials = "voxel_transmission_materials.txt";
+    writeSlabs(volume, materials, 1.0, 0.25);
+    MaterialTable table;
+    table.Compute();
+    VoxelPhantom phantom(volume, materials, table);
+    const double E = 0.511;
+    const int nEvents = 20000;
+    TLorentzVector source(-200.0, 5.0, 5.0, 0.0);
+    TLorentzVector momentum(E/1000, 0.0, 0.0, E/1000); //Event expects GeV
+    std::vector<TLorentzVector*> sourcePar = {&source};
+    std::vector<TLorentzVector*> fourMomenta = {&momentum};
+    int primary = 0;
+    for(int ii=0; ii<nEvents; ii++)
+    {
+        Event event(&sourcePar, &fourMomenta, 1.0, ONE);
+        phantom.Scatter(&event);
+        if(event.GetPrimaryPhoton(0))
+            primary++;
+        else
+        {
+            EXPECT_LE(event.GetFourMomentumOf(0)->E(), E);
+            //delayed by the flight from the source to the first collision at least
+            const TLorentzVector* start = event.GetEmissionPointOf(0);
+            EXPECT_GE(start->T(), Phantom::FlightTime(start->X()-source.X())-1e-12);
+        }
+    }
+    double expected = std::exp(-table.GetAttenuation(table.GetIndex("water"), E)*(50.0*1.0+50.0*0.25));
+    EXPECT_NEAR(primary/static_cast<double>(nEvents), expected, 0.015);
+    std::remove(volume.c_str());
+    std::remove(materials.c_str());
+}
@@ -0,0 +1,66 @@
+/// @file query.cpp
+/// @date 19.10.2026
+///
+/// @section DESCRIPTION
+/// Prints geometric acceptance interpolated from a cached acceptance map.
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "acceptancemap.h"
+
+int main(int argc, char* argv[])
+{
+    std::string cacheDir = "cache/";
+    int type = 2;
+    double R = 437.3;
+    double L = 500;
+    int grid[3] = {21, 21, 21};
+    int samples = 100000;
+    unsigned long seed = 0;
+    bool build = false;
+    std::vector<double> points;
+    for(int nn=1; nn<argc; nn++)
+    {
+        std::string arg(argv[nn]);
+        if(arg == "-c" && nn+1<argc) cacheDir = argv[++nn];
+        else if(arg == "-t" && nn+1<argc) type = atoi(argv[++nn]);
+        else if(arg == "-R" && nn+1<argc) R = atof(argv[++nn]);
+        else if(arg == "-L" && nn+1<argc) L = atof(argv[++nn]);
+        else if(arg == "-s" && nn+1<argc) samples = atoi(argv[++nn]);
+        else if(arg == "-r" && nn+1<argc) seed = atol(argv[++nn]);
+        else if(arg == "-b") build = true;
+        else if(arg == "-g" && nn+3<argc)
+        {
+            for(int ii=0; ii<3; ii++)
+                grid[ii] = atoi(argv[++nn]);
+        }
+        else
+            points.push_back(atof(argv[nn]));
+    }
+    if(cacheDir.back()!='/')
+        cacheDir += "/";
+    if(points.empty() || points.size()%3!=0)
+    {
+        std::cerr<<"Usage: ./query [-c cacheDir] [-t type] [-R R] [-L L] [-g nx ny nz] [-s samples] [-r seed] [-b] x y z [x y z ...]"<<std::endl;
+        return 1;
+    }
+    try
+    {
+        AcceptanceMap map(static_cast<DecayType>(type), R, L, AcceptanceMap::DefaultGrid(R, L, grid[0], grid[1], grid[2]), samples, seed);
+        if(build)
+            map.LoadOrBuild(cacheDir);
+        else if(!map.Load(cacheDir))
+        {
+            std::cerr<<"[ERROR] Map not found in cache: "<<cacheDir+map.GetCacheFileName()<<std::endl;
+            return 1;
+        }
+        for(unsigned ii=0; ii<points.size(); ii+=3)
+            std::cout<<points[ii]<<" "<<points[ii+1]<<" "<<points[ii+2]<<" "<<map.Interpolate(points[ii], points[ii+1], points[ii+2])<<std::endl;
+    }
+    catch(std::string e)
+    {
+        std::cerr<<e<<std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,455 @@
+/// @file io_benchmark.cpp
+/// @date 19.10.2026
+///
+/// @section DESCRIPTION
+/// Compares tree schemas, the RNTuple backend and compression settings: write and read throughput and file size for the same
+/// set of simulated events.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <sys/stat.h>
+#include "TFile.h"
+#include "TTree.h"
+#include "TRandom3.h"
+#include "TGenPhaseSpace.h"
+#include "event.h"
+#include "parammanager.h"
+#include "particlegenerator.h"
+#include "initialcuts.h"
+#include "comptonscattering.h"
+#include "flatevent.h"
+#include "compression.h"
+#include "ntuplewriter.h"
+#if ROOT_VERSION_CODE >= NTUPLE_MIN_ROOT_VERSION
+#include <ROOT/RNTupleReader.hxx>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,36,0)
+using ROOT::RNTupleReader;
+#else
+using ROOT::Experimental::RNTupleReader;
+#endif
+#endif
+
+///
+/// \brief The WriteSettings struct Settings of the output file and tree, the same as in the parameter file.
+///
+struct WriteSettings
+{
+    CompressionAlgorithm algorithm;
+    int level;
+    int basketSize;
+    long long autoFlush;
+
+    ///
+    /// \brief Name Short description used in the table of results.
+    /// \return Algorithm and level, e.g. "zstd-5", used also in names of files.
+    ///
+    std::string Name() const
+    {
+        return algorithm==DEFAULT_COMPRESSION ? "default" : CompressionAlgorithmName(algorithm)+"-"+std::to_string(level);
+    }
+};
+
+///
+/// \brief The BenchmarkResult struct Timings and size measured for one schema.
+///
+struct BenchmarkResult
+{
+    std::string name;
+    std::string settings;
+    double writeSeconds;
+    double readSeconds;
+    double partialReadSeconds; //only energies of photons are read, negative if not measured
+    long bytes; //size of the file
+    long long totalBytes; //size of the tree before compression, size of stored values for the RNTuple
+    double checksum; //sum of read energies, equal for all schemas up to float precision
+};
+
+///
+/// \brief secondsSince Measures time elapsed from start.
+/// \param start Start time.
+/// \return Elapsed time in seconds.
+///
+double secondsSince(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+}
+
+///
+/// \brief fileSize Returns size of a file on disk.
+/// \param path Path to the file.
+/// \return Size in bytes, -1 if the file does not exist.
+///
+long fileSize(const std::string& path)
+{
+    struct stat info;
+    return stat(path.c_str(), &info)==0 ? info.st_size : -1;
+}
+
+///
+/// \brief openOutput Creates the output file and the tree configured with settings.
+/// \param path Path of the output file.
+/// \param settings Compression and tree settings.
+/// \param tree Reference to the pointer to the created tree.
+/// \return Pointer to the created file.
+///
+TFile* openOutput(const std::string& path, const WriteSettings& settings, TTree*& tree)
+{
+    TFile* file = new TFile(path.c_str(), "recreate");
+    int compression = CompressionSettings(settings.algorithm, settings.level);
+    if(compression>=0)
+        file->SetCompressionSettings(compression);
+    tree = new TTree("tree", "Tree with events");
+    tree->SetAutoFlush(settings.autoFlush);
+    return file;
+}
+
+///
+/// \brief generateEvents Simulates events in the same way as the simulation does, histograms are disabled.
+/// \param nEvents Number of events.
+/// \param type Type of decay, TWO or THREE.
+/// \param eff Detection efficiency.
+/// \return Events, have to be deleted by the caller.
+///
+std::vector<Event*> generateEvents(int nEvents, DecayType type, double eff)
+{
+    ParamManager pManag;
+    pManag.SetR(437.3);
+    pManag.SetL(500);
+    pManag.SetEff(eff);
+    pManag.EnableSilentMode();
+    int noOfGammas = 0;
+    recognizeType(type, noOfGammas);
+    std::vector<double> masses(noOfGammas, 0.0);
+    TGenPhaseSpace phaseSpaceGen;
+    TLorentzVector Ps(0.0, 0.0, 0.0, 1.022/1000);
+    phaseSpaceGen.SetDecay(Ps, noOfGammas, masses.data());
+    TLorentzVector source(0.0, 0.0, 0.0, 0.0);
+    InitialCuts cuts(type, pManag.GetR(), pManag.GetL(), pManag.GetEff(), NO_HISTOGRAMS);
+    ComptonScattering cs(type, pManag.GetSmearLowLimit(), pManag.GetSmearHighLimit(), NO_HISTOGRAMS);
+    cuts.EnableSilentMode();
+    cs.EnableSilentMode();
+    std::vector<Event*> events;
+    events.reserve(nEvents);
+    for(int nn=0; nn<nEvents; nn++)
+    {
+        Event* event = generateEvent(phaseSpaceGen, source, pManag, type);
+        cuts.AddCuts(event);
+        cs.Scatter(event);
+        events.push_back(event);
+    }
+    return events;
+}
+
+///
+/// \brief benchmarkSplit Writes and reads events stored as split Event objects (treeSchema := split).
+/// \param events Events to be written.
+/// \param path Path of the output file.
+/// \param settings Compression and tree settings.
+/// \return Measured values.
+///
+BenchmarkResult benchmarkSplit(const std::vector<Event*>& events, const std::string& path, const WriteSettings& settings)
+{
+    BenchmarkResult result = {"split", settings.Name(), 0.0, 0.0, -1.0, 0, 0, 0.0};
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    TTree* tree = nullptr;
+    TFile* file = openOutput(path, settings, tree);
+    Event* event = nullptr;
+    tree->Branch("event_split", "Event", &event, settings.basketSize, 99);
+    for(unsigned ii=0; ii<events.size(); ii++)
+    {
+        event = events[ii];
+        tree->Fill();
+    }
+    tree->Write();
+    result.totalBytes = tree->GetTotBytes();
+    file->Close();
+    delete file;
+    result.writeSeconds = secondsSince(start);
+    result.bytes = fileSize(path);
+
+    start = std::chrono::steady_clock::now();
+    file = TFile::Open(path.c_str());
+    tree = static_cast<TTree*>(file->Get("tree"));
+    event = nullptr;
+    tree->SetBranchAddress("event_split", &event);
+    Long64_t entries = tree->GetEntries();
+    for(Long64_t ii=0; ii<entries; ii++)
+    {
+        tree->GetEntry(ii);
+        for(int jj=0; jj<event->GetNumberOfDecayProducts(); jj++)
+            result.checksum += event->GetFourMomentumOf(jj)->E();
+    }
+    file->Close();
+    delete file;
+    delete event;
+    result.readSeconds = secondsSince(start);
+    return result;
+}
+
+///
+/// \brief benchmarkFlat Writes and reads events stored in columns (treeSchema := flat or sparse).
+/// \param events Events to be written.
+/// \param path Path of the output file.
+/// \param settings Compression and tree settings.
+/// \param sparse Only detected photons are stored, the checksum includes only their energies.
+/// \return Measured values.
+///
+BenchmarkResult benchmarkFlat(const std::vector<Event*>& events, const std::string& path, const WriteSettings& settings, bool sparse=false)
+{
+    BenchmarkResult result = {sparse ? "sparse" : "flat", settings.Name(), 0.0, 0.0, 0.0, 0, 0, 0.0};
+    FlatEvent flat;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    TTree* tree = nullptr;
+    TFile* file = openOutput(path, settings, tree);
+    flat.Branch(tree, settings.basketSize, sparse);
+    for(unsigned ii=0; ii<events.size(); ii++)
+    {
+        flat.Assign(events[ii], sparse);
+        tree->Fill();
+    }
+    tree->Write();
+    result.totalBytes = tree->GetTotBytes();
+    file->Close();
+    delete file;
+    result.writeSeconds = secondsSince(start);
+    result.bytes = fileSize(path);
+
+    start = std::chrono::steady_clock::now();
+    file = TFile::Open(path.c_str());
+    tree = static_cast<TTree*>(file->Get("tree"));
+    flat.SetBranchAddresses(tree);
+    Long64_t entries = tree->GetEntries();
+    for(Long64_t ii=0; ii<entries; ii++)
+    {
+        tree->GetEntry(ii);
+        for(int jj=0; jj<flat.nPhotons; jj++)
+            result.checksum += flat.E[jj];
+    }
+    result.readSeconds = secondsSince(start);
+
+    //typical analysis reads only a few columns
+    start = std::chrono::steady_clock::now();
+    tree->SetBranchStatus("*", 0);
+    tree->SetBranchStatus("nPhotons", 1);
+    tree->SetBranchStatus("E", 1);
+    for(Long64_t ii=0; ii<entries; ii++)
+        tree->GetEntry(ii);
+    result.partialReadSeconds = secondsSince(start);
+    file->Close();
+    delete file;
+    return result;
+}
+
+#if ROOT_VERSION_CODE >= NTUPLE_MIN_ROOT_VERSION
+///
+/// \brief benchmarkNTuple Writes and reads events stored in an RNTuple (treeSchema := ntuple).
+/// \param events Events to be written.
+/// \param path Path of the output file.
+/// \param settings Compression settings, basket size and auto flush do not apply.
+/// \return Measured values.
+///
+BenchmarkResult benchmarkNTuple(const std::vector<Event*>& events, const std::string& path, const WriteSettings& settings)
+{
+    BenchmarkResult result = {"ntuple", settings.Name(), 0.0, 0.0, 0.0, 0, 0, 0.0};
+    const char* photonFields[] = {"px", "py", "pz", "E", "x0", "y0", "z0", "hitX", "hitY", "hitZ", "hitT", "edep", "edepSmear"};
+    FlatEvent flat;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    TFile* file = new TFile(path.c_str(), "recreate");
+    int compression = CompressionSettings(settings.algorithm, settings.level);
+    {
+        NTupleWriter writer(file, "events", compression);
+        for(unsigned ii=0; ii<events.size(); ii++)
+        {
+            flat.Assign(events[ii]);
+            writer.Fill(flat);
+            //id, decay type, weight, flags and 13 floats and flags of every photon
+            result.totalBytes += 20+flat.nPhotons*14*4;
+        }
+    } //the dataset is committed by the destructor
+    file->Close();
+    delete file;
+    result.writeSeconds = secondsSince(start);
+    result.bytes = fileSize(path);
+
+    start = std::chrono::steady_clock::now();
+    {
+        auto reader = RNTupleReader::Open("events", path);
+        auto id = reader->GetView<std::int64_t>("id");
+        auto decayType = reader->GetView<int>("decayType");
+        auto weight = reader->GetView<float>("weight");
+        auto flags = reader->GetView<int>("flags");
+        auto photonFlags = reader->GetView<std::vector<int>>("photonFlags");
+        std::vector<decltype(reader->GetView<std::vector<float>>("E"))> photons;
+        for(const char* name : photonFields)
+            photons.push_back(reader->GetView<std::vector<float>>(name));
+        //views read the values when they are called, so all fields are read as with TTree::GetEntry
+        for(auto ii : reader->GetEntryRange())
+        {
+            id(ii);
+            decayType(ii);
+            weight(ii);
+            flags(ii);
+            photonFlags(ii);
+            for(auto& view : photons)
+                view(ii);
+            for(float energy : photons[3](ii))
+                result.checksum += energy;
+        }
+    }
+    result.readSeconds = secondsSince(start);
+
+    //typical analysis reads only a few columns
+    start = std::chrono::steady_clock::now();
+    {
+        auto reader = RNTupleReader::Open("events", path);
+        auto energies = reader->GetView<std::vector<float>>("E");
+        for(auto ii : reader->GetEntryRange())
+            energies(ii);
+    }
+    result.partialReadSeconds = secondsSince(start);
+    return result;
+}
+#endif
+
+///
+/// \brief parseSettings Converts "algorithm[:level]" given in the command line to settings.
+/// \param arg Command line argument, e.g. "zstd:5" or "lz4".
+/// \param base Settings from which basket size and auto flush are taken.
+/// \return Settings.
+///
+WriteSettings parseSettings(const std::string& arg, const WriteSettings& base)
+{
+    WriteSettings settings = base;
+    size_t colon = arg.find(':');
+    settings.algorithm = ParseCompressionAlgorithm(arg.substr(0, colon));
+    settings.level = colon==std::string::npos ? 1 : atoi(arg.substr(colon+1).c_str());
+    return settings;
+}
+
+int main(int argc, char* argv[])
+{
+    int nEvents = 100000;
+    int type = 2;
+    double eff = 1.0;
+    std::string outputDir = "./";
+    std::string schema = "both";
+    bool keepFiles = false;
+    bool sweep = false;
+    WriteSettings base = {DEFAULT_COMPRESSION, 1, 32000, -30000000};
+    std::vector<std::string> compressionArgs;
+    for(int nn=1; nn<argc; nn++)
+    {
+        std::string arg(argv[nn]);
+        if(arg == "-n" && nn+1<argc) nEvents = atoi(argv[++nn]);
+        else if(arg == "-t" && nn+1<argc) type = atoi(argv[++nn]);
+        else if(arg == "-e" && nn+1<argc) eff = atof(argv[++nn]);
+        else if(arg == "-o" && nn+1<argc) outputDir = argv[++nn];
+        else if(arg == "-s" && nn+1<argc) schema = argv[++nn];
+        else if(arg == "-c" && nn+1<argc) compressionArgs.push_back(argv[++nn]);
+        else if(arg == "-b" && nn+1<argc) base.basketSize = atoi(argv[++nn]);
+        else if(arg == "-f" && nn+1<argc) base.autoFlush = atoll(argv[++nn]);
+        else if(arg == "-z") sweep = true;
+        else if(arg == "-k") keepFiles = true;
+        else
+        {
+            std::cerr<<"Usage: ./io_benchmark [-n events] [-t type] [-e efficiency] [-o outputDir] [-s split|flat|sparse|ntuple|both|all] [-c algorithm[:level]]... [-z]"\
+                     <<" [-b basketSize] [-f autoFlush] [-k]"<<std::endl;
+            return 1;
+        }
+    }
+    if(type!=TWO && type!=THREE)
+    {
+        std::cerr<<"[ERROR] Only 2- and 3-gamma decays are supported!"<<std::endl;
+        return 1;
+    }
+    if(schema!="split" && schema!="flat" && schema!="sparse" && schema!="ntuple" && schema!="both" && schema!="all")
+    {
+        std::cerr<<"[ERROR] Unknown schema: "<<schema<<std::endl;
+        return 1;
+    }
+    if(schema=="ntuple" && !NTupleWriter::IsAvailable())
+    {
+        std::cerr<<"[ERROR] RNTuple requires ROOT 6.32 or newer!"<<std::endl;
+        return 1;
+    }
+    if(outputDir.back()!='/')
+        outputDir += "/";
+
+    //list of compared settings
+    std::vector<WriteSettings> settings;
+    if(sweep)
+    {
+        const CompressionAlgorithm algorithms[] = {ZLIB, LZ4, ZSTD, LZMA};
+        const int levels[] = {1, 5, 9};
+        settings.push_back(base);
+        for(int aa=0; aa<4; aa++)
+        {
+            for(int ll=0; ll<3; ll++)
+            {
+                WriteSettings setting = base;
+                setting.algorithm = algorithms[aa];
+                setting.level = levels[ll];
+                settings.push_back(setting);
+            }
+        }
+    }
+    try
+    {
+        for(unsigned ii=0; ii<compressionArgs.size(); ii++)
+            settings.push_back(parseSettings(compressionArgs[ii], base));
+    }
+    catch(std::string& ex)
+    {
+        std::cerr<<"[ERROR] "<<ex<<std::endl;
+        return 1;
+    }
+    if(settings.empty())
+        settings.push_back(base);
+
+    gRandom->SetSeed(1);
+    std::cout<<"[INFO] Generating "<<nEvents<<" events."<<std::endl;
+    std::vector<Event*> events = generateEvents(nEvents, static_cast<DecayType>(type), eff);
+
+    std::vector<BenchmarkResult> results;
+    for(unsigned ii=0; ii<settings.size(); ii++)
+    {
+        std::cout<<"[INFO] Writing with compression: "<<settings[ii].Name()<<std::endl;
+        if(schema=="split" || schema=="both" || schema=="all")
+            results.push_back(benchmarkSplit(events, outputDir+"io_benchmark_split_"+settings[ii].Name()+".root", settings[ii]));
+        if(schema=="flat" || schema=="both" || schema=="all")
+            results.push_back(benchmarkFlat(events, outputDir+"io_benchmark_flat_"+settings[ii].Name()+".root", settings[ii]));
+        if(schema=="sparse" || schema=="all")
+            results.push_back(benchmarkFlat(events, outputDir+"io_benchmark_sparse_"+settings[ii].Name()+".root", settings[ii], true));
+#if ROOT_VERSION_CODE >= NTUPLE_MIN_ROOT_VERSION
+        if(schema=="ntuple" || schema=="all")
+            results.push_back(benchmarkNTuple(events, outputDir+"io_benchmark_ntuple_"+settings[ii].Name()+".root", settings[ii]));
+#endif
+    }
+    for(unsigned ii=0; ii<events.size(); ii++)
+        delete events[ii];
+
+    //throughput in MB/s refers to the uncompressed size of the tree
+    std::cout<<std::left<<std::setw(8)<<"schema"<<std::setw(10)<<"settings"<<std::right<<std::setw(14)<<"write [MB/s]"\
+             <<std::setw(13)<<"read [MB/s]"<<std::setw(14)<<"write [ev/s]"<<std::setw(13)<<"read [ev/s]"<<std::setw(15)<<"read E [ev/s]"\
+             <<std::setw(11)<<"size [MB]"<<std::setw(10)<<"B/event"<<std::setw(8)<<"ratio"<<std::setw(16)<<"checksum"<<std::endl;
+    for(unsigned ii=0; ii<results.size(); ii++)
+    {
+        const BenchmarkResult& r = results[ii];
+        std::cout<<std::left<<std::setw(8)<<r.name<<std::setw(10)<<r.settings<<std::right<<std::fixed<<std::setprecision(1)\
+                 <<std::setw(14)<<r.totalBytes/1.0e6/r.writeSeconds<<std::setw(13)<<r.totalBytes/1.0e6/r.readSeconds\
+                 <<std::setprecision(0)<<std::setw(14)<<nEvents/r.writeSeconds<<std::setw(13)<<nEvents/r.readSeconds;
+        if(r.partialReadSeconds>=0)
+            std::cout<<std::setw(15)<<nEvents/r.partialReadSeconds;
+        else
+            std::cout<<std::setw(15)<<"-";
+        std::cout<<std::setprecision(2)<<std::setw(11)<<r.bytes/1.0e6<<std::setprecision(1)<<std::setw(10)<<double(r.bytes)/nEvents\
+                 <<std::setprecision(2)<<std::setw(8)<<double(r.totalBytes)/r.bytes<<std::setprecision(3)<<std::setw(16)<<r.checksum<<std::endl;
+        if(!keepFiles)
+            std::remove((outputDir+"io_benchmark_"+r.name+"_"+r.settings+".root").c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+/// @file lmdump.cpp
+/// @date 19.10.2026
+///
+/// @section DESCRIPTION
+/// Prints the header and records of a list-mode file, or of every run of a stream.
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <sys/stat.h>
+#include "listmode.h"
+
+void printHeader(const ListModeHeader& header)
+{
+    std::cout<<"run: "<<header.run<<", seed: "<<header.seed<<", gammas: "<<header.noOfGammas<<std::endl;
+    std::cout<<"R: "<<header.R<<" mm, L: "<<header.L<<" mm, eff: "<<header.eff<<std::endl;
+    std::cout<<"source: ("<<header.sourceX<<", "<<header.sourceY<<", "<<header.sourceZ<<") r="<<header.sourceRadius<<" mm"<<std::endl;
+}
+
+void printRecord(const ListModeRecord& rec)
+{
+    std::cout<<rec.eventId<<" type "<<rec.GetDecayType()<<" weight "<<rec.weight;
+    for(int jj=0; jj<2; jj++)
+        std::cout<<" | ("<<rec.x[jj]<<", "<<rec.y[jj]<<", "<<rec.z[jj]<<") t="<<rec.t[jj]<<" E="<<rec.edep[jj];
+    std::cout<<std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc<2)
+    {
+        std::cerr<<"Usage: ./lmdump file.lm|fifo|- [numberOfRecords]"<<std::endl;
+        return 1;
+    }
+    uint64_t toPrint = argc>2 ? strtoull(argv[2], nullptr, 10) : 10;
+    std::string path(argv[1]);
+    struct stat info;
+    //pipes and the standard input are read sequentially, run by run
+    bool stream = path=="-" || (stat(path.c_str(), &info)==0 && !S_ISREG(info.st_mode));
+    try
+    {
+        if(stream)
+        {
+            ListModeStreamReader reader(path);
+            while(reader.NextRun())
+            {
+                printHeader(reader.GetHeader());
+                ListModeRecord rec;
+                while(reader.Next(rec))
+                {
+                    if(reader.GetNumberOfRecords()<=toPrint)
+                        printRecord(rec);
+                }
+                std::cout<<"events: "<<reader.GetNumberOfEvents()<<", records: "<<reader.GetNumberOfRecords()<<std::endl;
+            }
+            return 0;
+        }
+        ListModeReader reader(path);
+        const ListModeHeader& header = reader.GetHeader();
+        printHeader(header);
+        std::cout<<"events: "<<header.numberOfEvents<<", records: "<<reader.GetNumberOfRecords()<<std::endl;
+        if(toPrint>reader.GetNumberOfRecords())
+            toPrint = reader.GetNumberOfRecords();
+        for(uint64_t ii=0; ii<toPrint; ii++)
+            printRecord(reader[ii]);
+    }
+    catch(std::string& ex)
+    {
+        std::cerr<<ex<<std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+/// @file render.cpp
+/// @date 19.10.2026
+///
+/// @section DESCRIPTION
+/// Draws PNG canvases from raw histograms written by the simulation with "output := raw".
+/// Runs are distributed among worker processes.
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "TFile.h"
+#include "TKey.h"
+#include "TList.h"
+#include "TROOT.h"
+#include "psdecay.h"
+#include "initialcuts.h"
+#include "comptonscattering.h"
+#include "rawoutput.h"
+
+///
+/// \brief findRuns Lists directories of runs which contain raw histograms.
+/// \param file ROOT file created by the simulation.
+/// \return Names of the run directories.
+///
+std::vector<std::string> findRuns(TFile* file)
+{
+    std::vector<std::string> runs;
+    TIter next(file->GetListOfKeys());
+    TKey* key = nullptr;
+    while((key = (TKey*)next()))
+    {
+        if(std::string(key->GetClassName())!="TDirectoryFile")
+            continue;
+        if(file->GetDirectory((std::string(key->GetName())+"/Histograms").c_str()))
+            runs.push_back(key->GetName());
+    }
+    return runs;
+}
+
+///
+/// \brief renderRun Draws all canvases of a single run, the same as the simulation does with "output := png".
+/// \param file ROOT file created by the simulation.
+/// \param run Name of the run directory.
+/// \param outputDir Directory in which a subdirectory for the run is created.
+/// \return Number of rendered decay types.
+///
+int renderRun(TFile* file, const std::string& run, const std::string& outputDir)
+{
+    TDirectory* histDir = file->GetDirectory((run+"/Histograms").c_str());
+    std::string prefix = outputDir+run+"/";
+    mkdir(prefix.c_str(), ACCESSPERMS);
+    int rendered = 0;
+    TIter next(histDir->GetListOfKeys());
+    TKey* key = nullptr;
+    while((key = (TKey*)next()))
+    {
+        DecayType type = DecayTypeFromRawDirectory(key->GetName());
+        if(type==WRONG)
+            continue;
+        TDirectory* rawDir = histDir->GetDirectory(key->GetName());
+        PsDecay decay(type);
+        InitialCuts cuts(type);
+        ComptonScattering cs(type);
+        decay.EnableSilentMode();
+        cuts.EnableSilentMode();
+        cs.EnableSilentMode();
+        decay.ReadHistograms(rawDir);
+        cuts.ReadHistograms(rawDir);
+        cs.ReadHistograms(rawDir);
+        decay.DrawHistograms(prefix, PNG);
+        cuts.DrawHistograms(prefix, PNG);
+        cs.DrawComptonHistograms(prefix, PNG);
+        rendered++;
+    }
+    return rendered;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string inFile;
+    std::string outputDir;
+    int jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    for(int nn=1; nn<argc; nn++)
+    {
+        std::string arg(argv[nn]);
+        if(arg == "-j" && nn+1<argc) jobs = atoi(argv[++nn]);
+        else if(arg == "-o" && nn+1<argc) outputDir = argv[++nn];
+        else inFile = arg;
+    }
+    if(inFile.empty())
+    {
+        std::cerr<<"Usage: ./render [-j jobs] [-o outputDir] file.root"<<std::endl;
+        return 1;
+    }
+    //by default images are placed next to the ROOT file, as in "output := png" mode
+    if(outputDir.empty())
+        outputDir = inFile.find('/')==std::string::npos ? "./" : inFile.substr(0, inFile.rfind('/')+1);
+    if(outputDir.back()!='/')
+        outputDir += "/";
+    mkdir(outputDir.c_str(), ACCESSPERMS);
+
+    //the file is opened again in every worker, ROOT files must not be shared between processes
+    TFile* file = TFile::Open(inFile.c_str());
+    if(!file || file->IsZombie())
+    {
+        std::cerr<<"[ERROR] Cannot open file: "<<inFile<<std::endl;
+        return 1;
+    }
+    std::vector<std::string> runs = findRuns(file);
+    file->Close();
+    delete file;
+    if(runs.empty())
+    {
+        std::cerr<<"[ERROR] No raw histograms found, was the simulation run with \"output := raw\"?"<<std::endl;
+        return 1;
+    }
+    if(jobs<1)
+        jobs = 1;
+    if(jobs>(int)runs.size())
+        jobs = runs.size();
+    std::cout<<"[INFO] Rendering "<<runs.size()<<" run(s) using "<<jobs<<" process(es)."<<std::endl;
+
+    std::vector<pid_t> workers;
+    for(int jj=0; jj<jobs; jj++)
+    {
+        pid_t pid = fork();
+        if(pid<0)
+        {
+            std::cerr<<"[ERROR] Cannot start a worker process!"<<std::endl;
+            break;
+        }
+        if(pid==0)
+        {
+            gROOT->SetBatch(kTRUE);
+            TFile* workerFile = TFile::Open(inFile.c_str());
+            int status = 0;
+            for(unsigned ii=jj; ii<runs.size(); ii+=jobs)
+            {
+                if(renderRun(workerFile, runs[ii], outputDir)==0)
+                {
+                    std::cerr<<"[WARNING] Nothing to render in run: "<<runs[ii]<<std::endl;
+                    status = 2;
+                }
+            }
+            workerFile->Close();
+            _exit(status);
+        }
+        workers.push_back(pid);
+    }
+    int failed = 0;
+    for(unsigned ii=0; ii<workers.size(); ii++)
+    {
+        int status = 0;
+        waitpid(workers[ii], &status, 0);
+        if(!WIFEXITED(status) || WEXITSTATUS(status)!=0)
+            failed++;
+    }
+    if(failed>0 || (int)workers.size()<jobs)
+    {
+        std::cerr<<"[ERROR] "<<failed<<" worker(s) failed."<<std::endl;
+        return 1;
+    }
+    std::cout<<"[INFO] Images saved to: "<<outputDir<<std::endl;
+    return 0;
+}